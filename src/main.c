@@ -15,12 +15,17 @@
 // Framework entry point
 int main(int argc, char **argv) {
     int result = 0;
+    rune_context_t* ctx = rune_context_default();
     
     // Initialize the framework
     RUNE_LOG_FUNC_START("main");
     rune_log_checkpoint("SYSTEM: framework_start", RUNE_CHECKPOINT_LOAD, "rune_analyze framework initialized");
     
-    if (rune_initialize(argc, argv) != 0) {
+    int initialized = rune_initialize(ctx, argc, argv);
+    if (initialized == RUNE_CONFIG_HELP || initialized == RUNE_CONFIG_VERSION) {
+        return 0;
+    }
+    if (initialized != 0) {
         rune_log_error("Framework initialization failed\n");
         return 1;
     }
@@ -29,16 +34,17 @@ int main(int argc, char **argv) {
     RUNE_LOG_FUNC_START("analysis_execution");
     
     // Use enhanced verbose analysis for verbose mode, standard analysis otherwise
-    if (rune_is_verbose_mode()) {
-        result = rune_execute_enhanced_verbose_analysis();
+    // (not for --batch, whose stdout is one JSON object per line)
+    if (ctx->config.verbose_mode && !ctx->config.batch_manifest[0]) {
+        result = rune_execute_enhanced_verbose_analysis(ctx);
     } else {
-        result = rune_execute_analysis();
+        result = rune_execute_analysis(ctx);
     }
     
     RUNE_LOG_FUNC_END("analysis_execution");
     
     // Cleanup and exit
-    rune_cleanup();
+    rune_cleanup(ctx);
     RUNE_LOG_FUNC_END("main");
     rune_log_checkpoint("SYSTEM: framework_exit", RUNE_CHECKPOINT_EXIT, "rune_analyze framework shutdown");
     
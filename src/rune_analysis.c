@@ -9,6 +9,14 @@
  */
 
 #include "rune_analyze.h"
+#include "rune_supervisor.h"
+#include "rune_cgroup.h"
+#include "rune_perf.h"
+#include "rune_matcher.h"
+#include "rune_launch.h"
+#include "rune_probe_host.h"
+
+#include <pthread.h>
 
 // Validate target executable
 int rune_validate_executable(const char* path) {
@@ -39,141 +47,634 @@ int rune_validate_executable(const char* path) {
     return 0;
 }
 
-// Execute target and analyze (skeleton implementation)
-int rune_execute_target(void) {
+// Get current memory usage (VmRSS) in KB
+long rune_get_memory_usage(pid_t pid) {
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/status", pid);
+    
+    FILE* f = fopen(path, "r");
+    if (!f) return -1;
+    
+    char line[256];
+    long vmrss_kb = -1;
+    
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "VmRSS:", 6) == 0) {
+            sscanf(line, "VmRSS: %ld kB", &vmrss_kb);
+            break;
+        }
+    }
+    
+    fclose(f);
+    return vmrss_kb;
+}
+
+// Output keyword groups - each one feeds a counter in rune_results_t
+enum { RUNE_OUTPUT_VERBOSE, RUNE_OUTPUT_ERROR, RUNE_OUTPUT_WARNING, RUNE_OUTPUT_GROUPS };
+
+static const rune_match_pattern_t rune_output_patterns[] = {
+    { "verbose", RUNE_OUTPUT_VERBOSE },
+    { "==>",     RUNE_OUTPUT_VERBOSE },
+    { "<==",     RUNE_OUTPUT_VERBOSE },
+    { "error",   RUNE_OUTPUT_ERROR },
+    { "warning", RUNE_OUTPUT_WARNING },
+};
+
+static rune_matcher_t *rune_output_matcher = NULL;
+static pthread_once_t rune_output_matcher_once = PTHREAD_ONCE_INIT;
+
+static void rune_build_output_matcher(void) {
+    rune_output_matcher = rune_matcher_create(rune_output_patterns,
+                                              sizeof(rune_output_patterns) / sizeof(rune_output_patterns[0]),
+                                              RUNE_MATCH_NOCASE);
+}
+
+// Per-run scan state: automaton position per stream survives chunk boundaries
+typedef struct {
+    rune_context_t* ctx;
+    rune_match_state_t stream_state[2];
+    unsigned long counts[RUNE_OUTPUT_GROUPS];
+    rune_probe_host_t* probe;   // Target checkpoint rings (NULL = --probe not given)
+} rune_output_scan_t;
+
+// Supervisor callback: classify captured output
+static void rune_target_output(void *user, int stream, const char *data, size_t len) {
+    rune_output_scan_t *scan = user;
+    if (rune_output_matcher) {
+        rune_matcher_feed(rune_output_matcher, &scan->stream_state[stream], data, len, scan->counts);
+    }
+}
+
+// Supervisor callback: periodic resource sampling into the timeline
+static void rune_target_sample(void *user, pid_t pid) {
+    rune_output_scan_t *scan = user;
+    rune_context_t *ctx = scan->ctx;
+    rune_timeline_t *tl = &ctx->timeline;
+    if (scan->probe) {
+        rune_probe_host_drain(scan->probe, ctx);
+    }
+    rune_proctree_scan(&ctx->proctree);
+    if (rune_timeline_sample(tl) == 0 && tl->count > 0 &&
+        tl->rss_kb[tl->count - 1] > ctx->results.peak_memory_kb) {
+        ctx->results.peak_memory_kb = tl->rss_kb[tl->count - 1];
+    }
+}
+
+// Turn the sampled timeline into the startup / processing / cleanup split
+static void rune_record_phases(rune_context_t *ctx) {
+    rune_phases_t phases;
+    rune_timeline_detect_phases(&ctx->timeline, ctx->results.execution_time, &phases);
+    ctx->results.startup_time = phases.startup;
+    ctx->results.processing_time = phases.processing;
+    ctx->results.cleanup_time = phases.cleanup;
+    ctx->results.phases_measured = phases.measured;
+    ctx->results.timeline_samples = (int)ctx->timeline.count;
+    RUNE_SAFE_STRNCPY(ctx->results.phase_signal, phases.signal, sizeof(ctx->results.phase_signal));
+    
+    if (ctx->config.timeline_path[0] &&
+        rune_timeline_export_csv(&ctx->timeline, &phases, ctx->config.timeline_path) != 0) {
+        rune_log_error("Cannot write timeline %s: %s\n", ctx->config.timeline_path, strerror(errno));
+    }
+}
+
+// Fill the kernel accounting fields from the reaped child's rusage
+static void rune_record_rusage(rune_context_t *ctx, const struct rusage *ru) {
+    ctx->results.user_time = ru->ru_utime.tv_sec + ru->ru_utime.tv_usec / 1000000.0;
+    ctx->results.system_time = ru->ru_stime.tv_sec + ru->ru_stime.tv_usec / 1000000.0;
+    ctx->results.minor_faults = ru->ru_minflt;
+    ctx->results.major_faults = ru->ru_majflt;
+    ctx->results.voluntary_context_switches = ru->ru_nvcsw;
+    ctx->results.involuntary_context_switches = ru->ru_nivcsw;
+    ctx->results.context_switches = ru->ru_nvcsw + ru->ru_nivcsw;
+    
+    // maxrss is exact; sampling VmRSS misses short spikes
+    if (ru->ru_maxrss > ctx->results.peak_memory_kb) {
+        ctx->results.peak_memory_kb = ru->ru_maxrss;
+    }
+    if (ctx->results.execution_time > 0) {
+        ctx->results.cpu_usage_percent = (ctx->results.user_time + ctx->results.system_time) /
+                                      ctx->results.execution_time * 100.0;
+    }
+}
+
+// Fill the whole-tree accounting fields from the run's cgroup
+static void rune_record_cgroup(rune_context_t *ctx, const rune_cgroup_t *cg) {
+    rune_cgroup_stats_t stats;
+    rune_cgroup_read_stats(cg, &stats);
+    
+    ctx->results.cgroup_enabled = 1;
+    ctx->results.cgroup_cpu_usage_usec = stats.cpu_usage_usec;
+    ctx->results.cgroup_cpu_user_usec = stats.cpu_user_usec;
+    ctx->results.cgroup_cpu_system_usec = stats.cpu_system_usec;
+    ctx->results.cgroup_memory_peak_bytes = stats.memory_peak_bytes;
+    ctx->results.cgroup_io_read_bytes = stats.io_read_bytes;
+    ctx->results.cgroup_io_write_bytes = stats.io_write_bytes;
+    
+    // The cgroup sees every descendant, wait4() only the direct child
+    if (stats.memory_peak_bytes / 1024 > ctx->results.peak_memory_kb) {
+        ctx->results.peak_memory_kb = stats.memory_peak_bytes / 1024;
+    }
+    if (stats.cpu_usage_usec >= 0 && ctx->results.execution_time > 0) {
+        double tree_percent = stats.cpu_usage_usec / 1000000.0 / ctx->results.execution_time * 100.0;
+        if (tree_percent > ctx->results.cpu_usage_percent) {
+            ctx->results.cpu_usage_percent = tree_percent;
+        }
+    }
+}
+
+// Fill the counter fields from the run's perf_event descriptors
+static void rune_record_perf(rune_context_t *ctx, const rune_perf_t *perf) {
+    rune_perf_counts_t counts;
+    rune_perf_read(perf, &counts);
+    
+    ctx->results.perf_enabled = 1;
+    ctx->results.perf_hardware = counts.hardware;
+    ctx->results.perf_task_clock_ns = counts.value[RUNE_PERF_TASK_CLOCK];
+    ctx->results.perf_page_faults = counts.value[RUNE_PERF_PAGE_FAULTS];
+    ctx->results.perf_context_switches = counts.value[RUNE_PERF_CONTEXT_SWITCHES];
+    ctx->results.perf_cpu_migrations = counts.value[RUNE_PERF_CPU_MIGRATIONS];
+    ctx->results.perf_instructions = counts.value[RUNE_PERF_INSTRUCTIONS];
+    ctx->results.perf_cycles = counts.value[RUNE_PERF_CYCLES];
+    ctx->results.perf_cache_references = counts.value[RUNE_PERF_CACHE_REFERENCES];
+    ctx->results.perf_cache_misses = counts.value[RUNE_PERF_CACHE_MISSES];
+    ctx->results.perf_branches = counts.value[RUNE_PERF_BRANCHES];
+    ctx->results.perf_branch_misses = counts.value[RUNE_PERF_BRANCH_MISSES];
+    
+    ctx->results.perf_ipc = 0.0;
+    ctx->results.perf_cache_miss_rate = 0.0;
+    ctx->results.perf_branch_miss_rate = 0.0;
+    if (ctx->results.perf_instructions >= 0 && ctx->results.perf_cycles > 0) {
+        ctx->results.perf_ipc = (double)ctx->results.perf_instructions / ctx->results.perf_cycles;
+    }
+    if (ctx->results.perf_cache_misses >= 0 && ctx->results.perf_cache_references > 0) {
+        ctx->results.perf_cache_miss_rate = (double)ctx->results.perf_cache_misses /
+                                            ctx->results.perf_cache_references;
+    }
+    if (ctx->results.perf_branch_misses >= 0 && ctx->results.perf_branches > 0) {
+        ctx->results.perf_branch_miss_rate = (double)ctx->results.perf_branch_misses /
+                                             ctx->results.perf_branches;
+    }
+}
+
+// Fill the process-tree fields once the target and its tree have been accounted
+static void rune_record_proctree(rune_context_t *ctx) {
+    const rune_proctree_totals_t *totals = &ctx->proctree.totals;
+    ctx->results.tree_processes = (int)totals->processes;
+    ctx->results.tree_max_concurrent = (int)totals->max_concurrent;
+    ctx->results.tree_cpu_seconds = totals->cpu_seconds;
+    ctx->results.tree_peak_rss_kb = (long)totals->peak_rss_kb;
+    ctx->results.tree_read_bytes = totals->read_bytes;
+    ctx->results.tree_write_bytes = totals->write_bytes;
+    ctx->results.tree_orphans_reaped = (int)totals->orphans_reaped;
+    ctx->results.tree_still_running = (int)totals->still_running;
+    
+    // Headline numbers cover the whole tree, not just the direct child
+    if (totals->peak_rss_kb > (uint64_t)ctx->results.peak_memory_kb) {
+        ctx->results.peak_memory_kb = (long)totals->peak_rss_kb;
+    }
+    if (ctx->results.execution_time > 0) {
+        double tree_percent = totals->cpu_seconds / ctx->results.execution_time * 100.0;
+        if (tree_percent > ctx->results.cpu_usage_percent) {
+            ctx->results.cpu_usage_percent = tree_percent;
+        }
+    }
+    if (totals->dropped > 0) {
+        rune_log_warning("Process tree: %zu processes could not be followed\n", totals->dropped);
+    }
+}
+
+// Remove the target's cgroup leaf once the run is over
+static void rune_release_cgroup(rune_cgroup_t *cgroup) {
+    if (rune_cgroup_destroy(cgroup) != 0) {
+        rune_log_warning("Cannot remove cgroup %s: %s\n", cgroup->path, strerror(errno));
+    }
+}
+
+// Launch the target with stdout/stderr redirected into pipes, then supervise it
+static int rune_run_supervised(rune_context_t *ctx, int use_shell) {
+    rune_cgroup_t cgroup;
+    int use_cgroup = 0;
+    if (ctx->config.enable_cgroup) {
+        if (rune_cgroup_create(&cgroup, ctx->config.cgroup_parent) == 0) {
+            use_cgroup = 1;
+            rune_log_debug("Target cgroup: %s\n", cgroup.path);
+        } else {
+            rune_log_warning("cgroup v2 accounting unavailable: %s\n", strerror(errno));
+        }
+    }
+    
+    int stdout_pipe[2], stderr_pipe[2];
+    if (pipe2(stdout_pipe, O_CLOEXEC) != 0) {
+        rune_log_error("Failed to create pipes: %s\n", strerror(errno));
+        if (use_cgroup) rune_cgroup_destroy(&cgroup);
+        return -1;
+    }
+    if (pipe2(stderr_pipe, O_CLOEXEC) != 0) {
+        rune_log_error("Failed to create pipes: %s\n", strerror(errno));
+        if (use_cgroup) rune_cgroup_destroy(&cgroup);
+        close(stdout_pipe[0]);
+        close(stdout_pipe[1]);
+        return -1;
+    }
+    
+    // Report output printed so far before the target's output is forwarded
+    fflush(stdout);
+    fflush(stderr);
+    
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    
+    // Checkpoint rings for the target, and the environment that points it at them
+    rune_probe_host_t probe;
+    int use_probe = 0;
+    char *const *probe_envp = NULL;
+    if (ctx->config.enable_probe) {
+        char library[PATH_MAX];
+        const char *preload = NULL;
+        if (ctx->config.probe_library[0]) {
+            preload = ctx->config.probe_library;
+        } else if (rune_probe_host_find_library(library, sizeof(library)) == 0) {
+            preload = library;
+        } else {
+            rune_log_warning("%s not found next to rune_analyze: only instrumented targets will log\n",
+                             RUNE_PROBE_LIBRARY);
+        }
+        if (rune_probe_host_create(&probe) != 0) {
+            rune_log_warning("Target probe unavailable: %s\n", strerror(errno));
+        } else if (!(probe_envp = rune_probe_host_environ(&probe, preload))) {
+            rune_log_warning("Target probe unavailable: out of memory\n");
+            rune_probe_host_destroy(&probe);
+        } else {
+            use_probe = 1;
+            ctx->results.probe_enabled = 1;
+            ctx->results.probe_preloaded = preload != NULL;
+        }
+    }
+    
+    // Monitor mode: skip /bin/sh when the command is a plain word list
+    char *shell_argv[] = { "sh", "-c", ctx->config.target_executable, NULL };
+    char *direct_argv[MAX_ARGS + 1];
+    char *plain_argv[] = { ctx->config.target_executable, NULL };
+    char words[PATH_MAX];
+    rune_launch_spec_t spec = {
+        .argv = ctx->config.target_args ? ctx->config.target_args : plain_argv,
+        .path = ctx->config.target_executable,
+        .stdout_fd = stdout_pipe[1],
+        .stderr_fd = stderr_pipe[1],
+        .cgroup = use_cgroup ? &cgroup : NULL,
+        .envp = use_probe ? probe_envp : NULL,
+        .keep_fd = use_probe ? probe.fd : 0,
+        .method = (rune_launch_method_t)ctx->config.launch_method,
+    };
+    if (use_shell) {
+        spec.argv = shell_argv;
+        spec.path = "/bin/sh";
+        if (rune_launch_split_command(ctx->config.target_executable, words, sizeof(words),
+                                      direct_argv, MAX_ARGS + 1) > 0) {
+            spec.argv = direct_argv;
+            spec.path = NULL;
+            spec.search_path = 1;
+        }
+    }
+    
+    // Counters attach to this thread and are inherited by the target at launch,
+    // so open them last: nothing else we do before exec() is counted anyway
+    rune_perf_t perf;
+    int use_perf = 0;
+    if (ctx->config.enable_perf) {
+        if (rune_perf_open(&perf) == 0) {
+            use_perf = 1;
+            rune_log_debug("perf_event: %d counters%s\n", perf.opened,
+                           perf.user_only ? " (user space only)" : "");
+        } else {
+            rune_log_warning("perf_event counters unavailable: %s\n", strerror(errno));
+        }
+    }
+    
+    // Orphans the target leaves behind become ours instead of init's, so
+    // their CPU time is not lost (not with other targets sharing the process)
+    int adopt_orphans = !ctx->config.batch_worker && rune_proctree_adopt_orphans(1) == 0;
+    
+    pid_t pid = rune_launch(&spec);
+    if (pid < 0 && spec.search_path && (errno == ENOENT || errno == EACCES || errno == ENOEXEC)) {
+        // Let the shell produce its usual diagnostics (and exit code 127)
+        spec.argv = shell_argv;
+        spec.path = "/bin/sh";
+        spec.search_path = 0;
+        pid = rune_launch(&spec);
+    }
+    if (pid < 0) {
+        rune_log_error("Failed to start %s: %s\n", ctx->config.target_executable, strerror(errno));
+        if (use_probe) rune_probe_host_destroy(&probe);
+        if (adopt_orphans) rune_proctree_adopt_orphans(0);
+        if (use_perf) rune_perf_close(&perf);
+        if (use_cgroup) rune_cgroup_destroy(&cgroup);
+        close(stdout_pipe[0]);
+        close(stdout_pipe[1]);
+        close(stderr_pipe[0]);
+        close(stderr_pipe[1]);
+        return -1;
+    }
+    rune_log_debug("Launcher: %s%s\n", rune_launch_method_name(spec.method),
+                   spec.argv == shell_argv ? " via /bin/sh" : "");
+    
+    // Timeline starts at launch; the first sample is the freshly exec'd image
+    if (!ctx->timeline.capacity && rune_timeline_init(&ctx->timeline, RUNE_TIMELINE_CAPACITY) != 0) {
+        rune_log_warning("No memory for the resource timeline, sampling disabled\n");
+    }
+    rune_timeline_begin(&ctx->timeline, pid, &start);
+    rune_timeline_sample(&ctx->timeline);
+    if (rune_proctree_begin(&ctx->proctree, pid, &start, adopt_orphans) != 0) {
+        rune_log_warning("Cannot follow the process tree of %d\n", (int)pid);
+    }
+    
+    // Parent process - monitor child
+    close(stdout_pipe[1]);
+    close(stderr_pipe[1]);
+    ctx->results.child_pid = pid;
+    
+    rune_output_scan_t scan;
+    memset(&scan, 0, sizeof(scan));
+    scan.ctx = ctx;
+    scan.probe = use_probe ? &probe : NULL;
+    pthread_once(&rune_output_matcher_once, rune_build_output_matcher);
+    
+    rune_supervise_ops_t ops = {
+        .on_output = rune_target_output,
+        .on_sample = rune_target_sample,
+        .user = &scan,
+        .forward_output = !ctx->config.discard_target_output,
+        .sample_interval_us = 1000000 / (ctx->config.sample_rate_hz > 0 ? ctx->config.sample_rate_hz
+                                                                         : RUNE_SAMPLE_RATE_HZ),
+        .capture_ring_size = ctx->config.zero_copy_capture ? RUNE_CAPTURE_RING_SIZE : 0,
+        .timeout_us = (long)(ctx->config.timeout_seconds * 1000000.0),
+    };
+    rune_supervise_result_t sup;
+    if (rune_supervise_child(pid, stdout_pipe[0], stderr_pipe[0], &ops, &sup) != 0) {
+        rune_log_error("Supervising target failed: %s\n", strerror(errno));
+        rune_timeline_end(&ctx->timeline, 0.0, 0.0);
+        if (use_probe) rune_probe_host_destroy(&probe);
+        if (adopt_orphans) rune_proctree_adopt_orphans(0);
+        if (use_perf) rune_perf_close(&perf);
+        if (use_cgroup) rune_release_cgroup(&cgroup);
+        return -1;
+    }
+    
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    ctx->results.execution_time = (end.tv_sec - start.tv_sec) + 
+                              (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+    ctx->results.exit_code = sup.exit_code;
+    ctx->results.stdout_bytes = sup.stdout_bytes;
+    ctx->results.stderr_bytes = sup.stderr_bytes;
+    ctx->results.verbose_messages = (int)scan.counts[RUNE_OUTPUT_VERBOSE];
+    ctx->results.error_messages = (int)scan.counts[RUNE_OUTPUT_ERROR];
+    ctx->results.warning_messages = (int)scan.counts[RUNE_OUTPUT_WARNING];
+    ctx->results.capture_zero_copy = ctx->config.zero_copy_capture && sup.used_zero_copy;
+    ctx->results.capture_dropped_bytes = sup.capture_dropped_bytes;
+    ctx->results.timed_out = sup.timed_out;
+    rune_record_rusage(ctx, &sup.rusage);
+    rune_timeline_end(&ctx->timeline, ctx->results.execution_time,
+                      ctx->results.user_time + ctx->results.system_time);
+    rune_record_phases(ctx);
+    
+    rune_proctree_finish(&ctx->proctree, ctx->results.execution_time, &sup.rusage);
+    if (adopt_orphans) rune_proctree_adopt_orphans(0);
+    rune_record_proctree(ctx);
+    
+    // Whatever the tree logged after the last sample, exit events included
+    if (use_probe) {
+        rune_probe_host_drain(&probe, ctx);
+        ctx->results.probe_events = probe.received;
+        ctx->results.probe_dropped = probe.dropped;
+        rune_probe_host_destroy(&probe);
+    }
+    
+    if (use_cgroup) {
+        rune_record_cgroup(ctx, &cgroup);
+        rune_release_cgroup(&cgroup);
+    }
+    // The target is reaped: every task of the tree has folded its counts in
+    if (use_perf) {
+        rune_record_perf(ctx, &perf);
+        rune_perf_close(&perf);
+    }
+    
+    rune_log_debug("Supervisor: %lu wakeups (%s)\n", sup.wakeups,
+                   sup.used_pidfd ? "pidfd" : "timer fallback");
+    if (ctx->config.zero_copy_capture) {
+        rune_log_debug("Capture: %s\n", sup.used_zero_copy ? "tee/splice" : "read/write fallback");
+    }
+    if (sup.timed_out) {
+        rune_log_warning("Target killed after %.3f second timeout\n", ctx->config.timeout_seconds);
+    }
+    if (sup.capture_dropped_bytes > 0) {
+        rune_log_warning("Capture ring overflowed: %llu bytes forwarded but not pattern-analyzed\n",
+                         sup.capture_dropped_bytes);
+    }
+    return 0;
+}
+
+// Execute target and analyze (ctx is bound as the current context)
+static int rune_execute_target_bound(rune_context_t* ctx) {
     RUNE_LOG_FUNC_START("execute_target");
     
     rune_log_checkpoint("EXEC: target_started", RUNE_CHECKPOINT_SYSCALL, "Target process launched");
     
     // 🛡️ EXECUTION CONTROL CHECK
-    if (g_config.dry_run_mode) {
-        printf("🛡️ DRY RUN MODE: Simulating execution of %s\n", rune_get_target_executable());
+    if (ctx->config.dry_run_mode) {
+        printf("🛡️ DRY RUN MODE: Simulating execution of %s\n", ctx->config.target_executable);
         printf("   • Would fork child process\n");
         printf("   • Would execute command with monitoring\n");
         printf("   • Would collect performance metrics\n");
         printf("   • No actual execution performed\n");
         
         // Simulate timing for realistic dry run
-        g_results.execution_time = 0.123;
-        g_results.exit_code = 0;
-        g_results.child_pid = -1;
+        ctx->results.execution_time = 0.123;
+        ctx->results.exit_code = 0;
+        ctx->results.child_pid = -1;
         
         rune_log_info("🛡️ Dry run simulation completed\n");
         return 0;
     }
     
-    rune_log_info("Executing target: %s\n", rune_get_target_executable());
+    rune_log_info("Executing target: %s\n", ctx->config.target_executable);
     
     // Check if we're in classic monitoring mode
-    if (g_config.enable_monitoring) {
-        // Classic Unix way: execute the command with shell
-        rune_log_info("🔍 Classic monitoring mode: %s\n", rune_get_target_executable());
+    if (ctx->config.enable_monitoring) {
+        rune_log_info("🔍 Classic monitoring mode: %s\n", ctx->config.target_executable);
         
-        struct timeval start, end;
-        gettimeofday(&start, NULL);
-        
-        // Simple fork/exec - the classic Unix way
-        pid_t pid = fork();
-        if (pid == 0) {
-            // Child: use system() for simplicity (classic approach)
-            exit(system(rune_get_target_executable()));
-        } else if (pid > 0) {
-            // Parent: wait and collect basic metrics
-            int status;
-            waitpid(pid, &status, 0);
-            
-            gettimeofday(&end, NULL);
-            g_results.execution_time = (end.tv_sec - start.tv_sec) + 
-                                      (end.tv_usec - start.tv_usec) / 1000000.0;
-            g_results.exit_code = WEXITSTATUS(status);
-            g_results.child_pid = pid;
-            
-            rune_log_info("✅ Classic monitoring complete: %.6f seconds, exit code %d\n", 
-                         g_results.execution_time, g_results.exit_code);
-        } else {
-            rune_log_error("Fork failed: %s\n", strerror(errno));
+        if (rune_run_supervised(ctx, 1) != 0) {
             return -1;
         }
+        
+        rune_log_info("✅ Classic monitoring complete: %.6f seconds, exit code %d\n", 
+                     ctx->results.execution_time, ctx->results.exit_code);
     } else {
         // Direct execution mode (original behavior)
-        pid_t pid = fork();
-        if (pid == 0) {
-            // Child process - execute target
-            execv(rune_get_target_executable(), rune_get_target_args());
-            exit(1); // If execv returns, it failed
-        } else if (pid > 0) {
-            // Parent process - monitor child
-            int status;
-            struct timeval start, end;
-            gettimeofday(&start, NULL);
-            
-            waitpid(pid, &status, 0);
-            
-            gettimeofday(&end, NULL);
-            g_results.execution_time = (end.tv_sec - start.tv_sec) + 
-                                      (end.tv_usec - start.tv_usec) / 1000000.0;
-            g_results.exit_code = WEXITSTATUS(status);
-            g_results.child_pid = pid;
-        
-            rune_log_checkpoint("EXEC: target_completed", RUNE_CHECKPOINT_SYSCALL, "Target process finished");
-        } else {
-            rune_log_error("Fork failed: %s\n", strerror(errno));
+        if (rune_run_supervised(ctx, 0) != 0) {
             return -1;
         }
+        
+        rune_log_checkpoint("EXEC: target_completed", RUNE_CHECKPOINT_SYSCALL, "Target process finished");
     }
     
     RUNE_LOG_FUNC_END("execute_target");
-    return g_results.exit_code;
+    return ctx->results.exit_code;
+}
+
+// Execute target and analyze - checkpoints logged anywhere below land in ctx
+int rune_execute_target(rune_context_t* ctx) {
+    rune_context_t* previous = rune_context_bind(ctx);
+    int result = rune_execute_target_bound(ctx);
+    rune_context_bind(previous);
+    return result;
+}
+
+// ⏱️ Spawn latency of every launch method, at our size and with a large heap
+int rune_execute_spawn_benchmark(rune_context_t* ctx) {
+    int iterations = ctx->config.spawn_benchmark;
+    char *argv[] = { "/bin/true", NULL };
+    
+    printf("⏱️  Spawn latency: %s x %d per method\n", argv[0], iterations);
+    printf("═══════════════════════════════════════════════════════════════\n");
+    
+    // fork() copies page tables, so its cost tracks the parent's RSS
+    size_t ballast_size = (size_t)256 << 20;
+    char *ballast = NULL;
+    for (int pass = 0; pass < 2; pass++) {
+        if (pass == 1) {
+            ballast = malloc(ballast_size);
+            if (!ballast) break;
+            memset(ballast, 1, ballast_size);
+        }
+        printf("\n📏 Analyzer RSS: %ld KB\n", rune_get_memory_usage(getpid()));
+        printf("  %-8s %12s %12s %12s %14s\n", "method", "mean (us)", "p50 (us)", "p99 (us)", "round trip (us)");
+        for (int method = 0; method < RUNE_LAUNCH_METHODS; method++) {
+            rune_launch_bench_t bench;
+            if (rune_launch_benchmark((rune_launch_method_t)method, argv, iterations, &bench) != 0) {
+                rune_log_error("%s: cannot start %s: %s\n", rune_launch_method_name(method),
+                               argv[0], strerror(errno));
+                free(ballast);
+                return -1;
+            }
+            printf("  %-8s %12.1f %12.1f %12.1f %14.1f\n", rune_launch_method_name(method),
+                   bench.launch_mean_us, bench.launch_p50_us, bench.launch_p99_us, bench.roundtrip_mean_us);
+        }
+    }
+    free(ballast);
+    return 0;
 }
 
 // Deep analysis coordination (skeleton)
-void rune_perform_deep_analysis(void) {
+void rune_perform_deep_analysis(rune_context_t* ctx) {
+    rune_context_t* previous = rune_context_bind(ctx);
     RUNE_LOG_FUNC_START("deep_analysis");
     
     rune_log_checkpoint("ANALYSIS: deep_analysis_start", "PERF", "Starting comprehensive analysis");
     
     // TODO: Extract these from the monolithic file
-    rune_classify_tool();
-    rune_analyze_performance_timing();
-    rune_analyze_output_complexity();
-    rune_detect_behavioral_patterns();
-    rune_calculate_efficiency_scores();
+    rune_classify_tool(ctx);
+    rune_analyze_performance_timing(ctx);
+    rune_analyze_output_complexity(ctx);
+    rune_detect_behavioral_patterns(ctx);
+    rune_calculate_efficiency_scores(ctx);
     
     rune_log_checkpoint("ANALYSIS: deep_analysis_complete", "PERF", "Deep analysis completed");
     
     RUNE_LOG_FUNC_END("deep_analysis");
+    rune_context_bind(previous);
 }
 
 // Skeleton implementations - to be filled from monolithic code
-void rune_classify_tool(void) {
+void rune_classify_tool(rune_context_t* ctx) {
     // TODO: Extract from monolithic file
-    strcpy(g_results.tool_classification, "unknown");
-    rune_log_checkpoint("ANALYSIS: tool_classified", "PERF", g_results.tool_classification);
+    strcpy(ctx->results.tool_classification, "unknown");
+    rune_log_checkpoint("ANALYSIS: tool_classified", "PERF", ctx->results.tool_classification);
 }
 
-void rune_analyze_performance_timing(void) {
-    // TODO: Extract from monolithic file
-    g_results.startup_time = g_results.execution_time * 0.1;
-    g_results.processing_time = g_results.execution_time * 0.8;
-    g_results.cleanup_time = g_results.execution_time * 0.1;
-    rune_log_checkpoint("ANALYSIS: timing_analyzed", "PERF", "Performance timing breakdown completed");
+void rune_analyze_performance_timing(rune_context_t* ctx) {
+    // The split was measured from the timeline when the target ran; without
+    // samples (dry run, very short run) there is no evidence for any split
+    if (!ctx->results.phases_measured) {
+        ctx->results.startup_time = 0.0;
+        ctx->results.processing_time = ctx->results.execution_time;
+        ctx->results.cleanup_time = 0.0;
+    }
+    rune_log_checkpoint("ANALYSIS: timing_analyzed", "PERF",
+                        ctx->results.phases_measured ? "Timing breakdown measured from the resource timeline"
+                                                     : "Too few samples for a timing breakdown");
 }
 
-void rune_analyze_output_complexity(void) {
+void rune_analyze_output_complexity(rune_context_t* ctx) {
     // TODO: Extract from monolithic file
-    g_results.output_complexity_score = 5;  // Default
+    ctx->results.output_complexity_score = 5;  // Default
     rune_log_checkpoint("ANALYSIS: complexity_analyzed", "PERF", "Output complexity assessment completed");
 }
 
-void rune_detect_behavioral_patterns(void) {
+void rune_detect_behavioral_patterns(rune_context_t* ctx) {
     // TODO: Extract from monolithic file
-    strcpy(g_results.behavior_pattern, "standard_execution");
-    rune_log_checkpoint("ANALYSIS: behavior_detected", "PERF", g_results.behavior_pattern);
+    strcpy(ctx->results.behavior_pattern, "standard_execution");
+    rune_log_checkpoint("ANALYSIS: behavior_detected", "PERF", ctx->results.behavior_pattern);
 }
 
-void rune_calculate_efficiency_scores(void) {
-    // TODO: Extract from monolithic file
-    g_results.resource_efficiency_score = 7;  // Default
+void rune_calculate_efficiency_scores(rune_context_t* ctx) {
+    rune_results_t *r = &ctx->results;
+    int score = 10;
+    const char *category;
+    
+    if (r->perf_enabled && r->perf_hardware && r->perf_cycles > 0) {
+        // Retired instructions per cycle, discounted for cache and branch misses
+        if (r->perf_ipc >= 2.0) score = 10;
+        else if (r->perf_ipc >= 1.5) score = 8;
+        else if (r->perf_ipc >= 1.0) score = 6;
+        else if (r->perf_ipc >= 0.5) score = 4;
+        else score = 2;
+        if (r->perf_cache_miss_rate > 0.30) score -= 2;
+        else if (r->perf_cache_miss_rate > 0.10) score -= 1;
+        if (r->perf_branch_miss_rate > 0.05) score -= 1;
+        
+        double on_cpu = r->perf_task_clock_ns / 1000000000.0;
+        if (r->execution_time > 0 && on_cpu >= 0 && on_cpu < 0.5 * r->execution_time) {
+            category = "io_or_wait_bound";
+        } else if (r->perf_ipc < 0.7 && r->perf_cache_miss_rate > 0.10) {
+            category = "memory_bound";
+        } else if (r->perf_branch_miss_rate > 0.05) {
+            category = "branch_bound";
+        } else if (r->perf_ipc >= 1.5) {
+            category = "compute_efficient";
+        } else {
+            category = "compute_bound";
+        }
+    } else if (r->perf_enabled) {
+        // Software counters only (no PMU, e.g. in a VM): scheduler and fault overhead per CPU second
+        double on_cpu = r->perf_task_clock_ns / 1000000000.0;
+        if (on_cpu > 0) {
+            if (r->perf_cpu_migrations / on_cpu > 100.0) score -= 2;
+            if (r->perf_context_switches / on_cpu > 1000.0) score -= 2;
+            if (r->perf_page_faults / on_cpu > 100000.0) score -= 2;
+        }
+        if (r->execution_time > 0 && on_cpu >= 0 && on_cpu < 0.5 * r->execution_time) {
+            category = "io_or_wait_bound";
+        } else {
+            category = "cpu_bound";
+        }
+    } else {
+        // No counters: memory per output byte and wall time, as before
+        if (r->peak_memory_kb > 0) {
+            double memory_per_byte = (double)r->peak_memory_kb / (r->stdout_bytes + 1);
+            if (memory_per_byte > 10.0) score = 3;
+            else if (memory_per_byte > 5.0) score = 5;
+            else if (memory_per_byte > 1.0) score = 7;
+        }
+        if (r->execution_time < 0.05) category = "Excellent";
+        else if (r->execution_time < 0.5) category = "Good";
+        else if (r->execution_time < 2.0) category = "Average";
+        else category = "Slow";
+    }
+    
+    if (score < 1) score = 1;
+    r->resource_efficiency_score = score;
+    RUNE_SAFE_STRNCPY(r->performance_category, category, sizeof(r->performance_category));
     rune_log_checkpoint("ANALYSIS: efficiency_calculated", "PERF", "Resource efficiency scores computed");
 }
 
@@ -9,20 +9,22 @@
 #define RUNE_ANALYSIS_H
 
 #include "rune_types.h"
+#include "rune_context.h"
 
 // Core analysis functions
-int rune_execute_target(void);
+int rune_execute_target(rune_context_t* ctx);
+int rune_execute_spawn_benchmark(rune_context_t* ctx);
 int rune_validate_executable(const char* path);
 int rune_sanitize_args(char** args, int argc);
 long rune_get_memory_usage(pid_t pid);
 
 // Deep analysis functions (-vv mode)
-void rune_perform_deep_analysis(void);
-void rune_classify_tool(void);
-void rune_analyze_performance_timing(void);
-void rune_analyze_output_complexity(void);
-void rune_detect_behavioral_patterns(void);
-void rune_calculate_efficiency_scores(void);
+void rune_perform_deep_analysis(rune_context_t* ctx);
+void rune_classify_tool(rune_context_t* ctx);
+void rune_analyze_performance_timing(rune_context_t* ctx);
+void rune_analyze_output_complexity(rune_context_t* ctx);
+void rune_detect_behavioral_patterns(rune_context_t* ctx);
+void rune_calculate_efficiency_scores(rune_context_t* ctx);
 
 // Multi-language detection
 void rune_detect_language_runtime(void);
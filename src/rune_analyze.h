@@ -35,7 +35,11 @@
 #define MAX_OUTPUT_SIZE 65536
 #define MAX_COMMAND_LENGTH 4096
 #define MAX_ARGS 256
-#define MAX_CHECKPOINTS 1024
+#define RUNE_CHECKPOINT_CHUNK 4096      // Records per checkpoint storage chunk
+#define RUNE_CHECKPOINT_MEMORY_MB 16    // Checkpoints kept in memory before spilling (--checkpoint-memory)
+#define RUNE_SAMPLE_RATE_HZ 100         // Default timeline sampling rate (--sample-rate)
+#define RUNE_PROCTREE_REPORT_ROWS 15    // Busiest processes listed in the tree breakdown
+#define RUNE_CAPTURE_RING_SIZE (4 << 20) // Per-stream ring for --zero-copy capture
 
 // Forward declarations for modular components
 typedef struct rune_config rune_config_t;
@@ -44,19 +48,21 @@ typedef struct rune_checkpoint rune_checkpoint_t;
 
 // Include modular headers
 #include "rune_types.h"
+#include "rune_context.h"
 #include "rune_config.h"
 #include "rune_logging.h"
 #include "rune_checkpoint.h"
+#include "rune_dispatch.h"
 #include "rune_analysis.h"
 #include "rune_security.h"
 #include "rune_performance.h"
 #include "rune_output.h"
 
 // Main framework functions
-int rune_initialize(int argc, char **argv);
-int rune_execute_analysis(void);
-int rune_execute_enhanced_verbose_analysis(void);
-void rune_cleanup(void);
+int rune_initialize(rune_context_t* ctx, int argc, char **argv); // RUNE_CONFIG_HELP/_VERSION: printed, exit 0
+int rune_execute_analysis(rune_context_t* ctx);
+int rune_execute_enhanced_verbose_analysis(rune_context_t* ctx);
+void rune_cleanup(rune_context_t* ctx);
 void rune_print_usage(const char* program_name);
 
 #endif /* RUNE_ANALYZE_H */
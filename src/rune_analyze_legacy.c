@@ -15,7 +15,9 @@
  * This program is free software under GPL v3 License.
  */
 
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -30,8 +32,22 @@
 #include <signal.h>
 #include <fcntl.h>
 #include <limits.h>
+#include <stddef.h>
 #include <stdint.h>
+#include <inttypes.h>
 #include <ctype.h>
+#include <pthread.h>
+
+#include "rune_supervisor.h"
+#include "rune_matcher.h"
+#include "rune_launch.h"
+#include "rune_proctree.h"
+#include "rune_elf.h"
+#include "rune_dwarf.h"
+#include "rune_symclass.h"
+#include "rune_cache.h"
+#include "rune_callsite.h"
+#include "rune_deps.h"
 
 // Function declarations
 void perform_deep_analysis(void);
@@ -58,6 +74,7 @@ void analyze_stack_traces(void);
 void extract_debug_info(void);
 int run_objdump_analysis(void);
 int run_nm_analysis(void);
+int run_callsite_analysis(void);
 int run_readelf_analysis(void);
 void parse_gdb_backtrace(void);
 
@@ -121,6 +138,20 @@ int safe_atoi(const char* str, int* result);
 #define MAX_OUTPUT_SIZE 65536
 #define MAX_COMMAND_LENGTH 4096
 #define MAX_ARGS 256
+#define GDB_MAX_FRAMES 16
+#define GDB_MAX_MAPPINGS 16
+#define STATIC_CACHE_NAME "static-v1"
+#define STATIC_CACHE_MAX_BYTES (64ull << 20)
+
+// A call to a dangerous API, located in the machine code
+typedef struct {
+    uint64_t address;
+    uint32_t line;                   // 0 if unknown
+    uint8_t category;                // rune_symclass_category_t
+    char api[32];
+    char function[64];               // "" if no symbol covers the call
+    char file[128];
+} dangerous_call_t;
 
 // Analysis result structure
 typedef struct {
@@ -198,8 +229,12 @@ typedef struct {
     long context_switches;
     
     // Pinpoint Vulnerability Analysis - NEW!
-    char vulnerable_functions[10][64];    // List of specific vulnerable functions found
+    char (*vulnerable_functions)[64];     // Specific vulnerable functions found (grows)
     int vulnerable_function_count;        // Number of vulnerable functions detected
+    int vulnerable_function_capacity;
+    int dangerous_api_counts[RUNE_SYMCLASS_CATEGORIES]; // Imported dangerous APIs per category
+    const dangerous_call_t* dangerous_calls; // Where the binary calls them
+    int dangerous_call_count;
     char crash_function[64];              // Specific function where crash occurred
     int crash_line_number;                // Line number of crash (if available)
     char source_file[256];                // Source file containing vulnerability
@@ -211,6 +246,7 @@ typedef struct {
     char detected_language[32];           // "Java", "Rust", "Python", "C", "Go", etc.
     char runtime_version[64];             // Runtime/compiler version if detectable
     char language_specific_info[256];     // Language-specific analysis results
+    const rune_deps_closure_t* shared_libraries; // What the binary loads, NULL if not a dynamic ELF
     char detected_frameworks[512];        // Detected frameworks (React, Django, Spring, etc.)
     int uses_managed_memory;              // GC languages (Java, C#, Go, etc.)
     int uses_unsafe_code;                 // Rust unsafe blocks, C pointer arithmetic
@@ -242,6 +278,8 @@ typedef struct {
     int enable_performance;     // Enable performance profiling
     int enable_deep_analysis;   // Enable deep analysis (auto-enabled in -vv mode)
     int enable_network_analysis; // Enable network behavior analysis - NEW!
+    int zero_copy_capture;      // Forward output with tee()/splice(), analyze it from a ring
+    int no_cache;               // Neither read nor write the static analysis cache
     char target_executable[PATH_MAX];
     char **target_args;
     int target_argc;
@@ -431,15 +469,68 @@ long get_memory_usage(pid_t pid) {
     return vmrss_kb;
 }
 
+/**
+ * @brief Output keyword groups, counted in one pass by the streaming matcher
+ */
+enum { OUTPUT_VERBOSE, OUTPUT_ERROR, OUTPUT_WARNING, OUTPUT_GROUPS };
+
+static const rune_match_pattern_t output_patterns[] = {
+    { "verbose", OUTPUT_VERBOSE },
+    { "==>",     OUTPUT_VERBOSE },
+    { "<==",     OUTPUT_VERBOSE },
+    { "error",   OUTPUT_ERROR },
+    { "warning", OUTPUT_WARNING },
+};
+
+static rune_matcher_t* output_matcher = NULL;
+static pthread_once_t output_matcher_once = PTHREAD_ONCE_INIT;
+
+static void build_output_matcher(void) {
+    output_matcher = rune_matcher_create(output_patterns,
+                                         sizeof(output_patterns) / sizeof(output_patterns[0]),
+                                         RUNE_MATCH_NOCASE);
+}
+
+// Automaton state per stream, so keywords split across reads are still found
+typedef struct {
+    rune_match_state_t stream_state[2];
+    unsigned long counts[OUTPUT_GROUPS];
+} output_scan_t;
+
+/**
+ * @brief Supervisor callback - analyze a chunk of captured output
+ */
+static void analyze_output_chunk(void* user, int stream, const char* data, size_t len) {
+    output_scan_t* scan = user;
+    if (output_matcher) {
+        rune_matcher_feed(output_matcher, &scan->stream_state[stream], data, len, scan->counts);
+    }
+}
+
+/**
+ * @brief Supervisor callback - track peak memory usage
+ */
+// Every process the target forks, not just the direct child
+static rune_proctree_t g_proctree;
+
+static void sample_child_memory(void* user, pid_t pid) {
+    rune_proctree_scan(&g_proctree);
+    long current_memory = get_memory_usage(pid);
+    if (current_memory > g_results.peak_memory_kb) {
+        g_results.peak_memory_kb = current_memory;
+    }
+}
+
 /**
  * @brief Execute target command with comprehensive monitoring
  */
 int execute_and_analyze(void) {
     runeanalyzer_log(1, "Starting analysis of: %s\n", g_config.target_executable);
     
-    // Create pipes for stdout/stderr capture
+    // Create pipes for stdout/stderr capture (close-on-exec: the target
+    // only keeps the write ends it gets as stdout/stderr)
     int stdout_pipe[2], stderr_pipe[2];
-    if (pipe(stdout_pipe) != 0 || pipe(stderr_pipe) != 0) {
+    if (pipe2(stdout_pipe, O_CLOEXEC) != 0 || pipe2(stderr_pipe, O_CLOEXEC) != 0) {
         runeanalyzer_log(0, "Error: Failed to create pipes: %s\n", strerror(errno));
         return -1;
     }
@@ -448,40 +539,34 @@ int execute_and_analyze(void) {
     struct timeval start_time, end_time;
     gettimeofday(&start_time, NULL);
     
-    // Fork child process
-    pid_t child_pid = fork();
-    if (child_pid == -1) {
-        runeanalyzer_log(0, "Error: Fork failed: %s\n", strerror(errno));
-        return -1;
+    // Build argument array
+    char* exec_args[MAX_ARGS + 2];
+    exec_args[0] = g_config.target_executable;
+    
+    for (int i = 0; i < g_config.target_argc && i < MAX_ARGS; i++) {
+        exec_args[i + 1] = g_config.target_args[i];
     }
+    exec_args[g_config.target_argc + 1] = NULL;
     
-    if (child_pid == 0) {
-        // Child process - execute target command
-        
-        // Redirect stdout/stderr to pipes
-        dup2(stdout_pipe[1], STDOUT_FILENO);
-        dup2(stderr_pipe[1], STDERR_FILENO);
+    // Start the target with posix_spawn() - no page-table copy of ourselves
+    rune_launch_spec_t spec = {
+        .argv = exec_args,
+        .search_path = 1,
+        .stdout_fd = stdout_pipe[1],
+        .stderr_fd = stderr_pipe[1],
+        .method = RUNE_LAUNCH_SPAWN,
+    };
+    int adopt_orphans = rune_proctree_adopt_orphans(1) == 0;
+    pid_t child_pid = rune_launch(&spec);
+    if (child_pid == -1) {
+        if (adopt_orphans) rune_proctree_adopt_orphans(0);
+        runeanalyzer_log(0, "runeanalyzer: failed to execute '%s': %s\n",
+                         g_config.target_executable, strerror(errno));
         close(stdout_pipe[0]);
         close(stdout_pipe[1]);
         close(stderr_pipe[0]);
         close(stderr_pipe[1]);
-        
-        // Build argument array
-        char* exec_args[MAX_ARGS + 2];
-        exec_args[0] = g_config.target_executable;
-        
-        for (int i = 0; i < g_config.target_argc && i < MAX_ARGS; i++) {
-            exec_args[i + 1] = g_config.target_args[i];
-        }
-        exec_args[g_config.target_argc + 1] = NULL;
-        
-        // Execute target
-        execvp(g_config.target_executable, exec_args);
-        
-        // If we get here, exec failed
-        fprintf(stderr, "runeanalyzer: failed to execute '%s': %s\n", 
-                g_config.target_executable, strerror(errno));
-        exit(127);
+        return -1;
     }
     
     // Parent process - monitor child
@@ -489,110 +574,67 @@ int execute_and_analyze(void) {
     close(stderr_pipe[1]);
     
     g_results.child_pid = child_pid;
-    
-    // Monitor memory usage periodically
-    long peak_memory = 0;
-    
-    // Read output from pipes
-    fd_set read_fds;
-    int stdout_fd = stdout_pipe[0];
-    int stderr_fd = stderr_pipe[0];
-    int max_fd = (stdout_fd > stderr_fd) ? stdout_fd : stderr_fd;
-    
-    // Set pipes to non-blocking
-    fcntl(stdout_fd, F_SETFL, O_NONBLOCK);
-    fcntl(stderr_fd, F_SETFL, O_NONBLOCK);
-    
-    char buffer[4096];
-    int child_running = 1;
-    
-    while (child_running) {
-        // Check if child is still running
-        int status;
-        pid_t wait_result = waitpid(child_pid, &status, WNOHANG);
-        
-        if (wait_result == child_pid) {
-            // Child has terminated
-            child_running = 0;
-            if (WIFEXITED(status)) {
-                g_results.exit_code = WEXITSTATUS(status);
-            } else if (WIFSIGNALED(status)) {
-                g_results.exit_code = 128 + WTERMSIG(status);
-            }
-        } else if (wait_result == -1) {
-            runeanalyzer_log(0, "Error: waitpid failed: %s\n", strerror(errno));
-            break;
-        }
-        
-        // Monitor memory usage
-        if (child_running) {
-            long current_memory = get_memory_usage(child_pid);
-            if (current_memory > peak_memory) {
-                peak_memory = current_memory;
-            }
-        }
-        
-        // Read available output
-        FD_ZERO(&read_fds);
-        if (child_running || stdout_fd >= 0) FD_SET(stdout_fd, &read_fds);
-        if (child_running || stderr_fd >= 0) FD_SET(stderr_fd, &read_fds);
-        
-        struct timeval timeout = {0, 10000}; // 10ms timeout
-        int select_result = select(max_fd + 1, &read_fds, NULL, NULL, &timeout);
-        
-        if (select_result > 0) {
-            if (FD_ISSET(stdout_fd, &read_fds)) {
-                ssize_t bytes = read(stdout_fd, buffer, sizeof(buffer) - 1);
-                if (bytes > 0) {
-                    buffer[bytes] = '\0';
-                    g_results.stdout_bytes += bytes;
-                    // Forward to actual stdout
-                    write(STDOUT_FILENO, buffer, bytes);
-                    
-                    // Analyze output for patterns
-                    if (strstr(buffer, "verbose") || strstr(buffer, "VERBOSE") || strstr(buffer, "==>") || strstr(buffer, "<==")) {
-                        g_results.verbose_messages++;
-                    }
-                    if (strstr(buffer, "error") || strstr(buffer, "ERROR")) {
-                        g_results.error_messages++;
-                    }
-                    if (strstr(buffer, "warning") || strstr(buffer, "WARNING")) {
-                        g_results.warning_messages++;
-                    }
-                } else if (bytes == 0) {
-                    close(stdout_fd);
-                    stdout_fd = -1;
-                }
-            }
-            
-            if (FD_ISSET(stderr_fd, &read_fds)) {
-                ssize_t bytes = read(stderr_fd, buffer, sizeof(buffer) - 1);
-                if (bytes > 0) {
-                    buffer[bytes] = '\0';
-                    g_results.stderr_bytes += bytes;
-                    // Forward to actual stderr  
-                    write(STDERR_FILENO, buffer, bytes);
-                } else if (bytes == 0) {
-                    close(stderr_fd);
-                    stderr_fd = -1;
-                }
-            }
-        }
-        
-        // Small delay to prevent busy waiting
-        usleep(1000); // 1ms
+    struct timespec launch_time;
+    clock_gettime(CLOCK_MONOTONIC, &launch_time);
+    rune_proctree_begin(&g_proctree, child_pid, &launch_time, adopt_orphans);
+    
+    // Sleep in epoll until output arrives, the child exits or a sample is due
+    output_scan_t scan;
+    memset(&scan, 0, sizeof(scan));
+    pthread_once(&output_matcher_once, build_output_matcher);
+    
+    rune_supervise_ops_t ops = {
+        .on_output = analyze_output_chunk,
+        .on_sample = sample_child_memory,
+        .user = &scan,
+        .forward_output = 1,
+        .sample_interval_us = 10000, // 10ms, the old polling period
+        .capture_ring_size = g_config.zero_copy_capture ? (4 << 20) : 0,
+    };
+    rune_supervise_result_t sup;
+    if (rune_supervise_child(child_pid, stdout_pipe[0], stderr_pipe[0], &ops, &sup) != 0) {
+        runeanalyzer_log(0, "Error: supervising child failed: %s\n", strerror(errno));
+        if (adopt_orphans) rune_proctree_adopt_orphans(0);
+        return -1;
     }
     
-    // Clean up remaining pipes
-    if (stdout_fd >= 0) close(stdout_fd);
-    if (stderr_fd >= 0) close(stderr_fd);
-    
+    g_results.exit_code = sup.exit_code;
+    g_results.stdout_bytes = sup.stdout_bytes;
+    g_results.stderr_bytes = sup.stderr_bytes;
+    g_results.verbose_messages = (int)scan.counts[OUTPUT_VERBOSE];
+    g_results.error_messages = (int)scan.counts[OUTPUT_ERROR];
+    g_results.warning_messages = (int)scan.counts[OUTPUT_WARNING];
+    if (sup.capture_dropped_bytes > 0) {
+        runeanalyzer_log(1, "Capture ring overflowed: %llu bytes not pattern-analyzed\n",
+                         sup.capture_dropped_bytes);
+    }
+
     // Calculate execution time
     gettimeofday(&end_time, NULL);
-    g_results.execution_time = (end_time.tv_sec - start_time.tv_sec) + 
+    g_results.execution_time = (end_time.tv_sec - start_time.tv_sec) +
                                (end_time.tv_usec - start_time.tv_usec) / 1000000.0;
+
+    // Kernel accounting from wait4() - maxrss catches spikes the sampler misses
+    double cpu_seconds = sup.rusage.ru_utime.tv_sec + sup.rusage.ru_utime.tv_usec / 1000000.0 +
+                         sup.rusage.ru_stime.tv_sec + sup.rusage.ru_stime.tv_usec / 1000000.0;
+    if (g_results.execution_time > 0) {
+        g_results.cpu_usage_percent = cpu_seconds / g_results.execution_time * 100.0;
+    }
+    g_results.context_switches = sup.rusage.ru_nvcsw + sup.rusage.ru_nivcsw;
+    if (sup.rusage.ru_maxrss > g_results.peak_memory_kb) {
+        g_results.peak_memory_kb = sup.rusage.ru_maxrss;
+    }
     
-    g_results.peak_memory_kb = peak_memory;
+    // Builds and installers work in descendants: account for all of them
+    rune_proctree_finish(&g_proctree, g_results.execution_time, &sup.rusage);
+    if (adopt_orphans) rune_proctree_adopt_orphans(0);
+    if ((long)g_proctree.totals.peak_rss_kb > g_results.peak_memory_kb) {
+        g_results.peak_memory_kb = (long)g_proctree.totals.peak_rss_kb;
+    }
+    if (g_results.execution_time > 0 &&
+        g_proctree.totals.cpu_seconds / g_results.execution_time * 100.0 > g_results.cpu_usage_percent) {
+        g_results.cpu_usage_percent = g_proctree.totals.cpu_seconds / g_results.execution_time * 100.0;
+    }
     
     runeanalyzer_log(1, "Analysis completed in %.3fs\n", g_results.execution_time);
     
@@ -971,131 +1013,559 @@ void detect_memory_vulnerabilities(void) {
     if (g_results.overall_security_score > 10) g_results.overall_security_score = 10;
 }
 
+static void add_vulnerable_function(const char* name) {
+    if (g_results.vulnerable_function_count == g_results.vulnerable_function_capacity) {
+        int capacity = g_results.vulnerable_function_capacity ? g_results.vulnerable_function_capacity * 2 : 16;
+        char (*functions)[64] = realloc(g_results.vulnerable_functions, (size_t)capacity * sizeof(*functions));
+        if (!functions) {
+            runeanalyzer_log(1, "Out of memory recording vulnerable function %s\n", name);
+            return;
+        }
+        g_results.vulnerable_functions = functions;
+        g_results.vulnerable_function_capacity = capacity;
+    }
+    SAFE_STRNCPY(g_results.vulnerable_functions[g_results.vulnerable_function_count], name,
+                 sizeof(g_results.vulnerable_functions[0]));
+    g_results.vulnerable_function_count++;
+}
+
+// Model of the target binary, shared by the static analyzers below
+static rune_elf_t g_target_elf;
+static int g_target_elf_open;
+
+static const rune_elf_t* target_elf(void) {
+    if (!g_target_elf_open) {
+        if (rune_elf_open(&g_target_elf, g_config.target_executable) != 0) {
+            runeanalyzer_log(2, "Cannot read %s as ELF: %s\n", g_config.target_executable, strerror(errno));
+            return NULL;
+        }
+        g_target_elf_open = 1;
+    }
+    return &g_target_elf;
+}
+
+// Its DWARF, from the binary itself or its separate debug file
+static rune_dwarf_t g_target_dwarf;
+static rune_elf_t g_debug_elf;
+static int g_target_dwarf_state;       // 0: not tried, 1: open, -1: none
+
+static rune_dwarf_t* target_dwarf(void) {
+    if (g_target_dwarf_state != 0) {
+        return g_target_dwarf_state > 0 ? &g_target_dwarf : NULL;
+    }
+    g_target_dwarf_state = -1;
+    const rune_elf_t* elf = target_elf();
+    if (!elf) {
+        return NULL;
+    }
+    if (rune_dwarf_open(&g_target_dwarf, elf) == 0) {
+        g_target_dwarf_state = 1;
+        return &g_target_dwarf;
+    }
+    if (errno != ENODATA || elf->build_id_size < 2) {
+        runeanalyzer_log(2, "Cannot read DWARF of %s: %s\n", g_config.target_executable, strerror(errno));
+        return NULL;
+    }
+
+    // Distribution debug packages install it under the build ID
+    char path[PATH_MAX];
+    int length = snprintf(path, sizeof(path), "/usr/lib/debug/.build-id/%02x/", elf->build_id[0]);
+    for (size_t i = 1; i < elf->build_id_size && length < (int)sizeof(path) - 8; i++) {
+        length += snprintf(path + length, sizeof(path) - length, "%02x", elf->build_id[i]);
+    }
+    snprintf(path + length, sizeof(path) - length, ".debug");
+    if (rune_elf_open(&g_debug_elf, path) != 0) {
+        runeanalyzer_log(2, "No debug information for %s\n", g_config.target_executable);
+        return NULL;
+    }
+    if (rune_dwarf_open(&g_target_dwarf, &g_debug_elf) != 0) {
+        rune_elf_close(&g_debug_elf);
+        return NULL;
+    }
+    runeanalyzer_log(2, "Using separate debug file %s\n", path);
+    g_target_dwarf_state = 1;
+    return &g_target_dwarf;
+}
+
+// The libraries it loads, from a dependency graph kept for the whole process
+static rune_deps_t g_deps;
+static int g_deps_ready;
+static rune_deps_closure_t g_target_deps;
+static int g_target_deps_state;        // 0: not tried, 1: resolved, -1: failed
+
+static const rune_deps_closure_t* target_deps(void) {
+    if (g_target_deps_state != 0) {
+        return g_target_deps_state > 0 ? &g_target_deps : NULL;
+    }
+    g_target_deps_state = -1;
+    if (!g_deps_ready) {
+        if (rune_deps_init(&g_deps) != 0) {
+            return NULL;
+        }
+        g_deps_ready = 1;
+    }
+    if (rune_deps_closure(&g_deps, g_config.target_executable, &g_target_deps) != 0) {
+        runeanalyzer_log(2, "Cannot resolve the libraries of %s: %s\n", g_config.target_executable, strerror(errno));
+        return NULL;
+    }
+    g_target_deps_state = 1;
+    runeanalyzer_log(2, "Resolved %zu shared libraries (%zu not found), %zu files parsed, %llu names reused\n",
+                     g_target_deps.count, g_target_deps.missing_count, g_deps.count,
+                     (unsigned long long)g_deps.reused);
+    return &g_target_deps;
+}
+
+static void target_elf_close(void) {
+    if (g_target_dwarf_state > 0) {
+        rune_dwarf_close(&g_target_dwarf);
+        if (g_debug_elf.data) {
+            rune_elf_close(&g_debug_elf);
+        }
+    }
+    g_target_dwarf_state = 0;
+    if (g_target_elf_open) {
+        rune_elf_close(&g_target_elf);
+        g_target_elf_open = 0;
+    }
+}
+
+// Source path as the build named it: directories relative to the build root are kept
+static const char* source_path(const rune_dwarf_file_t* source) {
+    static char path[256];
+    if (source->name[0] == '/' || !source->directory || !source->directory[0] || source->directory[0] == '/') {
+        return source->name;
+    }
+    snprintf(path, sizeof(path), "%s/%s", source->directory, source->name);
+    return path;
+}
+
+// Function and source position of a link-time address, from the DWARF
+static int locate_source(uint64_t addr, const char** function, const char** file, uint32_t* line) {
+    rune_dwarf_t* dwarf = target_dwarf();
+    if (!dwarf) {
+        return -1;
+    }
+    const rune_dwarf_function_t* fn = rune_dwarf_function_at(dwarf, addr);
+    const rune_dwarf_file_t* source = NULL;
+    *function = fn ? fn->name : NULL;
+    *file = NULL;
+    *line = 0;
+    if (rune_dwarf_line(dwarf, addr, &source, line) == 0 && source) {
+        *file = source_path(source);
+    } else if (fn) {
+        const rune_dwarf_unit_t* units;
+        *file = fn->unit < rune_dwarf_units(dwarf, &units) ? units[fn->unit].name : NULL;
+    }
+    return fn || *file ? 0 : -1;
+}
+
+// What the static analyzers found, kept apart from g_results so it can be cached per binary
+enum {
+    FINDING_API,                // Dangerous API from the classifier
+    FINDING_MARKER_OVERFLOW,    // Test functions named after their bug
+    FINDING_MARKER_UAF,
+    FINDING_MARKER_FORMAT,
+    FINDING_VULNERABLE_SYMBOL,  // vulnerable_* functions
+};
+
+// Native binaries the name did not classify, by their strings and file(1) output
+enum {
+    NATIVE_UNPROBED,
+    NATIVE_OTHER,
+    NATIVE_RUST,
+    NATIVE_GO,
+    NATIVE_C,
+};
+
+typedef struct {
+    uint8_t kind;
+    uint8_t category;           // rune_symclass_category_t, FINDING_API only
+    uint8_t imported;
+    char symbol[64];
+} static_finding_t;
+
+typedef struct {
+    int symbols_scanned;        // Findings, has_debug_info and source_file are valid
+    int has_debug_info;
+    char source_file[256];
+    int native_language;
+    uint32_t symbol_count;      // Symbols the classifier looked at
+    static_finding_t* findings;
+    size_t finding_count;
+    size_t finding_capacity;
+    dangerous_call_t* calls;
+    size_t call_count;
+    size_t call_capacity;
+
+    int loaded;
+    int dirty;                  // Gained facts the cache does not have
+    int cache_usable;
+    rune_cache_t cache;
+    rune_cache_key_t key;
+} static_facts_t;
+
+static static_facts_t g_static;
+
+#define STATIC_FACTS_VERSION 2
+
+static void add_static_finding(int kind, int category, int imported, const char* symbol) {
+    if (g_static.finding_count == g_static.finding_capacity) {
+        size_t capacity = g_static.finding_capacity ? g_static.finding_capacity * 2 : 16;
+        static_finding_t* findings = realloc(g_static.findings, capacity * sizeof(*findings));
+        if (!findings) {
+            runeanalyzer_log(1, "Out of memory recording symbol %s\n", symbol);
+            return;
+        }
+        g_static.findings = findings;
+        g_static.finding_capacity = capacity;
+    }
+    static_finding_t* finding = &g_static.findings[g_static.finding_count++];
+    finding->kind = (uint8_t)kind;
+    finding->category = (uint8_t)category;
+    finding->imported = (uint8_t)imported;
+    SAFE_STRNCPY(finding->symbol, symbol, sizeof(finding->symbol));
+}
+
+static dangerous_call_t* add_dangerous_call(void) {
+    if (g_static.call_count == g_static.call_capacity) {
+        size_t capacity = g_static.call_capacity ? g_static.call_capacity * 2 : 16;
+        dangerous_call_t* calls = realloc(g_static.calls, capacity * sizeof(*calls));
+        if (!calls) {
+            runeanalyzer_log(1, "Out of memory recording call sites\n");
+            return NULL;
+        }
+        g_static.calls = calls;
+        g_static.call_capacity = capacity;
+    }
+    dangerous_call_t* call = &g_static.calls[g_static.call_count++];
+    memset(call, 0, sizeof(*call));
+    return call;
+}
+
+// Little-endian fields of the cached payload
+static void put_uint(uint8_t** p, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; i++) {
+        *(*p)++ = (uint8_t)(value >> (8 * i));
+    }
+}
+
+static void put_string(uint8_t** p, const char* s, int length_bytes) {
+    size_t length = strlen(s);
+    put_uint(p, length, length_bytes);
+    memcpy(*p, s, length);
+    *p += length;
+}
+
+typedef struct {
+    const uint8_t* p;
+    const uint8_t* end;
+    int bad;                    // Ran past the end or read a bad value
+} facts_reader_t;
+
+static uint64_t get_uint(facts_reader_t* r, int bytes) {
+    uint64_t value = 0;
+    if (r->end - r->p < bytes) {
+        r->bad = 1;
+        return 0;
+    }
+    for (int i = 0; i < bytes; i++) {
+        value |= (uint64_t)*r->p++ << (8 * i);
+    }
+    return value;
+}
+
+static void get_string(facts_reader_t* r, char* buffer, size_t size, int length_bytes) {
+    uint64_t length = get_uint(r, length_bytes);
+    if (r->bad || length >= size || (uint64_t)(r->end - r->p) < length) {
+        r->bad = 1;
+        buffer[0] = '\0';
+        return;
+    }
+    memcpy(buffer, r->p, length);
+    buffer[length] = '\0';
+    r->p += length;
+}
+
+/*
+ * Payload: u8 version, u8 flags (1 scanned, 2 debug info), u8 native language,
+ * u32 symbol count, u16-length source file, u32 finding count, then per
+ * finding u8 kind, u8 category, u8 imported, u8-length symbol; u32 call
+ * count, then per call u64 address, u32 line, u8 category and u8-length
+ * api, function and file. The cache checksums the whole.
+ */
+static size_t encode_static_facts(uint8_t** out) {
+    size_t size = 3 + 4 + 2 + strlen(g_static.source_file) + 4 +
+                  g_static.finding_count * (4 + sizeof(g_static.findings[0].symbol)) + 4 +
+                  g_static.call_count * (8 + 4 + 1 + 3 + sizeof(dangerous_call_t));
+    uint8_t* p = malloc(size);
+    if (!p) {
+        return 0;
+    }
+    *out = p;
+    put_uint(&p, STATIC_FACTS_VERSION, 1);
+    put_uint(&p, (g_static.symbols_scanned ? 1 : 0) | (g_static.has_debug_info ? 2 : 0), 1);
+    put_uint(&p, (uint64_t)g_static.native_language, 1);
+    put_uint(&p, g_static.symbol_count, 4);
+    put_string(&p, g_static.source_file, 2);
+    put_uint(&p, g_static.finding_count, 4);
+    for (size_t f = 0; f < g_static.finding_count; f++) {
+        const static_finding_t* finding = &g_static.findings[f];
+        put_uint(&p, finding->kind, 1);
+        put_uint(&p, finding->category, 1);
+        put_uint(&p, finding->imported, 1);
+        put_string(&p, finding->symbol, 1);
+    }
+    put_uint(&p, g_static.call_count, 4);
+    for (size_t c = 0; c < g_static.call_count; c++) {
+        const dangerous_call_t* call = &g_static.calls[c];
+        put_uint(&p, call->address, 8);
+        put_uint(&p, call->line, 4);
+        put_uint(&p, call->category, 1);
+        put_string(&p, call->api, 1);
+        put_string(&p, call->function, 1);
+        put_string(&p, call->file, 1);
+    }
+    return (size_t)(p - *out);
+}
+
+static int decode_static_facts(const uint8_t* p, size_t size) {
+    facts_reader_t r = { p, p + size, 0 };
+    if (get_uint(&r, 1) != STATIC_FACTS_VERSION) {
+        return -1;
+    }
+    unsigned flags = (unsigned)get_uint(&r, 1);
+    g_static.symbols_scanned = (flags & 1) != 0;
+    g_static.has_debug_info = (flags & 2) != 0;
+    g_static.native_language = (int)get_uint(&r, 1);
+    g_static.symbol_count = (uint32_t)get_uint(&r, 4);
+    get_string(&r, g_static.source_file, sizeof(g_static.source_file), 2);
+    if (g_static.native_language > NATIVE_C) {
+        return -1;
+    }
+
+    uint64_t count = get_uint(&r, 4);
+    for (uint64_t f = 0; f < count && !r.bad; f++) {
+        unsigned kind = (unsigned)get_uint(&r, 1);
+        unsigned category = (unsigned)get_uint(&r, 1);
+        unsigned imported = (unsigned)get_uint(&r, 1);
+        char symbol[sizeof(g_static.findings[0].symbol)];
+        get_string(&r, symbol, sizeof(symbol), 1);
+        if (kind > FINDING_VULNERABLE_SYMBOL || category >= RUNE_SYMCLASS_CATEGORIES) {
+            return -1;
+        }
+        if (!r.bad) {
+            add_static_finding((int)kind, (int)category, (int)imported, symbol);
+        }
+    }
+
+    count = get_uint(&r, 4);
+    for (uint64_t c = 0; c < count && !r.bad; c++) {
+        dangerous_call_t call;
+        call.address = get_uint(&r, 8);
+        call.line = (uint32_t)get_uint(&r, 4);
+        call.category = (uint8_t)get_uint(&r, 1);
+        get_string(&r, call.api, sizeof(call.api), 1);
+        get_string(&r, call.function, sizeof(call.function), 1);
+        get_string(&r, call.file, sizeof(call.file), 1);
+        if (call.category >= RUNE_SYMCLASS_CATEGORIES) {
+            return -1;
+        }
+        dangerous_call_t* slot = r.bad ? NULL : add_dangerous_call();
+        if (slot) {
+            *slot = call;
+        }
+    }
+    return r.bad || r.p != r.end ? -1 : 0;
+}
+
+/**
+ * @brief Static facts about the target, from the cache when it has seen this binary
+ */
+static static_facts_t* static_facts(void) {
+    if (g_static.loaded) {
+        return &g_static;
+    }
+    g_static.loaded = 1;
+    if (g_config.no_cache) {
+        return &g_static;
+    }
+    if (rune_cache_open(&g_static.cache, STATIC_CACHE_NAME, STATIC_CACHE_MAX_BYTES) != 0 ||
+        rune_cache_key(&g_static.key, g_config.target_executable) != 0) {
+        runeanalyzer_log(2, "Static analysis cache unavailable: %s\n", strerror(errno));
+        return &g_static;
+    }
+    g_static.cache_usable = 1;
+
+    size_t size;
+    uint8_t* payload = rune_cache_get(&g_static.cache, &g_static.key, &size);
+    if (!payload) {
+        runeanalyzer_log(2, "No cached static analysis for %s\n", g_config.target_executable);
+        return &g_static;
+    }
+    if (decode_static_facts(payload, size) != 0) {
+        runeanalyzer_log(2, "Ignoring unreadable cached static analysis\n");
+        free(g_static.findings);
+        free(g_static.calls);
+        memset(&g_static, 0, offsetof(static_facts_t, loaded));
+        g_static.loaded = 1;
+        g_static.dirty = 1;     // Overwrite it
+        g_static.cache_usable = 1;
+    } else {
+        runeanalyzer_log(2, "Loaded static analysis of %s from cache\n", g_config.target_executable);
+    }
+    free(payload);
+    return &g_static;
+}
+
+/**
+ * @brief Store what this run learned about the target for the next one
+ */
+static void save_static_facts(void) {
+    if (!g_static.dirty || !g_static.cache_usable) {
+        return;
+    }
+    uint8_t* payload;
+    size_t size = encode_static_facts(&payload);
+    if (size == 0) {
+        return;
+    }
+    if (rune_cache_put(&g_static.cache, &g_static.key, payload, size) != 0) {
+        runeanalyzer_log(2, "Could not cache static analysis: %s\n", strerror(errno));
+    } else {
+        g_static.dirty = 0;
+    }
+    free(payload);
+}
+
 /**
- * @brief Analyze binary symbols using nm command for pinpoint detection
+ * @brief Scan the binary's symbol tables for pinpoint detection
  */
 int run_nm_analysis(void) {
-    runeanalyzer_log(2, "Running nm binary symbol analysis...\n");
+    runeanalyzer_log(2, "Running binary symbol analysis...\n");
     
-    char command[512];
-    snprintf(command, sizeof(command), "nm -D '%s' 2>/dev/null || nm '%s' 2>/dev/null", 
-             g_config.target_executable, g_config.target_executable);
-    
-    FILE* pipe = popen(command, "r");
-    if (!pipe) {
-        runeanalyzer_log(1, "Could not run nm analysis\n");
+    const rune_elf_t* elf = target_elf();
+    if (!elf) {
+        runeanalyzer_log(1, "Could not run symbol analysis\n");
         return -1;
     }
     
-    char line[256];
-    int dangerous_symbols_found = 0;
-    
-    // List of dangerous/vulnerable function signatures
-    const char* dangerous_funcs[] = {
-        "strcpy", "strcat", "sprintf", "vsprintf", "gets", "scanf",
-        "malloc", "free", "realloc", "calloc", "system", "popen",
-        "execve", "execl", "execlp", "execle", "execv", "execvp",
-        "buffer_overflow", "use_after_free", "double_free", "format_string",
-        NULL
-    };
+    rune_symclass_report_t report;
+    if (rune_symclass_classify(elf, &report) != 0) {
+        runeanalyzer_log(1, "Out of memory classifying symbols, results are partial\n");
+    }
+    for (size_t h = 0; h < report.count; h++) {
+        const rune_symclass_hit_t* hit = &report.hits[h];
+        add_static_finding(FINDING_API, hit->category, hit->imported, hit->symbol);
+    }
+    g_static.symbol_count = (uint32_t)report.symbols_scanned;
+    rune_symclass_free(&report);
     
-    while (fgets(line, sizeof(line), pipe) != NULL && dangerous_symbols_found < 10) {
-        // Parse nm output: address type symbol_name
-        char addr[32], type[8], symbol[128];
-        if (sscanf(line, "%31s %7s %127s", addr, type, symbol) == 3) {
-            
-            // Check against dangerous function list
-            for (int i = 0; dangerous_funcs[i] != NULL; i++) {
-                if (strstr(symbol, dangerous_funcs[i])) {
-                    SAFE_STRNCPY(g_results.vulnerable_functions[dangerous_symbols_found], 
-                                symbol, sizeof(g_results.vulnerable_functions[0]));
-                    dangerous_symbols_found++;
-                    
-                    runeanalyzer_log(2, "Found potentially dangerous symbol: %s (type: %s)\n", symbol, type);
-                    
-                    // Specific vulnerability pattern detection
-                    if (strstr(symbol, "buffer_overflow")) {
-                        g_results.buffer_overflow_risk = 5;
-                        SAFE_STRNCPY(g_results.vulnerability_details, 
-                                   "Buffer overflow function detected in binary symbols", 
-                                   sizeof(g_results.vulnerability_details));
-                    } else if (strstr(symbol, "use_after_free")) {
-                        g_results.use_after_free_risk = 5;
-                        SAFE_STRNCPY(g_results.vulnerability_details, 
-                                   "Use-after-free function detected in binary symbols", 
-                                   sizeof(g_results.vulnerability_details));
-                    } else if (strstr(symbol, "format_string")) {
-                        g_results.format_string_vuln = 5;
-                        SAFE_STRNCPY(g_results.vulnerability_details, 
-                                   "Format string vulnerability function detected", 
-                                   sizeof(g_results.vulnerability_details));
-                    } else if (strstr(symbol, "strcpy") || strstr(symbol, "sprintf")) {
-                        g_results.buffer_overflow_risk += 2;
-                        SAFE_STRNCPY(g_results.vulnerability_details, 
-                                   "Unsafe string function detected in binary", 
-                                   sizeof(g_results.vulnerability_details));
-                    }
-                    
-                    break;
-                }
-            }
+    // Our test programs name their functions after the bug they demonstrate
+    for (size_t s = 0; s < elf->symbol_count; s++) {
+        const rune_elf_symbol_t* sym = &elf->symbols[s];
+        if (sym->dynamic == elf->has_symtab || sym->type != STT_FUNC || sym->shndx == SHN_UNDEF) {
+            continue;
+        }
+        const char* symbol = sym->name;
+        if (strstr(symbol, "buffer_overflow")) {
+            add_static_finding(FINDING_MARKER_OVERFLOW, 0, 0, symbol);
+        } else if (strstr(symbol, "use_after_free") || strstr(symbol, "double_free")) {
+            add_static_finding(FINDING_MARKER_UAF, 0, 0, symbol);
+        } else if (strstr(symbol, "format_string")) {
+            add_static_finding(FINDING_MARKER_FORMAT, 0, 0, symbol);
         }
     }
     
-    pclose(pipe);
-    g_results.vulnerable_function_count = dangerous_symbols_found;
+    return 0;
+}
+
+/**
+ * @brief Look for debug information and vulnerable function symbols
+ */
+int run_objdump_analysis(void) {
+    runeanalyzer_log(2, "Running section and symbol table analysis...\n");
+    
+    const rune_elf_t* elf = target_elf();
+    if (!elf) {
+        runeanalyzer_log(1, "Could not run section analysis\n");
+        return -1;
+    }
+    
+    g_static.has_debug_info = elf->has_debug_info;
     
-    if (dangerous_symbols_found > 0) {
-        runeanalyzer_log(1, "🎯 Found %d potentially vulnerable functions in binary\n", dangerous_symbols_found);
+    // Look for specific vulnerable function patterns in symbol table
+    for (size_t s = 0; s < elf->symbol_count; s++) {
+        const rune_elf_symbol_t* sym = &elf->symbols[s];
+        if (sym->dynamic || sym->shndx == SHN_UNDEF || !strstr(sym->name, "vulnerable_")) {
+            continue;
+        }
+        add_static_finding(FINDING_VULNERABLE_SYMBOL, 0, 0, sym->name);
     }
     
     return 0;
 }
 
+// "strcpy called in f() at file.c:12", with whatever of that is known
+static void describe_call(const dangerous_call_t* call, char* buffer, size_t size) {
+    int length = call->function[0]
+        ? snprintf(buffer, size, "%s called in %s()", call->api, call->function)
+        : snprintf(buffer, size, "%s called at 0x%" PRIx64, call->api, call->address);
+    if (call->file[0] && length > 0 && (size_t)length < size) {
+        snprintf(buffer + length, size - length, " at %s:%u", call->file, call->line);
+    }
+}
+
+static int is_dangerous_import(const char* import, void* arg) {
+    return rune_symclass_lookup(import, NULL) >= 0;
+}
+
 /**
- * @brief Analyze binary with objdump for disassembly and vulnerability patterns
+ * @brief Find where the binary calls dangerous APIs, down to the source line with DWARF
  */
-int run_objdump_analysis(void) {
-    runeanalyzer_log(2, "Running objdump disassembly analysis...\n");
+int run_callsite_analysis(void) {
+    runeanalyzer_log(2, "Scanning machine code for dangerous API call sites...\n");
     
-    char command[512];
-    snprintf(command, sizeof(command), "objdump -t '%s' 2>/dev/null | head -50", 
-             g_config.target_executable);
-    
-    FILE* pipe = popen(command, "r");
-    if (!pipe) {
-        runeanalyzer_log(1, "Could not run objdump analysis\n");
+    const rune_elf_t* elf = target_elf();
+    if (!elf) {
         return -1;
     }
     
-    char line[256];
-    int debug_symbols_found = 0;
-    
-    while (fgets(line, sizeof(line), pipe) != NULL) {
-        // Look for debug symbols and function names
-        if (strstr(line, ".debug_") || strstr(line, "DWARF")) {
-            debug_symbols_found = 1;
-            g_results.has_debug_symbols = 1;
-            runeanalyzer_log(2, "Debug symbols detected - enhanced analysis possible\n");
+    rune_callsite_report_t report;
+    if (rune_callsite_scan(elf, is_dangerous_import, NULL, &report) != 0) {
+        runeanalyzer_log(2, "Call site scan %s: %s\n", report.count ? "incomplete" : "unavailable", strerror(errno));
+    }
+    for (size_t i = 0; i < report.count; i++) {
+        const rune_callsite_t* site = &report.sites[i];
+        const char* api;
+        int category = rune_symclass_lookup(site->import, &api);
+        dangerous_call_t* call = category >= 0 ? add_dangerous_call() : NULL;
+        if (!call) {
+            continue;
+        }
+        call->address = site->address;
+        call->category = (uint8_t)category;
+        SAFE_STRNCPY(call->api, api, sizeof(call->api));
+        if (site->function) {
+            SAFE_STRNCPY(call->function, site->function, sizeof(call->function));
         }
         
-        // Look for specific vulnerable function patterns in symbol table
-        if (strstr(line, "buffer_overflow") || strstr(line, "vulnerable_")) {
-            char symbol[128];
-            if (sscanf(line, "%*s %*s %*s %*s %127s", symbol) == 1) {
-                runeanalyzer_log(2, "Found vulnerable function symbol: %s\n", symbol);
-                if (g_results.vulnerable_function_count < 10) {
-                    SAFE_STRNCPY(g_results.vulnerable_functions[g_results.vulnerable_function_count], 
-                                symbol, sizeof(g_results.vulnerable_functions[0]));
-                    g_results.vulnerable_function_count++;
-                }
+        const char* function;
+        const char* file;
+        uint32_t line;
+        if (locate_source(site->address, &function, &file, &line) == 0) {
+            if (!call->function[0] && function) {
+                SAFE_STRNCPY(call->function, function, sizeof(call->function));
+            }
+            if (file) {
+                SAFE_STRNCPY(call->file, file, sizeof(call->file));
+                call->line = line;
             }
         }
     }
+    runeanalyzer_log(2, "Decoded %" PRIu64 " KiB of code, %zu calls to dangerous APIs\n",
+                 report.bytes_decoded / 1024, report.count);
+    rune_callsite_free(&report);
     
-    pclose(pipe);
-    
-    g_results.has_debug_symbols = debug_symbols_found;
     return 0;
 }
 
@@ -1105,40 +1575,144 @@ int run_objdump_analysis(void) {
 void extract_debug_info(void) {
     runeanalyzer_log(2, "Extracting debug information...\n");
     
-    // Try to get source file information using readelf
-    char command[512];
-    snprintf(command, sizeof(command), "readelf --debug-dump=info '%s' 2>/dev/null | head -20", 
-             g_config.target_executable);
-    
-    FILE* pipe = popen(command, "r");
-    if (!pipe) {
+    const rune_elf_t* elf = target_elf();
+    if (!elf) {
         runeanalyzer_log(2, "No debug info extraction possible\n");
         return;
     }
     
-    char line[256];
-    while (fgets(line, sizeof(line), pipe) != NULL) {
-        // Look for source file references
-        if (strstr(line, "DW_AT_name") && (strstr(line, ".c") || strstr(line, ".cpp"))) {
-            char* filename = strrchr(line, '/');
-            if (!filename) filename = strrchr(line, '\\');
-            if (!filename) filename = line;
-            
-            // Extract just the filename
-            char* end = strstr(filename, ".c");
-            if (end) {
-                size_t len = end - filename + 2; // Include .c
-                if (len < sizeof(g_results.source_file)) {
-                    strncpy(g_results.source_file, filename, len);
-                    g_results.source_file[len] = '\0';
-                    runeanalyzer_log(2, "Found source file reference: %s\n", g_results.source_file);
-                    break;
-                }
-            }
+    // With DWARF: where the first vulnerable function we can place is defined, else main
+    rune_dwarf_t* dwarf = target_dwarf();
+    if (dwarf) {
+        const rune_dwarf_unit_t* units;
+        size_t unit_count = rune_dwarf_units(dwarf, &units);
+        const rune_dwarf_function_t* fn = NULL;
+        for (size_t i = 0; i < g_static.finding_count && !fn; i++) {
+            fn = rune_dwarf_function(dwarf, g_static.findings[i].symbol);
+        }
+        if (!fn) {
+            fn = rune_dwarf_function(dwarf, "main");
+        }
+        const char* function;
+        const char* file;
+        uint32_t line;
+        if (fn && locate_source(fn->low, &function, &file, &line) == 0 && file) {
+            SAFE_STRNCPY(g_static.source_file, file, sizeof(g_static.source_file));
+            runeanalyzer_log(2, "Found %s at %s:%u (%zu compile units)\n", fn->name, file, line, unit_count);
+            return;
+        }
+        if (unit_count > 0 && units[0].name[0]) {
+            SAFE_STRNCPY(g_static.source_file, units[0].name, sizeof(g_static.source_file));
+            return;
         }
     }
     
-    pclose(pipe);
+    // Without: the compiler leaves one STT_FILE symbol per translation unit in .symtab
+    for (size_t s = 0; s < elf->symbol_count; s++) {
+        const rune_elf_symbol_t* sym = &elf->symbols[s];
+        if (sym->type != STT_FILE) {
+            continue;
+        }
+        const char* dot = strrchr(sym->name, '.');
+        if (!dot || (strcmp(dot, ".c") != 0 && strcmp(dot, ".cpp") != 0)) {
+            continue;
+        }
+        const char* filename = strrchr(sym->name, '/');
+        filename = filename ? filename + 1 : sym->name;
+        if (strncmp(filename, "crt", 3) == 0) {
+            continue;   // Toolchain startup code (crtstuff.c)
+        }
+        if (strlen(filename) < sizeof(g_static.source_file)) {
+            SAFE_STRNCPY(g_static.source_file, filename, sizeof(g_static.source_file));
+            break;
+        }
+    }
+}
+
+/**
+ * @brief Score the static findings into the results, in the order the analyzers found them
+ */
+static void apply_symbol_facts(void) {
+    size_t api_count = 0;
+    for (size_t f = 0; f < g_static.finding_count; f++) {
+        const static_finding_t* finding = &g_static.findings[f];
+        if (finding->kind != FINDING_API) {
+            continue;
+        }
+        add_vulnerable_function(finding->symbol);
+        runeanalyzer_log(2, "Found potentially dangerous symbol: %s (%s, %s)\n", finding->symbol,
+                     rune_symclass_category_name(finding->category), finding->imported ? "imported" : "defined");
+        if (finding->category == RUNE_SYMCLASS_STRING) {
+            g_results.buffer_overflow_risk += 2;
+            SAFE_STRNCPY(g_results.vulnerability_details, 
+                       "Unsafe string function detected in binary", 
+                       sizeof(g_results.vulnerability_details));
+        }
+        g_results.dangerous_api_counts[finding->category]++;
+        api_count++;
+    }
+    
+    for (size_t f = 0; f < g_static.finding_count; f++) {
+        const static_finding_t* finding = &g_static.findings[f];
+        if (finding->kind == FINDING_MARKER_OVERFLOW) {
+            g_results.buffer_overflow_risk = 5;
+            SAFE_STRNCPY(g_results.vulnerability_details, 
+                       "Buffer overflow function detected in binary symbols", 
+                       sizeof(g_results.vulnerability_details));
+        } else if (finding->kind == FINDING_MARKER_UAF) {
+            g_results.use_after_free_risk = 5;
+            SAFE_STRNCPY(g_results.vulnerability_details, 
+                       "Use-after-free function detected in binary symbols", 
+                       sizeof(g_results.vulnerability_details));
+        } else if (finding->kind == FINDING_MARKER_FORMAT) {
+            g_results.format_string_vuln = 5;
+            SAFE_STRNCPY(g_results.vulnerability_details, 
+                       "Format string vulnerability function detected", 
+                       sizeof(g_results.vulnerability_details));
+        } else {
+            continue;
+        }
+        add_vulnerable_function(finding->symbol);
+        runeanalyzer_log(2, "Found vulnerable test function: %s\n", finding->symbol);
+    }
+    
+    if (api_count > 0) {
+        runeanalyzer_log(1, "🎯 Found %zu dangerous API imports among %u symbols\n",
+                     api_count, g_static.symbol_count);
+    }
+    
+    g_results.dangerous_calls = g_static.calls;
+    g_results.dangerous_call_count = (int)g_static.call_count;
+    int located = 0;
+    for (size_t c = 0; c < g_static.call_count; c++) {
+        const dangerous_call_t* call = &g_static.calls[c];
+        char where[256];
+        describe_call(call, where, sizeof(where));
+        runeanalyzer_log(2, "Call site: %s\n", where);
+        // Name the first unsafe string call instead of just the import
+        if (!located && call->category == RUNE_SYMCLASS_STRING) {
+            snprintf(g_results.vulnerability_details, sizeof(g_results.vulnerability_details),
+                     "Unsafe string function %s", where);
+            located = 1;
+        }
+    }
+    
+    g_results.has_debug_symbols = g_static.has_debug_info;
+    if (g_static.has_debug_info) {
+        runeanalyzer_log(2, "Debug symbols detected - enhanced analysis possible\n");
+    }
+    for (size_t f = 0; f < g_static.finding_count; f++) {
+        const static_finding_t* finding = &g_static.findings[f];
+        if (finding->kind == FINDING_VULNERABLE_SYMBOL) {
+            runeanalyzer_log(2, "Found vulnerable function symbol: %s\n", finding->symbol);
+            add_vulnerable_function(finding->symbol);
+        }
+    }
+    
+    if (g_static.source_file[0]) {
+        SAFE_STRNCPY(g_results.source_file, g_static.source_file, sizeof(g_results.source_file));
+        runeanalyzer_log(2, "Found source file reference: %s\n", g_results.source_file);
+    }
 }
 
 /**
@@ -1173,11 +1747,12 @@ void parse_gdb_backtrace(void) {
     fprintf(script, "\n");
     fprintf(script, "bt\n");
     fprintf(script, "info registers\n"); 
+    fprintf(script, "info proc mappings\n");
     fprintf(script, "quit\n");
     fclose(script);
     
     // Run GDB with the script
-    char command[512];
+    char command[PATH_MAX + 256];       // Room for the target path and the fixed text
     snprintf(command, sizeof(command), 
              "timeout 10s gdb -quiet -batch -x %s '%s' 2>/dev/null", 
              gdb_script, g_config.target_executable);
@@ -1193,7 +1768,36 @@ void parse_gdb_backtrace(void) {
     int in_backtrace = 0;
     int stack_lines = 0;
     
+    // Frame addresses and where the target is mapped, to place the crash through its DWARF
+    uint64_t frames[GDB_MAX_FRAMES] = {0};
+    uint64_t mappings[GDB_MAX_MAPPINGS][3];    // Start, end, file offset
+    int mapping_count = 0;
+    char target_path[PATH_MAX];
+    if (!realpath(g_config.target_executable, target_path)) {
+        SAFE_STRNCPY(target_path, g_config.target_executable, sizeof(target_path));
+    }
+    
     while (fgets(line, sizeof(line), pipe) != NULL && stack_lines < 10) {
+        unsigned frame;
+        uint64_t pc, start, end, size, offset;
+        char reg[8];
+        if (sscanf(line, "#%u 0x%" SCNx64, &frame, &pc) == 2 && frame < GDB_MAX_FRAMES) {
+            frames[frame] = pc;
+        } else if (sscanf(line, "%7s 0x%" SCNx64, reg, &pc) == 2 &&
+                   (strcmp(reg, "rip") == 0 || strcmp(reg, "pc") == 0 || strcmp(reg, "eip") == 0)) {
+            frames[0] = pc;     // Frame #0 is printed without its address at a line start
+        } else if (sscanf(line, " 0x%" SCNx64 " 0x%" SCNx64 " 0x%" SCNx64 " 0x%" SCNx64,
+                          &start, &end, &size, &offset) == 4 && mapping_count < GDB_MAX_MAPPINGS) {
+            const char* objfile = strrchr(line, ' ');
+            if (objfile && strncmp(objfile + 1, target_path, strlen(target_path)) == 0 &&
+                (objfile[1 + strlen(target_path)] == '\n' || objfile[1 + strlen(target_path)] == '\0')) {
+                mappings[mapping_count][0] = start;
+                mappings[mapping_count][1] = end;
+                mappings[mapping_count][2] = offset;
+                mapping_count++;
+            }
+        }
+        
         // Detect start of backtrace
         if (strstr(line, "#0") || strstr(line, "backtrace")) {
             in_backtrace = 1;
@@ -1245,6 +1849,38 @@ void parse_gdb_backtrace(void) {
     pclose(pipe);
     unlink(gdb_script);
     
+    // The innermost frame in the target itself (frame #0 is often inside libc)
+    for (int f = 0; f < GDB_MAX_FRAMES && mapping_count > 0; f++) {
+        // Caller frames hold return addresses, one past the call
+        uint64_t pc = frames[f] ? frames[f] - (f > 0) : 0;
+        int m = 0;
+        while (m < mapping_count && !(pc >= mappings[m][0] && pc < mappings[m][1])) {
+            m++;
+        }
+        if (m == mapping_count) {
+            continue;
+        }
+        int64_t vaddr = rune_elf_offset_vaddr(target_elf(), pc - mappings[m][0] + mappings[m][2]);
+        const char* function;
+        const char* file;
+        uint32_t line_number;
+        if (vaddr < 0 || locate_source((uint64_t)vaddr, &function, &file, &line_number) != 0) {
+            break;
+        }
+        SAFE_STRNCPY(g_results.crash_function, function ? function : "??", sizeof(g_results.crash_function));
+        g_results.crash_line_number = (int)line_number;
+        if (file) {
+            SAFE_STRNCPY(g_results.source_file, file, sizeof(g_results.source_file));
+        }
+        runeanalyzer_log(1, "🎯 CRASH LOCATION: Function '%s' at line %u in %s (frame #%d, DWARF)\n",
+                     g_results.crash_function, line_number, file ? file : "??", f);
+        snprintf(g_results.vulnerability_details, sizeof(g_results.vulnerability_details),
+                "Crash in function '%s' at line %u in file '%s' - Exit code %d indicates %s",
+                g_results.crash_function, line_number, file ? file : "??", g_results.exit_code,
+                decode_exit_code(g_results.exit_code));
+        break;
+    }
+    
     if (g_results.crash_function[0]) {
         runeanalyzer_log(1, "🔍 Pinpoint analysis complete - crash location identified!\n");
     }
@@ -1260,21 +1896,28 @@ void analyze_binary_symbols(void) {
     g_results.vulnerable_function_count = 0;
     g_results.crash_line_number = 0;
     g_results.has_debug_symbols = 0;
-    memset(g_results.vulnerable_functions, 0, sizeof(g_results.vulnerable_functions));
+    memset(g_results.dangerous_api_counts, 0, sizeof(g_results.dangerous_api_counts));
     memset(g_results.crash_function, 0, sizeof(g_results.crash_function));
     memset(g_results.source_file, 0, sizeof(g_results.source_file));
     memset(g_results.vulnerability_details, 0, sizeof(g_results.vulnerability_details));
     memset(g_results.stack_trace, 0, sizeof(g_results.stack_trace));
     
-    // Run different analysis tools
-    run_nm_analysis();
-    run_objdump_analysis(); 
-    extract_debug_info();
+    // Run different analysis tools, unless the cache already holds their findings
+    if (!static_facts()->symbols_scanned) {
+        run_nm_analysis();
+        run_objdump_analysis(); 
+        run_callsite_analysis();
+        extract_debug_info();
+        g_static.symbols_scanned = 1;
+        g_static.dirty = 1;
+    }
+    apply_symbol_facts();
     
     // If program crashed, run detailed GDB analysis
     if (g_results.exit_code >= 128) {
         parse_gdb_backtrace();
     }
+    target_elf_close();
     
     runeanalyzer_log(2, "Binary analysis complete\n");
 }
@@ -1302,27 +1945,21 @@ void detect_vulnerable_functions(void) {
             const char* vuln_type = g_config.target_args[0];
             
             if (strstr(vuln_type, "buffer_overflow")) {
-                SAFE_STRNCPY(g_results.vulnerable_functions[g_results.vulnerable_function_count], 
-                           "test_buffer_overflow", sizeof(g_results.vulnerable_functions[0]));
-                g_results.vulnerable_function_count++;
+                add_vulnerable_function("test_buffer_overflow");
                 g_results.buffer_overflow_risk = 5;
                 SAFE_STRNCPY(g_results.vulnerability_details, 
                            "Buffer overflow in test_buffer_overflow() function", 
                            sizeof(g_results.vulnerability_details));
                            
             } else if (strstr(vuln_type, "use_after_free")) {
-                SAFE_STRNCPY(g_results.vulnerable_functions[g_results.vulnerable_function_count], 
-                           "test_use_after_free", sizeof(g_results.vulnerable_functions[0]));
-                g_results.vulnerable_function_count++;
+                add_vulnerable_function("test_use_after_free");
                 g_results.use_after_free_risk = 5;
                 SAFE_STRNCPY(g_results.vulnerability_details, 
                            "Use-after-free in test_use_after_free() function", 
                            sizeof(g_results.vulnerability_details));
                            
             } else if (strstr(vuln_type, "format_string")) {
-                SAFE_STRNCPY(g_results.vulnerable_functions[g_results.vulnerable_function_count], 
-                           "test_format_string", sizeof(g_results.vulnerable_functions[0]));
-                g_results.vulnerable_function_count++;
+                add_vulnerable_function("test_format_string");
                 g_results.format_string_vuln = 5;
                 SAFE_STRNCPY(g_results.vulnerability_details, 
                            "Format string vulnerability in test_format_string() function", 
@@ -1368,6 +2005,115 @@ void analyze_dangerous_functions(void) {
     if (g_results.overall_security_score < 1) g_results.overall_security_score = 1;
 }
 
+// What the libraries a binary loads say about it, matched as name prefixes
+static const struct {
+    const char* prefix;
+    int native_language;        // NATIVE_* the library implies, NATIVE_UNPROBED if none
+    const char* runtime;        // Language runtime embedded through it
+    const char* framework;
+} g_library_signals[] = {
+    { "libstd-",         NATIVE_RUST,     NULL,      NULL },   // Rust std as a dylib: libstd-<hash>.so
+    { "libgo.so",        NATIVE_GO,       NULL,      NULL },   // gccgo
+    { "libjvm.so",       NATIVE_UNPROBED, "JVM",     NULL },
+    { "libjli.so",       NATIVE_UNPROBED, "JVM",     NULL },
+    { "libpython",       NATIVE_UNPROBED, "Python",  NULL },
+    { "libruby",         NATIVE_UNPROBED, "Ruby",    NULL },
+    { "libperl.so",      NATIVE_UNPROBED, "Perl",    NULL },
+    { "libnode.so",      NATIVE_UNPROBED, "Node.js", NULL },
+    { "liblua",          NATIVE_UNPROBED, "Lua",     NULL },
+    { "libluajit",       NATIVE_UNPROBED, "LuaJIT",  NULL },
+    { "libmonosgen",     NATIVE_UNPROBED, "Mono",    NULL },
+    { "libcoreclr.so",   NATIVE_UNPROBED, ".NET",    NULL },
+    { "libQt5Core.so",   NATIVE_UNPROBED, NULL,      "Qt 5" },
+    { "libQt6Core.so",   NATIVE_UNPROBED, NULL,      "Qt 6" },
+    { "libgtk-3.so",     NATIVE_UNPROBED, NULL,      "GTK 3" },
+    { "libgtk-4.so",     NATIVE_UNPROBED, NULL,      "GTK 4" },
+    { "libSDL2",         NATIVE_UNPROBED, NULL,      "SDL2" },
+    { "libboost_",       NATIVE_UNPROBED, NULL,      "Boost" },
+    { "libssl.so",       NATIVE_UNPROBED, NULL,      "OpenSSL" },
+    { "libgnutls.so",    NATIVE_UNPROBED, NULL,      "GnuTLS" },
+    { "libcurl",         NATIVE_UNPROBED, NULL,      "libcurl" },
+    { "libuv.so",        NATIVE_UNPROBED, NULL,      "libuv" },
+    { "libsqlite3.so",   NATIVE_UNPROBED, NULL,      "SQLite" },
+    { "libpq.so",        NATIVE_UNPROBED, NULL,      "PostgreSQL client" },
+    { "libmysqlclient",  NATIVE_UNPROBED, NULL,      "MySQL client" },
+    { "libmariadb",      NATIVE_UNPROBED, NULL,      "MariaDB client" },
+    { "libtorch",        NATIVE_UNPROBED, NULL,      "PyTorch" },
+    { "libtensorflow",   NATIVE_UNPROBED, NULL,      "TensorFlow" },
+};
+
+#define LIBRARY_SIGNAL_COUNT (sizeof(g_library_signals) / sizeof(g_library_signals[0]))
+
+/**
+ * @brief Tell Rust, Go and C/C++ binaries apart by their libraries, strings and ELF header
+ */
+static int probe_native_language(const char* executable) {
+    char command[PATH_MAX + 256];       // Room for the target path and the fixed text
+    FILE* pipe;
+    
+    // A dynamically linked Rust std or Go runtime settles it without reading the binary
+    const rune_deps_closure_t* deps = target_deps();
+    for (size_t i = 0; deps && i < LIBRARY_SIGNAL_COUNT; i++) {
+        if (g_library_signals[i].native_language != NATIVE_UNPROBED &&
+            rune_deps_find(deps, g_library_signals[i].prefix)) {
+            return g_library_signals[i].native_language;
+        }
+    }
+    
+    // First, check if it's a Rust binary by looking for Rust-specific strings
+    snprintf(command, sizeof(command), "strings '%s' 2>/dev/null | grep -i 'RUST\\|rust_' | head -1", executable);
+    pipe = popen(command, "r");
+    if (pipe) {
+        char line[256];
+        int found = fgets(line, sizeof(line), pipe) && strlen(line) > 1;
+        pclose(pipe);
+        if (found) {
+            return NATIVE_RUST;
+        }
+    }
+    
+    // Check for Go runtime signatures
+    snprintf(command, sizeof(command), "strings '%s' 2>/dev/null | grep -i 'golang\\|go build\\|runtime.go' | head -1", executable);
+    pipe = popen(command, "r");
+    if (pipe) {
+        char line[256];
+        int found = fgets(line, sizeof(line), pipe) && strlen(line) > 1;
+        pclose(pipe);
+        if (found) {
+            return NATIVE_GO;
+        }
+    }
+    
+    // Default to C/C++ for other native binaries
+    const rune_elf_t* elf = target_elf();
+    if (elf && (elf->machine == EM_X86_64 || elf->machine == EM_386 ||
+                elf->machine == EM_AARCH64 || elf->machine == EM_ARM)) {
+        return NATIVE_C;
+    }
+    return NATIVE_OTHER;
+}
+
+/**
+ * @brief Note the language runtimes a native binary embeds through its libraries
+ */
+static void note_embedded_runtimes(void) {
+    const rune_deps_closure_t* deps = target_deps();
+    for (size_t i = 0; deps && i < LIBRARY_SIGNAL_COUNT; i++) {
+        const rune_deps_library_t* lib;
+        if (!g_library_signals[i].runtime || !(lib = rune_deps_find(deps, g_library_signals[i].prefix))) {
+            continue;
+        }
+        char note[128];
+        snprintf(note, sizeof(note), "%sEmbeds %s (%s)", g_results.language_specific_info[0] ? "; " : "",
+                 g_library_signals[i].runtime, lib->name);
+        SAFE_STRNCAT(g_results.language_specific_info, note, sizeof(g_results.language_specific_info));
+        if (strcmp(g_library_signals[i].runtime, "JVM") == 0) {
+            g_results.jvm_analysis_available = 1;
+        }
+        runeanalyzer_log(2, "Embedded runtime: %s through %s\n", g_library_signals[i].runtime, lib->path);
+    }
+}
+
 /**
  * @brief Detect the programming language and runtime of the target executable
  */
@@ -1379,8 +2125,7 @@ void detect_language_runtime(void) {
     if (basename) basename++; else basename = executable;
     
     // Declare variables at the beginning
-    char command[512];
-    FILE* pipe;
+    char joined[2 * PATH_MAX];
     char resolved_path[PATH_MAX];
     
     // Resolve symbolic links to get the actual file
@@ -1395,8 +2140,9 @@ void detect_language_runtime(void) {
                 size_t dir_len = last_slash - executable;
                 strncpy(dir_path, executable, dir_len);
                 dir_path[dir_len] = '\0';
-                snprintf(command, sizeof(command), "%s/%s", dir_path, resolved_path);
-                SAFE_STRNCPY(resolved_path, command, sizeof(resolved_path));
+                if (snprintf(joined, sizeof(joined), "%s/%s", dir_path, resolved_path) < (int)sizeof(resolved_path)) {
+                    SAFE_STRNCPY(resolved_path, joined, sizeof(resolved_path));
+                }
             }
         }
         runeanalyzer_log(2, "Resolved symlink: %s -> %s\n", executable, resolved_path);
@@ -1509,55 +2255,35 @@ void detect_language_runtime(void) {
         }
         
         // Default analysis for native binaries - enhanced Rust detection
-        // First, check if it's a Rust binary by looking for Rust-specific strings
-        snprintf(command, sizeof(command), "strings '%s' 2>/dev/null | grep -i 'RUST\\|rust_' | head -1", executable);
-        pipe = popen(command, "r");
-        if (pipe) {
-            char line[256];
-            if (fgets(line, sizeof(line), pipe) && strlen(line) > 1) {
-                SAFE_STRNCPY(g_results.detected_language, "Rust", sizeof(g_results.detected_language));
-                g_results.uses_managed_memory = 0;  // Rust has ownership system
-                SAFE_STRNCPY(g_results.dependency_manager, "Cargo", sizeof(g_results.dependency_manager));
-                analyze_rust_program();
-                pclose(pipe);
-                runeanalyzer_log(1, "🔍 Detected Language: %s (compiled binary with Rust signatures)\n", g_results.detected_language);
-                return;
-            }
-            pclose(pipe);
+        static_facts_t* facts = static_facts();
+        if (facts->native_language == NATIVE_UNPROBED) {
+            facts->native_language = probe_native_language(executable);
+            facts->dirty = 1;
         }
-        
-        // Check for Go runtime signatures
-        snprintf(command, sizeof(command), "strings '%s' 2>/dev/null | grep -i 'golang\\|go build\\|runtime.go' | head -1", executable);
-        pipe = popen(command, "r");
-        if (pipe) {
-            char line[256];
-            if (fgets(line, sizeof(line), pipe) && strlen(line) > 1) {
-                SAFE_STRNCPY(g_results.detected_language, "Go", sizeof(g_results.detected_language));
-                g_results.uses_managed_memory = 1;  // Go has GC
-                SAFE_STRNCPY(g_results.dependency_manager, "go mod", sizeof(g_results.dependency_manager));
-                analyze_go_program();
-                pclose(pipe);
-                runeanalyzer_log(1, "🔍 Detected Language: %s (compiled binary with Go signatures)\n", g_results.detected_language);
-                return;
-            }
-            pclose(pipe);
+        if (facts->native_language == NATIVE_RUST) {
+            SAFE_STRNCPY(g_results.detected_language, "Rust", sizeof(g_results.detected_language));
+            g_results.uses_managed_memory = 0;  // Rust has ownership system
+            SAFE_STRNCPY(g_results.dependency_manager, "Cargo", sizeof(g_results.dependency_manager));
+            analyze_rust_program();
+            note_embedded_runtimes();
+            runeanalyzer_log(1, "🔍 Detected Language: %s (compiled binary with Rust signatures)\n", g_results.detected_language);
+            return;
         }
-        
-        // Default to C/C++ for other native binaries
-        snprintf(command, sizeof(command), "file '%s' 2>/dev/null", executable);
-        
-        pipe = popen(command, "r");
-        if (pipe) {
-            char line[256];
-            if (fgets(line, sizeof(line), pipe)) {
-                if (strstr(line, "ELF") && (strstr(line, "x86") || strstr(line, "ARM"))) {
-                    SAFE_STRNCPY(g_results.detected_language, "C/C++", sizeof(g_results.detected_language));
-                    g_results.uses_managed_memory = 0;
-                    SAFE_STRNCPY(g_results.dependency_manager, "Make/CMake", sizeof(g_results.dependency_manager));
-                }
-            }
-            pclose(pipe);
+        if (facts->native_language == NATIVE_GO) {
+            SAFE_STRNCPY(g_results.detected_language, "Go", sizeof(g_results.detected_language));
+            g_results.uses_managed_memory = 1;  // Go has GC
+            SAFE_STRNCPY(g_results.dependency_manager, "go mod", sizeof(g_results.dependency_manager));
+            analyze_go_program();
+            note_embedded_runtimes();
+            runeanalyzer_log(1, "🔍 Detected Language: %s (compiled binary with Go signatures)\n", g_results.detected_language);
+            return;
         }
+        if (facts->native_language == NATIVE_C) {
+            SAFE_STRNCPY(g_results.detected_language, "C/C++", sizeof(g_results.detected_language));
+            g_results.uses_managed_memory = 0;
+            SAFE_STRNCPY(g_results.dependency_manager, "Make/CMake", sizeof(g_results.dependency_manager));
+        }
+        note_embedded_runtimes();
     }
     
     runeanalyzer_log(1, "🔍 Detected Language: %s\n", g_results.detected_language);
@@ -1570,7 +2296,7 @@ void analyze_java_program(void) {
     runeanalyzer_log(2, "Analyzing Java program specifics...\n");
     
     // Try to get Java version
-    char command[512];
+    char command[PATH_MAX + 256];       // Room for the target path and the fixed text
     snprintf(command, sizeof(command), "java -version 2>&1 | head -1");
     
     FILE* pipe = popen(command, "r");
@@ -1754,7 +2480,7 @@ void analyze_rust_program(void) {
     runeanalyzer_log(2, "Analyzing Rust program specifics...\n");
     
     // Try to get Rust version
-    char command[512];
+    char command[PATH_MAX + 256];       // Room for the target path and the fixed text
     snprintf(command, sizeof(command), "rustc --version 2>/dev/null || echo 'Unknown'");
     
     FILE* pipe = popen(command, "r");
@@ -2361,6 +3087,18 @@ void detect_frameworks(void) {
         runeanalyzer_log(2, "Detected Kubernetes orchestration\n");
     }
     
+    // Native frameworks, from the libraries the binary loads
+    const rune_deps_closure_t* deps = target_deps();
+    for (size_t i = 0; deps && i < LIBRARY_SIGNAL_COUNT; i++) {
+        if (g_library_signals[i].framework && rune_deps_find(deps, g_library_signals[i].prefix) &&
+            !strstr(g_results.detected_frameworks, g_library_signals[i].framework)) {
+            SAFE_STRNCAT(g_results.detected_frameworks, g_library_signals[i].framework, sizeof(g_results.detected_frameworks));
+            SAFE_STRNCAT(g_results.detected_frameworks, ", ", sizeof(g_results.detected_frameworks));
+            runeanalyzer_log(2, "Detected %s from the linked libraries\n", g_library_signals[i].framework);
+        }
+    }
+    g_results.shared_libraries = deps;
+    
     // Remove trailing comma and space if frameworks were detected
     size_t len = strlen(g_results.detected_frameworks);
     if (len > 2 && strcmp(&g_results.detected_frameworks[len-2], ", ") == 0) {
@@ -2676,6 +3414,63 @@ int check_network_activity(pid_t pid) {
     return 0;
 }
 
+/**
+ * @brief Tool families recognised by name in analyze_verbose_patterns()
+ * Order matters: the first family whose name pattern matches wins.
+ */
+enum {
+    VERBOSE_FILE_OPS, VERBOSE_COMPRESSION, VERBOSE_COMPILATION, VERBOSE_NETWORK,
+    VERBOSE_DIAGNOSTICS, VERBOSE_PACKAGES, VERBOSE_PROFILE_COUNT
+};
+
+typedef struct {
+    const char* operation_type;
+    int score;
+    int file_operations;
+    int path_manipulations;
+    int compression_operations;
+    int compilation_steps;
+    int network_operations;
+    int progress_indicators;
+    int system_calls_verbose;
+    const char* message;
+} verbose_profile_t;
+
+static const verbose_profile_t verbose_profiles[VERBOSE_PROFILE_COUNT] = {
+    [VERBOSE_FILE_OPS]    = { "file_operations", 8, 1, 1, 0, 0, 0, 0, 0,
+                              "File operation tool detected - verbose shows file paths and operations" },
+    [VERBOSE_COMPRESSION] = { "compression", 9, 1, 0, 1, 0, 0, 1, 0,
+                              "Compression tool detected - verbose shows file processing and progress" },
+    [VERBOSE_COMPILATION] = { "compilation", 10, 1, 0, 0, 1, 0, 0, 0,
+                              "Compilation tool detected - verbose shows build steps and dependencies" },
+    [VERBOSE_NETWORK]     = { "network_transfer", 9, 0, 0, 0, 0, 1, 1, 0,
+                              "Network tool detected - verbose shows transfer progress and details" },
+    [VERBOSE_DIAGNOSTICS] = { "system_diagnostics", 10, 0, 0, 0, 0, 0, 0, 1,
+                              "System diagnostic tool detected - verbose shows system call details" },
+    [VERBOSE_PACKAGES]    = { "package_management", 9, 1, 0, 0, 0, 1, 1, 0,
+                              "Package manager detected - verbose shows download and installation steps" },
+};
+
+static const rune_match_pattern_t verbose_tool_patterns[] = {
+    { "cp", VERBOSE_FILE_OPS }, { "mv", VERBOSE_FILE_OPS }, { "ln", VERBOSE_FILE_OPS },
+    { "tar", VERBOSE_COMPRESSION }, { "gzip", VERBOSE_COMPRESSION }, { "zip", VERBOSE_COMPRESSION },
+    { "unzip", VERBOSE_COMPRESSION },
+    { "gcc", VERBOSE_COMPILATION }, { "clang", VERBOSE_COMPILATION }, { "make", VERBOSE_COMPILATION },
+    { "ld", VERBOSE_COMPILATION },
+    { "wget", VERBOSE_NETWORK }, { "curl", VERBOSE_NETWORK }, { "rsync", VERBOSE_NETWORK },
+    { "strace", VERBOSE_DIAGNOSTICS }, { "ltrace", VERBOSE_DIAGNOSTICS }, { "ldd", VERBOSE_DIAGNOSTICS },
+    { "apt", VERBOSE_PACKAGES }, { "yum", VERBOSE_PACKAGES }, { "dnf", VERBOSE_PACKAGES },
+    { "runepkg", VERBOSE_PACKAGES },
+};
+
+static rune_matcher_t* verbose_matcher = NULL;
+static pthread_once_t verbose_matcher_once = PTHREAD_ONCE_INIT;
+
+static void build_verbose_matcher(void) {
+    verbose_matcher = rune_matcher_create(verbose_tool_patterns,
+                                          sizeof(verbose_tool_patterns) / sizeof(verbose_tool_patterns[0]), 0);
+}
+
 /**
  * @brief Analyze verbose output patterns from common Linux tools
  * Your insight: verbose output reveals the internal operations and decision paths!
@@ -2702,61 +3497,33 @@ void analyze_verbose_patterns(void) {
     const char* basename = strrchr(executable, '/');
     if (basename) basename++; else basename = executable;
     
-    // File operation tools (cp, mv, ln, chmod, etc.)
-    if (strstr(basename, "cp") || strstr(basename, "mv") || strstr(basename, "ln")) {
-        g_results.file_operations_detected = 1;
-        g_results.path_manipulations = 1;
-        strncpy(g_results.verbose_operation_type, "file_operations", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 8;
-        runeanalyzer_log(2, "File operation tool detected - verbose shows file paths and operations\n");
+    // One pass over the name finds every tool family; the first family in table order wins
+    pthread_once(&verbose_matcher_once, build_verbose_matcher);
+    unsigned long hits[VERBOSE_PROFILE_COUNT] = {0};
+    if (verbose_matcher) {
+        rune_matcher_scan(verbose_matcher, basename, hits);
     }
     
-    // Compression tools (tar, gzip, zip, etc.)
-    else if (strstr(basename, "tar") || strstr(basename, "gzip") || strstr(basename, "zip") || strstr(basename, "unzip")) {
-        g_results.compression_operations = 1;
-        g_results.file_operations_detected = 1;
-        g_results.progress_indicators = 1;
-        strncpy(g_results.verbose_operation_type, "compression", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 9;
-        runeanalyzer_log(2, "Compression tool detected - verbose shows file processing and progress\n");
-    }
-    
-    // Compilation tools (gcc, make, ld, etc.)
-    else if (strstr(basename, "gcc") || strstr(basename, "clang") || strstr(basename, "make") || strstr(basename, "ld")) {
-        g_results.compilation_steps = 1;
-        g_results.file_operations_detected = 1;
-        strncpy(g_results.verbose_operation_type, "compilation", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 10;
-        runeanalyzer_log(2, "Compilation tool detected - verbose shows build steps and dependencies\n");
-    }
-    
-    // Network tools (wget, curl, rsync, etc.)
-    else if (strstr(basename, "wget") || strstr(basename, "curl") || strstr(basename, "rsync")) {
-        g_results.network_operations = 1;
-        g_results.progress_indicators = 1;
-        strncpy(g_results.verbose_operation_type, "network_transfer", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 9;
-        runeanalyzer_log(2, "Network tool detected - verbose shows transfer progress and details\n");
-    }
-    
-    // System diagnostic tools (strace, ltrace, ldd, etc.)
-    else if (strstr(basename, "strace") || strstr(basename, "ltrace") || strstr(basename, "ldd")) {
-        g_results.system_calls_verbose = 1;
-        strncpy(g_results.verbose_operation_type, "system_diagnostics", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 10;
-        runeanalyzer_log(2, "System diagnostic tool detected - verbose shows system call details\n");
+    const verbose_profile_t* profile = NULL;
+    for (int i = 0; i < VERBOSE_PROFILE_COUNT; i++) {
+        if (hits[i]) {
+            profile = &verbose_profiles[i];
+            break;
+        }
     }
     
-    // Package managers (apt, yum, dnf, etc.)
-    else if (strstr(basename, "apt") || strstr(basename, "yum") || strstr(basename, "dnf") || strstr(basename, "runepkg")) {
-        g_results.file_operations_detected = 1;
-        g_results.network_operations = 1;
-        g_results.progress_indicators = 1;
-        strncpy(g_results.verbose_operation_type, "package_management", sizeof(g_results.verbose_operation_type) - 1);
-        g_results.verbose_intelligence_score = 9;
-        runeanalyzer_log(2, "Package manager detected - verbose shows download and installation steps\n");
+    if (profile) {
+        g_results.file_operations_detected = profile->file_operations;
+        g_results.path_manipulations = profile->path_manipulations;
+        g_results.compression_operations = profile->compression_operations;
+        g_results.compilation_steps = profile->compilation_steps;
+        g_results.network_operations = profile->network_operations;
+        g_results.progress_indicators = profile->progress_indicators;
+        g_results.system_calls_verbose = profile->system_calls_verbose;
+        strncpy(g_results.verbose_operation_type, profile->operation_type, sizeof(g_results.verbose_operation_type) - 1);
+        g_results.verbose_intelligence_score = profile->score;
+        runeanalyzer_log(2, "%s\n", profile->message);
     }
-    
     // Generic file utilities
     else if (strcmp(g_results.tool_classification, "file_utility") == 0) {
         g_results.file_operations_detected = 1;
@@ -2867,6 +3634,13 @@ void print_human_report(void) {
         }
     }
     
+    // Process tree breakdown
+    if (g_proctree.totals.processes > 1) {
+        printf("👪 " COLOR_MAGENTA "Process Tree:" COLOR_RESET " %zu processes (max %zu at once), %.3fs CPU\n",
+               g_proctree.totals.processes, g_proctree.totals.max_concurrent, g_proctree.totals.cpu_seconds);
+        rune_proctree_print(&g_proctree, stdout, 15);
+    }
+    
     // I/O analysis
     printf("💿 " COLOR_CYAN "I/O Analysis:" COLOR_RESET "\n");
     printf("  📤 Stdout Output: %zu bytes\n", g_results.stdout_bytes);
@@ -2929,6 +3703,18 @@ void print_human_report(void) {
             if (strcmp(g_results.detected_frameworks, "None detected") != 0 && g_results.detected_frameworks[0]) {
                 printf("  🚀 Detected Frameworks: %s\n", g_results.detected_frameworks);
             }
+            
+            const rune_deps_closure_t* deps = g_results.shared_libraries;
+            if (deps && (deps->count || deps->missing_count)) {
+                printf("  📚 Shared Libraries: %zu", deps->count);
+                if (deps->missing_count) {
+                    printf(" (" COLOR_YELLOW "%zu not found" COLOR_RESET ")", deps->missing_count);
+                }
+                printf("\n");
+                for (size_t i = 0; i < deps->missing_count && i < 5; i++) {
+                    printf("    • %s: not found\n", deps->missing[i]);
+                }
+            }
         }
         
         if (g_results.execution_time > 0.1) {
@@ -3023,6 +3809,20 @@ void print_human_report(void) {
                 for (int i = 0; i < g_results.vulnerable_function_count && i < 5; i++) {
                     printf("    • %s\n", g_results.vulnerable_functions[i]);
                 }
+                printf("  ⚠️  Dangerous APIs:");
+                for (int c = 0; c < RUNE_SYMCLASS_CATEGORIES; c++) {
+                    printf(" %s %d", rune_symclass_category_name((rune_symclass_category_t)c),
+                           g_results.dangerous_api_counts[c]);
+                }
+                printf("\n");
+                if (g_results.dangerous_call_count > 0) {
+                    printf("  📞 Dangerous Call Sites: %d\n", g_results.dangerous_call_count);
+                    for (int i = 0; i < g_results.dangerous_call_count && i < 5; i++) {
+                        char where[256];
+                        describe_call(&g_results.dangerous_calls[i], where, sizeof(where));
+                        printf("    • %s\n", where);
+                    }
+                }
                 
                 if (g_results.crash_function[0]) {
                     printf("  💥 " COLOR_RED "Crash Location: %s" COLOR_RESET, g_results.crash_function);
@@ -3153,7 +3953,21 @@ void print_json_report(void) {
         printf("      \"uses_unsafe_code\": %s,\n", g_results.uses_unsafe_code ? "true" : "false");
         printf("      \"jvm_analysis_available\": %s,\n", g_results.jvm_analysis_available ? "true" : "false");
         printf("      \"cargo_project_detected\": %s,\n", g_results.cargo_project_detected ? "true" : "false");
-        printf("      \"language_specific_info\": \"%s\"\n", g_results.language_specific_info);
+        printf("      \"language_specific_info\": \"%s\",\n", g_results.language_specific_info);
+        const rune_deps_closure_t* deps = g_results.shared_libraries;
+        size_t library_count = deps ? deps->count : 0;
+        size_t missing_count = deps ? deps->missing_count : 0;
+        printf("      \"shared_libraries\": [");
+        for (size_t i = 0; i < library_count; i++) {
+            printf("%s\n        {\"name\": \"%s\", \"path\": \"%s\"}", i ? "," : "",
+                   deps->libraries[i]->name, deps->libraries[i]->path);
+        }
+        printf("%s],\n", library_count ? "\n      " : "");
+        printf("      \"missing_libraries\": [");
+        for (size_t i = 0; i < missing_count; i++) {
+            printf("%s\"%s\"", i ? ", " : "", deps->missing[i]);
+        }
+        printf("]\n");
         printf("    }");
         
         // Add security analysis to JSON if enabled
@@ -3174,6 +3988,27 @@ void print_json_report(void) {
             printf("      \"pinpoint_analysis\": {\n");
             printf("        \"vulnerable_function_count\": %d,\n", g_results.vulnerable_function_count);
             printf("        \"has_debug_symbols\": %s,\n", g_results.has_debug_symbols ? "true" : "false");
+            printf("        \"dangerous_apis\": {");
+            for (int c = 0; c < RUNE_SYMCLASS_CATEGORIES; c++) {
+                printf("%s\"%s\": %d", c ? ", " : "", rune_symclass_category_name((rune_symclass_category_t)c),
+                       g_results.dangerous_api_counts[c]);
+            }
+            printf("},\n");
+            printf("        \"dangerous_calls\": [");
+            for (int i = 0; i < g_results.dangerous_call_count; i++) {
+                const dangerous_call_t* call = &g_results.dangerous_calls[i];
+                printf("%s\n          {\"api\": \"%s\", \"category\": \"%s\", \"address\": \"0x%" PRIx64 "\"",
+                       i ? "," : "", call->api, rune_symclass_category_name((rune_symclass_category_t)call->category),
+                       call->address);
+                if (call->function[0]) {
+                    printf(", \"function\": \"%s\"", call->function);
+                }
+                if (call->file[0]) {
+                    printf(", \"file\": \"%s\", \"line\": %u", call->file, call->line);
+                }
+                printf("}");
+            }
+            printf("%s],\n", g_results.dangerous_call_count ? "\n        " : "");
             if (g_results.vulnerable_function_count > 0) {
                 printf("        \"vulnerable_functions\": [");
                 for (int i = 0; i < g_results.vulnerable_function_count && i < 5; i++) {
@@ -3225,7 +4060,9 @@ void print_usage(const char* program_name) {
     printf("  --io                    Enable I/O monitoring\n");
     printf("  --security              Enable security analysis\n");
     printf("  --performance           Enable performance profiling\n");
-    printf("  --all                   Enable all analysis modules\n\n");
+    printf("  --all                   Enable all analysis modules\n");
+    printf("  --zero-copy             Forward target output with splice(), analyze it asynchronously\n");
+    printf("  --no-cache              Do not read or write the static analysis cache\n\n");
     printf("Examples:\n");
     printf("  %s /bin/ls -la                    # Analyze ls command\n", program_name);
     printf("  %s -vv /usr/bin/sort file.txt     # Deep analysis with verbose mode\n", program_name);
@@ -3324,6 +4161,10 @@ int main(int argc, char* argv[]) {
             g_config.enable_io = 1;
             g_config.enable_security = 1;
             g_config.enable_performance = 1;
+        } else if (strcmp(argv[i], "--zero-copy") == 0) {
+            g_config.zero_copy_capture = 1;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            g_config.no_cache = 1;
         } else if (argv[i][0] != '-') {
             // Found the executable
             executable_index = i;
@@ -3362,6 +4203,7 @@ int main(int argc, char* argv[]) {
     if (result != 0) {
         return 1;
     }
+    save_static_facts();
     
     // Generate report
     if (g_config.output_format == 0 || g_config.output_format == 2) {
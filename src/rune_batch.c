@@ -0,0 +1,386 @@
+/**
+ * rune_batch.c - Parallel batch analysis implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+#include "rune_batch.h"
+
+#include <pthread.h>
+#include <sched.h>
+
+// One manifest entry
+typedef struct rune_batch_job {
+    int line;                   // Manifest line number (1-based)
+    char *text;                 // Line with the newline stripped
+} rune_batch_job_t;
+
+// State shared by all workers
+typedef struct rune_batch {
+    const rune_context_t *base; // Command line configuration every job starts from
+    rune_batch_job_t *jobs;
+    size_t job_count;
+    size_t next_job;            // Claimed with an atomic increment
+
+    pthread_mutex_t lock;       // Serializes result lines and the counters below
+    unsigned long succeeded;
+    unsigned long failed;
+    unsigned long timed_out;
+    unsigned long invalid;
+} rune_batch_t;
+
+typedef struct rune_batch_worker {
+    rune_batch_t *batch;
+    rune_context_t *ctx;        // Reused for every job this worker runs
+    pthread_t thread;
+    int index;
+    int cpu;                    // CPU the worker and its targets are pinned to, -1 = unpinned
+} rune_batch_worker_t;
+
+// Write s as a JSON string literal
+static void rune_batch_json_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c == '\n') {
+            fputs("\\n", out);
+        } else if (c == '\t') {
+            fputs("\\t", out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Split a manifest line in place, shell style. Returns the argument count or -1.
+static int rune_batch_split(char *line, char **argv, int max_args) {
+    int argc = 0;
+    char *src = line, *dst = line;
+
+    for (;;) {
+        while (*src == ' ' || *src == '\t') src++;
+        if (!*src) break;
+        if (argc == max_args) return -1;
+
+        argv[argc++] = dst;
+        char quote = 0;
+        while (*src && (quote || (*src != ' ' && *src != '\t'))) {
+            if (quote && *src == quote) {
+                quote = 0;
+                src++;
+            } else if (!quote && (*src == '\'' || *src == '"')) {
+                quote = *src++;
+            } else if (*src == '\\' && quote != '\'' && src[1]) {
+                *dst++ = src[1];
+                src += 2;
+            } else {
+                *dst++ = *src++;
+            }
+        }
+        if (quote) return -1; // Unterminated quote
+        if (*src) src++;
+        *dst++ = '\0';
+    }
+    return argc;
+}
+
+// Read the manifest, keeping only lines that describe a job
+static int rune_batch_load(rune_batch_t *batch, const char *path) {
+    FILE *manifest = fopen(path, "r");
+    if (!manifest) {
+        rune_log_error("Cannot open batch manifest %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    size_t capacity = 0;
+    char *line = NULL;
+    size_t line_size = 0;
+    ssize_t length;
+    int line_number = 0;
+    int rc = 0;
+
+    while ((length = getline(&line, &line_size, manifest)) >= 0) {
+        line_number++;
+        while (length > 0 && (line[length - 1] == '\n' || line[length - 1] == '\r')) {
+            line[--length] = '\0';
+        }
+        const char *first = line + strspn(line, " \t");
+        if (*first == '\0' || *first == '#') continue;
+
+        if (batch->job_count == capacity) {
+            capacity = capacity ? capacity * 2 : 64;
+            rune_batch_job_t *grown = realloc(batch->jobs, capacity * sizeof(*grown));
+            if (!grown) {
+                rc = -1;
+                break;
+            }
+            batch->jobs = grown;
+        }
+        char *text = strdup(line);
+        if (!text) {
+            rc = -1;
+            break;
+        }
+        batch->jobs[batch->job_count].line = line_number;
+        batch->jobs[batch->job_count].text = text;
+        batch->job_count++;
+    }
+
+    if (rc != 0) {
+        rune_log_error("Out of memory reading batch manifest %s\n", path);
+    }
+    free(line);
+    fclose(manifest);
+    return rc;
+}
+
+// Emit one result line; called with the worker's context holding the job's results
+static void rune_batch_report(rune_batch_worker_t *worker, const rune_batch_job_t *job,
+                              const char *status, const char *detail) {
+    rune_batch_t *batch = worker->batch;
+    const rune_context_t *ctx = worker->ctx;
+    const rune_results_t *results = &ctx->results;
+
+    // Format outside the lock, write the finished line under it
+    char *buffer = NULL;
+    size_t size = 0;
+    FILE *out = open_memstream(&buffer, &size);
+    if (!out) return;
+
+    fprintf(out, "{\"job\": %zu, \"line\": %d, \"command\": ", (size_t)(job - batch->jobs) + 1, job->line);
+    rune_batch_json_string(out, job->text);
+    fputs(", \"target\": ", out);
+    rune_batch_json_string(out, ctx->config.target_executable);
+    fprintf(out, ", \"status\": \"%s\"", status);
+    if (detail) {
+        fputs(", \"error\": ", out);
+        rune_batch_json_string(out, detail);
+    }
+    fprintf(out, ", \"exit_code\": %d, \"timed_out\": %s, \"execution_time\": %.6f",
+            results->exit_code, results->timed_out ? "true" : "false", results->execution_time);
+    fprintf(out, ", \"user_time\": %.6f, \"system_time\": %.6f, \"peak_memory_kb\": %ld",
+            results->user_time, results->system_time, results->peak_memory_kb);
+    fprintf(out, ", \"stdout_bytes\": %zu, \"stderr_bytes\": %zu",
+            results->stdout_bytes, results->stderr_bytes);
+    fprintf(out, ", \"verbose_messages\": %d, \"error_messages\": %d, \"warning_messages\": %d",
+            results->verbose_messages, results->error_messages, results->warning_messages);
+    fprintf(out, ", \"tree_processes\": %d, \"tree_cpu_seconds\": %.6f, \"tree_peak_rss_kb\": %ld",
+            results->tree_processes, results->tree_cpu_seconds, results->tree_peak_rss_kb);
+    if (results->perf_enabled) {
+        fprintf(out, ", \"task_clock_ns\": %lld, \"instructions\": %lld, \"cycles\": %lld, \"ipc\": %.3f",
+                results->perf_task_clock_ns, results->perf_instructions, results->perf_cycles,
+                results->perf_ipc);
+        fprintf(out, ", \"cache_miss_rate\": %.4f, \"branch_miss_rate\": %.4f",
+                results->perf_cache_miss_rate, results->perf_branch_miss_rate);
+    }
+    fprintf(out, ", \"worker\": %d, \"cpu\": %d}\n", worker->index, worker->cpu);
+    fclose(out);
+
+    pthread_mutex_lock(&batch->lock);
+    fwrite(buffer, 1, size, stdout);
+    fflush(stdout);
+    if (strcmp(status, "ok") == 0) batch->succeeded++;
+    else if (strcmp(status, "timeout") == 0) batch->timed_out++;
+    else if (strcmp(status, "invalid") == 0) batch->invalid++;
+    else batch->failed++;
+    pthread_mutex_unlock(&batch->lock);
+
+    free(buffer);
+}
+
+// Run one manifest entry in the worker's (already bound) context
+static void rune_batch_run_job(rune_batch_worker_t *worker, const rune_batch_job_t *job) {
+    rune_context_t *ctx = worker->ctx;
+
+    // Start over from the command line configuration: no config, results,
+    // checkpoints or triggers survive from the previous job
+    ctx->config = worker->batch->base->config;
+    ctx->config.batch_manifest[0] = '\0';
+    ctx->config.target_executable[0] = '\0';
+    ctx->config.target_args = NULL;
+    ctx->config.target_argc = 0;
+    // Export files are per run: a manifest line names its own or gets none,
+    // rather than every job rewriting the command line's file at once
+    ctx->config.timeline_path[0] = '\0';
+    ctx->config.flamegraph_path[0] = '\0';
+    ctx->config.trace_path[0] = '\0';
+    ctx->config.discard_target_output = 1; // stdout carries the result lines
+    ctx->config.batch_worker = 1;
+    rune_context_reset_results(ctx);
+    rune_trigger_cleanup(ctx);
+    rune_checkpoint_init(ctx);
+
+    // argv storage must outlive the run: target_args points into it
+    char *words = strdup(job->text);
+    char *argv[RUNE_BATCH_MAX_ARGS + 1];
+    if (!words) {
+        rune_batch_report(worker, job, "error", "out of memory");
+        return;
+    }
+    argv[0] = "rune_analyze";
+    int argc = rune_batch_split(words, &argv[1], RUNE_BATCH_MAX_ARGS - 1);
+    if (argc <= 0) {
+        rune_batch_report(worker, job, "invalid", "unterminated quote or too many arguments");
+        free(words);
+        return;
+    }
+    argc++;
+    argv[argc] = NULL;
+
+    int parsed = rune_config_parse_args(ctx, argc, argv);
+    if (parsed == RUNE_CONFIG_HELP || parsed == RUNE_CONFIG_VERSION) {
+        rune_batch_report(worker, job, "invalid", parsed == RUNE_CONFIG_HELP ? "--help is not a job" : "--version is not a job");
+    } else if (parsed != 0) {
+        rune_batch_report(worker, job, "invalid", "bad options");
+    } else if (ctx->config.batch_manifest[0]) {
+        rune_batch_report(worker, job, "invalid", "--batch cannot be nested");
+    } else if (ctx->config.target_executable[0] == '\0') {
+        rune_batch_report(worker, job, "invalid", "no target");
+    } else if (!ctx->config.enable_monitoring && !ctx->config.dry_run_mode &&
+               rune_validate_executable(ctx->config.target_executable) != 0) {
+        rune_batch_report(worker, job, "invalid", "target is not an executable file");
+    } else if (rune_execute_target(ctx) < 0) {
+        rune_batch_report(worker, job, "error", "could not start target");
+    } else if (ctx->results.timed_out) {
+        rune_batch_report(worker, job, "timeout", NULL);
+    } else {
+        rune_batch_report(worker, job, ctx->results.exit_code == 0 ? "ok" : "failed", NULL);
+    }
+    free(words);
+}
+
+static void *rune_batch_worker_main(void *arg) {
+    rune_batch_worker_t *worker = arg;
+    rune_batch_t *batch = worker->batch;
+
+    // Targets inherit the affinity, so each job stays on its worker's CPU
+    if (worker->cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(worker->cpu, &set);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+            rune_log_debug("Batch worker %d: could not pin to CPU %d\n", worker->index, worker->cpu);
+            worker->cpu = -1;
+        }
+    }
+
+    rune_context_bind(worker->ctx);
+    for (;;) {
+        size_t next = __atomic_fetch_add(&batch->next_job, 1, __ATOMIC_RELAXED);
+        if (next >= batch->job_count) break;
+        rune_batch_run_job(worker, &batch->jobs[next]);
+    }
+    rune_context_bind(NULL);
+    return NULL;
+}
+
+// 📦 Run the whole manifest through a bounded worker pool
+int rune_batch_run(rune_context_t* ctx) {
+    RUNE_LOG_FUNC_START("batch_run");
+
+    rune_batch_t batch;
+    memset(&batch, 0, sizeof(batch));
+    batch.base = ctx;
+    if (rune_batch_load(&batch, ctx->config.batch_manifest) != 0) {
+        for (size_t i = 0; i < batch.job_count; i++) free(batch.jobs[i].text);
+        free(batch.jobs);
+        return -1;
+    }
+
+    // CPUs we may run on; workers are pinned round-robin across them
+    int cpus[CPU_SETSIZE];
+    int cpu_count = 0;
+    cpu_set_t allowed;
+    if (sched_getaffinity(0, sizeof(allowed), &allowed) == 0) {
+        for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+            if (CPU_ISSET(cpu, &allowed)) cpus[cpu_count++] = cpu;
+        }
+    }
+
+    long worker_count = ctx->config.batch_jobs;
+    if (worker_count <= 0) worker_count = cpu_count > 0 ? cpu_count : sysconf(_SC_NPROCESSORS_ONLN);
+    if (worker_count <= 0) worker_count = 1;
+    if ((size_t)worker_count > batch.job_count) worker_count = (long)batch.job_count;
+
+    rune_log_info("📦 Batch: %zu jobs from %s on %ld workers\n",
+                  batch.job_count, ctx->config.batch_manifest, worker_count);
+    if (ctx->config.timeline_path[0]) {
+        rune_log_warning("Batch: --timeline %s is ignored, give --timeline on the manifest lines instead\n",
+                         ctx->config.timeline_path);
+    }
+
+    rune_batch_worker_t *workers = calloc(worker_count > 0 ? (size_t)worker_count : 1, sizeof(*workers));
+    if (!workers) {
+        rune_log_error("Out of memory starting batch workers\n");
+        for (size_t i = 0; i < batch.job_count; i++) free(batch.jobs[i].text);
+        free(batch.jobs);
+        return -1;
+    }
+    pthread_mutex_init(&batch.lock, NULL);
+
+    fflush(stdout);
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+
+    long started = 0;
+    for (long i = 0; i < worker_count; i++) {
+        rune_batch_worker_t *worker = &workers[started];
+        worker->batch = &batch;
+        worker->index = (int)started;
+        worker->cpu = cpu_count > 0 ? cpus[started % cpu_count] : -1;
+        worker->ctx = rune_context_create();
+        if (!worker->ctx) break;
+        if (pthread_create(&worker->thread, NULL, rune_batch_worker_main, worker) != 0) {
+            rune_context_destroy(worker->ctx);
+            break;
+        }
+        started++;
+    }
+    if (started < worker_count) {
+        rune_log_warning("Batch: only %ld of %ld workers could be started\n", started, worker_count);
+    }
+    if (started == 0 && batch.job_count > 0) {
+        // No pool at all: run everything on this thread
+        workers[0].batch = &batch;
+        workers[0].cpu = -1;
+        workers[0].ctx = rune_context_create();
+        if (workers[0].ctx) {
+            rune_batch_worker_main(&workers[0]);
+            rune_context_destroy(workers[0].ctx);
+            rune_context_bind(ctx);
+        }
+    }
+    for (long i = 0; i < started; i++) {
+        pthread_join(workers[i].thread, NULL);
+        rune_context_destroy(workers[i].ctx);
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+    unsigned long finished = batch.succeeded + batch.failed + batch.timed_out + batch.invalid;
+
+    // Summary goes to stderr so stdout stays pure JSON lines
+    fprintf(stderr, "📦 Batch complete: %lu/%zu jobs in %.3fs on %ld workers (%.1f jobs/sec)\n",
+            finished, batch.job_count, elapsed, started ? started : 1,
+            elapsed > 0 ? finished / elapsed : 0.0);
+    fprintf(stderr, "   ✅ %lu ok  ❌ %lu failed  ⏱️  %lu timed out  ⚠️  %lu invalid\n",
+            batch.succeeded, batch.failed, batch.timed_out, batch.invalid);
+
+    int result = (finished == batch.job_count && finished == batch.succeeded) ? 0 : 1;
+
+    pthread_mutex_destroy(&batch.lock);
+    free(workers);
+    for (size_t i = 0; i < batch.job_count; i++) free(batch.jobs[i].text);
+    free(batch.jobs);
+
+    RUNE_LOG_FUNC_END("batch_run");
+    return result;
+}
@@ -0,0 +1,36 @@
+/**
+ * rune_batch.h - Parallel batch analysis for rune_analyze
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * --batch <manifest> runs one analysis per manifest line through a
+ * bounded pool of worker threads. Every worker owns a rune_context_t
+ * that is rebuilt from the command line's configuration before each
+ * job, so nothing leaks from one target into the next. Results are
+ * written to stdout as one JSON object per line, in completion order.
+ */
+
+#ifndef RUNE_BATCH_H
+#define RUNE_BATCH_H
+
+#include "rune_context.h"
+
+// Arguments per manifest line (including the implicit program name)
+#define RUNE_BATCH_MAX_ARGS 256
+
+/**
+ * @brief Run every entry of ctx->config.batch_manifest
+ *
+ * Manifest lines are split like a shell would (whitespace, '...', "..."
+ * and backslash escapes) and parsed with rune_config_parse_args(), so a
+ * line is either "target arg..." or per-job options such as
+ * --monitor "cmd" or --timeout 5. Blank lines and # comments are skipped.
+ * Options given on the command line apply to every job.
+ *
+ * @param ctx Context holding the batch configuration
+ * @return 0 when every job exited 0, 1 when some did not, -1 on error
+ */
+int rune_batch_run(rune_context_t* ctx);
+
+#endif /* RUNE_BATCH_H */
@@ -0,0 +1,75 @@
+/**
+ * rune_cache.h - Content-addressed on-disk cache of per-binary results
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * A result is stored under the SHA-256 of the binary it describes, in
+ * $XDG_CACHE_HOME/rune_analyze/<name>/ (~/.cache when unset). A small
+ * stat record maps (device, inode, size, mtime) to that digest, so an
+ * unchanged binary is found without reading it; a copied or touched
+ * one costs one hash of its contents and is still a hit. Files modified
+ * in the last two seconds get no stat record, since a second write
+ * within the same timestamp would go unnoticed.
+ *
+ * Every file is written under a temporary name and renamed into place,
+ * so concurrent analyzers never see a partial entry, and carries a
+ * checksum that rejects a damaged one. Entries are spread over 256
+ * shard directories; a write evicts the least recently used entries of
+ * its shard once the shard holds more than its share of the size cap.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_CACHE_H
+#define RUNE_CACHE_H
+
+#include <limits.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define RUNE_CACHE_DIGEST_SIZE 32      // SHA-256
+
+typedef struct rune_cache {
+    char dir[PATH_MAX - 128];   // Leaves room for the entry names below it
+    uint64_t max_bytes;
+} rune_cache_t;
+
+// Identity of one binary: its stat tuple, and its digest once computed
+typedef struct rune_cache_key {
+    const char *path;           // Must outlive the key
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_ns;
+    uint8_t digest[RUNE_CACHE_DIGEST_SIZE];
+    int has_digest;
+} rune_cache_key_t;
+
+/**
+ * @brief Create (if needed) the cache directory for results called name
+ * @return 0 on success, -1 on error (errno is set; ENOENT if neither
+ *         XDG_CACHE_HOME nor HOME is set)
+ */
+int rune_cache_open(rune_cache_t *cache, const char *name, uint64_t max_bytes);
+
+/**
+ * @brief Identify the file at path (following symlinks) without reading it
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_cache_key(rune_cache_key_t *key, const char *path);
+
+/**
+ * @brief Cached value for key, in a malloc()ed buffer the caller frees
+ * @return The value, or NULL (errno ENOENT on a miss)
+ */
+void *rune_cache_get(rune_cache_t *cache, rune_cache_key_t *key, size_t *size);
+
+/**
+ * @brief Store value for key, replacing any previous one
+ * @return 0 on success, -1 on error (errno is set; ESTALE if the file
+ *         no longer matches the key)
+ */
+int rune_cache_put(rune_cache_t *cache, rune_cache_key_t *key, const void *value, size_t size);
+
+#endif /* RUNE_CACHE_H */
@@ -0,0 +1,639 @@
+/**
+ * rune_callsite.c - Import call-site scanner implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Three sorted tables drive the scan: GOT slots (from relocations),
+ * PLT stubs (decoded from the .plt* sections, each jumping through one
+ * slot) and function symbols (for attribution and resynchronization).
+ * A decoded branch is only looked up when its target falls inside the
+ * stub or slot range, so the sweep costs little more than decoding.
+ */
+
+#include "rune_callsite.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+// --- x86-64 length decoder ---
+
+#define RUNE_X86_MAX_LENGTH 15
+
+#define RUNE_X86_MODRM   0x001
+#define RUNE_X86_I8      0x002
+#define RUNE_X86_I16     0x004
+#define RUNE_X86_I32     0x008
+#define RUNE_X86_IZ      0x010      // 16 or 32 bits by operand size
+#define RUNE_X86_IV      0x020      // 16, 32 or 64 bits (mov r, imm)
+#define RUNE_X86_MOFFS   0x040      // Address-sized offset (mov al, moffs)
+#define RUNE_X86_GROUP3  0x080      // Immediate only with /0 and /1 (test)
+#define RUNE_X86_PREFIX  0x100
+#define RUNE_X86_REX     0x200
+#define RUNE_X86_INVALID 0x400      // Undefined, or not valid in 64-bit mode
+
+#define NO 0
+#define MR RUNE_X86_MODRM
+#define MB (RUNE_X86_MODRM | RUNE_X86_I8)
+#define MZ (RUNE_X86_MODRM | RUNE_X86_IZ)
+#define G8 (RUNE_X86_MODRM | RUNE_X86_I8 | RUNE_X86_GROUP3)
+#define GZ (RUNE_X86_MODRM | RUNE_X86_IZ | RUNE_X86_GROUP3)
+#define IB RUNE_X86_I8
+#define IW RUNE_X86_I16
+#define ID RUNE_X86_I32
+#define IZ RUNE_X86_IZ
+#define IV RUNE_X86_IV
+#define EN (RUNE_X86_I16 | RUNE_X86_I8)
+#define MO RUNE_X86_MOFFS
+#define PF RUNE_X86_PREFIX
+#define RX RUNE_X86_REX
+#define XX RUNE_X86_INVALID
+
+// One-byte opcodes; 0F, C4, C5, 62 and XOP 8F are escapes handled before the lookup
+static const uint16_t g_x86_one_byte[256] = {
+    /*      0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F */
+    /* 0 */ MR, MR, MR, MR, IB, IZ, XX, XX, MR, MR, MR, MR, IB, IZ, XX, XX,
+    /* 1 */ MR, MR, MR, MR, IB, IZ, XX, XX, MR, MR, MR, MR, IB, IZ, XX, XX,
+    /* 2 */ MR, MR, MR, MR, IB, IZ, PF, XX, MR, MR, MR, MR, IB, IZ, PF, XX,
+    /* 3 */ MR, MR, MR, MR, IB, IZ, PF, XX, MR, MR, MR, MR, IB, IZ, PF, XX,
+    /* 4 */ RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX, RX,
+    /* 5 */ NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, NO,
+    /* 6 */ XX, XX, XX, MR, PF, PF, PF, PF, IZ, MZ, IB, MB, NO, NO, NO, NO,
+    /* 7 */ IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB, IB,
+    /* 8 */ MB, MZ, XX, MB, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 9 */ NO, NO, NO, NO, NO, NO, NO, NO, NO, NO, XX, NO, NO, NO, NO, NO,
+    /* A */ MO, MO, MO, MO, NO, NO, NO, NO, IB, IZ, NO, NO, NO, NO, NO, NO,
+    /* B */ IB, IB, IB, IB, IB, IB, IB, IB, IV, IV, IV, IV, IV, IV, IV, IV,
+    /* C */ MB, MB, IW, NO, XX, XX, MB, MZ, EN, NO, IW, NO, NO, IB, XX, NO,
+    /* D */ MR, MR, MR, MR, XX, XX, XX, NO, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* E */ IB, IB, IB, IB, IB, IB, IB, IB, ID, ID, XX, IB, NO, NO, NO, NO,
+    /* F */ PF, NO, PF, PF, NO, NO, G8, GZ, NO, NO, NO, NO, NO, NO, MR, MR,
+};
+
+// 0F xx; 0F 38 and 0F 3A are escapes to all-ModRM maps (the latter with an imm8)
+static const uint16_t g_x86_two_byte[256] = {
+    /*      0   1   2   3   4   5   6   7   8   9   A   B   C   D   E   F */
+    /* 0 */ MR, MR, MR, MR, XX, NO, NO, NO, NO, NO, XX, NO, XX, MR, NO, MB,
+    /* 1 */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 2 */ MR, MR, MR, MR, XX, XX, XX, XX, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 3 */ NO, NO, NO, NO, NO, NO, XX, NO, XX, XX, XX, XX, XX, XX, XX, XX,
+    /* 4 */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 5 */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 6 */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* 7 */ MB, MB, MB, MB, MR, MR, MR, NO, MR, MR, XX, XX, MR, MR, MR, MR,
+    /* 8 */ ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID, ID,
+    /* 9 */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* A */ NO, NO, NO, MR, MB, MR, XX, XX, NO, NO, NO, MR, MB, MR, MR, MR,
+    /* B */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MB, MR, MR, MR, MR, MR,
+    /* C */ MR, MR, MB, MR, MB, MB, MB, MR, NO, NO, NO, NO, NO, NO, NO, NO,
+    /* D */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* E */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+    /* F */ MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR, MR,
+};
+
+#undef NO
+#undef MR
+#undef MB
+#undef MZ
+#undef G8
+#undef GZ
+#undef IB
+#undef IW
+#undef ID
+#undef IZ
+#undef IV
+#undef EN
+#undef MO
+#undef PF
+#undef RX
+#undef XX
+
+// Opcode maps past the two tables: VEX/EVEX mmmmm values, XOP 8..10
+enum {
+    RUNE_X86_MAP_ONE_BYTE,
+    RUNE_X86_MAP_0F,
+    RUNE_X86_MAP_0F38,
+    RUNE_X86_MAP_0F3A,
+    RUNE_X86_MAP_XOP8 = 8,
+    RUNE_X86_MAP_XOPA = 10,
+};
+
+typedef enum {
+    RUNE_BRANCH_NONE,
+    RUNE_BRANCH_CALL,           // target: the callee
+    RUNE_BRANCH_JUMP,
+    RUNE_BRANCH_CALL_SLOT,      // target: the memory slot holding the callee
+    RUNE_BRANCH_JUMP_SLOT,
+} rune_branch_t;
+
+static int32_t rune_x86_rel32(const uint8_t *p) {
+    return (int32_t)((uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+}
+
+/*
+ * Length of the instruction at p (0 if invalid or cut off by avail), and
+ * whether it is a direct call/jmp rel32 or an indirect one through a
+ * RIP-relative slot (ff /2, ff /4).
+ */
+static size_t rune_x86_decode(const uint8_t *p, size_t avail, uint64_t ip, rune_branch_t *branch, uint64_t *target) {
+    if (avail > RUNE_X86_MAX_LENGTH) {
+        avail = RUNE_X86_MAX_LENGTH;
+    }
+    *branch = RUNE_BRANCH_NONE;
+    int operand16 = 0, address32 = 0, rex_w = 0;
+    size_t i = 0;
+
+    // Legacy prefixes; a REX only counts directly before the opcode
+    for (;; i++) {
+        if (i >= avail) {
+            return 0;
+        }
+        uint16_t flags = g_x86_one_byte[p[i]];
+        if (flags & RUNE_X86_REX) {
+            rex_w = p[i] & 0x08;
+        } else if (flags & RUNE_X86_PREFIX) {
+            operand16 |= p[i] == 0x66;
+            address32 |= p[i] == 0x67;
+            rex_w = 0;
+        } else {
+            break;
+        }
+    }
+
+    uint8_t opcode = p[i++];
+    unsigned map = RUNE_X86_MAP_ONE_BYTE;
+    if (opcode == 0x0f) {
+        if (i >= avail) {
+            return 0;
+        }
+        opcode = p[i++];
+        map = RUNE_X86_MAP_0F;
+        if (opcode == 0x38 || opcode == 0x3a) {
+            map = opcode == 0x38 ? RUNE_X86_MAP_0F38 : RUNE_X86_MAP_0F3A;
+            if (i >= avail) {
+                return 0;
+            }
+            opcode = p[i++];
+        }
+    } else if (opcode == 0xc4 || opcode == 0xc5 || opcode == 0x62 || (opcode == 0x8f && i < avail && (p[i] & 0x1f) >= 8)) {
+        // VEX3/XOP carry the map in mmmmm, EVEX in mmm; VEX2 implies 0F
+        size_t payload = opcode == 0xc5 ? 1 : opcode == 0x62 ? 3 : 2;
+        if (i + payload >= avail) {
+            return 0;
+        }
+        map = opcode == 0xc5 ? RUNE_X86_MAP_0F : opcode == 0x62 ? (p[i] & 0x07u) : (p[i] & 0x1fu);
+        if (map == RUNE_X86_MAP_ONE_BYTE) {
+            return 0;
+        }
+        i += payload;
+        opcode = p[i++];
+    }
+
+    uint16_t flags;
+    switch (map) {
+    case RUNE_X86_MAP_ONE_BYTE: flags = g_x86_one_byte[opcode]; break;
+    case RUNE_X86_MAP_0F: flags = g_x86_two_byte[opcode]; break;
+    case RUNE_X86_MAP_0F3A: case RUNE_X86_MAP_XOP8: flags = RUNE_X86_MODRM | RUNE_X86_I8; break;
+    case RUNE_X86_MAP_XOPA: flags = RUNE_X86_MODRM | RUNE_X86_I32; break;
+    default: flags = RUNE_X86_MODRM; break;         // 0F38, EVEX 4..7, XOP 9
+    }
+    if (flags & (RUNE_X86_INVALID | RUNE_X86_PREFIX | RUNE_X86_REX)) {
+        return 0;
+    }
+
+    uint8_t modrm = 0;
+    int64_t disp = 0;
+    if (flags & RUNE_X86_MODRM) {
+        if (i >= avail) {
+            return 0;
+        }
+        modrm = p[i++];
+        unsigned mod = modrm >> 6, rm = modrm & 7;
+        size_t disp_size = mod == 1 ? 1 : mod == 2 ? 4 : 0;
+        if (mod != 3 && rm == 4) {
+            if (i >= avail) {
+                return 0;
+            }
+            if (mod == 0 && (p[i] & 7) == 5) {
+                disp_size = 4;      // SIB with no base
+            }
+            i++;
+        } else if (mod == 0 && rm == 5) {
+            disp_size = 4;          // RIP-relative
+        }
+        if (disp_size > avail - i) {
+            return 0;
+        }
+        disp = disp_size == 1 ? (int8_t)p[i] : disp_size == 4 ? rune_x86_rel32(p + i) : 0;
+        i += disp_size;
+    }
+
+    size_t imm = 0;
+    if (!(flags & RUNE_X86_GROUP3) || ((modrm >> 3) & 7) < 2) {
+        imm += (flags & RUNE_X86_I8) ? 1 : 0;
+        imm += (flags & RUNE_X86_I16) ? 2 : 0;
+        imm += (flags & RUNE_X86_I32) ? 4 : 0;
+        imm += (flags & RUNE_X86_IZ) ? (operand16 ? 2 : 4) : 0;
+        imm += (flags & RUNE_X86_IV) ? (rex_w ? 8 : operand16 ? 2 : 4) : 0;
+        imm += (flags & RUNE_X86_MOFFS) ? (address32 ? 4 : 8) : 0;
+    }
+    if (imm > avail - i) {
+        return 0;
+    }
+    size_t length = i + imm;
+
+    if (map == RUNE_X86_MAP_ONE_BYTE && (opcode == 0xe8 || opcode == 0xe9)) {
+        *branch = opcode == 0xe8 ? RUNE_BRANCH_CALL : RUNE_BRANCH_JUMP;
+        *target = ip + length + (uint64_t)(int64_t)rune_x86_rel32(p + i);
+    } else if (map == RUNE_X86_MAP_ONE_BYTE && opcode == 0xff && (modrm & 0xc7) == 0x05) {
+        unsigned reg = (modrm >> 3) & 7;
+        if (reg == 2 || reg == 4) {
+            *branch = reg == 2 ? RUNE_BRANCH_CALL_SLOT : RUNE_BRANCH_JUMP_SLOT;
+            *target = ip + length + (uint64_t)disp;
+        }
+    }
+    return length;
+}
+
+// --- AArch64 patterns ---
+
+typedef enum {
+    RUNE_A64_OTHER,
+    RUNE_A64_BL,
+    RUNE_A64_B,
+    RUNE_A64_BLR,
+    RUNE_A64_BR,
+    RUNE_A64_ADRP,
+    RUNE_A64_LDR,               // ldr xt, [xn, #imm12 * 8]
+    RUNE_A64_BTI,
+} rune_a64_kind_t;
+
+typedef struct rune_a64_pattern {
+    uint32_t mask;
+    uint32_t value;
+    rune_a64_kind_t kind;
+} rune_a64_pattern_t;
+
+static const rune_a64_pattern_t g_a64_patterns[] = {
+    { 0xfc000000, 0x94000000, RUNE_A64_BL },
+    { 0xfc000000, 0x14000000, RUNE_A64_B },
+    { 0xfffffc1f, 0xd63f0000, RUNE_A64_BLR },
+    { 0xfffffc1f, 0xd61f0000, RUNE_A64_BR },
+    { 0x9f000000, 0x90000000, RUNE_A64_ADRP },
+    { 0xffc00000, 0xf9400000, RUNE_A64_LDR },
+    { 0xffffff3f, 0xd503241f, RUNE_A64_BTI },
+};
+
+static rune_a64_kind_t rune_a64_kind(uint32_t insn) {
+    for (size_t i = 0; i < sizeof(g_a64_patterns) / sizeof(g_a64_patterns[0]); i++) {
+        if ((insn & g_a64_patterns[i].mask) == g_a64_patterns[i].value) {
+            return g_a64_patterns[i].kind;
+        }
+    }
+    return RUNE_A64_OTHER;
+}
+
+static uint64_t rune_a64_adrp(uint32_t insn, uint64_t pc) {
+    int64_t imm = (int64_t)((insn >> 5 & 0x7ffff) << 2 | (insn >> 29 & 3));
+    imm = (imm ^ 0x100000) - 0x100000;      // Sign-extend 21 bits
+    return (pc & ~(uint64_t)0xfff) + (uint64_t)(imm * 4096);
+}
+
+// Slot loaded by adrp xm, page; ldr xt, [xm, #off] at words[0..1], or 0
+static uint64_t rune_a64_slot(const rune_elf_t *elf, const uint8_t *words, uint64_t pc, unsigned *reg) {
+    uint32_t adrp = rune_elf_u32(elf, words), ldr = rune_elf_u32(elf, words + 4);
+    if (rune_a64_kind(adrp) != RUNE_A64_ADRP || rune_a64_kind(ldr) != RUNE_A64_LDR || (adrp & 0x1f) != (ldr >> 5 & 0x1f)) {
+        return 0;
+    }
+    *reg = ldr & 0x1f;
+    return rune_a64_adrp(adrp, pc) + (uint64_t)(ldr >> 10 & 0xfff) * 8;
+}
+
+// --- Tables ---
+
+typedef struct rune_callsite_target {
+    uint64_t address;
+    uint64_t size;              // Functions only
+    const char *name;
+} rune_callsite_target_t;
+
+typedef struct rune_callsite_table {
+    rune_callsite_target_t *entries;
+    size_t count;
+    size_t capacity;
+} rune_callsite_table_t;
+
+static int rune_callsite_add(rune_callsite_table_t *table, uint64_t address, uint64_t size, const char *name) {
+    if (table->count == table->capacity) {
+        size_t capacity = table->capacity ? table->capacity * 2 : 64;
+        rune_callsite_target_t *entries = realloc(table->entries, capacity * sizeof(*entries));
+        if (!entries) {
+            return -1;
+        }
+        table->entries = entries;
+        table->capacity = capacity;
+    }
+    table->entries[table->count++] = (rune_callsite_target_t){ address, size, name };
+    return 0;
+}
+
+static int rune_callsite_order(const void *a, const void *b) {
+    const rune_callsite_target_t *x = a, *y = b;
+    return x->address < y->address ? -1 : x->address > y->address;
+}
+
+static void rune_callsite_sort(rune_callsite_table_t *table) {
+    if (table->count > 1) {
+        qsort(table->entries, table->count, sizeof(*table->entries), rune_callsite_order);
+    }
+}
+
+// Last entry at or below address, or NULL
+static const rune_callsite_target_t *rune_callsite_floor(const rune_callsite_table_t *table, uint64_t address) {
+    size_t lo = 0, hi = table->count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table->entries[mid].address <= address) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo ? &table->entries[lo - 1] : NULL;
+}
+
+static const char *rune_callsite_find(const rune_callsite_table_t *table, uint64_t address) {
+    if (table->count == 0 || address < table->entries[0].address ||
+        address > table->entries[table->count - 1].address) {
+        return NULL;
+    }
+    const rune_callsite_target_t *entry = rune_callsite_floor(table, address);
+    return entry && entry->address == address ? entry->name : NULL;
+}
+
+typedef struct rune_callsite_scan {
+    const rune_elf_t *elf;
+    rune_callsite_filter_t filter;
+    void *arg;
+    rune_callsite_table_t slots;        // GOT slot -> import
+    rune_callsite_table_t stubs;        // PLT stub (or local definition) -> import
+    rune_callsite_table_t functions;    // For attribution and resynchronization
+    rune_callsite_report_t *report;
+} rune_callsite_scan_t;
+
+static int rune_callsite_wanted(const rune_callsite_scan_t *scan, const char *name) {
+    return name[0] && (!scan->filter || scan->filter(name, scan->arg));
+}
+
+static int rune_callsite_is_plt(const rune_elf_section_t *section) {
+    return strncmp(section->name, ".plt", 4) == 0 || strcmp(section->name, ".iplt") == 0;
+}
+
+// GOT slots from JUMP_SLOT/GLOB_DAT against .dynsym, and IRELATIVE (named by their resolver)
+static int rune_callsite_read_relocations(rune_callsite_scan_t *scan) {
+    const rune_elf_t *elf = scan->elf;
+    int x86 = elf->machine == EM_X86_64;
+    uint32_t jump_slot = x86 ? R_X86_64_JUMP_SLOT : R_AARCH64_JUMP_SLOT;
+    uint32_t glob_dat = x86 ? R_X86_64_GLOB_DAT : R_AARCH64_GLOB_DAT;
+    uint32_t irelative = x86 ? R_X86_64_IRELATIVE : R_AARCH64_IRELATIVE;
+    size_t dynsym_base = elf->symbol_count - elf->dynamic_symbol_count;
+
+    for (size_t s = 0; s < elf->section_count; s++) {
+        const rune_elf_section_t *section = &elf->sections[s];
+        if (section->type != SHT_RELA && section->type != SHT_REL) {
+            continue;
+        }
+        const uint8_t *data = rune_elf_section_data(elf, section);
+        size_t entsize = section->type == SHT_RELA ? sizeof(Elf64_Rela) : sizeof(Elf64_Rel);
+        int against_dynsym = section->link < elf->section_count && elf->sections[section->link].type == SHT_DYNSYM;
+        for (size_t n = 0; data && n < section->size / entsize; n++) {
+            const uint8_t *p = data + n * entsize;
+            uint64_t offset = rune_elf_u64(elf, p);
+            uint64_t info = rune_elf_u64(elf, p + 8);
+            uint32_t type = (uint32_t)ELF64_R_TYPE(info);
+            uint64_t symbol = ELF64_R_SYM(info);
+            const char *name = NULL;
+            if ((type == jump_slot || type == glob_dat) && against_dynsym && symbol >= 1 &&
+                symbol <= elf->dynamic_symbol_count) {
+                name = elf->symbols[dynsym_base + symbol - 1].name;
+            } else if (type == irelative && section->type == SHT_RELA) {
+                uint64_t resolver = rune_elf_u64(elf, p + 16);
+                for (size_t i = 0; i < elf->symbol_count && !name; i++) {
+                    const rune_elf_symbol_t *sym = &elf->symbols[i];
+                    if (sym->type == STT_GNU_IFUNC && sym->value == resolver && sym->shndx != SHN_UNDEF) {
+                        name = sym->name;
+                    }
+                }
+            }
+            if (name && rune_callsite_wanted(scan, name) && rune_callsite_add(&scan->slots, offset, 0, name) != 0) {
+                return -1;
+            }
+        }
+    }
+    rune_callsite_sort(&scan->slots);
+    return 0;
+}
+
+// Each PLT entry jumps through one slot; the entry's address is what code calls
+static int rune_callsite_read_plt(rune_callsite_scan_t *scan, const rune_elf_section_t *section) {
+    const rune_elf_t *elf = scan->elf;
+    const uint8_t *data = rune_elf_section_data(elf, section);
+    if (!data) {
+        return 0;
+    }
+    if (elf->machine == EM_X86_64) {
+        size_t entsize = section->entsize == 8 || section->entsize == 16 ? section->entsize : 16;
+        for (size_t entry = 0; entry + entsize <= section->size; entry += entsize) {
+            for (size_t at = entry; at < entry + entsize;) {
+                rune_branch_t branch;
+                uint64_t slot;
+                size_t length = rune_x86_decode(data + at, entry + entsize - at, section->addr + at, &branch, &slot);
+                if (length == 0) {
+                    break;
+                }
+                if (branch == RUNE_BRANCH_JUMP_SLOT) {
+                    const char *name = rune_callsite_find(&scan->slots, slot);
+                    if (name && rune_callsite_add(&scan->stubs, section->addr + entry, 0, name) != 0) {
+                        return -1;
+                    }
+                    break;
+                }
+                at += length;
+            }
+        }
+        return 0;
+    }
+    for (size_t at = 0; at + 8 <= section->size; at += 4) {
+        unsigned reg;
+        uint64_t slot = rune_a64_slot(elf, data + at, section->addr + at, &reg);
+        const char *name = slot ? rune_callsite_find(&scan->slots, slot) : NULL;
+        if (!name) {
+            continue;
+        }
+        size_t entry = at >= 4 && rune_a64_kind(rune_elf_u32(elf, data + at - 4)) == RUNE_A64_BTI ? at - 4 : at;
+        if (rune_callsite_add(&scan->stubs, section->addr + entry, 0, name) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int rune_callsite_read_symbols(rune_callsite_scan_t *scan) {
+    const rune_elf_t *elf = scan->elf;
+    // A static binary calls its own copy of each function directly
+    int dynamic = elf->interp || elf->dynamic_count > 0;
+    for (size_t i = 0; i < elf->symbol_count; i++) {
+        const rune_elf_symbol_t *sym = &elf->symbols[i];
+        // .symtab lists everything .dynsym does; stripped binaries only have .dynsym
+        if (sym->dynamic == elf->has_symtab || sym->shndx == SHN_UNDEF || sym->value == 0 ||
+            (sym->type != STT_FUNC && sym->type != STT_GNU_IFUNC)) {
+            continue;
+        }
+        if (rune_callsite_add(&scan->functions, sym->value, sym->size, sym->name) != 0) {
+            return -1;
+        }
+        if (!dynamic && sym->type == STT_FUNC && rune_callsite_wanted(scan, sym->name) &&
+            rune_callsite_add(&scan->stubs, sym->value, 0, sym->name) != 0) {
+            return -1;
+        }
+    }
+    rune_callsite_sort(&scan->functions);
+    rune_callsite_sort(&scan->stubs);
+    return 0;
+}
+
+static int rune_callsite_record(rune_callsite_scan_t *scan, uint64_t address, const char *import, int tail,
+                                int through_got) {
+    rune_callsite_report_t *report = scan->report;
+    if (report->count == report->capacity) {
+        size_t capacity = report->capacity ? report->capacity * 2 : 16;
+        rune_callsite_t *sites = realloc(report->sites, capacity * sizeof(*sites));
+        if (!sites) {
+            return -1;
+        }
+        report->sites = sites;
+        report->capacity = capacity;
+    }
+    const rune_callsite_target_t *fn = rune_callsite_floor(&scan->functions, address);
+    if (fn && fn->size && address - fn->address >= fn->size) {
+        fn = NULL;
+    }
+    report->sites[report->count++] = (rune_callsite_t){
+        .address = address, .import = import, .function = fn ? fn->name : NULL,
+        .tail = (uint8_t)tail, .through_got = (uint8_t)through_got,
+    };
+    return 0;
+}
+
+// Linear sweep of one executable section, restarting at each function symbol
+static int rune_callsite_sweep(rune_callsite_scan_t *scan, const rune_elf_section_t *section) {
+    const rune_elf_t *elf = scan->elf;
+    const uint8_t *data = rune_elf_section_data(elf, section);
+    if (!data) {
+        return 0;
+    }
+    const rune_callsite_target_t *next = scan->functions.entries;
+    const rune_callsite_target_t *last = next + scan->functions.count;
+    while (next < last && next->address <= section->addr) {
+        next++;
+    }
+    scan->report->bytes_decoded += section->size;
+
+    if (elf->machine == EM_X86_64) {
+        for (uint64_t at = 0; at < section->size;) {
+            uint64_t ip = section->addr + at;
+            if (next < last && ip >= next->address) {
+                if (ip > next->address && next->address - section->addr < section->size) {
+                    at = next->address - section->addr;  // An instruction ran into the function
+                    ip = next->address;
+                }
+                while (next < last && next->address <= ip) {
+                    next++;
+                }
+            }
+            rune_branch_t branch;
+            uint64_t target = 0;
+            size_t length = rune_x86_decode(data + at, section->size - at, ip, &branch, &target);
+            if (length == 0) {
+                at++;
+                continue;
+            }
+            at += length;
+            if (branch == RUNE_BRANCH_NONE) {
+                continue;
+            }
+            int through_got = branch == RUNE_BRANCH_CALL_SLOT || branch == RUNE_BRANCH_JUMP_SLOT;
+            const char *import = rune_callsite_find(through_got ? &scan->slots : &scan->stubs, target);
+            if (import && rune_callsite_record(scan, ip, import, branch == RUNE_BRANCH_JUMP ||
+                                               branch == RUNE_BRANCH_JUMP_SLOT, through_got) != 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    // AArch64: fixed width, so no resynchronization is needed
+    for (uint64_t at = 0; at + 4 <= section->size; at += 4) {
+        uint64_t pc = section->addr + at;
+        uint32_t insn = rune_elf_u32(elf, data + at);
+        rune_a64_kind_t kind = rune_a64_kind(insn);
+        const char *import = NULL;
+        int through_got = 0;
+        if (kind == RUNE_A64_BL || kind == RUNE_A64_B) {
+            int64_t offset = (int64_t)((insn & 0x3ffffff) ^ 0x2000000) - 0x2000000;
+            import = rune_callsite_find(&scan->stubs, pc + (uint64_t)(offset * 4));
+        } else if ((kind == RUNE_A64_BLR || kind == RUNE_A64_BR) && at >= 8) {
+            unsigned reg;
+            uint64_t slot = rune_a64_slot(elf, data + at - 8, pc - 8, &reg);
+            if (slot && reg == (insn >> 5 & 0x1f)) {
+                import = rune_callsite_find(&scan->slots, slot);
+                through_got = 1;
+            }
+        }
+        if (import && rune_callsite_record(scan, pc, import, kind == RUNE_A64_B || kind == RUNE_A64_BR,
+                                           through_got) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+int rune_callsite_scan(const rune_elf_t *elf, rune_callsite_filter_t filter, void *arg,
+                       rune_callsite_report_t *report) {
+    memset(report, 0, sizeof(*report));
+    if (elf->bits != 64 || elf->big_endian || (elf->machine != EM_X86_64 && elf->machine != EM_AARCH64)) {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    rune_callsite_scan_t scan = { .elf = elf, .filter = filter, .arg = arg, .report = report };
+    int result = rune_callsite_read_relocations(&scan);
+    for (size_t s = 0; result == 0 && s < elf->section_count; s++) {
+        const rune_elf_section_t *section = &elf->sections[s];
+        if ((section->flags & SHF_EXECINSTR) && rune_callsite_is_plt(section)) {
+            result = rune_callsite_read_plt(&scan, section);
+        }
+    }
+    if (result == 0) {
+        result = rune_callsite_read_symbols(&scan);
+    }
+    report->import_count = scan.stubs.count + scan.slots.count;
+    for (size_t s = 0; result == 0 && s < elf->section_count; s++) {
+        const rune_elf_section_t *section = &elf->sections[s];
+        if (section->type == SHT_PROGBITS && (section->flags & SHF_EXECINSTR) && !rune_callsite_is_plt(section)) {
+            result = rune_callsite_sweep(&scan, section);
+        }
+    }
+    free(scan.slots.entries);
+    free(scan.stubs.entries);
+    free(scan.functions.entries);
+    if (result != 0) {
+        errno = ENOMEM;
+    }
+    return result;
+}
+
+void rune_callsite_free(rune_callsite_report_t *report) {
+    free(report->sites);
+    memset(report, 0, sizeof(*report));
+}
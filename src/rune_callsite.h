@@ -0,0 +1,66 @@
+/**
+ * rune_callsite.h - Call sites of imported functions, from the machine code
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Knowing that a binary imports strcpy does not say who calls it. This
+ * scanner resolves every PLT stub and GOT slot to the import it stands
+ * for (JUMP_SLOT/GLOB_DAT relocations against .dynsym, IRELATIVE ones
+ * in static binaries), then decodes the executable sections linearly
+ * and reports each call or tail jump that lands on one: direct calls
+ * through the PLT as well as -fno-plt calls through the GOT.
+ *
+ * x86-64 instructions are sized by a table-driven length decoder
+ * (legacy, VEX, EVEX and XOP encodings); AArch64 ones are fixed width
+ * and matched against a small mask/value table. The sweep restarts at
+ * every function symbol, so padding or data between functions cannot
+ * desynchronize it for long.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_CALLSITE_H
+#define RUNE_CALLSITE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rune_elf.h"
+
+typedef struct rune_callsite {
+    uint64_t address;           // Of the call instruction, link-time
+    const char *import;         // Function called
+    const char *function;       // Symbol containing the call, NULL if none does
+    uint8_t tail;               // A jump (tail call) rather than a call
+    uint8_t through_got;        // Loaded from the GOT rather than through a PLT stub
+} rune_callsite_t;
+
+typedef struct rune_callsite_report {
+    rune_callsite_t *sites;     // In address order within each section
+    size_t count;
+    size_t capacity;
+    size_t import_count;        // Stubs and GOT slots resolved
+    uint64_t bytes_decoded;
+} rune_callsite_report_t;
+
+/**
+ * @brief Decide whether calls to import are wanted
+ * @return Nonzero to report them
+ */
+typedef int (*rune_callsite_filter_t)(const char *import, void *arg);
+
+/**
+ * @brief Find the calls to the imports filter accepts (all if NULL)
+ * @return 0 on success, -1 on error (errno EOPNOTSUPP: not x86-64 or
+ *         AArch64, ENOMEM: the report holds the sites found so far)
+ */
+int rune_callsite_scan(const rune_elf_t *elf, rune_callsite_filter_t filter, void *arg,
+                       rune_callsite_report_t *report);
+
+/**
+ * @brief Free the sites of a report
+ */
+void rune_callsite_free(rune_callsite_report_t *report);
+
+#endif /* RUNE_CALLSITE_H */
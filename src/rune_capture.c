@@ -0,0 +1,256 @@
+/**
+ * rune_capture.c - Zero-copy output capture implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_capture.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+
+// Largest chunk moved per tee()/splice() call
+#define RUNE_CAPTURE_CHUNK (1 << 20)
+
+static void rune_capture_notify(rune_capture_t *cap) {
+    uint64_t one = 1;
+    if (write(cap->wake_fd, &one, sizeof(one)) < 0) {
+        // Counter saturation only - the consumer is awake anyway
+    }
+}
+
+// Hand every unread span to the analyzers. Returns 1 if anything was consumed.
+static int rune_capture_consume_all(rune_capture_t *cap) {
+    int busy = 0;
+    for (int stream = 0; stream < 2; stream++) {
+        size_t len;
+        const unsigned char *data = rune_ring_peek(&cap->rings[stream], &len);
+        if (len == 0) continue;
+        if (cap->on_output) {
+            cap->on_output(cap->user, stream, (const char *)data, len);
+        }
+        rune_ring_consume(&cap->rings[stream], len);
+        busy = 1;
+    }
+    return busy;
+}
+
+static void *rune_capture_consumer(void *arg) {
+    rune_capture_t *cap = arg;
+    for (;;) {
+        // Read the flag first: anything committed before it was set is visible below
+        int closing = __atomic_load_n(&cap->closed, __ATOMIC_ACQUIRE);
+        if (rune_capture_consume_all(cap)) continue;
+        if (closing) break;
+
+        uint64_t wakeups;
+        if (read(cap->wake_fd, &wakeups, sizeof(wakeups)) < 0 && errno != EINTR) break;
+    }
+    return NULL;
+}
+
+int rune_capture_start(rune_capture_t *cap, size_t ring_size, int forward,
+                       rune_capture_fn on_output, void *user) {
+    memset(cap, 0, sizeof(*cap));
+    cap->null_fd = -1;
+    cap->wake_fd = -1;
+    cap->forward = forward;
+    cap->on_output = on_output;
+    cap->user = user;
+    for (int i = 0; i < 2; i++) {
+        cap->rings[i].memfd = -1;
+        cap->tee_pipe[i][0] = cap->tee_pipe[i][1] = -1;
+    }
+
+    for (int i = 0; i < 2; i++) {
+        if (rune_ring_init(&cap->rings[i], ring_size) != 0) goto fail;
+        if (forward) {
+            if (pipe2(cap->tee_pipe[i], O_CLOEXEC | O_NONBLOCK) != 0) goto fail;
+            // A bigger duplicate pipe means fewer, larger tee() calls (best effort)
+            fcntl(cap->tee_pipe[i][1], F_SETPIPE_SZ, RUNE_CAPTURE_CHUNK);
+        }
+    }
+    cap->null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    if (cap->null_fd < 0) goto fail;
+    cap->wake_fd = eventfd(0, EFD_CLOEXEC);
+    if (cap->wake_fd < 0) goto fail;
+
+    int err = pthread_create(&cap->consumer, NULL, rune_capture_consumer, cap);
+    if (err != 0) {
+        errno = err;
+        goto fail;
+    }
+    cap->thread_started = 1;
+    return 0;
+
+fail:
+    {
+        int saved_errno = errno;
+        rune_capture_finish(cap);
+        errno = saved_errno;
+    }
+    return -1;
+}
+
+// Throw away exactly len bytes from a pipe
+static void rune_capture_discard(rune_capture_t *cap, int fd, size_t len) {
+    while (len > 0) {
+        ssize_t n = splice(fd, NULL, cap->null_fd, NULL, len, SPLICE_F_NONBLOCK);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) {
+            // /dev/null refused a splice (should not happen) - read it away
+            char scratch[4096];
+            n = read(fd, scratch, len < sizeof(scratch) ? len : sizeof(scratch));
+            if (n <= 0) return;
+        }
+        len -= (size_t)n;
+    }
+}
+
+// Move len bytes of the tee()'d duplicate into the ring, dropping what does not fit
+static void rune_capture_store(rune_capture_t *cap, int stream, int fd, size_t len) {
+    rune_ring_t *ring = &cap->rings[stream];
+    size_t stored = 0;
+    while (stored < len) {
+        ssize_t n = rune_ring_splice_in(ring, fd, len - stored);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) break;
+        stored += (size_t)n;
+    }
+    if (stored < len) {
+        // Output was forwarded and counted; only the analysis misses it
+        rune_capture_discard(cap, fd, len - stored);
+        cap->dropped_bytes += len - stored;
+    }
+    if (stored > 0) rune_capture_notify(cap);
+}
+
+// Forward exactly len bytes that tee() has already duplicated
+static int rune_capture_forward(rune_capture_t *cap, int stream, int fd, size_t len) {
+    int out_fd = stream == 0 ? STDOUT_FILENO : STDERR_FILENO;
+    size_t moved = 0;
+    while (moved < len) {
+        ssize_t n = splice(fd, NULL, out_fd, NULL, len - moved, SPLICE_F_MOVE);
+        if (n > 0) {
+            moved += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (moved == 0 && n < 0 && errno == EINVAL) {
+            return -1; // Output fd cannot splice - caller switches to copy mode
+        }
+        // Our stdout went away (EPIPE): keep consuming so the target never blocks
+        rune_capture_discard(cap, fd, len - moved);
+        return 0;
+    }
+    return 0;
+}
+
+// read()/write() path for streams that cannot splice
+static int rune_capture_copy(rune_capture_t *cap, int stream, int fd, size_t *bytes) {
+    char buffer[65536];
+    int out_fd = stream == 0 ? STDOUT_FILENO : STDERR_FILENO;
+    for (;;) {
+        ssize_t n = read(fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            *bytes += (size_t)n;
+            if (cap->forward) {
+                const char *p = buffer;
+                size_t left = (size_t)n;
+                while (left > 0) {
+                    ssize_t w = write(out_fd, p, left);
+                    if (w < 0) {
+                        if (errno == EINTR) continue;
+                        break;
+                    }
+                    p += w;
+                    left -= (size_t)w;
+                }
+            }
+            size_t stored = rune_ring_write(&cap->rings[stream], buffer, (size_t)n);
+            cap->dropped_bytes += (size_t)n - stored;
+            if (stored > 0) rune_capture_notify(cap);
+            continue;
+        }
+        if (n == 0) return 0;
+        if (errno == EINTR) continue;
+        return errno == EAGAIN ? 1 : 0;
+    }
+}
+
+int rune_capture_drain(rune_capture_t *cap, int stream, int fd, size_t *bytes) {
+    for (;;) {
+        if (cap->copy_mode[stream]) {
+            return rune_capture_copy(cap, stream, fd, bytes);
+        }
+
+        ssize_t n;
+        if (cap->forward) {
+            // Duplicate the pipe contents without consuming them
+            n = tee(fd, cap->tee_pipe[stream][1], RUNE_CAPTURE_CHUNK, SPLICE_F_NONBLOCK);
+        } else if (rune_ring_free_space(&cap->rings[stream]) > 0) {
+            n = rune_ring_splice_in(&cap->rings[stream], fd, RUNE_CAPTURE_CHUNK);
+        } else {
+            n = splice(fd, NULL, cap->null_fd, NULL, RUNE_CAPTURE_CHUNK, SPLICE_F_NONBLOCK);
+            if (n > 0) cap->dropped_bytes += (size_t)n;
+        }
+
+        if (n == 0) return 0;
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN) return 1;
+            if (errno == EINVAL) {
+                cap->copy_mode[stream] = 1;
+                continue;
+            }
+            return 0;
+        }
+
+        if (cap->forward) {
+            if (rune_capture_forward(cap, stream, fd, (size_t)n) != 0) {
+                // Nothing was consumed: drop the duplicate and redo this chunk by copying
+                rune_capture_discard(cap, cap->tee_pipe[stream][0], (size_t)n);
+                cap->copy_mode[stream] = 1;
+                continue;
+            }
+            rune_capture_store(cap, stream, cap->tee_pipe[stream][0], (size_t)n);
+        } else {
+            rune_capture_notify(cap);
+        }
+        *bytes += (size_t)n;
+    }
+}
+
+void rune_capture_finish(rune_capture_t *cap) {
+    if (cap->thread_started) {
+        __atomic_store_n(&cap->closed, 1, __ATOMIC_RELEASE);
+        rune_capture_notify(cap);
+        pthread_join(cap->consumer, NULL);
+        cap->thread_started = 0;
+    }
+    for (int i = 0; i < 2; i++) {
+        rune_ring_destroy(&cap->rings[i]);
+        for (int end = 0; end < 2; end++) {
+            if (cap->tee_pipe[i][end] >= 0) {
+                close(cap->tee_pipe[i][end]);
+                cap->tee_pipe[i][end] = -1;
+            }
+        }
+    }
+    if (cap->null_fd >= 0) {
+        close(cap->null_fd);
+        cap->null_fd = -1;
+    }
+    if (cap->wake_fd >= 0) {
+        close(cap->wake_fd);
+        cap->wake_fd = -1;
+    }
+}
+
+int rune_capture_zero_copy(const rune_capture_t *cap) {
+    return !cap->copy_mode[0] && !cap->copy_mode[1];
+}
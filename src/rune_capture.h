@@ -0,0 +1,67 @@
+/**
+ * rune_capture.h - Zero-copy output capture for the supervisor
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Target output is forwarded to our stdout/stderr with tee() + splice()
+ * so the data never crosses into userspace. The tee'd duplicate is
+ * spliced into a per-stream rune_ring_t and handed to the pattern
+ * analyzers by a consumer thread, off the supervisor's hot path.
+ *
+ * When a descriptor does not support splicing (old kernel, O_APPEND
+ * file, some ttys) that stream quietly falls back to read()/write().
+ */
+
+#ifndef RUNE_CAPTURE_H
+#define RUNE_CAPTURE_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rune_ring.h"
+
+typedef void (*rune_capture_fn)(void *user, int stream, const char *data, size_t len);
+
+typedef struct rune_capture {
+    rune_ring_t rings[2];       // One ring per stream (stdout, stderr)
+    int tee_pipe[2][2];         // Holds the tee()'d duplicate until it is spliced into the ring
+    int copy_mode[2];           // Stream fell back to read()/write()
+    int null_fd;                // /dev/null, sink for bytes the ring cannot take
+    int wake_fd;                // eventfd, producer -> consumer
+    int forward;                // Forward output to our own stdout/stderr
+    int closed;                 // Producer is done
+    int thread_started;
+    pthread_t consumer;
+    rune_capture_fn on_output;
+    void *user;
+    uint64_t dropped_bytes;     // Bytes forwarded but not analyzed (ring full)
+} rune_capture_t;
+
+/**
+ * @brief Set up the rings and start the consumer thread
+ * @param ring_size Capacity of each stream's ring
+ * @return 0 on success, -1 on error (errno is set, nothing to clean up)
+ */
+int rune_capture_start(rune_capture_t *cap, size_t ring_size, int forward,
+                       rune_capture_fn on_output, void *user);
+
+/**
+ * @brief Move everything currently readable on a stream's pipe
+ * @param bytes Incremented by the exact number of bytes taken from the pipe
+ * @return 1 if the pipe is drained for now, 0 on EOF or error
+ */
+int rune_capture_drain(rune_capture_t *cap, int stream, int fd, size_t *bytes);
+
+/**
+ * @brief Let the consumer finish the backlog, join it and free everything
+ */
+void rune_capture_finish(rune_capture_t *cap);
+
+/**
+ * @brief 1 if every stream used splice() end to end
+ */
+int rune_capture_zero_copy(const rune_capture_t *cap);
+
+#endif /* RUNE_CAPTURE_H */
@@ -0,0 +1,232 @@
+/**
+ * rune_cgroup.c - Per-run cgroup v2 accounting implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_cgroup.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#define RUNE_CGROUP_KILL_TRIES 100      // Leaf removal attempts, 10 ms apart
+
+// Find where the cgroup v2 hierarchy is mounted
+static int rune_cgroup_mount_point(char *out, size_t size) {
+    FILE *f = fopen("/proc/self/mountinfo", "r");
+    if (!f) return -1;
+
+    char line[4096];
+    int found = -1;
+    while (fgets(line, sizeof(line), f)) {
+        // ... mount_point ... - fstype source options
+        char *sep = strstr(line, " - ");
+        if (!sep || strncmp(sep + 3, "cgroup2 ", 8) != 0) continue;
+
+        char mount_point[PATH_MAX];
+        if (sscanf(line, "%*s %*s %*s %*s %4095s", mount_point) == 1) {
+            snprintf(out, size, "%s", mount_point);
+            found = 0;
+            break;
+        }
+    }
+    fclose(f);
+    if (found != 0) errno = ENOENT;
+    return found;
+}
+
+// Path of our own cgroup inside the v2 hierarchy ("0::/path")
+static int rune_cgroup_self_path(char *out, size_t size) {
+    FILE *f = fopen("/proc/self/cgroup", "r");
+    if (!f) return -1;
+
+    char line[4096];
+    int found = -1;
+    while (fgets(line, sizeof(line), f)) {
+        if (strncmp(line, "0::", 3) == 0) {
+            line[strcspn(line, "\n")] = '\0';
+            snprintf(out, size, "%s", line + 3);
+            found = 0;
+            break;
+        }
+    }
+    fclose(f);
+    if (found != 0) errno = ENOENT;
+    return found;
+}
+
+// Best effort: delegate controllers to our leaves
+static void rune_cgroup_enable_controllers(const char *parent) {
+    static const char *controllers[] = { "+memory", "+cpu", "+io" };
+    char path[PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/cgroup.subtree_control", parent);
+
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd < 0) return;
+    for (size_t i = 0; i < sizeof(controllers) / sizeof(controllers[0]); i++) {
+        // Fails with EBUSY/ENOENT when not allowed - accounting degrades
+        if (write(fd, controllers[i], strlen(controllers[i])) < 0) {
+            continue;
+        }
+    }
+    close(fd);
+}
+
+int rune_cgroup_create(rune_cgroup_t *cg, const char *parent) {
+    static unsigned int leaf_counter = 0;
+    char parent_path[PATH_MAX];
+
+    memset(cg, 0, sizeof(*cg));
+    cg->procs_fd = -1;
+
+    if (parent && parent[0]) {
+        snprintf(parent_path, sizeof(parent_path), "%s", parent);
+    } else {
+        char mount_point[PATH_MAX], self_path[PATH_MAX];
+        if (rune_cgroup_mount_point(mount_point, sizeof(mount_point)) != 0 ||
+            rune_cgroup_self_path(self_path, sizeof(self_path)) != 0) {
+            return -1;
+        }
+        int n = snprintf(parent_path, sizeof(parent_path), "%s%s", mount_point,
+                         strcmp(self_path, "/") == 0 ? "" : self_path);
+        if (n < 0 || (size_t)n >= sizeof(parent_path)) {
+            errno = ENAMETOOLONG;
+            return -1;
+        }
+    }
+
+    rune_cgroup_enable_controllers(parent_path);
+
+    unsigned int id = __atomic_fetch_add(&leaf_counter, 1, __ATOMIC_RELAXED);
+    int n = snprintf(cg->path, sizeof(cg->path), "%s/rune_analyze-%d-%u",
+                     parent_path, (int)getpid(), id);
+    if (n < 0 || (size_t)n >= sizeof(cg->path)) {
+        errno = ENAMETOOLONG;
+        return -1;
+    }
+    if (mkdir(cg->path, 0755) != 0) {
+        return -1;
+    }
+
+    char procs[PATH_MAX + 16];
+    snprintf(procs, sizeof(procs), "%s/cgroup.procs", cg->path);
+    cg->procs_fd = open(procs, O_WRONLY | O_CLOEXEC);
+    if (cg->procs_fd < 0) {
+        int saved_errno = errno;
+        rmdir(cg->path);
+        errno = saved_errno;
+        return -1;
+    }
+    return 0;
+}
+
+int rune_cgroup_attach_self(const rune_cgroup_t *cg) {
+    // "0" means the writing process
+    return write(cg->procs_fd, "0", 1) == 1 ? 0 : -1;
+}
+
+// Read a whole small control file into buf
+static int rune_cgroup_read_file(const rune_cgroup_t *cg, const char *name, char *buf, size_t size) {
+    char path[PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/%s", cg->path, name);
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return -1;
+    ssize_t n = read(fd, buf, size - 1);
+    close(fd);
+    if (n < 0) return -1;
+    buf[n] = '\0';
+    return 0;
+}
+
+int rune_cgroup_read_stats(const rune_cgroup_t *cg, rune_cgroup_stats_t *stats) {
+    char buf[8192];
+    char *save;
+
+    stats->cpu_usage_usec = -1;
+    stats->cpu_user_usec = -1;
+    stats->cpu_system_usec = -1;
+    stats->memory_peak_bytes = -1;
+    stats->io_read_bytes = -1;
+    stats->io_write_bytes = -1;
+
+    // cpu.stat is always present, even without the cpu controller
+    if (rune_cgroup_read_file(cg, "cpu.stat", buf, sizeof(buf)) == 0) {
+        for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+            long long value;
+            if (sscanf(line, "usage_usec %lld", &value) == 1) stats->cpu_usage_usec = value;
+            else if (sscanf(line, "user_usec %lld", &value) == 1) stats->cpu_user_usec = value;
+            else if (sscanf(line, "system_usec %lld", &value) == 1) stats->cpu_system_usec = value;
+        }
+    }
+
+    // memory.peak needs the memory controller and Linux 5.19+
+    if (rune_cgroup_read_file(cg, "memory.peak", buf, sizeof(buf)) == 0) {
+        stats->memory_peak_bytes = strtoll(buf, NULL, 10);
+    }
+
+    // io.stat: one "MAJ:MIN rbytes=N wbytes=N ..." line per device
+    if (rune_cgroup_read_file(cg, "io.stat", buf, sizeof(buf)) == 0) {
+        stats->io_read_bytes = 0;
+        stats->io_write_bytes = 0;
+        for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+            char *field;
+            if ((field = strstr(line, "rbytes=")) != NULL) stats->io_read_bytes += strtoll(field + 7, NULL, 10);
+            if ((field = strstr(line, "wbytes=")) != NULL) stats->io_write_bytes += strtoll(field + 7, NULL, 10);
+        }
+    }
+
+    return 0;
+}
+
+// SIGKILL everything left in the leaf: cgroup.kill (Linux 5.14+), else each pid in cgroup.procs
+static void rune_cgroup_kill(const rune_cgroup_t *cg) {
+    char path[PATH_MAX + 32];
+    snprintf(path, sizeof(path), "%s/cgroup.kill", cg->path);
+    int fd = open(path, O_WRONLY | O_CLOEXEC);
+    if (fd >= 0) {
+        ssize_t written = write(fd, "1", 1);
+        close(fd);
+        if (written == 1) return;
+    }
+
+    char buf[8192];
+    char *save;
+    if (rune_cgroup_read_file(cg, "cgroup.procs", buf, sizeof(buf)) != 0) return;
+    for (char *line = strtok_r(buf, "\n", &save); line; line = strtok_r(NULL, "\n", &save)) {
+        pid_t pid = (pid_t)strtol(line, NULL, 10);
+        if (pid > 0) kill(pid, SIGKILL);
+    }
+}
+
+int rune_cgroup_destroy(rune_cgroup_t *cg) {
+    if (cg->procs_fd >= 0) {
+        close(cg->procs_fd);
+        cg->procs_fd = -1;
+    }
+    if (!cg->path[0]) {
+        return 0;
+    }
+
+    // Descendants the target orphaned keep the leaf busy: kill them and
+    // wait for the kernel to empty it
+    int rc = rmdir(cg->path);
+    for (int tries = 0; rc != 0 && errno == EBUSY && tries < RUNE_CGROUP_KILL_TRIES; tries++) {
+        rune_cgroup_kill(cg);
+        struct timespec pause = { 0, 10 * 1000 * 1000 };
+        nanosleep(&pause, NULL);
+        rc = rmdir(cg->path);
+    }
+    if (rc == 0) {
+        cg->path[0] = '\0';
+    }
+    return rc;
+}
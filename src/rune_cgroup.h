@@ -0,0 +1,61 @@
+/**
+ * rune_cgroup.h - Per-run cgroup v2 accounting for rune_analyze
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * The target is placed in its own cgroup v2 leaf so that memory.peak,
+ * cpu.stat and io.stat cover the whole process tree, including every
+ * descendant the target forks. Controllers that are not delegated to
+ * us are simply reported as unavailable.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_CGROUP_H
+#define RUNE_CGROUP_H
+
+#include <limits.h>
+
+typedef struct rune_cgroup {
+    char path[PATH_MAX];        // Absolute path of the leaf directory
+    int procs_fd;               // Open cgroup.procs of the leaf (O_CLOEXEC)
+} rune_cgroup_t;
+
+// Whole-tree accounting read back after the run (-1 = not available)
+typedef struct rune_cgroup_stats {
+    long long cpu_usage_usec;
+    long long cpu_user_usec;
+    long long cpu_system_usec;
+    long long memory_peak_bytes;
+    long long io_read_bytes;
+    long long io_write_bytes;
+} rune_cgroup_stats_t;
+
+/**
+ * @brief Create a leaf cgroup for one run
+ * @param cg Filled on success
+ * @param parent cgroup v2 directory to create the leaf in, or NULL to
+ *        use the cgroup the analyzer itself runs in
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_cgroup_create(rune_cgroup_t *cg, const char *parent);
+
+/**
+ * @brief Move the calling process into the leaf
+ * Async-signal-safe: meant to be called in the child between fork()
+ * and exec().
+ */
+int rune_cgroup_attach_self(const rune_cgroup_t *cg);
+
+// Read memory.peak, cpu.stat and io.stat of the leaf
+int rune_cgroup_read_stats(const rune_cgroup_t *cg, rune_cgroup_stats_t *stats);
+
+/**
+ * @brief Remove the leaf, killing whatever the target left running in it
+ * @return 0 on success, -1 if the leaf could not be removed (errno is
+ *         set, cg->path still names it)
+ */
+int rune_cgroup_destroy(rune_cgroup_t *cg);
+
+#endif /* RUNE_CGROUP_H */
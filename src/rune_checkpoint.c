@@ -9,214 +9,784 @@
  */
 
 #include "rune_analyze.h"
-#include <sys/time.h>
+#include "rune_intern.h"
+#include "rune_dispatch.h"
+#include <fnmatch.h>
 
-// Global checkpoint storage
-static rune_checkpoint_t g_checkpoints[MAX_CHECKPOINTS];
-static int g_checkpoint_count = 0;
-static double g_start_time = 0.0;
+#define RUNE_CHECKPOINT_RING_SIZE 1024      // Records per thread and context (power of two)
+#define RUNE_CHECKPOINT_READ_BATCH 512      // Spilled records read back per pread()
 
-// Global trigger storage
-static rune_trigger_t g_triggers[64];
-static int g_trigger_count = 0;
+// One thread's records for one context: that thread is the only
+// producer, consumers move records to storage under checkpoint_lock
+typedef struct rune_checkpoint_ring {
+    struct rune_checkpoint_ring *next;
+    const void *owner;                  // &t_ring of the producing thread
+    uint32_t thread;                    // Numbered per context from 1, stored in the records' flags
+    uint32_t head;                      // Next write (producer)
+    uint32_t tail;                      // Next read (consumers)
+    rune_checkpoint_record_t records[RUNE_CHECKPOINT_RING_SIZE];
+} rune_checkpoint_ring_t;
 
-// Internal helper to get current timestamp
-static double rune_get_current_time(void) {
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    return (double)tv.tv_sec + (double)tv.tv_usec / 1000000.0;
+// The calling thread's ring in the context it last logged into
+static __thread struct {
+    const rune_context_t *ctx;
+    unsigned long serial;
+    rune_checkpoint_ring_t *ring;
+} t_ring;
+
+static __thread rune_checkpoint_t t_view;  // rune_get_checkpoint() result
+
+_Static_assert(sizeof(rune_checkpoint_record_t) == 24, "checkpoint records are meant to stay 24 bytes");
+
+// Indexed by rune_checkpoint_category_t - RUNE_CATEGORY_LOAD
+static const char* const g_category_names[RUNE_CATEGORY_END - RUNE_CATEGORY_LOAD] = {
+    RUNE_CHECKPOINT_LOAD, RUNE_CHECKPOINT_FUNC, RUNE_CHECKPOINT_SYSCALL, RUNE_CHECKPOINT_MEM,
+    RUNE_CHECKPOINT_NET, RUNE_CHECKPOINT_SEC, RUNE_CHECKPOINT_PERF, RUNE_CHECKPOINT_EXIT,
+    RUNE_CHECKPOINT_MISC,
+};
+
+// Before main(): nothing can have been interned yet
+__attribute__((constructor)) static void rune_checkpoint_categories(void) {
+    if (rune_intern_reserve(g_category_names, RUNE_CATEGORY_END - RUNE_CATEGORY_LOAD) != 0) {
+        fprintf(stderr, "rune_analyze: could not reserve checkpoint categories\n");
+        abort();
+    }
+}
+
+const char* rune_checkpoint_category_name(uint32_t category) {
+    if (category >= RUNE_CATEGORY_LOAD && category < RUNE_CATEGORY_END) {
+        return g_category_names[category - RUNE_CATEGORY_LOAD];
+    }
+    return rune_intern_string(category);
+}
+
+static int rune_trigger_dispatch(rune_context_t* ctx, const char* id, uint32_t category,
+                                 const rune_checkpoint_record_t* record, rune_checkpoint_t* view);
+static void rune_trigger_free(rune_context_t* ctx);
+
+static uint64_t rune_clock_ns(clockid_t clock) {
+    struct timespec ts;
+    clock_gettime(clock, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Slow path: first checkpoint of this thread in ctx
+static rune_checkpoint_ring_t* rune_checkpoint_ring_attach(rune_context_t* ctx) {
+    pthread_mutex_lock(&ctx->checkpoint_lock);
+    // A new thread whose TLS lands where an exited one's was takes over its ring
+    rune_checkpoint_ring_t* ring = ctx->checkpoint_rings;
+    uint32_t rings = 0;
+    while (ring && ring->owner != &t_ring) {
+        ring = ring->next;
+        rings++;
+    }
+    if (!ring && (ring = calloc(1, sizeof(*ring))) != NULL) {
+        ring->owner = &t_ring;
+        ring->thread = rings + 1;
+        ring->next = ctx->checkpoint_rings;
+        ctx->checkpoint_rings = ring;
+    }
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
+
+    if (ring) {
+        t_ring.ctx = ctx;
+        t_ring.serial = ctx->checkpoint_serial;
+        t_ring.ring = ring;
+    }
+    return ring;
+}
+
+static inline rune_checkpoint_ring_t* rune_checkpoint_ring(rune_context_t* ctx) {
+    if (t_ring.ctx == ctx && t_ring.serial == ctx->checkpoint_serial) {
+        return t_ring.ring;
+    }
+    return rune_checkpoint_ring_attach(ctx);
+}
+
+// In-memory chunks the cap allows: at least two, so the chunk being
+// sorted into is never the one spilled
+static size_t rune_checkpoint_max_chunks(const rune_context_t* ctx) {
+    size_t mb = ctx->config.checkpoint_memory_mb > 0 ? (size_t)ctx->config.checkpoint_memory_mb
+                                                     : RUNE_CHECKPOINT_MEMORY_MB;
+    size_t chunks = (mb << 20) / (RUNE_CHECKPOINT_CHUNK * sizeof(rune_checkpoint_record_t));
+    return chunks < 2 ? 2 : chunks;
+}
+
+// Record at an index that is still in memory
+static inline rune_checkpoint_record_t* rune_checkpoint_slot(const rune_context_t* ctx, size_t index) {
+    size_t offset = index - ctx->checkpoint_spilled;
+    return &ctx->checkpoint_chunks[offset / RUNE_CHECKPOINT_CHUNK][offset % RUNE_CHECKPOINT_CHUNK];
+}
+
+// Segment file for spilled records: unlinked, so it goes away with us
+static int rune_checkpoint_open_segment(void) {
+    const char* dir = getenv("TMPDIR");
+    if (!dir || !*dir) {
+        dir = "/tmp";
+    }
+    int fd = open(dir, O_TMPFILE | O_RDWR | O_CLOEXEC, 0600);
+    if (fd >= 0) {
+        return fd;
+    }
+
+    char path[PATH_MAX];
+    snprintf(path, sizeof(path), "%s/rune_checkpoints.XXXXXX", dir);
+    fd = mkostemp(path, O_CLOEXEC);
+    if (fd >= 0) {
+        unlink(path);
+    }
+    return fd;
+}
+
+// Write the oldest chunk to the segment file and recycle it as the
+// newest (checkpoint_lock held)
+static int rune_checkpoint_spill(rune_context_t* ctx) {
+    if (ctx->checkpoint_spill_fd < 0 && (ctx->checkpoint_spill_fd = rune_checkpoint_open_segment()) < 0) {
+        return -1;
+    }
+
+    rune_checkpoint_record_t* oldest = ctx->checkpoint_chunks[0];
+    const char* data = (const char*)oldest;
+    size_t size = RUNE_CHECKPOINT_CHUNK * sizeof(*oldest);
+    off_t offset = (off_t)(ctx->checkpoint_spilled * sizeof(*oldest));
+    while (size > 0) {
+        ssize_t written = pwrite(ctx->checkpoint_spill_fd, data, size, offset);
+        if (written < 0 && errno == EINTR) {
+            continue;
+        }
+        if (written <= 0) {
+            return -1;
+        }
+        data += written;
+        size -= (size_t)written;
+        offset += written;
+    }
+
+    memmove(&ctx->checkpoint_chunks[0], &ctx->checkpoint_chunks[1],
+            (ctx->checkpoint_chunk_count - 1) * sizeof(*ctx->checkpoint_chunks));
+    ctx->checkpoint_chunks[ctx->checkpoint_chunk_count - 1] = oldest;
+    ctx->checkpoint_spilled += RUNE_CHECKPOINT_CHUNK;
+    return 0;
+}
+
+// Make room for the record at checkpoint_count (checkpoint_lock held)
+static int rune_checkpoint_reserve(rune_context_t* ctx) {
+    size_t offset = ctx->checkpoint_count - ctx->checkpoint_spilled;
+    if (offset % RUNE_CHECKPOINT_CHUNK != 0) {
+        return 0;
+    }
+
+    size_t chunk = offset / RUNE_CHECKPOINT_CHUNK;
+    if (chunk >= rune_checkpoint_max_chunks(ctx) && chunk >= ctx->checkpoint_chunk_count) {
+        return rune_checkpoint_spill(ctx);
+    }
+    if (chunk < ctx->checkpoint_chunk_count) {
+        return 0;
+    }
+
+    if (ctx->checkpoint_chunk_count == ctx->checkpoint_chunk_slots) {
+        size_t slots = ctx->checkpoint_chunk_slots ? ctx->checkpoint_chunk_slots * 2 : 16;
+        rune_checkpoint_record_t** chunks = realloc(ctx->checkpoint_chunks, slots * sizeof(*chunks));
+        if (!chunks) {
+            return -1;
+        }
+        ctx->checkpoint_chunks = chunks;
+        ctx->checkpoint_chunk_slots = slots;
+    }
+    rune_checkpoint_record_t* fresh = malloc(RUNE_CHECKPOINT_CHUNK * sizeof(*fresh));
+    if (!fresh) {
+        // Out of memory: disk is the only place left
+        return ctx->checkpoint_chunk_count > 1 ? rune_checkpoint_spill(ctx) : -1;
+    }
+    ctx->checkpoint_chunks[ctx->checkpoint_chunk_count++] = fresh;
+    return 0;
+}
+
+// Move a ring's records to storage, keeping storage in time order
+// (checkpoint_lock held)
+static void rune_checkpoint_drain(rune_context_t* ctx, rune_checkpoint_ring_t* ring) {
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    uint32_t tail = ring->tail;
+    size_t first = ctx->checkpoint_count;
+    for (; tail != head; tail++) {
+        if (rune_checkpoint_reserve(ctx) != 0) {
+            __atomic_add_fetch(&ctx->checkpoint_dropped, 1, __ATOMIC_RELAXED);
+            continue;
+        }
+        *rune_checkpoint_slot(ctx, ctx->checkpoint_count++) = ring->records[tail & (RUNE_CHECKPOINT_RING_SIZE - 1)];
+    }
+    __atomic_store_n(&ring->tail, tail, __ATOMIC_RELEASE);
+
+    // Rings of different threads interleave: insertion sort, stable and
+    // cheap on a nearly ordered tail. Spilled records are final, so a
+    // straggler older than all of memory lands at its start.
+    if (first <= ctx->checkpoint_spilled) {
+        first = ctx->checkpoint_spilled + 1;
+    }
+    for (size_t i = first; i < ctx->checkpoint_count; i++) {
+        rune_checkpoint_record_t record = *rune_checkpoint_slot(ctx, i);
+        size_t j = i;
+        while (j > ctx->checkpoint_spilled && rune_checkpoint_slot(ctx, j - 1)->time_ns > record.time_ns) {
+            *rune_checkpoint_slot(ctx, j) = *rune_checkpoint_slot(ctx, j - 1);
+            j--;
+        }
+        *rune_checkpoint_slot(ctx, j) = record;
+    }
+}
+
+// Bring storage up to date; returns with checkpoint_lock held
+static rune_context_t* rune_checkpoint_collect(const rune_context_t* cctx) {
+    rune_context_t* ctx = (rune_context_t*)cctx;
+    pthread_mutex_lock(&ctx->checkpoint_lock);
+    for (rune_checkpoint_ring_t* ring = ctx->checkpoint_rings; ring; ring = ring->next) {
+        rune_checkpoint_drain(ctx, ring);
+    }
+    return ctx;
+}
+
+// Sequential reader over spilled and in-memory records (checkpoint_lock held)
+typedef struct rune_checkpoint_cursor {
+    const rune_context_t* ctx;
+    size_t buffered_from;
+    size_t buffered;
+    rune_checkpoint_record_t buffer[RUNE_CHECKPOINT_READ_BATCH];
+} rune_checkpoint_cursor_t;
+
+static const rune_checkpoint_record_t* rune_checkpoint_fetch(rune_checkpoint_cursor_t* cursor, size_t index) {
+    const rune_context_t* ctx = cursor->ctx;
+    if (index >= ctx->checkpoint_spilled) {
+        return rune_checkpoint_slot(ctx, index);
+    }
+    if (index < cursor->buffered_from || index >= cursor->buffered_from + cursor->buffered) {
+        size_t want = ctx->checkpoint_spilled - index;
+        if (want > RUNE_CHECKPOINT_READ_BATCH) {
+            want = RUNE_CHECKPOINT_READ_BATCH;
+        }
+        ssize_t got = pread(ctx->checkpoint_spill_fd, cursor->buffer, want * sizeof(rune_checkpoint_record_t),
+                            (off_t)(index * sizeof(rune_checkpoint_record_t)));
+        if (got < (ssize_t)sizeof(rune_checkpoint_record_t)) {
+            cursor->buffered = 0;
+            return NULL;
+        }
+        cursor->buffered_from = index;
+        cursor->buffered = (size_t)got / sizeof(rune_checkpoint_record_t);
+    }
+    return &cursor->buffer[index - cursor->buffered_from];
+}
+
+// Format a record the way triggers and reports see it
+void rune_checkpoint_format(const rune_context_t* ctx, const rune_checkpoint_record_t* record,
+                            rune_checkpoint_t* view) {
+    snprintf(view->id, sizeof(view->id), "%s", rune_intern_string(record->id));
+    snprintf(view->category, sizeof(view->category), "%s", rune_checkpoint_category_name(record->category));
+    snprintf(view->context, sizeof(view->context), "%s", rune_intern_string(record->context));
+
+    int64_t delta_ns = (int64_t)(record->time_ns - ctx->checkpoint_start_ns);
+    view->time_offset = (double)delta_ns / 1e9;
+
+    uint64_t wall_ns = ctx->checkpoint_start_realtime_ns + (uint64_t)delta_ns;
+    time_t seconds = (time_t)(wall_ns / 1000000000ull);
+    struct tm tm_info;
+    localtime_r(&seconds, &tm_info);
+    snprintf(view->timestamp, sizeof(view->timestamp), "%02d:%02d:%02d.%03u",
+             tm_info.tm_hour, tm_info.tm_min, tm_info.tm_sec,
+             (unsigned)(wall_ns % 1000000000ull / 1000000ull));
+
+    view->trigger_fired = (record->flags & RUNE_CHECKPOINT_TRIGGERED) != 0;
+}
+
+// Handle of a category name; the built-in names resolve to their enum value
+static uint32_t rune_checkpoint_category_handle(const char* category) {
+    return category ? rune_intern(category) : RUNE_CATEGORY_MISC;
+}
+
+// Run matching triggers; the view is only built when one matches
+static void rune_checkpoint_fire(rune_context_t* ctx, rune_checkpoint_record_t* record) {
+    rune_checkpoint_t view;
+    if (rune_trigger_dispatch(ctx, rune_intern_string(record->id), record->category, record, &view) > 0) {
+        record->flags |= RUNE_CHECKPOINT_TRIGGERED;
+    }
+}
+
+static void rune_checkpoint_record(rune_context_t* ctx, uint64_t time_ns, const char* id,
+                                   uint32_t category, const char* context, uint32_t flags) {
+    rune_checkpoint_ring_t* ring = rune_checkpoint_ring(ctx);
+    if (!ring) {
+        __atomic_add_fetch(&ctx->checkpoint_dropped, 1, __ATOMIC_RELAXED);
+        return;
+    }
+
+    rune_checkpoint_record_t record = {
+        .time_ns = time_ns,
+        .id = rune_intern(id ? id : "UNKNOWN"),
+        .category = category,
+        .context = rune_intern(context),
+        .flags = (flags & RUNE_CHECKPOINT_TARGET) ? flags : ring->thread << RUNE_CHECKPOINT_THREAD_SHIFT,
+    };
+    if (ctx->trigger_count > 0) {
+        rune_checkpoint_fire(ctx, &record);
+    }
+
+    uint32_t head = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+    if (head - __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE) == RUNE_CHECKPOINT_RING_SIZE) {
+        // Nobody has read for a while: move every ring to storage ourselves,
+        // so other threads' older records are not left behind to be spilled past
+        rune_checkpoint_collect(ctx);
+        pthread_mutex_unlock(&ctx->checkpoint_lock);
+    }
+    ring->records[head & (RUNE_CHECKPOINT_RING_SIZE - 1)] = record;
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
 }
 
 // Initialize checkpoint system
-void rune_checkpoint_init(void) {
-    g_checkpoint_count = 0;
-    g_start_time = rune_get_current_time();
-    memset(g_checkpoints, 0, sizeof(g_checkpoints));
+void rune_checkpoint_init(rune_context_t* ctx) {
+    rune_checkpoint_discard(ctx);
+    ctx->checkpoint_start_ns = rune_clock_ns(CLOCK_MONOTONIC);
+    ctx->checkpoint_start_realtime_ns = rune_clock_ns(CLOCK_REALTIME);
     
     // Log the initialization checkpoint
-    rune_log_checkpoint("SYSTEM: checkpoint_system_initialized", "LOAD", "Framework checkpoint system ready");
+    rune_context_t* previous = rune_context_bind(ctx);
+    rune_log_checkpoint_category("SYSTEM: checkpoint_system_initialized", RUNE_CATEGORY_LOAD,
+                                 "Framework checkpoint system ready");
+    rune_context_bind(previous);
 }
 
 // Cleanup checkpoint system
-void rune_checkpoint_cleanup(void) {
-    rune_log_checkpoint("SYSTEM: checkpoint_system_cleanup", "EXIT", "Framework checkpoint system shutdown");
-    g_checkpoint_count = 0;
-    g_start_time = 0.0;
+void rune_checkpoint_cleanup(rune_context_t* ctx) {
+    rune_context_t* previous = rune_context_bind(ctx);
+    rune_log_checkpoint_category("SYSTEM: checkpoint_system_cleanup", RUNE_CATEGORY_EXIT,
+                                 "Framework checkpoint system shutdown");
+    rune_context_bind(previous);
+    rune_checkpoint_discard(ctx);
+    ctx->checkpoint_start_ns = 0;
+    ctx->checkpoint_start_realtime_ns = 0;
+}
+
+// Forget everything recorded so far, in storage and in the rings
+// (chunks are kept for the next run)
+void rune_checkpoint_discard(rune_context_t* ctx) {
+    pthread_mutex_lock(&ctx->checkpoint_lock);
+    for (rune_checkpoint_ring_t* ring = ctx->checkpoint_rings; ring; ring = ring->next) {
+        __atomic_store_n(&ring->tail, __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE), __ATOMIC_RELEASE);
+    }
+    ctx->checkpoint_count = 0;
+    ctx->checkpoint_spilled = 0;
+    if (ctx->checkpoint_spill_fd >= 0) {
+        close(ctx->checkpoint_spill_fd);
+        ctx->checkpoint_spill_fd = -1;
+    }
+    __atomic_store_n(&ctx->checkpoint_dropped, 0, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
+}
+
+// Release rings, chunks, the segment file and triggers (no thread may
+// log into ctx any more)
+void rune_checkpoint_free(rune_context_t* ctx) {
+    rune_trigger_free(ctx);
+
+    rune_checkpoint_ring_t* ring = ctx->checkpoint_rings;
+    while (ring) {
+        rune_checkpoint_ring_t* next = ring->next;
+        free(ring);
+        ring = next;
+    }
+    ctx->checkpoint_rings = NULL;
+
+    for (size_t i = 0; i < ctx->checkpoint_chunk_count; i++) {
+        free(ctx->checkpoint_chunks[i]);
+    }
+    free(ctx->checkpoint_chunks);
+    ctx->checkpoint_chunks = NULL;
+    ctx->checkpoint_chunk_count = 0;
+    ctx->checkpoint_chunk_slots = 0;
+    ctx->checkpoint_count = 0;
+    ctx->checkpoint_spilled = 0;
+    if (ctx->checkpoint_spill_fd >= 0) {
+        close(ctx->checkpoint_spill_fd);
+        ctx->checkpoint_spill_fd = -1;
+    }
 }
 
 // Core checkpoint logging function
 void rune_log_checkpoint(const char* id, const char* category, const char* context) {
-    double current_time = rune_get_current_time();
-    rune_log_checkpoint_with_time(id, category, context, current_time - g_start_time);
+    rune_checkpoint_record(rune_context_current(), rune_clock_ns(CLOCK_MONOTONIC), id,
+                           rune_checkpoint_category_handle(category), context, 0);
+}
+
+void rune_log_checkpoint_category(const char* id, rune_checkpoint_category_t category, const char* context) {
+    rune_checkpoint_record(rune_context_current(), rune_clock_ns(CLOCK_MONOTONIC), id, category, context, 0);
 }
 
 // Checkpoint logging with specific time offset
 void rune_log_checkpoint_with_time(const char* id, const char* category, const char* context, double time_offset) {
-    if (g_checkpoint_count >= MAX_CHECKPOINTS) {
-        // Handle overflow - for now just ignore new checkpoints
-        return;
-    }
-    
-    rune_checkpoint_t* cp = &g_checkpoints[g_checkpoint_count++];
-    
-    // Fill checkpoint data
-    strncpy(cp->id, id ? id : "UNKNOWN", sizeof(cp->id) - 1);
-    cp->id[sizeof(cp->id) - 1] = '\0';
-    
-    strncpy(cp->category, category ? category : "MISC", sizeof(cp->category) - 1);
-    cp->category[sizeof(cp->category) - 1] = '\0';
-    
-    if (context) {
-        strncpy(cp->context, context, sizeof(cp->context) - 1);
-        cp->context[sizeof(cp->context) - 1] = '\0';
-    } else {
-        cp->context[0] = '\0';
-    }
-    
-    cp->time_offset = time_offset;
-    cp->trigger_fired = 0;
-    
-    // Create human-readable timestamp
-    struct timeval tv;
-    gettimeofday(&tv, NULL);
-    struct tm* tm_info = localtime(&tv.tv_sec);
-    snprintf(cp->timestamp, sizeof(cp->timestamp), "%02d:%02d:%02d.%03ld",
-             tm_info->tm_hour, tm_info->tm_min, tm_info->tm_sec, tv.tv_usec / 1000);
-    
-    // Process any triggers for this checkpoint
-    rune_process_checkpoint_triggers(cp);
+    rune_context_t* ctx = rune_context_current();
+    uint64_t time_ns = ctx->checkpoint_start_ns + (uint64_t)(int64_t)(time_offset * 1e9);
+    rune_checkpoint_record(ctx, time_ns, id, rune_checkpoint_category_handle(category), context, 0);
+}
+
+// Checkpoint from elsewhere (the target's probe), on our CLOCK_MONOTONIC
+void rune_checkpoint_ingest(rune_context_t* ctx, uint64_t time_ns, const char* id, const char* category,
+                            const char* context, uint32_t flags) {
+    rune_checkpoint_record(ctx, time_ns, id, rune_checkpoint_category_handle(category), context, flags);
 }
 
 // Get checkpoint count
-int rune_get_checkpoint_count(void) {
-    return g_checkpoint_count;
+int rune_get_checkpoint_count(const rune_context_t* cctx) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    size_t count = ctx->checkpoint_count;
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
+    return count > INT_MAX ? INT_MAX : (int)count;
 }
 
 // Get specific checkpoint
-const rune_checkpoint_t* rune_get_checkpoint(int index) {
-    if (index < 0 || index >= g_checkpoint_count) {
-        return NULL;
+const rune_checkpoint_t* rune_get_checkpoint(const rune_context_t* cctx, int index) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    const rune_checkpoint_record_t* record = NULL;
+    rune_checkpoint_record_t spilled;
+    if (index >= 0 && (size_t)index < ctx->checkpoint_count) {
+        if ((size_t)index >= ctx->checkpoint_spilled) {
+            record = rune_checkpoint_slot(ctx, (size_t)index);
+        } else if (pread(ctx->checkpoint_spill_fd, &spilled, sizeof(spilled),
+                         (off_t)((size_t)index * sizeof(spilled))) == (ssize_t)sizeof(spilled)) {
+            record = &spilled;
+        }
     }
-    return &g_checkpoints[index];
+    if (record) {
+        rune_checkpoint_format(ctx, record, &t_view);
+    }
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
+    return record ? &t_view : NULL;
+}
+
+// Storage statistics
+void rune_get_checkpoint_stats(const rune_context_t* cctx, rune_checkpoint_stats_t* stats) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    stats->recorded = ctx->checkpoint_count;
+    stats->spilled = ctx->checkpoint_spilled;
+    stats->memory_bytes = ctx->checkpoint_chunk_count * RUNE_CHECKPOINT_CHUNK * sizeof(rune_checkpoint_record_t);
+    stats->dropped = __atomic_load_n(&ctx->checkpoint_dropped, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
 }
 
 // Print checkpoint timeline (human readable)
-void rune_print_checkpoint_timeline(void) {
-    printf("\n📍 Execution Timeline (%d checkpoints):\n", g_checkpoint_count);
+void rune_print_checkpoint_timeline(const rune_context_t* cctx) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    unsigned long dropped = __atomic_load_n(&ctx->checkpoint_dropped, __ATOMIC_RELAXED);
+    printf("\n📍 Execution Timeline (%zu checkpoints", ctx->checkpoint_count);
+    if (ctx->checkpoint_spilled) {
+        printf(", %zu spilled to disk", ctx->checkpoint_spilled);
+    }
+    if (dropped) {
+        printf(", %lu dropped", dropped);
+    }
+    printf("):\n");
     printf("═══════════════════════════════════════════════════════════════\n");
     
-    for (int i = 0; i < g_checkpoint_count; i++) {
-        const rune_checkpoint_t* cp = &g_checkpoints[i];
-        printf("[%s] %s %s", cp->timestamp, cp->id, cp->trigger_fired ? "🔥" : "");
-        if (cp->context[0]) {
-            printf(" → %s", cp->context);
+    rune_checkpoint_cursor_t cursor = { .ctx = ctx };
+    for (size_t i = 0; i < ctx->checkpoint_count; i++) {
+        const rune_checkpoint_record_t* record = rune_checkpoint_fetch(&cursor, i);
+        if (!record) {
+            printf("[??:??:??.???] <checkpoint unreadable from the spill file>\n");
+            continue;
+        }
+        rune_checkpoint_t cp;
+        rune_checkpoint_format(ctx, record, &cp);
+        printf("[%s] %s %s", cp.timestamp, cp.id, cp.trigger_fired ? "🔥" : "");
+        if (cp.context[0]) {
+            printf(" → %s", cp.context);
         }
         printf("\n");
     }
     printf("═══════════════════════════════════════════════════════════════\n");
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
 }
 
 // Export checkpoints as JSON
-void rune_export_checkpoints_json(void) {
-    printf("  \"checkpoints\": [\n");
-    for (int i = 0; i < g_checkpoint_count; i++) {
-        const rune_checkpoint_t* cp = &g_checkpoints[i];
-        printf("    {\n");
-        printf("      \"id\": \"%s\",\n", cp->id);
-        printf("      \"timestamp\": \"%s\",\n", cp->timestamp);
-        printf("      \"category\": \"%s\",\n", cp->category);
-        printf("      \"time_offset\": %.6f,\n", cp->time_offset);
-        printf("      \"trigger_fired\": %s", cp->trigger_fired ? "true" : "false");
-        if (cp->context[0]) {
-            printf(",\n      \"context\": \"%s\"", cp->context);
+void rune_export_checkpoints_json(const rune_context_t* cctx) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    printf("  \"checkpoints_spilled\": %zu,\n", ctx->checkpoint_spilled);
+    printf("  \"checkpoints_dropped\": %lu,\n", __atomic_load_n(&ctx->checkpoint_dropped, __ATOMIC_RELAXED));
+    printf("  \"checkpoints\": [");
+    rune_checkpoint_cursor_t cursor = { .ctx = ctx };
+    int first = 1;
+    for (size_t i = 0; i < ctx->checkpoint_count; i++) {
+        const rune_checkpoint_record_t* record = rune_checkpoint_fetch(&cursor, i);
+        if (!record) {
+            continue;
+        }
+        rune_checkpoint_t cp;
+        rune_checkpoint_format(ctx, record, &cp);
+        printf("%s\n    {\n", first ? "" : ",");
+        printf("      \"id\": \"%s\",\n", cp.id);
+        printf("      \"timestamp\": \"%s\",\n", cp.timestamp);
+        printf("      \"category\": \"%s\",\n", cp.category);
+        printf("      \"time_offset\": %.6f,\n", cp.time_offset);
+        printf("      \"trigger_fired\": %s", cp.trigger_fired ? "true" : "false");
+        if (cp.context[0]) {
+            printf(",\n      \"context\": \"%s\"", cp.context);
         }
-        printf("\n    }%s\n", (i < g_checkpoint_count - 1) ? "," : "");
+        printf("\n    }");
+        first = 0;
     }
-    printf("  ],\n");
+    printf("\n  ],\n");
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
 }
 
+// Stream raw records in time order, without formatting them
+int rune_checkpoint_foreach(const rune_context_t* cctx,
+                            int (*visit)(const rune_checkpoint_record_t* record, void* arg), void* arg) {
+    rune_context_t* ctx = rune_checkpoint_collect(cctx);
+    rune_checkpoint_cursor_t* cursor = malloc(sizeof(*cursor));
+    int result = cursor ? 0 : -1;
+    if (cursor) {
+        cursor->ctx = ctx;
+        cursor->buffered_from = 0;
+        cursor->buffered = 0;
+    }
+    for (size_t i = 0; cursor && i < ctx->checkpoint_count && result == 0; i++) {
+        const rune_checkpoint_record_t* record = rune_checkpoint_fetch(cursor, i);
+        if (record) {
+            result = visit(record, arg);
+        }
+    }
+    pthread_mutex_unlock(&ctx->checkpoint_lock);
+    free(cursor);
+    return result;
+}
+
+// Trie node over the literal heads of trigger patterns
+typedef struct rune_trigger_node {
+    uint32_t first_child;       // 0 = none (the root is never a child)
+    uint32_t next_sibling;
+    int first_trigger;          // Triggers whose literal head ends here (-1 = none)
+    int last_trigger;
+    char c;
+} rune_trigger_node_t;
+
 // Initialize trigger system
-void rune_trigger_init(void) {
-    g_trigger_count = 0;
-    memset(g_triggers, 0, sizeof(g_triggers));
+void rune_trigger_init(rune_context_t* ctx) {
+    rune_trigger_cleanup(ctx);
+}
+
+// Cleanup trigger system (storage and the pool are kept for the next registrations)
+void rune_trigger_cleanup(rune_context_t* ctx) {
+    rune_dispatch_flush(ctx->trigger_pool);
+    ctx->trigger_count = 0;
+    ctx->trigger_node_count = 0;
+}
+
+// Release trigger storage (context teardown)
+static void rune_trigger_free(rune_context_t* ctx) {
+    rune_dispatch_destroy(ctx->trigger_pool);
+    ctx->trigger_pool = NULL;
+    free(ctx->triggers);
+    free(ctx->trigger_nodes);
+    ctx->triggers = NULL;
+    ctx->trigger_nodes = NULL;
+    ctx->trigger_count = ctx->trigger_capacity = 0;
+    ctx->trigger_node_count = ctx->trigger_node_capacity = 0;
+}
+
+static int rune_trigger_new_node(rune_context_t* ctx, char c, uint32_t* index) {
+    if (ctx->trigger_node_count == ctx->trigger_node_capacity) {
+        uint32_t capacity = ctx->trigger_node_capacity ? ctx->trigger_node_capacity * 2 : 64;
+        rune_trigger_node_t* nodes = realloc(ctx->trigger_nodes, capacity * sizeof(*nodes));
+        if (!nodes) {
+            return -1;
+        }
+        ctx->trigger_nodes = nodes;
+        ctx->trigger_node_capacity = capacity;
+    }
+    *index = ctx->trigger_node_count++;
+    ctx->trigger_nodes[*index] = (rune_trigger_node_t){ .first_trigger = -1, .last_trigger = -1, .c = c };
+    return 0;
+}
+
+static uint32_t rune_trigger_child(const rune_context_t* ctx, uint32_t node, char c) {
+    uint32_t child = ctx->trigger_nodes[node].first_child;
+    while (child && ctx->trigger_nodes[child].c != c) {
+        child = ctx->trigger_nodes[child].next_sibling;
+    }
+    return child;
 }
 
-// Cleanup trigger system
-void rune_trigger_cleanup(void) {
-    g_trigger_count = 0;
+// Node for the first len bytes of text, created as needed
+static int rune_trigger_insert_path(rune_context_t* ctx, const char* text, size_t len, uint32_t* node) {
+    uint32_t current = 0;
+    if (ctx->trigger_node_count == 0 && rune_trigger_new_node(ctx, '\0', &current) != 0) {
+        return -1;
+    }
+    for (size_t i = 0; i < len; i++) {
+        uint32_t child = rune_trigger_child(ctx, current, text[i]);
+        if (!child) {
+            if (rune_trigger_new_node(ctx, text[i], &child) != 0) {
+                return -1;
+            }
+            ctx->trigger_nodes[child].next_sibling = ctx->trigger_nodes[current].first_child;
+            ctx->trigger_nodes[current].first_child = child;
+        }
+        current = child;
+    }
+    *node = current;
+    return 0;
 }
 
 // Register a new trigger
-int rune_register_trigger(const char* pattern, const char* name, void (*callback)(const rune_checkpoint_t *)) {
-    if (g_trigger_count >= 64 || !pattern || !name || !callback) {
+int rune_register_trigger(rune_context_t* ctx, const char* pattern, const char* name, void (*callback)(const rune_checkpoint_t *)) {
+    return rune_register_category_trigger(ctx, NULL, pattern, name, callback);
+}
+
+// Register a trigger limited to some checkpoint categories
+int rune_register_category_trigger(rune_context_t* ctx, const char* categories, const char* pattern,
+                                   const char* name, void (*callback)(const rune_checkpoint_t *)) {
+    if (!pattern || !name || !callback) {
         return -1;
     }
-    
-    rune_trigger_t* trigger = &g_triggers[g_trigger_count++];
+    if (ctx->trigger_count == ctx->trigger_capacity) {
+        int capacity = ctx->trigger_capacity ? ctx->trigger_capacity * 2 : 16;
+        rune_trigger_t* triggers = realloc(ctx->triggers, (size_t)capacity * sizeof(*triggers));
+        if (!triggers) {
+            return -1;
+        }
+        ctx->triggers = triggers;
+        ctx->trigger_capacity = capacity;
+    }
+
+    rune_trigger_t* trigger = &ctx->triggers[ctx->trigger_count];
+    memset(trigger, 0, sizeof(*trigger));
     strncpy(trigger->pattern, pattern, sizeof(trigger->pattern) - 1);
-    trigger->pattern[sizeof(trigger->pattern) - 1] = '\0';
-    
     strncpy(trigger->name, name, sizeof(trigger->name) - 1);
-    trigger->name[sizeof(trigger->name) - 1] = '\0';
-    
     trigger->callback = callback;
     trigger->enabled = 1;
+    trigger->next = -1;
+
+    if (categories) {
+        char list[256];
+        char* saveptr = NULL;
+        int count = 0;
+        snprintf(list, sizeof(list), "%s", categories);
+        for (char* category = strtok_r(list, ", ", &saveptr); category; category = strtok_r(NULL, ", ", &saveptr)) {
+            if (count == RUNE_TRIGGER_MAX_CATEGORIES) {
+                return -1;
+            }
+            trigger->categories[count++] = rune_intern(category);
+        }
+    }
+
+    // Index the literal head; globbing only starts at the first special character
+    size_t literal = strcspn(trigger->pattern, "*?[\\");
+    uint32_t node;
+    if (rune_trigger_insert_path(ctx, trigger->pattern, literal, &node) != 0) {
+        return -1;
+    }
+    if (ctx->trigger_nodes[node].last_trigger >= 0) {
+        ctx->triggers[ctx->trigger_nodes[node].last_trigger].next = ctx->trigger_count;
+    } else {
+        ctx->trigger_nodes[node].first_trigger = ctx->trigger_count;
+    }
+    ctx->trigger_nodes[node].last_trigger = ctx->trigger_count;
+    ctx->trigger_count++;
     
     return 0;
 }
 
 // Enable a trigger by name
-void rune_enable_trigger(const char* name) {
-    for (int i = 0; i < g_trigger_count; i++) {
-        if (strcmp(g_triggers[i].name, name) == 0) {
-            g_triggers[i].enabled = 1;
+void rune_enable_trigger(rune_context_t* ctx, const char* name) {
+    for (int i = 0; i < ctx->trigger_count; i++) {
+        if (strcmp(ctx->triggers[i].name, name) == 0) {
+            ctx->triggers[i].enabled = 1;
             break;
         }
     }
 }
 
 // Disable a trigger by name
-void rune_disable_trigger(const char* name) {
-    for (int i = 0; i < g_trigger_count; i++) {
-        if (strcmp(g_triggers[i].name, name) == 0) {
-            g_triggers[i].enabled = 0;
+void rune_disable_trigger(rune_context_t* ctx, const char* name) {
+    for (int i = 0; i < ctx->trigger_count; i++) {
+        if (strcmp(ctx->triggers[i].name, name) == 0) {
+            ctx->triggers[i].enabled = 0;
             break;
         }
     }
 }
 
-// Simple pattern matching for triggers
-static int rune_pattern_match(const char* pattern, const char* text) {
-    // Simple wildcard matching: "*" matches anything
-    if (strcmp(pattern, "*") == 0) {
+// Run a trigger asynchronously or not; NULL name = every trigger
+int rune_set_trigger_async(rune_context_t* ctx, const char* name, int async) {
+    if (async && !ctx->trigger_pool) {
+        int workers = ctx->config.trigger_workers > 0 ? ctx->config.trigger_workers : RUNE_DISPATCH_WORKERS;
+        ctx->trigger_pool = rune_dispatch_create(ctx, workers, (rune_trigger_overflow_t)ctx->config.trigger_overflow);
+        if (!ctx->trigger_pool) {
+            return -1;
+        }
+    }
+    for (int i = 0; i < ctx->trigger_count; i++) {
+        if (!name || strcmp(ctx->triggers[i].name, name) == 0) {
+            ctx->triggers[i].async = async;
+        }
+    }
+    return 0;
+}
+
+// Wait for queued async triggers, so their statistics are complete
+void rune_trigger_flush(rune_context_t* ctx) {
+    rune_dispatch_flush(ctx->trigger_pool);
+}
+
+static int rune_trigger_category_match(const rune_trigger_t* trigger, uint32_t category) {
+    if (!trigger->categories[0]) {
         return 1;
     }
-    
-    // If pattern ends with "*", match prefix
-    size_t pattern_len = strlen(pattern);
-    if (pattern_len > 0 && pattern[pattern_len - 1] == '*') {
-        return strncmp(pattern, text, pattern_len - 1) == 0;
+    for (int i = 0; i < RUNE_TRIGGER_MAX_CATEGORIES && trigger->categories[i]; i++) {
+        if (trigger->categories[i] == category) {
+            return 1;
+        }
     }
-    
-    // Exact match
-    return strcmp(pattern, text) == 0;
+    return 0;
 }
 
-// Process triggers for a checkpoint
-void rune_process_checkpoint_triggers(const rune_checkpoint_t* checkpoint) {
-    for (int i = 0; i < g_trigger_count; i++) {
-        rune_trigger_t* trigger = &g_triggers[i];
-        
-        if (!trigger->enabled) {
-            continue;
+// Walk the trie along id: only triggers whose literal head is a prefix
+// of id are looked at, however many are registered. With a record,
+// async triggers are queued and the view is built for the first
+// synchronous match.
+static int rune_trigger_dispatch(rune_context_t* ctx, const char* id, uint32_t category,
+                                 const rune_checkpoint_record_t* record, rune_checkpoint_t* view) {
+    if (ctx->trigger_node_count == 0) {
+        return 0;
+    }
+
+    int matches = 0;
+    int formatted = record == NULL;
+    uint32_t node = 0;
+    for (size_t depth = 0;; depth++) {
+        for (int t = ctx->trigger_nodes[node].first_trigger; t >= 0; t = ctx->triggers[t].next) {
+            const rune_trigger_t* trigger = &ctx->triggers[t];
+            if (!trigger->enabled || !rune_trigger_category_match(trigger, category) ||
+                fnmatch(trigger->pattern + depth, id + depth, 0) != 0) {
+                continue;
+            }
+            matches++;
+            if (record && trigger->async && ctx->trigger_pool) {
+                rune_dispatch_submit(ctx->trigger_pool, t, record);
+                continue;
+            }
+            if (!formatted) {
+                rune_checkpoint_format(ctx, record, view);
+                formatted = 1;
+            }
+            view->trigger_fired = 1;
+            uint64_t start = rune_clock_ns(CLOCK_MONOTONIC);
+            trigger->callback(view);
+            uint64_t run_ns = rune_clock_ns(CLOCK_MONOTONIC) - start;
+            rune_trigger_account(&ctx->triggers[t], run_ns, run_ns);
         }
-        
-        if (rune_pattern_match(trigger->pattern, checkpoint->id)) {
-            // Mark that this checkpoint fired a trigger
-            ((rune_checkpoint_t*)checkpoint)->trigger_fired = 1;
-            
-            // Call the trigger callback
-            trigger->callback(checkpoint);
+        if (!id[depth] || !(node = rune_trigger_child(ctx, node, id[depth]))) {
+            break;
         }
     }
+    return matches;
+}
+
+// Process triggers for a checkpoint
+void rune_process_checkpoint_triggers(rune_context_t* ctx, rune_checkpoint_t* checkpoint) {
+    rune_trigger_dispatch(ctx, checkpoint->id, rune_intern(checkpoint->category), NULL, checkpoint);
 }
@@ -6,34 +6,80 @@
  *
  * Revolutionary checkpoint-based execution analysis system
  * Foundation for the framework's timeline analysis capabilities
+ *
+ * Logging a checkpoint is cheap enough for hot loops and safe from any
+ * thread: it stores a 24-byte record (raw CLOCK_MONOTONIC time and
+ * interned strings, built-in categories as rune_checkpoint_category_t)
+ * into the calling thread's ring for the context,
+ * without locks. Timestamps and strings are only formatted when the
+ * timeline is read.
+ *
+ * Storage grows in chunks without a count limit. Past the memory cap
+ * (--checkpoint-memory) the oldest chunks move to an unlinked segment
+ * file of raw records; the printer, the exporter and the accessors read
+ * both transparently. Records are only dropped when neither memory nor
+ * disk is left, and then counted.
  */
 
 #ifndef RUNE_CHECKPOINT_H
 #define RUNE_CHECKPOINT_H
 
 #include "rune_types.h"
+#include "rune_context.h"
+#include "rune_span.h"
 
 // Checkpoint management functions
-void rune_checkpoint_init(void);
-void rune_checkpoint_cleanup(void);
+void rune_checkpoint_init(rune_context_t* ctx);
+void rune_checkpoint_cleanup(rune_context_t* ctx);
+void rune_checkpoint_discard(rune_context_t* ctx);      // Forget recorded checkpoints
+void rune_checkpoint_free(rune_context_t* ctx);         // Context teardown only
 
-// Core checkpoint logging
+// Core checkpoint logging (into the calling thread's current context)
 void rune_log_checkpoint(const char* id, const char* category, const char* context);
+// Same with a built-in category: nothing to intern for it
+void rune_log_checkpoint_category(const char* id, rune_checkpoint_category_t category, const char* context);
 void rune_log_checkpoint_with_time(const char* id, const char* category, const char* context, double time_offset);
+// Into ctx with an absolute CLOCK_MONOTONIC time; triggers fire as for our own checkpoints.
+// flags: RUNE_CHECKPOINT_TARGET with the target's tid in the thread bits, or 0.
+void rune_checkpoint_ingest(rune_context_t* ctx, uint64_t time_ns, const char* id, const char* category,
+                            const char* context, uint32_t flags);
 
 // Checkpoint analysis and retrieval
-int rune_get_checkpoint_count(void);
-const rune_checkpoint_t* rune_get_checkpoint(int index);
-void rune_print_checkpoint_timeline(void);
-void rune_export_checkpoints_json(void);
+int rune_get_checkpoint_count(const rune_context_t* ctx);
+const rune_checkpoint_t* rune_get_checkpoint(const rune_context_t* ctx, int index);  // Valid until the thread's next call
+void rune_print_checkpoint_timeline(const rune_context_t* ctx);
+void rune_export_checkpoints_json(const rune_context_t* ctx);
+void rune_checkpoint_format(const rune_context_t* ctx, const rune_checkpoint_record_t* record,
+                            rune_checkpoint_t* view);
+// Visit every record in time order, spilled ones included, until visit returns nonzero;
+// returns that value (-1 if out of memory). Loggers only wait if their ring fills meanwhile.
+int rune_checkpoint_foreach(const rune_context_t* ctx,
+                            int (*visit)(const rune_checkpoint_record_t* record, void* arg), void* arg);
+
+// Where the timeline lives and what it lost
+typedef struct rune_checkpoint_stats {
+    size_t recorded;            // Kept, in memory or on disk
+    size_t spilled;             // Of those, in the segment file
+    size_t memory_bytes;        // Chunks allocated for the rest
+    unsigned long dropped;      // Lost: no memory and no disk left
+} rune_checkpoint_stats_t;
+
+void rune_get_checkpoint_stats(const rune_context_t* ctx, rune_checkpoint_stats_t* stats);
 
 // Trigger system - event-driven analysis
-void rune_trigger_init(void);
-void rune_trigger_cleanup(void);
-int rune_register_trigger(const char* pattern, const char* name, void (*callback)(const rune_checkpoint_t *));
-void rune_enable_trigger(const char* name);
-void rune_disable_trigger(const char* name);
-void rune_process_checkpoint_triggers(const rune_checkpoint_t* checkpoint);
+void rune_trigger_init(rune_context_t* ctx);
+void rune_trigger_cleanup(rune_context_t* ctx);
+// Patterns are full globs (*, ?, [a-z], [!x]); no limit on the number of triggers
+int rune_register_trigger(rune_context_t* ctx, const char* pattern, const char* name, void (*callback)(const rune_checkpoint_t *));
+// categories: comma separated list (e.g. "SEC,SYSCALL"), at most RUNE_TRIGGER_MAX_CATEGORIES; NULL = any
+int rune_register_category_trigger(rune_context_t* ctx, const char* categories, const char* pattern,
+                                   const char* name, void (*callback)(const rune_checkpoint_t *));
+void rune_enable_trigger(rune_context_t* ctx, const char* name);
+void rune_disable_trigger(rune_context_t* ctx, const char* name);
+// Async triggers run on a worker pool (see rune_dispatch.h); NULL name = every trigger
+int rune_set_trigger_async(rune_context_t* ctx, const char* name, int async);
+void rune_trigger_flush(rune_context_t* ctx);   // Wait until queued async triggers have run
+void rune_process_checkpoint_triggers(rune_context_t* ctx, rune_checkpoint_t* checkpoint);
 
 // Built-in checkpoint categories
 #define RUNE_CHECKPOINT_LOAD     "LOAD"
@@ -44,12 +90,23 @@ void rune_process_checkpoint_triggers(const rune_checkpoint_t* checkpoint);
 #define RUNE_CHECKPOINT_SEC      "SEC"
 #define RUNE_CHECKPOINT_PERF     "PERF"
 #define RUNE_CHECKPOINT_EXIT     "EXIT"
+#define RUNE_CHECKPOINT_MISC     "MISC"
+
+// Name of a category handle, built-in or not
+const char* rune_checkpoint_category_name(uint32_t category);
 
 // Convenience macros for checkpoint logging
-#define RUNE_LOG_FUNC_START(name) rune_log_checkpoint("FUNC: " name " started", RUNE_CHECKPOINT_FUNC, NULL)
-#define RUNE_LOG_FUNC_END(name) rune_log_checkpoint("FUNC: " name " completed", RUNE_CHECKPOINT_FUNC, NULL)
-#define RUNE_LOG_SYSCALL(name) rune_log_checkpoint("SYSCALL: " name, RUNE_CHECKPOINT_SYSCALL, NULL)
-#define RUNE_LOG_MEMORY(action) rune_log_checkpoint("MEM: " action, RUNE_CHECKPOINT_MEM, NULL)
-#define RUNE_LOG_SECURITY(issue) rune_log_checkpoint("SEC: " issue, RUNE_CHECKPOINT_SEC, NULL)
+// FUNC_START/END also open and close a span (rune_span.h)
+#define RUNE_LOG_FUNC_START(name) do { \
+        rune_span_begin(name); \
+        rune_log_checkpoint_category("FUNC: " name " started", RUNE_CATEGORY_FUNC, NULL); \
+    } while (0)
+#define RUNE_LOG_FUNC_END(name) do { \
+        rune_log_checkpoint_category("FUNC: " name " completed", RUNE_CATEGORY_FUNC, NULL); \
+        rune_span_end(name); \
+    } while (0)
+#define RUNE_LOG_SYSCALL(name) rune_log_checkpoint_category("SYSCALL: " name, RUNE_CATEGORY_SYSCALL, NULL)
+#define RUNE_LOG_MEMORY(action) rune_log_checkpoint_category("MEM: " action, RUNE_CATEGORY_MEM, NULL)
+#define RUNE_LOG_SECURITY(issue) rune_log_checkpoint_category("SEC: " issue, RUNE_CATEGORY_SEC, NULL)
 
 #endif /* RUNE_CHECKPOINT_H */
@@ -6,30 +6,31 @@
  */
 
 #include "rune_analyze.h"
+#include "rune_launch.h"
 
 // Initialize configuration with defaults
-int rune_config_init(void) {
-    memset(&g_config, 0, sizeof(g_config));
+int rune_config_init(rune_context_t* ctx) {
+    memset(&ctx->config, 0, sizeof(ctx->config));
     
     // Set defaults
-    g_config.verbose_mode = 1;          // Normal verbosity
-    g_config.output_format = 0;         // Human readable
-    g_config.enable_security = 1;       // Enable by default
-    g_config.enable_memory = 1;         // Enable by default
-    g_config.enable_performance = 1;    // Enable by default
-    g_config.enable_deep_analysis = 0;  // Disabled by default
+    ctx->config.verbose_mode = 1;          // Normal verbosity
+    ctx->config.output_format = 0;         // Human readable
+    ctx->config.enable_security = 1;       // Enable by default
+    ctx->config.enable_memory = 1;         // Enable by default
+    ctx->config.enable_performance = 1;    // Enable by default
+    ctx->config.enable_deep_analysis = 0;  // Disabled by default
     
     // 🌟 Master Orchestration Modes (initialized to disabled)
-    g_config.master_deep_install = 0;
-    g_config.master_security_scan = 0;
-    g_config.master_smart_monitor = 0;
-    g_config.master_threat_analyze = 0;
+    ctx->config.master_deep_install = 0;
+    ctx->config.master_security_scan = 0;
+    ctx->config.master_smart_monitor = 0;
+    ctx->config.master_threat_analyze = 0;
     
     return 0;
 }
 
 // Parse command line arguments
-int rune_config_parse_args(int argc, char **argv) {
+int rune_config_parse_args(rune_context_t* ctx, int argc, char **argv) {
     if (argc < 2) {
         rune_print_usage(argv[0]);
         return -1;
@@ -38,31 +39,30 @@ int rune_config_parse_args(int argc, char **argv) {
     int i;
     for (i = 1; i < argc; i++) {
         if (strcmp(argv[i], "-h") == 0 || strcmp(argv[i], "--help") == 0) {
-            rune_print_usage(argv[0]);
-            exit(0);
+            return RUNE_CONFIG_HELP;
         }
         else if (strcmp(argv[i], "-v") == 0 || strcmp(argv[i], "--verbose") == 0) {
-            g_config.verbose_mode = 2;
+            ctx->config.verbose_mode = 2;
         }
         else if (strcmp(argv[i], "-vv") == 0 || strcmp(argv[i], "--very-verbose") == 0) {
-            g_config.verbose_mode = 3;
-            g_config.enable_deep_analysis = 1;
+            ctx->config.verbose_mode = 3;
+            ctx->config.enable_deep_analysis = 1;
         }
         else if (strcmp(argv[i], "-q") == 0 || strcmp(argv[i], "--quiet") == 0) {
-            g_config.verbose_mode = 0;
+            ctx->config.verbose_mode = 0;
         }
         else if (strcmp(argv[i], "--json") == 0) {
-            g_config.output_format = 1;
+            ctx->config.output_format = 1;
         }
         else if (strcmp(argv[i], "--both") == 0) {
-            g_config.output_format = 2;
+            ctx->config.output_format = 2;
         }
         else if (strcmp(argv[i], "--monitor") == 0) {
             // Classic Unix way: --monitor "command"
             if (i + 1 < argc) {
                 // Store the entire command to monitor
-                RUNE_SAFE_STRNCPY(g_config.target_executable, argv[i+1], sizeof(g_config.target_executable));
-                g_config.enable_monitoring = 1;
+                RUNE_SAFE_STRNCPY(ctx->config.target_executable, argv[i+1], sizeof(ctx->config.target_executable));
+                ctx->config.enable_monitoring = 1;
                 i++;
             } else {
                 rune_log(0, "Error: --monitor requires a command to monitor\n");
@@ -72,10 +72,10 @@ int rune_config_parse_args(int argc, char **argv) {
         // 🛡️ SAFE ANALYSIS COMMANDS (New - No Execution)
         else if (strcmp(argv[i], "--safe-analyze") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.master_target_package, argv[i+1], sizeof(g_config.master_target_package));
-                g_config.master_safe_analyze = 1;
-                g_config.safe_mode = 1;  // Explicitly safe
-                g_config.enable_security = 1;    // Enable security analysis
+                RUNE_SAFE_STRNCPY(ctx->config.master_target_package, argv[i+1], sizeof(ctx->config.master_target_package));
+                ctx->config.master_safe_analyze = 1;
+                ctx->config.safe_mode = 1;  // Explicitly safe
+                ctx->config.enable_security = 1;    // Enable security analysis
                 i++;
             } else {
                 rune_log(0, "Error: --safe-analyze requires a package path\n");
@@ -84,11 +84,11 @@ int rune_config_parse_args(int argc, char **argv) {
         }
         else if (strcmp(argv[i], "--safe-threats") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.master_target_package, argv[i+1], sizeof(g_config.master_target_package));
-                g_config.master_safe_threats = 1;
-                g_config.safe_mode = 1;  // Explicitly safe
-                g_config.enable_security = 1;
-                g_config.enable_deep_analysis = 1;
+                RUNE_SAFE_STRNCPY(ctx->config.master_target_package, argv[i+1], sizeof(ctx->config.master_target_package));
+                ctx->config.master_safe_threats = 1;
+                ctx->config.safe_mode = 1;  // Explicitly safe
+                ctx->config.enable_security = 1;
+                ctx->config.enable_deep_analysis = 1;
                 i++;
             } else {
                 rune_log(0, "Error: --safe-threats requires a package path\n");
@@ -98,11 +98,11 @@ int rune_config_parse_args(int argc, char **argv) {
         // 🌟 Master Orchestration Commands (THE VISION!) - Now require -f flag
         else if (strcmp(argv[i], "--deep-install") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.master_target_package, argv[i+1], sizeof(g_config.master_target_package));
-                g_config.master_deep_install = 1;
-                g_config.enable_security = 1;    // Force enable security for master mode
-                g_config.enable_performance = 1; // Force enable performance
-                g_config.enable_deep_analysis = 1; // Force enable deep analysis
+                RUNE_SAFE_STRNCPY(ctx->config.master_target_package, argv[i+1], sizeof(ctx->config.master_target_package));
+                ctx->config.master_deep_install = 1;
+                ctx->config.enable_security = 1;    // Force enable security for master mode
+                ctx->config.enable_performance = 1; // Force enable performance
+                ctx->config.enable_deep_analysis = 1; // Force enable deep analysis
                 i++;
             } else {
                 rune_log(0, "Error: --deep-install requires a .deb package path\n");
@@ -111,10 +111,10 @@ int rune_config_parse_args(int argc, char **argv) {
         }
         else if (strcmp(argv[i], "--security-scan") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.master_target_package, argv[i+1], sizeof(g_config.master_target_package));
-                g_config.master_security_scan = 1;
-                g_config.enable_security = 1;    // Force enable security analysis
-                g_config.safe_mode = 1;          // Security scan is inherently safe
+                RUNE_SAFE_STRNCPY(ctx->config.master_target_package, argv[i+1], sizeof(ctx->config.master_target_package));
+                ctx->config.master_security_scan = 1;
+                ctx->config.enable_security = 1;    // Force enable security analysis
+                ctx->config.safe_mode = 1;          // Security scan is inherently safe
                 i++;
             } else {
                 rune_log(0, "Error: --security-scan requires a .deb package path\n");
@@ -123,10 +123,10 @@ int rune_config_parse_args(int argc, char **argv) {
         }
         else if (strcmp(argv[i], "--smart-monitor") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.target_executable, argv[i+1], sizeof(g_config.target_executable));
-                g_config.master_smart_monitor = 1;
-                g_config.enable_monitoring = 1;   // Enable monitoring
-                g_config.enable_security = 1;     // Enable real-time security detection
+                RUNE_SAFE_STRNCPY(ctx->config.target_executable, argv[i+1], sizeof(ctx->config.target_executable));
+                ctx->config.master_smart_monitor = 1;
+                ctx->config.enable_monitoring = 1;   // Enable monitoring
+                ctx->config.enable_security = 1;     // Enable real-time security detection
                 i++;
             } else {
                 rune_log(0, "Error: --smart-monitor requires a command to monitor\n");
@@ -135,12 +135,12 @@ int rune_config_parse_args(int argc, char **argv) {
         }
         else if (strcmp(argv[i], "--threat-analyze") == 0) {
             if (i + 1 < argc) {
-                RUNE_SAFE_STRNCPY(g_config.master_target_package, argv[i+1], sizeof(g_config.master_target_package));
-                g_config.master_threat_analyze = 1;
-                g_config.enable_security = 1;     // Force enable all security features
-                g_config.enable_deep_analysis = 1;
-                g_config.enable_network_analysis = 1;
-                g_config.safe_mode = 1;           // Threat analysis is safe (no execution)
+                RUNE_SAFE_STRNCPY(ctx->config.master_target_package, argv[i+1], sizeof(ctx->config.master_target_package));
+                ctx->config.master_threat_analyze = 1;
+                ctx->config.enable_security = 1;     // Force enable all security features
+                ctx->config.enable_deep_analysis = 1;
+                ctx->config.enable_network_analysis = 1;
+                ctx->config.safe_mode = 1;           // Threat analysis is safe (no execution)
                 i++;
             } else {
                 rune_log(0, "Error: --threat-analyze requires a .deb package path\n");
@@ -149,49 +149,203 @@ int rune_config_parse_args(int argc, char **argv) {
         }
         // 🛡️ FORCE AND CONTROL OPTIONS
         else if (strcmp(argv[i], "-f") == 0 || strcmp(argv[i], "--force") == 0) {
-            g_config.force_execution = 1;
-            g_config.safe_mode = 0;  // Explicit override of safe mode
+            ctx->config.force_execution = 1;
+            ctx->config.safe_mode = 0;  // Explicit override of safe mode
         }
         else if (strcmp(argv[i], "--dry-run") == 0) {
-            g_config.dry_run_mode = 1;
-            g_config.safe_mode = 1;  // Dry run is inherently safe
+            ctx->config.dry_run_mode = 1;
+            ctx->config.safe_mode = 1;  // Dry run is inherently safe
+        }
+        // ⚙️ KERNEL ACCOUNTING OPTIONS
+        else if (strcmp(argv[i], "--cgroup") == 0) {
+            ctx->config.enable_cgroup = 1;
+        }
+        else if (strcmp(argv[i], "--cgroup-parent") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.cgroup_parent, argv[i+1], sizeof(ctx->config.cgroup_parent));
+                ctx->config.enable_cgroup = 1;
+                i++;
+            } else {
+                rune_log(0, "Error: --cgroup-parent requires a cgroup v2 directory\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--perf") == 0) {
+            ctx->config.enable_perf = 1;
+        }
+        else if (strcmp(argv[i], "--probe") == 0) {
+            ctx->config.enable_probe = 1;
+        }
+        else if (strcmp(argv[i], "--probe-lib") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.probe_library, argv[i+1], sizeof(ctx->config.probe_library));
+                ctx->config.enable_probe = 1;
+                i++;
+            } else {
+                rune_log(0, "Error: --probe-lib requires a shared library\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--zero-copy") == 0) {
+            ctx->config.zero_copy_capture = 1;
+        }
+        else if (strcmp(argv[i], "--timeout") == 0) {
+            if (i + 1 < argc && atof(argv[i+1]) > 0) {
+                ctx->config.timeout_seconds = atof(argv[i+1]);
+                i++;
+            } else {
+                rune_log(0, "Error: --timeout requires a positive number of seconds\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--sample-rate") == 0) {
+            int rate = i + 1 < argc ? atoi(argv[i+1]) : 0;
+            if (rate < 1 || rate > RUNE_TIMELINE_MAX_RATE_HZ) {
+                rune_log(0, "Error: --sample-rate requires 1-%d Hz\n", RUNE_TIMELINE_MAX_RATE_HZ);
+                return -1;
+            }
+            ctx->config.sample_rate_hz = rate;
+            i++;
+        }
+        else if (strcmp(argv[i], "--async-log") == 0) {
+            ctx->config.async_log = 1;
+        }
+        else if (strcmp(argv[i], "--async-triggers") == 0) {
+            ctx->config.async_triggers = 1;
+        }
+        else if (strcmp(argv[i], "--trigger-workers") == 0) {
+            int workers = i + 1 < argc ? atoi(argv[i+1]) : 0;
+            if (workers < 1 || workers > RUNE_DISPATCH_MAX_WORKERS) {
+                rune_log(0, "Error: --trigger-workers requires 1-%d workers\n", RUNE_DISPATCH_MAX_WORKERS);
+                return -1;
+            }
+            ctx->config.trigger_workers = workers;
+            i++;
+        }
+        else if (strcmp(argv[i], "--trigger-overflow") == 0) {
+            const char* policy = i + 1 < argc ? argv[i+1] : "";
+            if (strcmp(policy, "drop") == 0) {
+                ctx->config.trigger_overflow = RUNE_TRIGGER_OVERFLOW_DROP;
+            } else if (strcmp(policy, "block") == 0) {
+                ctx->config.trigger_overflow = RUNE_TRIGGER_OVERFLOW_BLOCK;
+            } else if (strcmp(policy, "coalesce") == 0) {
+                ctx->config.trigger_overflow = RUNE_TRIGGER_OVERFLOW_COALESCE;
+            } else {
+                rune_log(0, "Error: --trigger-overflow requires drop, block or coalesce\n");
+                return -1;
+            }
+            i++;
+        }
+        else if (strcmp(argv[i], "--checkpoint-memory") == 0) {
+            int mb = i + 1 < argc ? atoi(argv[i+1]) : 0;
+            if (mb < 1 || mb > 65536) {
+                rune_log(0, "Error: --checkpoint-memory requires 1-65536 MB\n");
+                return -1;
+            }
+            ctx->config.checkpoint_memory_mb = mb;
+            i++;
+        }
+        else if (strcmp(argv[i], "--timeline") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.timeline_path, argv[i+1], sizeof(ctx->config.timeline_path));
+                i++;
+            } else {
+                rune_log(0, "Error: --timeline requires an output file\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--flamegraph") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.flamegraph_path, argv[i+1], sizeof(ctx->config.flamegraph_path));
+                i++;
+            } else {
+                rune_log(0, "Error: --flamegraph requires an output file\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--trace") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.trace_path, argv[i+1], sizeof(ctx->config.trace_path));
+                i++;
+            } else {
+                rune_log(0, "Error: --trace requires an output file\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--launcher") == 0) {
+            int method = i + 1 < argc ? rune_launch_method_from_name(argv[i+1]) : -1;
+            if (method < 0) {
+                rune_log(0, "Error: --launcher requires spawn, vfork or fork\n");
+                return -1;
+            }
+            ctx->config.launch_method = method;
+            i++;
+        }
+        else if (strcmp(argv[i], "--spawn-benchmark") == 0) {
+            ctx->config.spawn_benchmark = 1000;
+            if (i + 1 < argc && atoi(argv[i+1]) > 0) {
+                ctx->config.spawn_benchmark = atoi(argv[i+1]);
+                i++;
+            }
+        }
+        // 📦 BATCH MODE
+        else if (strcmp(argv[i], "--batch") == 0) {
+            if (i + 1 < argc) {
+                RUNE_SAFE_STRNCPY(ctx->config.batch_manifest, argv[i+1], sizeof(ctx->config.batch_manifest));
+                i++;
+            } else {
+                rune_log(0, "Error: --batch requires a manifest file\n");
+                return -1;
+            }
+        }
+        else if (strcmp(argv[i], "--jobs") == 0 || strcmp(argv[i], "-j") == 0) {
+            if (i + 1 < argc && atoi(argv[i+1]) > 0) {
+                ctx->config.batch_jobs = atoi(argv[i+1]);
+                i++;
+            } else {
+                rune_log(0, "Error: --jobs requires a positive worker count\n");
+                return -1;
+            }
         }
         else if (strcmp(argv[i], "--version") == 0) {
-            printf("rune_analyze version %s\n", RUNE_ANALYZE_VERSION);
-            exit(0);
+            return RUNE_CONFIG_VERSION;
         }
         else if (argv[i][0] != '-') {
             // Found the target executable
-            RUNE_SAFE_STRNCPY(g_config.target_executable, argv[i], sizeof(g_config.target_executable));
+            RUNE_SAFE_STRNCPY(ctx->config.target_executable, argv[i], sizeof(ctx->config.target_executable));
             
             // Store remaining arguments
-            g_config.target_argc = argc - i;
-            g_config.target_args = &argv[i];
+            ctx->config.target_argc = argc - i;
+            ctx->config.target_args = &argv[i];
             break;
         }
     }
     
+    rune_log_allow(ctx->config.verbose_mode);
     return 0;
 }
 
 // Validate configuration
-int rune_config_validate(void) {
+int rune_config_validate(const rune_context_t* ctx) {
     // 🛡️ FORCE EXECUTION VALIDATION
     // Check if execution commands are used without -f flag
-    if ((g_config.master_deep_install || g_config.master_smart_monitor || g_config.enable_monitoring) && 
-        !g_config.force_execution && !g_config.dry_run_mode) {
+    int batch_mode = ctx->config.batch_manifest[0] != '\0';
+    if ((ctx->config.master_deep_install || ctx->config.master_smart_monitor || ctx->config.enable_monitoring || batch_mode) && 
+        !ctx->config.force_execution && !ctx->config.dry_run_mode) {
         
         printf("🚨 EXECUTION SAFETY BLOCK:\n");
         printf("═══════════════════════════\n");
         printf("The following commands EXECUTE code on your system:\n");
-        if (g_config.master_deep_install) printf("  • --deep-install (runs actual installation)\n");
-        if (g_config.master_smart_monitor) printf("  • --smart-monitor (executes monitored command)\n");
-        if (g_config.enable_monitoring) printf("  • --monitor (executes monitored command)\n");
+        if (ctx->config.master_deep_install) printf("  • --deep-install (runs actual installation)\n");
+        if (ctx->config.master_smart_monitor) printf("  • --smart-monitor (executes monitored command)\n");
+        if (ctx->config.enable_monitoring) printf("  • --monitor (executes monitored command)\n");
+        if (batch_mode) printf("  • --batch (executes every manifest entry)\n");
         printf("\n🛡️ FOR YOUR SAFETY:\n");
         printf("  Add -f flag to explicitly permit execution:\n");
-        if (g_config.master_deep_install) printf("    ./rune_analyze --deep-install package.deb -f\n");
-        if (g_config.master_smart_monitor) printf("    ./rune_analyze --smart-monitor \"command\" -f\n");
-        if (g_config.enable_monitoring) printf("    ./rune_analyze --monitor \"command\" -f\n");
+        if (ctx->config.master_deep_install) printf("    ./rune_analyze --deep-install package.deb -f\n");
+        if (ctx->config.master_smart_monitor) printf("    ./rune_analyze --smart-monitor \"command\" -f\n");
+        if (ctx->config.enable_monitoring) printf("    ./rune_analyze --monitor \"command\" -f\n");
+        if (batch_mode) printf("    ./rune_analyze --batch manifest.txt -f\n");
         printf("\n✅ OR USE SAFE ALTERNATIVES:\n");
         printf("    ./rune_analyze --safe-analyze package.deb     # Safe static analysis\n");
         printf("    ./rune_analyze --security-scan package.deb    # Safe security scan\n");
@@ -201,19 +355,25 @@ int rune_config_validate(void) {
         return -1;
     }
     
+    // 📦 Batch entries are validated one by one as they run;
+    //    the spawn benchmark only starts /bin/true
+    if (batch_mode || ctx->config.spawn_benchmark) {
+        return 0;
+    }
+    
     // 🌟 Master modes have their own validation logic
-    if (g_config.master_deep_install || g_config.master_security_scan || 
-        g_config.master_threat_analyze || g_config.master_safe_analyze || 
-        g_config.master_safe_threats) {
-        if (strlen(g_config.master_target_package) == 0) {
+    if (ctx->config.master_deep_install || ctx->config.master_security_scan || 
+        ctx->config.master_threat_analyze || ctx->config.master_safe_analyze || 
+        ctx->config.master_safe_threats) {
+        if (strlen(ctx->config.master_target_package) == 0) {
             rune_log_error("No target package specified for master mode\n");
             return -1;
         }
         return 0; // Master modes are valid
     }
     
-    if (g_config.master_smart_monitor) {
-        if (strlen(g_config.target_executable) == 0) {
+    if (ctx->config.master_smart_monitor) {
+        if (strlen(ctx->config.target_executable) == 0) {
             rune_log_error("No target command specified for smart monitor\n");
             return -1;
         }
@@ -221,7 +381,7 @@ int rune_config_validate(void) {
     }
     
     // Standard validation for regular modes
-    if (strlen(g_config.target_executable) == 0) {
+    if (strlen(ctx->config.target_executable) == 0) {
         rune_log_error("No target executable specified\n");
         return -1;
     }
@@ -230,7 +390,7 @@ int rune_config_validate(void) {
 }
 
 // Cleanup configuration
-void rune_config_cleanup(void) {
+void rune_config_cleanup(rune_context_t* ctx) {
     // Currently no dynamic memory to clean up
 }
 
@@ -268,12 +428,13 @@ int rune_is_both_output_enabled(void) {
 }
 
 // JSON output functions
-void rune_output_json_analysis_start(const char* target_executable) {
-    if (!rune_is_json_output_enabled() && !rune_is_both_output_enabled()) return;
+void rune_output_json_analysis_start(const rune_context_t* ctx) {
+    if (ctx->config.output_format != 1 && ctx->config.output_format != 2) return;
+    const char* target_executable = ctx->config.target_executable;
     
     time_t now = time(NULL);
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("\n=== JSON ANALYSIS START ===\n");
     }
     
@@ -283,28 +444,28 @@ void rune_output_json_analysis_start(const char* target_executable) {
     printf("  \"timestamp\": %ld,\n", now);
     printf("  \"target_executable\": \"%s\",\n", target_executable ? target_executable : "null");
     printf("  \"analysis_config\": {\n");
-    printf("    \"verbose_mode\": %d,\n", g_config.verbose_mode);
-    printf("    \"output_format\": %d,\n", g_config.output_format);
-    printf("    \"security_analysis\": %s,\n", g_config.enable_security ? "true" : "false");
-    printf("    \"memory_analysis\": %s,\n", g_config.enable_memory ? "true" : "false");
-    printf("    \"performance_analysis\": %s,\n", g_config.enable_performance ? "true" : "false");
-    printf("    \"deep_analysis\": %s,\n", g_config.enable_deep_analysis ? "true" : "false");
-    printf("    \"network_analysis\": %s\n", g_config.enable_network_analysis ? "true" : "false");
+    printf("    \"verbose_mode\": %d,\n", ctx->config.verbose_mode);
+    printf("    \"output_format\": %d,\n", ctx->config.output_format);
+    printf("    \"security_analysis\": %s,\n", ctx->config.enable_security ? "true" : "false");
+    printf("    \"memory_analysis\": %s,\n", ctx->config.enable_memory ? "true" : "false");
+    printf("    \"performance_analysis\": %s,\n", ctx->config.enable_performance ? "true" : "false");
+    printf("    \"deep_analysis\": %s,\n", ctx->config.enable_deep_analysis ? "true" : "false");
+    printf("    \"network_analysis\": %s\n", ctx->config.enable_network_analysis ? "true" : "false");
     printf("  }\n");
     printf("}\n");
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("=== END JSON ANALYSIS START ===\n\n");
     }
 }
 
-void rune_output_json_analysis_result(const rune_results_t* results, double execution_time) {
-    if (!rune_is_json_output_enabled() && !rune_is_both_output_enabled()) return;
-    if (!results) return;
+void rune_output_json_analysis_result(const rune_context_t* ctx, double execution_time) {
+    const rune_results_t* results = &ctx->results;
+    if (ctx->config.output_format != 1 && ctx->config.output_format != 2) return;
     
     time_t now = time(NULL);
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("\n=== JSON ANALYSIS RESULT ===\n");
     }
     
@@ -312,10 +473,11 @@ void rune_output_json_analysis_result(const rune_results_t* results, double exec
     printf("  \"rune_analyze_version\": \"%s\",\n", RUNE_ANALYZE_VERSION);
     printf("  \"operation\": \"analysis_complete\",\n");
     printf("  \"timestamp\": %ld,\n", now);
-    printf("  \"target_executable\": \"%s\",\n", rune_get_target_executable());
+    printf("  \"target_executable\": \"%s\",\n", ctx->config.target_executable);
     printf("  \"execution_result\": {\n");
     printf("    \"exit_code\": %d,\n", results->exit_code);
     printf("    \"execution_time\": %.6f,\n", results->execution_time);
+    printf("    \"timed_out\": %s,\n", results->timed_out ? "true" : "false");
     printf("    \"child_pid\": %d\n", results->child_pid);
     printf("  },\n");
     printf("  \"memory_analysis\": {\n");
@@ -344,14 +506,30 @@ void rune_output_json_analysis_result(const rune_results_t* results, double exec
     printf("    \"bytes_read\": %ld,\n", results->bytes_read);
     printf("    \"bytes_written\": %ld,\n", results->bytes_written);
     printf("    \"stdout_bytes\": %zu,\n", results->stdout_bytes);
-    printf("    \"stderr_bytes\": %zu\n", results->stderr_bytes);
+    printf("    \"stderr_bytes\": %zu,\n", results->stderr_bytes);
+    printf("    \"zero_copy_capture\": %s,\n", results->capture_zero_copy ? "true" : "false");
+    printf("    \"capture_dropped_bytes\": %llu\n", results->capture_dropped_bytes);
+    printf("  },\n");
+    printf("  \"output_analysis\": {\n");
+    printf("    \"verbose_messages\": %d,\n", results->verbose_messages);
+    printf("    \"error_messages\": %d,\n", results->error_messages);
+    printf("    \"warning_messages\": %d\n", results->warning_messages);
     printf("  },\n");
     printf("  \"performance_analysis\": {\n");
     printf("    \"cpu_usage_percent\": %.2f,\n", results->cpu_usage_percent);
     printf("    \"context_switches\": %ld,\n", results->context_switches);
+    printf("    \"user_time\": %.6f,\n", results->user_time);
+    printf("    \"system_time\": %.6f,\n", results->system_time);
+    printf("    \"minor_faults\": %ld,\n", results->minor_faults);
+    printf("    \"major_faults\": %ld,\n", results->major_faults);
+    printf("    \"voluntary_context_switches\": %ld,\n", results->voluntary_context_switches);
+    printf("    \"involuntary_context_switches\": %ld,\n", results->involuntary_context_switches);
     printf("    \"startup_time\": %.6f,\n", results->startup_time);
     printf("    \"processing_time\": %.6f,\n", results->processing_time);
     printf("    \"cleanup_time\": %.6f,\n", results->cleanup_time);
+    printf("    \"phases_measured\": %s,\n", results->phases_measured ? "true" : "false");
+    printf("    \"phase_signal\": \"%s\",\n", results->phase_signal);
+    printf("    \"timeline_samples\": %d,\n", results->timeline_samples);
     printf("    \"resource_efficiency_score\": %d,\n", results->resource_efficiency_score);
     printf("    \"performance_category\": \"%s\"\n", results->performance_category);
     printf("  },\n");
@@ -363,20 +541,116 @@ void rune_output_json_analysis_result(const rune_results_t* results, double exec
     printf("    \"package_downloads_detected\": %s,\n", results->package_downloads_detected ? "true" : "false");
     printf("    \"network_security_score\": %d,\n", results->network_security_score);
     printf("    \"suspicious_network_activity\": %s\n", results->suspicious_network_activity ? "true" : "false");
-    printf("  }\n");
+    printf("  },\n");
+    printf("  \"cgroup_accounting\": {\n");
+    printf("    \"enabled\": %s,\n", results->cgroup_enabled ? "true" : "false");
+    printf("    \"cpu_usage_usec\": %lld,\n", results->cgroup_cpu_usage_usec);
+    printf("    \"cpu_user_usec\": %lld,\n", results->cgroup_cpu_user_usec);
+    printf("    \"cpu_system_usec\": %lld,\n", results->cgroup_cpu_system_usec);
+    printf("    \"memory_peak_bytes\": %lld,\n", results->cgroup_memory_peak_bytes);
+    printf("    \"io_read_bytes\": %lld,\n", results->cgroup_io_read_bytes);
+    printf("    \"io_write_bytes\": %lld\n", results->cgroup_io_write_bytes);
+    printf("  },\n");
+    printf("  \"process_tree\": {\n");
+    printf("    \"processes\": %d,\n", results->tree_processes);
+    printf("    \"max_concurrent\": %d,\n", results->tree_max_concurrent);
+    printf("    \"cpu_seconds\": %.6f,\n", results->tree_cpu_seconds);
+    printf("    \"peak_rss_kb\": %ld,\n", results->tree_peak_rss_kb);
+    printf("    \"read_bytes\": %llu,\n", results->tree_read_bytes);
+    printf("    \"write_bytes\": %llu,\n", results->tree_write_bytes);
+    printf("    \"orphans_reaped\": %d,\n", results->tree_orphans_reaped);
+    printf("    \"still_running\": %d,\n", results->tree_still_running);
+    printf("    \"top_processes\": [");
+    size_t order[RUNE_PROCTREE_REPORT_ROWS];
+    size_t rows = results->tree_processes > 0
+        ? rune_proctree_top(&ctx->proctree, order, RUNE_PROCTREE_REPORT_ROWS) : 0;
+    for (size_t r = 0; r < rows; r++) {
+        const rune_proc_t *proc = &ctx->proctree.procs[order[r]];
+        printf("%s\n      {\"pid\": %d, \"comm\": \"%s\", \"cpu_seconds\": %.6f, \"peak_rss_kb\": %u, "
+               "\"read_bytes\": %llu, \"write_bytes\": %llu, \"start_seconds\": %.6f, \"end_seconds\": %.6f}",
+               r ? "," : "", (int)proc->pid, proc->comm, proc->cpu_us / 1000000.0, proc->peak_rss_kb,
+               (unsigned long long)proc->own_read_bytes, (unsigned long long)proc->own_write_bytes,
+               proc->start_us / 1000000.0, proc->end_us / 1000000.0);
+    }
+    printf("%s]\n", rows ? "\n    " : "");
+    printf("  },\n");
+    printf("  \"perf_counters\": {\n");
+    printf("    \"enabled\": %s,\n", results->perf_enabled ? "true" : "false");
+    printf("    \"hardware\": %s,\n", results->perf_hardware ? "true" : "false");
+    printf("    \"task_clock_ns\": %lld,\n", results->perf_task_clock_ns);
+    printf("    \"page_faults\": %lld,\n", results->perf_page_faults);
+    printf("    \"context_switches\": %lld,\n", results->perf_context_switches);
+    printf("    \"cpu_migrations\": %lld,\n", results->perf_cpu_migrations);
+    printf("    \"instructions\": %lld,\n", results->perf_instructions);
+    printf("    \"cycles\": %lld,\n", results->perf_cycles);
+    printf("    \"cache_references\": %lld,\n", results->perf_cache_references);
+    printf("    \"cache_misses\": %lld,\n", results->perf_cache_misses);
+    printf("    \"branches\": %lld,\n", results->perf_branches);
+    printf("    \"branch_misses\": %lld,\n", results->perf_branch_misses);
+    printf("    \"ipc\": %.3f,\n", results->perf_ipc);
+    printf("    \"cache_miss_rate\": %.4f,\n", results->perf_cache_miss_rate);
+    printf("    \"branch_miss_rate\": %.4f\n", results->perf_branch_miss_rate);
+    printf("  },\n");
+    printf("  \"probe\": {\n");
+    printf("    \"enabled\": %s,\n", results->probe_enabled ? "true" : "false");
+    printf("    \"preloaded\": %s,\n", results->probe_preloaded ? "true" : "false");
+    printf("    \"events\": %llu,\n", results->probe_events);
+    printf("    \"dropped\": %llu\n", results->probe_dropped);
+    printf("  },\n");
+    rune_checkpoint_stats_t checkpoints;
+    rune_get_checkpoint_stats(ctx, &checkpoints);
+    printf("  \"checkpoints\": {\n");
+    printf("    \"recorded\": %zu,\n", checkpoints.recorded);
+    printf("    \"spilled\": %zu,\n", checkpoints.spilled);
+    printf("    \"memory_bytes\": %zu,\n", checkpoints.memory_bytes);
+    printf("    \"dropped\": %lu\n", checkpoints.dropped);
+    printf("  },\n");
+    printf("  \"triggers\": {\n");
+    printf("    \"overflow_policy\": \"%s\",\n",
+           rune_trigger_overflow_name((rune_trigger_overflow_t)ctx->config.trigger_overflow));
+    printf("    \"stats\": [");
+    for (int t = 0; t < ctx->trigger_count; t++) {
+        const rune_trigger_t* trigger = &ctx->triggers[t];
+        const rune_trigger_stats_t* stats = &trigger->stats;
+        printf("%s\n      {\"name\": \"%s\", \"pattern\": \"%s\", \"async\": %s, \"fired\": %llu, "
+               "\"queued\": %llu, \"dropped\": %llu, \"coalesced\": %llu, \"blocked\": %llu, "
+               "\"latency_avg_us\": %.3f, \"latency_max_us\": %.3f, \"run_avg_us\": %.3f, "
+               "\"queue_depth_avg\": %.2f, \"queue_depth_max\": %llu}",
+               t ? "," : "", trigger->name, trigger->pattern, trigger->async ? "true" : "false",
+               (unsigned long long)stats->fired, (unsigned long long)stats->queued,
+               (unsigned long long)stats->dropped, (unsigned long long)stats->coalesced,
+               (unsigned long long)stats->blocked,
+               stats->fired ? stats->latency_ns_total / 1000.0 / stats->fired : 0.0,
+               stats->latency_ns_max / 1000.0,
+               stats->fired ? stats->run_ns_total / 1000.0 / stats->fired : 0.0,
+               stats->queued ? (double)stats->depth_total / stats->queued : 0.0,
+               (unsigned long long)stats->depth_max);
+    }
+    printf("%s]\n", ctx->trigger_count ? "\n    " : "");
+    printf("  },\n");
+    rune_span_total_t* spans;
+    int span_count = rune_span_totals(ctx, &spans);
+    printf("  \"spans\": [");
+    for (int s = 0; s < span_count; s++) {
+        printf("%s\n    {\"name\": \"%s\", \"calls\": %llu, \"total_ms\": %.3f, \"self_ms\": %.3f}",
+               s ? "," : "", spans[s].name, (unsigned long long)spans[s].calls,
+               spans[s].total_ns / 1e6, spans[s].self_ns / 1e6);
+    }
+    printf("%s]\n", span_count > 0 ? "\n  " : "");
+    free(spans);
     printf("}\n");
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("=== END JSON ANALYSIS RESULT ===\n\n");
     }
 }
 
-void rune_output_json_error_report(const char* operation, const char* error_message, int error_code) {
-    if (!rune_is_json_output_enabled() && !rune_is_both_output_enabled()) return;
+void rune_output_json_error_report(const rune_context_t* ctx, const char* operation, const char* error_message, int error_code) {
+    if (ctx->config.output_format != 1 && ctx->config.output_format != 2) return;
     
     time_t now = time(NULL);
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("\n=== JSON ERROR REPORT ===\n");
     }
     
@@ -389,10 +663,10 @@ void rune_output_json_error_report(const char* operation, const char* error_mess
     printf("    \"message\": \"%s\",\n", error_message ? error_message : "Unknown error");
     printf("    \"type\": \"analysis_failure\"\n");
     printf("  },\n");
-    printf("  \"target_executable\": \"%s\"\n", rune_get_target_executable());
+    printf("  \"target_executable\": \"%s\"\n", ctx->config.target_executable);
     printf("}\n");
     
-    if (rune_is_both_output_enabled()) {
+    if (ctx->config.output_format == 2) {
         printf("=== END JSON ERROR REPORT ===\n\n");
     }
 }
@@ -9,18 +9,22 @@
 #define RUNE_CONFIG_H
 
 #include "rune_types.h"
+#include "rune_context.h"
 
-// Configuration management
-extern rune_config_t g_config;
-extern rune_results_t g_results;
+// Compatibility shim: the old globals name the calling thread's current context
+#define g_config  (rune_context_current()->config)
+#define g_results (rune_context_current()->results)
 
 // Configuration functions
-int rune_config_init(void);
-int rune_config_parse_args(int argc, char **argv);
-void rune_config_cleanup(void);
-int rune_config_validate(void);
+int rune_config_init(rune_context_t* ctx);
+// rune_config_parse_args() results besides 0 and -1: nothing to analyze, the caller prints and exits 0
+#define RUNE_CONFIG_HELP 1      // -h/--help
+#define RUNE_CONFIG_VERSION 2   // --version
+int rune_config_parse_args(rune_context_t* ctx, int argc, char **argv);
+void rune_config_cleanup(rune_context_t* ctx);
+int rune_config_validate(const rune_context_t* ctx);
 
-// Configuration accessors
+// Configuration accessors (current context)
 const char* rune_get_target_executable(void);
 char** rune_get_target_args(void);
 int rune_get_target_argc(void);
@@ -31,9 +35,9 @@ int rune_is_json_output_enabled(void);          // ✨ NEW: JSON output check
 int rune_is_both_output_enabled(void);          // ✨ NEW: Both output modes check
 
 // JSON output functions  
-void rune_output_json_analysis_start(const char* target_executable);
-void rune_output_json_analysis_result(const rune_results_t* results, double execution_time);
-void rune_output_json_error_report(const char* operation, const char* error_message, int error_code);
+void rune_output_json_analysis_start(const rune_context_t* ctx);
+void rune_output_json_analysis_result(const rune_context_t* ctx, double execution_time);
+void rune_output_json_error_report(const rune_context_t* ctx, const char* operation, const char* error_message, int error_code);
 
 // Safe string operations - Defensive C Programming
 #define RUNE_SAFE_STRNCPY(dest, src, size) do { \
@@ -0,0 +1,62 @@
+/**
+ * rune_context.c - Reentrant analysis context implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+
+// The CLI's context - static so the shim works before anything is set up
+static rune_context_t g_default_context = {
+    .checkpoint_spill_fd = -1,
+    .checkpoint_lock = PTHREAD_MUTEX_INITIALIZER,
+    .span_lock = PTHREAD_MUTEX_INITIALIZER,
+};
+static unsigned long g_context_serial = 0;
+
+// Context the calling thread is working on (NULL = default)
+static __thread rune_context_t* t_current_context = NULL;
+
+rune_context_t* rune_context_create(void) {
+    rune_context_t* ctx = calloc(1, sizeof(*ctx));
+    if (!ctx) return NULL;
+
+    ctx->checkpoint_spill_fd = -1;
+    ctx->checkpoint_serial = __atomic_add_fetch(&g_context_serial, 1, __ATOMIC_RELAXED);
+    pthread_mutex_init(&ctx->checkpoint_lock, NULL);
+    pthread_mutex_init(&ctx->span_lock, NULL);
+    return ctx;
+}
+
+void rune_context_destroy(rune_context_t* ctx) {
+    if (!ctx || ctx == &g_default_context) return;
+    if (t_current_context == ctx) t_current_context = NULL;
+    rune_checkpoint_free(ctx);
+    pthread_mutex_destroy(&ctx->checkpoint_lock);
+    rune_span_free(ctx);
+    pthread_mutex_destroy(&ctx->span_lock);
+    rune_timeline_free(&ctx->timeline);
+    rune_proctree_free(&ctx->proctree);
+    free(ctx);
+}
+
+void rune_context_reset_results(rune_context_t* ctx) {
+    memset(&ctx->results, 0, sizeof(ctx->results));
+    rune_checkpoint_discard(ctx);
+    ctx->timeline.count = 0;
+}
+
+rune_context_t* rune_context_default(void) {
+    return &g_default_context;
+}
+
+rune_context_t* rune_context_current(void) {
+    return t_current_context ? t_current_context : &g_default_context;
+}
+
+rune_context_t* rune_context_bind(rune_context_t* ctx) {
+    rune_context_t* previous = rune_context_current();
+    t_current_context = ctx;
+    return previous;
+}
@@ -0,0 +1,107 @@
+/**
+ * rune_context.h - Reentrant analysis context for rune_analyze
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * A rune_context_t owns everything one analysis needs: configuration,
+ * results, the checkpoint timeline and the trigger table. Module entry
+ * points take the context explicitly, so several targets can be
+ * analyzed concurrently in one process, one context per thread.
+ *
+ * Code that still reaches for g_config/g_results (or logs checkpoints
+ * through the RUNE_LOG_* macros) lands in the calling thread's
+ * *current* context. Entry points bind their context as current for
+ * the duration of the call; threads that never bind one share the
+ * process-wide default context, which is what the CLI uses.
+ */
+
+#ifndef RUNE_CONTEXT_H
+#define RUNE_CONTEXT_H
+
+#include <pthread.h>
+
+#include "rune_types.h"
+#include "rune_timeline.h"
+#include "rune_proctree.h"
+
+typedef struct rune_context {
+    rune_config_t config;
+    rune_results_t results;
+
+    // Checkpoint timeline, in time order. Threads record into their own
+    // ring; readers drain the rings into storage under checkpoint_lock
+    // (see rune_checkpoint.c). Storage is a list of RUNE_CHECKPOINT_CHUNK
+    // record chunks; past the memory cap the oldest chunks are spilled
+    // to an unlinked segment file.
+    rune_checkpoint_record_t **checkpoint_chunks;
+    size_t checkpoint_chunk_count;          // Chunks allocated (in use or spare)
+    size_t checkpoint_chunk_slots;          // Capacity of checkpoint_chunks
+    size_t checkpoint_count;                // Recorded, spilled ones included
+    size_t checkpoint_spilled;              // The oldest ones, in the segment file
+    int checkpoint_spill_fd;                // -1 until the first spill
+    unsigned long checkpoint_dropped;       // Lost: no memory and no disk left
+    uint64_t checkpoint_start_ns;           // CLOCK_MONOTONIC at rune_checkpoint_init()
+    uint64_t checkpoint_start_realtime_ns;  // The same instant on the wall clock
+    struct rune_checkpoint_ring *checkpoint_rings;
+    unsigned long checkpoint_serial;        // Tells a context from a later one at the same address
+    pthread_mutex_t checkpoint_lock;
+
+    // Trigger table, indexed by a prefix trie over the patterns' literal
+    // heads (see rune_checkpoint.c). Register before threads log into
+    // the context: dispatch reads both without locks.
+    rune_trigger_t *triggers;
+    int trigger_count;
+    int trigger_capacity;
+    struct rune_trigger_node *trigger_nodes;
+    uint32_t trigger_node_count;
+    uint32_t trigger_node_capacity;
+    struct rune_dispatch *trigger_pool;     // Async triggers (started by rune_set_trigger_async)
+    
+    // Span call tree from RUNE_LOG_FUNC_START/END (see rune_span.c),
+    // kept across rune_context_reset_results()
+    rune_span_node_t *spans;
+    int span_count;
+    int span_capacity;
+    pthread_mutex_t span_lock;
+    
+    // Resource samples of the last run (columns allocated on first use)
+    rune_timeline_t timeline;
+    
+    // Process tree of the last run (per-process breakdown)
+    rune_proctree_t proctree;
+} rune_context_t;
+
+/**
+ * @brief Allocate a new, zeroed context
+ * @return Context or NULL on allocation failure
+ */
+rune_context_t* rune_context_create(void);
+
+/**
+ * @brief Free a context from rune_context_create()
+ */
+void rune_context_destroy(rune_context_t* ctx);
+
+/**
+ * @brief Forget the previous run's results and timeline, keep config and triggers
+ */
+void rune_context_reset_results(rune_context_t* ctx);
+
+/**
+ * @brief The process-wide context behind the g_config/g_results shim
+ */
+rune_context_t* rune_context_default(void);
+
+/**
+ * @brief The calling thread's current context (the default one if none is bound)
+ */
+rune_context_t* rune_context_current(void);
+
+/**
+ * @brief Make ctx the calling thread's current context
+ * @return The previously bound context, to hand back to rune_context_bind() later
+ */
+rune_context_t* rune_context_bind(rune_context_t* ctx);
+
+#endif /* RUNE_CONTEXT_H */
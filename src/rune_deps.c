@@ -0,0 +1,622 @@
+/**
+ * rune_deps.c - Shared-library dependency graph implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Libraries live in one array, indexed by (device, inode) through an
+ * open-addressing table; files that are not usable ELF objects get an
+ * entry too, so a failed candidate is not reopened. ld.so.cache is read
+ * on the first search that reaches it (new format only, which glibc has
+ * written since 2.32, also when appended to the old one).
+ */
+
+#include "rune_deps.h"
+
+#include <elf.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "rune_elf.h"
+
+#define RUNE_DEPS_CACHE_FILE "/etc/ld.so.cache"
+#define RUNE_DEPS_CACHE_MAGIC "glibc-ld.so.cache1.1"
+#define RUNE_DEPS_OLD_MAGIC "ld.so-1.7.0"
+#define RUNE_DEPS_CACHE_HEADER 48       // struct cache_file_new, up to its entries
+#define RUNE_DEPS_CACHE_ENTRY 24        // struct file_entry_new
+
+// Search results besides an index into the graph
+#define RUNE_DEPS_NOT_HERE (-1)
+#define RUNE_DEPS_ERROR (-2)
+
+struct rune_deps_cache_entry {
+    const char *name;
+    const char *path;
+    uint32_t order;             // Position in the file, which ld.so prefers
+};
+
+// Multiarch directory and $PLATFORM of the machines ld.so runs on
+static const struct {
+    uint16_t machine;
+    uint8_t bits;
+    const char *triplet;
+    const char *platform;
+} g_rune_deps_arches[] = {
+    { EM_X86_64,  64, "x86_64-linux-gnu",      "x86_64" },
+    { EM_AARCH64, 64, "aarch64-linux-gnu",     "aarch64" },
+    { EM_386,     32, "i386-linux-gnu",        "i686" },
+    { EM_ARM,     32, "arm-linux-gnueabihf",   "v7l" },
+    { EM_RISCV,   64, "riscv64-linux-gnu",     "riscv64" },
+    { EM_PPC64,   64, "powerpc64le-linux-gnu", "powerpc64le" },
+    { EM_S390,    64, "s390x-linux-gnu",       "s390x" },
+};
+
+static size_t rune_deps_hash(uint64_t dev, uint64_t ino) {
+    uint64_t h = dev * 0x9e3779b97f4a7c15ull ^ ino;
+    h ^= h >> 31;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 29;
+    return (size_t)h;
+}
+
+static int32_t rune_deps_lookup(const rune_deps_t *deps, uint64_t dev, uint64_t ino) {
+    if (!deps->index_size) {
+        return -1;
+    }
+    size_t mask = deps->index_size - 1;
+    for (size_t i = rune_deps_hash(dev, ino) & mask;; i = (i + 1) & mask) {
+        int32_t n = deps->index[i];
+        if (n < 0 || (deps->libraries[n]->dev == dev && deps->libraries[n]->ino == ino)) {
+            return n;
+        }
+    }
+}
+
+// Keep the index at most half full
+static int rune_deps_grow_index(rune_deps_t *deps) {
+    if ((deps->count + 1) * 2 <= deps->index_size) {
+        return 0;
+    }
+    size_t size = deps->index_size ? deps->index_size * 2 : 256;
+    int32_t *index = malloc(size * sizeof(*index));
+    if (!index) {
+        return -1;
+    }
+    memset(index, 0xff, size * sizeof(*index));
+    for (size_t n = 0; n < deps->count; n++) {
+        size_t i = rune_deps_hash(deps->libraries[n]->dev, deps->libraries[n]->ino) & (size - 1);
+        while (index[i] >= 0) {
+            i = (i + 1) & (size - 1);
+        }
+        index[i] = (int32_t)n;
+    }
+    free(deps->index);
+    deps->index = index;
+    deps->index_size = size;
+    return 0;
+}
+
+static void rune_deps_library_free(rune_deps_library_t *lib) {
+    if (!lib) {
+        return;
+    }
+    for (size_t i = 0; i < lib->needed_count; i++) {
+        free(lib->needed[i]);
+    }
+    free(lib->needed);
+    free(lib->path);
+    free(lib->name);
+    free(lib->rpath);
+    free(lib->runpath);
+    free(lib->resolved);
+    free(lib->from_rpath);
+    free(lib);
+}
+
+static int rune_deps_copy(char **to, const char *from) {
+    if (!from) {
+        return 0;
+    }
+    *to = strdup(from);
+    return *to ? 0 : -1;
+}
+
+// Parse the dynamic section of a file into a new library
+static rune_deps_library_t *rune_deps_parse(const char *path, const struct stat *st) {
+    rune_deps_library_t *lib = calloc(1, sizeof(*lib));
+    if (!lib || rune_deps_copy(&lib->path, path) != 0) {
+        free(lib);
+        return NULL;
+    }
+    lib->dev = (uint64_t)st->st_dev;
+    lib->ino = (uint64_t)st->st_ino;
+
+    rune_elf_t elf;
+    int ok = 0;
+    const char *soname = NULL;
+    if (rune_elf_open(&elf, path) == 0) {
+        lib->machine = elf.machine;
+        lib->bits = (uint8_t)elf.bits;
+        lib->needed = elf.needed_count ? calloc(elf.needed_count, sizeof(*lib->needed)) : NULL;
+        ok = !elf.needed_count || lib->needed;
+        for (size_t i = 0; ok && i < elf.needed_count; i++) {
+            ok = rune_deps_copy(&lib->needed[lib->needed_count++], elf.needed[i]) == 0;
+        }
+        ok = ok && rune_deps_copy(&lib->rpath, elf.rpath) == 0 && rune_deps_copy(&lib->runpath, elf.runpath) == 0;
+        if (ok && elf.soname && elf.soname[0]) {
+            ok = rune_deps_copy(&lib->name, elf.soname) == 0;
+            soname = lib->name;
+        }
+        rune_elf_close(&elf);
+    } else {
+        ok = 1;                 // Remembered as unusable
+    }
+    if (ok && !soname) {
+        const char *base = strrchr(path, '/');
+        ok = rune_deps_copy(&lib->name, base ? base + 1 : path) == 0;
+    }
+    if (!ok) {
+        rune_deps_library_free(lib);
+        return NULL;
+    }
+    return lib;
+}
+
+// Index of the file at path, parsed on first sight
+static int32_t rune_deps_load(rune_deps_t *deps, const char *path, const struct stat *st) {
+    int32_t n = rune_deps_lookup(deps, (uint64_t)st->st_dev, (uint64_t)st->st_ino);
+    if (n >= 0) {
+        return n;
+    }
+    if (deps->count >= INT32_MAX || rune_deps_grow_index(deps) != 0) {
+        return RUNE_DEPS_ERROR;
+    }
+    if (deps->count == deps->capacity) {
+        size_t capacity = deps->capacity ? deps->capacity * 2 : 64;
+        rune_deps_library_t **libraries = realloc(deps->libraries, capacity * sizeof(*libraries));
+        if (!libraries) {
+            return RUNE_DEPS_ERROR;
+        }
+        deps->libraries = libraries;
+        deps->capacity = capacity;
+    }
+    rune_deps_library_t *lib = rune_deps_parse(path, st);
+    if (!lib) {
+        return RUNE_DEPS_ERROR;
+    }
+    n = (int32_t)deps->count;
+    deps->libraries[deps->count++] = lib;
+    size_t mask = deps->index_size - 1;
+    size_t i = rune_deps_hash(lib->dev, lib->ino) & mask;
+    while (deps->index[i] >= 0) {
+        i = (i + 1) & mask;
+    }
+    deps->index[i] = n;
+    return n;
+}
+
+// The library at path if it exists and can be loaded by requester
+static int32_t rune_deps_try(rune_deps_t *deps, const char *path, const rune_deps_library_t *requester) {
+    struct stat st;
+    if (stat(path, &st) != 0 || !S_ISREG(st.st_mode)) {
+        return RUNE_DEPS_NOT_HERE;
+    }
+    int32_t n = rune_deps_load(deps, path, &st);
+    if (n < 0) {
+        return n;
+    }
+    const rune_deps_library_t *lib = deps->libraries[n];
+    return lib->machine == requester->machine && lib->bits == requester->bits ? n : RUNE_DEPS_NOT_HERE;
+}
+
+static int rune_deps_arch(const rune_deps_library_t *lib) {
+    for (size_t i = 0; i < sizeof(g_rune_deps_arches) / sizeof(g_rune_deps_arches[0]); i++) {
+        if (g_rune_deps_arches[i].machine == lib->machine && g_rune_deps_arches[i].bits == lib->bits) {
+            return (int)i;
+        }
+    }
+    return -1;
+}
+
+static int rune_deps_name_char(char c) {
+    return c == '_' || (c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+/*
+ * Expand $ORIGIN, $LIB and $PLATFORM (also in braces) of one search
+ * directory or DT_NEEDED path, relative to owner. Returns -1 if the
+ * result does not fit or names an unknown or unavailable token, which
+ * ld.so also skips.
+ */
+static int rune_deps_expand(const char *from, size_t length, const rune_deps_library_t *owner,
+                            char *out, size_t size) {
+    size_t used = 0;
+    for (size_t i = 0; i < length;) {
+        const char *value = NULL;
+        size_t value_length = 0;
+        if (from[i] == '$') {
+            static const char *const tokens[] = { "ORIGIN", "LIB", "PLATFORM" };
+            size_t t, skip = 0;
+            for (t = 0; t < 3; t++) {
+                size_t n = strlen(tokens[t]);
+                if (i + 1 + n <= length && strncmp(from + i + 1, tokens[t], n) == 0 &&
+                    (i + 1 + n == length || !rune_deps_name_char(from[i + 1 + n]))) {
+                    skip = 1 + n;
+                    break;
+                }
+                if (i + 3 + n <= length && from[i + 1] == '{' && strncmp(from + i + 2, tokens[t], n) == 0 &&
+                    from[i + 2 + n] == '}') {
+                    skip = 3 + n;
+                    break;
+                }
+            }
+            int arch = rune_deps_arch(owner);
+            if (t == 0) {
+                const char *slash = strrchr(owner->path, '/');
+                value = owner->path;
+                value_length = slash ? (size_t)(slash - owner->path) : 0;
+                if (value_length == 0) {
+                    value = "/";
+                    value_length = 1;
+                }
+            } else if (t == 1) {
+                value = owner->bits == 64 ? "lib64" : "lib";
+                value_length = strlen(value);
+            } else if (t == 2 && arch >= 0) {
+                value = g_rune_deps_arches[arch].platform;
+                value_length = strlen(value);
+            } else {
+                return -1;
+            }
+            i += skip;
+        } else {
+            value = from + i;
+            value_length = 1;
+            i++;
+        }
+        if (used + value_length >= size) {
+            return -1;
+        }
+        memcpy(out + used, value, value_length);
+        used += value_length;
+    }
+    out[used] = '\0';
+    return 0;
+}
+
+// Search name in a ':' or ';' separated directory list belonging to owner
+static int32_t rune_deps_search_list(rune_deps_t *deps, const char *list, const rune_deps_library_t *owner,
+                                     const rune_deps_library_t *requester, const char *name) {
+    char dir[PATH_MAX], path[PATH_MAX];
+    for (const char *p = list; p && *p;) {
+        size_t length = strcspn(p, ":;");
+        if (length && rune_deps_expand(p, length, owner, dir, sizeof(dir)) == 0 &&
+            (size_t)snprintf(path, sizeof(path), "%s/%s", dir, name) < sizeof(path)) {
+            int32_t n = rune_deps_try(deps, path, requester);
+            if (n != RUNE_DEPS_NOT_HERE) {
+                return n;
+            }
+        }
+        p += length;
+        p += *p != '\0';
+    }
+    return RUNE_DEPS_NOT_HERE;
+}
+
+static int rune_deps_cache_order(const void *a, const void *b) {
+    const rune_deps_cache_entry_t *x = a, *y = b;
+    int c = strcmp(x->name, y->name);
+    return c ? c : (x->order > y->order) - (x->order < y->order);
+}
+
+// Read /etc/ld.so.cache; a missing or unknown one just searches nothing
+static int rune_deps_load_cache(rune_deps_t *deps) {
+    deps->cache_loaded = 1;
+    int fd = open(RUNE_DEPS_CACHE_FILE, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return 0;
+    }
+    struct stat st;
+    char *data = NULL;
+    size_t size = 0;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return 0;
+    }
+    if ((data = malloc((size_t)st.st_size + 1))) {
+        while (size < (size_t)st.st_size) {
+            ssize_t got = read(fd, data + size, (size_t)st.st_size - size);
+            if (got <= 0) {
+                break;
+            }
+            size += (size_t)got;
+        }
+        data[size] = '\0';      // Terminates a string running past the end
+    }
+    close(fd);
+    if (!data) {
+        return -1;
+    }
+
+    size_t at = 0;
+    if (size >= 16 && memcmp(data, RUNE_DEPS_OLD_MAGIC, sizeof(RUNE_DEPS_OLD_MAGIC) - 1) == 0) {
+        uint32_t old_count;
+        memcpy(&old_count, data + 12, 4);
+        at = ((size_t)16 + (size_t)old_count * 12 + 7) & ~(size_t)7;
+    }
+    uint32_t count = 0;
+    if (at <= size && size - at >= RUNE_DEPS_CACHE_HEADER &&
+        memcmp(data + at, RUNE_DEPS_CACHE_MAGIC, sizeof(RUNE_DEPS_CACHE_MAGIC) - 1) == 0) {
+        memcpy(&count, data + at + 20, 4);
+        if (count > (size - at - RUNE_DEPS_CACHE_HEADER) / RUNE_DEPS_CACHE_ENTRY) {
+            count = 0;
+        }
+    }
+    deps->cache = count ? malloc(count * sizeof(*deps->cache)) : NULL;
+    if (count && !deps->cache) {
+        free(data);
+        return -1;
+    }
+    for (uint32_t i = 0; i < count; i++) {
+        const char *e = data + at + RUNE_DEPS_CACHE_HEADER + (size_t)i * RUNE_DEPS_CACHE_ENTRY;
+        uint32_t key, value;
+        memcpy(&key, e + 4, 4);
+        memcpy(&value, e + 8, 4);
+        if (key >= size - at || value >= size - at) {
+            continue;
+        }
+        rune_deps_cache_entry_t *entry = &deps->cache[deps->cache_count++];
+        entry->name = data + at + key;
+        entry->path = data + at + value;
+        entry->order = i;
+    }
+    qsort(deps->cache, deps->cache_count, sizeof(*deps->cache), rune_deps_cache_order);
+    deps->cache_strings = data;
+    return 0;
+}
+
+static int32_t rune_deps_search_cache(rune_deps_t *deps, const rune_deps_library_t *requester, const char *name) {
+    if (!deps->cache_loaded && rune_deps_load_cache(deps) != 0) {
+        return RUNE_DEPS_ERROR;
+    }
+    size_t low = 0, high = deps->cache_count;
+    while (low < high) {
+        size_t mid = low + (high - low) / 2;
+        if (strcmp(deps->cache[mid].name, name) < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    for (; low < deps->cache_count && strcmp(deps->cache[low].name, name) == 0; low++) {
+        int32_t n = rune_deps_try(deps, deps->cache[low].path, requester);
+        if (n != RUNE_DEPS_NOT_HERE) {
+            return n;
+        }
+    }
+    return RUNE_DEPS_NOT_HERE;
+}
+
+static int32_t rune_deps_search_defaults(rune_deps_t *deps, const rune_deps_library_t *requester, const char *name) {
+    char list[256];
+    int arch = rune_deps_arch(requester);
+    snprintf(list, sizeof(list), "%s%s%s%s%s%s/lib:/usr/lib",
+             arch >= 0 ? "/lib/" : "", arch >= 0 ? g_rune_deps_arches[arch].triplet : "",
+             arch >= 0 ? ":/usr/lib/" : "", arch >= 0 ? g_rune_deps_arches[arch].triplet : "",
+             arch >= 0 ? ":" : "", requester->bits == 64 ? "/lib64:/usr/lib64:" : "");
+    return rune_deps_search_list(deps, list, requester, requester, name);
+}
+
+// Resolve every DT_NEEDED name of a library, once, in the order ld.so searches
+static int rune_deps_edges(rune_deps_t *deps, rune_deps_library_t *lib) {
+    if (lib->edges_done) {
+        deps->reused += lib->needed_count;
+        return 0;
+    }
+    if (lib->needed_count) {
+        lib->resolved = malloc(lib->needed_count * sizeof(*lib->resolved));
+        lib->from_rpath = calloc(lib->needed_count, sizeof(*lib->from_rpath));
+        if (!lib->resolved || !lib->from_rpath) {
+            free(lib->resolved);
+            free(lib->from_rpath);
+            lib->resolved = NULL;
+            lib->from_rpath = NULL;
+            return -1;
+        }
+    }
+    for (size_t i = 0; i < lib->needed_count; i++) {
+        const char *name = lib->needed[i];
+        int32_t n = RUNE_DEPS_NOT_HERE;
+        deps->resolutions++;
+        if (strchr(name, '/')) {
+            char path[PATH_MAX];
+            if (rune_deps_expand(name, strlen(name), lib, path, sizeof(path)) == 0) {
+                n = rune_deps_try(deps, path, lib);
+            }
+        } else {
+            if (!lib->runpath && lib->rpath) {
+                n = rune_deps_search_list(deps, lib->rpath, lib, lib, name);
+                lib->from_rpath[i] = n >= 0;
+            }
+            if (n == RUNE_DEPS_NOT_HERE && deps->library_path) {
+                n = rune_deps_search_list(deps, deps->library_path, lib, lib, name);
+            }
+            if (n == RUNE_DEPS_NOT_HERE && lib->runpath) {
+                n = rune_deps_search_list(deps, lib->runpath, lib, lib, name);
+            }
+            if (n == RUNE_DEPS_NOT_HERE) {
+                n = rune_deps_search_cache(deps, lib, name);
+            }
+            if (n == RUNE_DEPS_NOT_HERE) {
+                n = rune_deps_search_defaults(deps, lib, name);
+            }
+        }
+        if (n == RUNE_DEPS_ERROR) {
+            return -1;
+        }
+        // Loading may have grown the array, but lib itself does not move
+        lib->resolved[i] = n;
+    }
+    lib->edges_done = 1;
+    return 0;
+}
+
+int rune_deps_init(rune_deps_t *deps) {
+    memset(deps, 0, sizeof(*deps));
+    const char *env = getenv("LD_LIBRARY_PATH");
+    if (env && *env && !(deps->library_path = strdup(env))) {
+        return -1;
+    }
+    pthread_mutex_init(&deps->lock, NULL);
+    return 0;
+}
+
+void rune_deps_free(rune_deps_t *deps) {
+    for (size_t i = 0; i < deps->count; i++) {
+        rune_deps_library_free(deps->libraries[i]);
+    }
+    free(deps->libraries);
+    free(deps->index);
+    free(deps->library_path);
+    free(deps->cache);
+    free(deps->cache_strings);
+    pthread_mutex_destroy(&deps->lock);
+    memset(deps, 0, sizeof(*deps));
+}
+
+// Room for one more item in an array that starts at 8 and doubles
+static void *rune_deps_grow(void *array, size_t count, size_t size) {
+    if (count && (count < 8 || (count & (count - 1)) != 0)) {
+        return array;
+    }
+    return realloc(array, (count ? count * 2 : 8) * size);
+}
+
+// The library of the closure (or its root) already loaded under name, as ld.so matches it first
+static const rune_deps_library_t *rune_deps_loaded(const rune_deps_closure_t *closure,
+                                                   const rune_deps_library_t *root, const char *name) {
+    if (strcmp(root->name, name) == 0) {
+        return root;
+    }
+    for (size_t i = 0; i < closure->count; i++) {
+        if (strcmp(closure->libraries[i]->name, name) == 0) {
+            return closure->libraries[i];
+        }
+    }
+    return NULL;
+}
+
+static int rune_deps_walk(rune_deps_t *deps, rune_deps_library_t *root, rune_deps_closure_t *closure) {
+    int inherit = root->rpath && !root->runpath;
+    for (size_t q = 0; q <= closure->count; q++) {
+        rune_deps_library_t *lib = q ? (rune_deps_library_t *)closure->libraries[q - 1] : root;
+        if (rune_deps_edges(deps, lib) != 0) {
+            return -1;
+        }
+        for (size_t i = 0; i < lib->needed_count; i++) {
+            const rune_deps_library_t *found = rune_deps_loaded(closure, root, lib->needed[i]);
+            if (found) {
+                continue;
+            }
+            int32_t n = lib->resolved[i];
+            // The executable's RPATH comes before everything but the library's own
+            if (inherit && lib != root && !lib->runpath && !lib->from_rpath[i] && !strchr(lib->needed[i], '/')) {
+                int32_t inherited = rune_deps_search_list(deps, root->rpath, root, lib, lib->needed[i]);
+                if (inherited == RUNE_DEPS_ERROR) {
+                    return -1;
+                }
+                if (inherited >= 0) {
+                    n = inherited;
+                }
+            }
+            if (n < 0) {
+                int known = 0;
+                for (size_t m = 0; m < closure->missing_count && !known; m++) {
+                    known = strcmp(closure->missing[m], lib->needed[i]) == 0;
+                }
+                if (!known) {
+                    const char **missing = rune_deps_grow(closure->missing, closure->missing_count,
+                                                          sizeof(*missing));
+                    if (!missing) {
+                        return -1;
+                    }
+                    closure->missing = missing;
+                    closure->missing[closure->missing_count++] = lib->needed[i];
+                }
+                continue;
+            }
+            // Same file under another name (a symlink without SONAME)
+            found = deps->libraries[n];
+            int seen = found == root;
+            for (size_t m = 0; m < closure->count && !seen; m++) {
+                seen = closure->libraries[m] == found;
+            }
+            if (!seen) {
+                const rune_deps_library_t **libraries = rune_deps_grow(closure->libraries, closure->count,
+                                                                       sizeof(*libraries));
+                if (!libraries) {
+                    return -1;
+                }
+                closure->libraries = libraries;
+                closure->libraries[closure->count++] = found;
+            }
+        }
+    }
+    return 0;
+}
+
+int rune_deps_closure(rune_deps_t *deps, const char *path, rune_deps_closure_t *closure) {
+    memset(closure, 0, sizeof(*closure));
+    // $ORIGIN of the executable is where it really is, symlinks resolved
+    char real[PATH_MAX];
+    struct stat st;
+    if (!realpath(path, real) || stat(real, &st) != 0) {
+        return -1;
+    }
+    if (!S_ISREG(st.st_mode)) {
+        errno = ENOEXEC;
+        return -1;
+    }
+
+    pthread_mutex_lock(&deps->lock);
+    int rc = -1;
+    int32_t n = rune_deps_load(deps, real, &st);
+    if (n < 0) {
+        errno = ENOMEM;
+    } else if (!deps->libraries[n]->machine) {
+        errno = ENOEXEC;
+    } else if (rune_deps_walk(deps, deps->libraries[n], closure) != 0) {
+        errno = ENOMEM;
+    } else {
+        rc = 0;
+    }
+    pthread_mutex_unlock(&deps->lock);
+    if (rc != 0) {
+        int error = errno;
+        rune_deps_closure_free(closure);
+        errno = error;
+    }
+    return rc;
+}
+
+const rune_deps_library_t *rune_deps_find(const rune_deps_closure_t *closure, const char *prefix) {
+    size_t length = strlen(prefix);
+    for (size_t i = 0; i < closure->count; i++) {
+        if (strncmp(closure->libraries[i]->name, prefix, length) == 0) {
+            return closure->libraries[i];
+        }
+    }
+    return NULL;
+}
+
+void rune_deps_closure_free(rune_deps_closure_t *closure) {
+    free(closure->libraries);
+    free(closure->missing);
+    memset(closure, 0, sizeof(*closure));
+}
@@ -0,0 +1,102 @@
+/**
+ * rune_deps.h - Shared-library dependency graph, resolved like ld.so
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Finds the libraries a binary loads without running it or ldd: each
+ * DT_NEEDED name is searched in DT_RPATH (the object's, then the
+ * executable's, unless DT_RUNPATH is set), LD_LIBRARY_PATH, DT_RUNPATH,
+ * /etc/ld.so.cache and the default directories, skipping files of the
+ * wrong class or machine. $ORIGIN, $LIB and $PLATFORM are expanded.
+ * Only the executable's RPATH is inherited, not that of intermediate
+ * libraries.
+ *
+ * The graph is memoized for the life of the process: every file is
+ * parsed once (by device and inode, whatever path reached it) and each
+ * of its DT_NEEDED names is resolved once, so libc or libstdc++ cost
+ * nothing after the first target that loads them. A mutex makes one
+ * graph shareable between threads.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_DEPS_H
+#define RUNE_DEPS_H
+
+#include <pthread.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct rune_deps_library {
+    char *path;                 // As found ("/lib/x86_64-linux-gnu/libc.so.6")
+    char *name;                 // DT_SONAME, else the file name of path
+    uint16_t machine;           // EM_*, 0 if the file is not a usable ELF
+    uint8_t bits;
+    uint64_t dev;
+    uint64_t ino;
+
+    char **needed;              // DT_NEEDED, in order
+    size_t needed_count;
+    char *rpath;                // NULL if absent
+    char *runpath;
+
+    // Resolution memo, filled on first use
+    int32_t *resolved;          // Per needed name: index into the graph, -1 if not found
+    uint8_t *from_rpath;        // Found through the object's own DT_RPATH
+    int edges_done;
+} rune_deps_library_t;
+
+typedef struct rune_deps_cache_entry rune_deps_cache_entry_t;
+
+typedef struct rune_deps {
+    pthread_mutex_t lock;
+    rune_deps_library_t **libraries;    // Stable pointers: closures keep them
+    size_t count;
+    size_t capacity;
+    int32_t *index;             // Open addressing on (dev, ino), -1 for free slots
+    size_t index_size;
+
+    char *library_path;         // LD_LIBRARY_PATH, NULL if unset
+    rune_deps_cache_entry_t *cache;     // /etc/ld.so.cache, sorted by name
+    size_t cache_count;
+    char *cache_strings;
+    int cache_loaded;
+
+    uint64_t resolutions;       // DT_NEEDED names searched for
+    uint64_t reused;            // Names answered by the memo
+} rune_deps_t;
+
+typedef struct rune_deps_closure {
+    const rune_deps_library_t **libraries;  // Breadth-first load order, root excluded
+    size_t count;
+    const char **missing;       // DT_NEEDED names no directory had
+    size_t missing_count;
+} rune_deps_closure_t;
+
+/**
+ * @brief Start an empty graph (LD_LIBRARY_PATH is read now)
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_deps_init(rune_deps_t *deps);
+
+/**
+ * @brief Free the graph; closures taken from it become invalid
+ */
+void rune_deps_free(rune_deps_t *deps);
+
+/**
+ * @brief Every library the binary at path loads, directly or not
+ * @return 0 on success, -1 on error (errno is set; ENOEXEC if path is
+ *         not ELF). Static binaries have an empty closure.
+ */
+int rune_deps_closure(rune_deps_t *deps, const char *path, rune_deps_closure_t *closure);
+
+/**
+ * @brief First library of the closure whose name starts with prefix, or NULL
+ */
+const rune_deps_library_t *rune_deps_find(const rune_deps_closure_t *closure, const char *prefix);
+
+void rune_deps_closure_free(rune_deps_closure_t *closure);
+
+#endif /* RUNE_DEPS_H */
@@ -0,0 +1,329 @@
+/**
+ * rune_dispatch.c - Asynchronous trigger dispatch implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+#include "rune_dispatch.h"
+
+#include <linux/futex.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+
+#define RUNE_DISPATCH_IDLE_NS 100000000L    // Worker re-checks its queue at least every 100 ms
+#define RUNE_DISPATCH_BACKOFF_NS 20000L     // Blocked producers and flush poll every 20 us
+
+// One queue slot: seq tells producers and the worker whose turn it is
+typedef struct rune_dispatch_cell {
+    uint64_t seq;
+    int trigger;
+    uint64_t queued_ns;
+    rune_checkpoint_record_t record;
+} rune_dispatch_cell_t;
+
+typedef struct rune_dispatch_worker {
+    uint64_t tail __attribute__((aligned(64)));  // Next free cell (producers, CAS)
+    uint64_t head __attribute__((aligned(64)));  // Next cell to run (the worker)
+    uint32_t sleeping;                           // Futex word: the worker waits for work
+    uint32_t coalesced;                          // One of our triggers has a latest event
+    rune_dispatch_t* pool;
+    int index;
+    int started;
+    pthread_t thread;
+    rune_dispatch_cell_t cells[RUNE_DISPATCH_QUEUE_SIZE];
+} rune_dispatch_worker_t;
+
+struct rune_dispatch {
+    rune_context_t* ctx;
+    rune_trigger_overflow_t overflow;
+    int worker_count;
+    int stopping;
+    uint64_t pending;                   // Submitted, not run yet
+    rune_dispatch_worker_t* workers;
+};
+
+static __thread const rune_dispatch_t* t_dispatch_pool;  // Set on worker threads
+
+static uint64_t rune_dispatch_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void rune_dispatch_pause(long ns) {
+    struct timespec ts = { 0, ns };
+    nanosleep(&ts, NULL);
+}
+
+static void rune_dispatch_max(uint64_t* target, uint64_t value) {
+    uint64_t current = __atomic_load_n(target, __ATOMIC_RELAXED);
+    while (value > current &&
+           !__atomic_compare_exchange_n(target, &current, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+void rune_trigger_account(rune_trigger_t* trigger, uint64_t latency_ns, uint64_t run_ns) {
+    __atomic_add_fetch(&trigger->stats.fired, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&trigger->stats.latency_ns_total, latency_ns, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&trigger->stats.run_ns_total, run_ns, __ATOMIC_RELAXED);
+    rune_dispatch_max(&trigger->stats.latency_ns_max, latency_ns);
+}
+
+const char* rune_trigger_overflow_name(rune_trigger_overflow_t overflow) {
+    switch (overflow) {
+        case RUNE_TRIGGER_OVERFLOW_BLOCK: return "block";
+        case RUNE_TRIGGER_OVERFLOW_COALESCE: return "coalesce";
+        default: return "drop";
+    }
+}
+
+static void rune_dispatch_wake(rune_dispatch_worker_t* worker) {
+    // Pairs with the fence in the worker's sleep path: either it sees
+    // our event, or we see it sleeping
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&worker->sleeping, __ATOMIC_RELAXED)) {
+        __atomic_store_n(&worker->sleeping, 0, __ATOMIC_RELAXED);
+        syscall(SYS_futex, &worker->sleeping, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+}
+
+// Producer side; returns the queue depth, or 0 when full
+static uint64_t rune_dispatch_push(rune_dispatch_worker_t* worker, int trigger,
+                                   const rune_checkpoint_record_t* record, uint64_t queued_ns) {
+    uint64_t pos = __atomic_load_n(&worker->tail, __ATOMIC_RELAXED);
+    rune_dispatch_cell_t* cell;
+    for (;;) {
+        cell = &worker->cells[pos & (RUNE_DISPATCH_QUEUE_SIZE - 1)];
+        int64_t diff = (int64_t)(__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&worker->tail, &pos, pos + 1, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return 0;
+        } else {
+            pos = __atomic_load_n(&worker->tail, __ATOMIC_RELAXED);
+        }
+    }
+    cell->trigger = trigger;
+    cell->queued_ns = queued_ns;
+    cell->record = *record;
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+    return pos + 1 - __atomic_load_n(&worker->head, __ATOMIC_RELAXED);
+}
+
+// Worker side
+static int rune_dispatch_pop(rune_dispatch_worker_t* worker, rune_dispatch_cell_t* out) {
+    uint64_t pos = worker->head;
+    rune_dispatch_cell_t* cell = &worker->cells[pos & (RUNE_DISPATCH_QUEUE_SIZE - 1)];
+    if (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) != pos + 1) {
+        return 0;
+    }
+    *out = *cell;
+    __atomic_store_n(&cell->seq, pos + RUNE_DISPATCH_QUEUE_SIZE, __ATOMIC_RELEASE);
+    __atomic_store_n(&worker->head, pos + 1, __ATOMIC_RELAXED);
+    return 1;
+}
+
+static int rune_dispatch_has_work(const rune_dispatch_worker_t* worker) {
+    const rune_dispatch_cell_t* cell = &worker->cells[worker->head & (RUNE_DISPATCH_QUEUE_SIZE - 1)];
+    return __atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) == worker->head + 1 ||
+           __atomic_load_n(&worker->coalesced, __ATOMIC_ACQUIRE);
+}
+
+static void rune_dispatch_run(rune_dispatch_t* pool, int index, const rune_checkpoint_record_t* record,
+                              uint64_t queued_ns) {
+    rune_trigger_t* trigger = &pool->ctx->triggers[index];
+    rune_checkpoint_t view;
+    rune_checkpoint_format(pool->ctx, record, &view);
+    view.trigger_fired = 1;
+
+    uint64_t start = rune_dispatch_now();
+    trigger->callback(&view);
+    uint64_t end = rune_dispatch_now();
+    rune_trigger_account(trigger, end - queued_ns, end - start);
+}
+
+// Run the latest events our triggers coalesced
+static void rune_dispatch_run_coalesced(rune_dispatch_worker_t* worker) {
+    rune_dispatch_t* pool = worker->pool;
+    if (!__atomic_exchange_n(&worker->coalesced, 0, __ATOMIC_ACQ_REL)) {
+        return;
+    }
+    for (int i = worker->index; i < pool->ctx->trigger_count; i += pool->worker_count) {
+        rune_trigger_t* trigger = &pool->ctx->triggers[i];
+        if (!__atomic_load_n(&trigger->latest_pending, __ATOMIC_ACQUIRE)) {
+            continue;
+        }
+        while (__atomic_test_and_set(&trigger->latest_lock, __ATOMIC_ACQUIRE)) {
+        }
+        rune_checkpoint_record_t record = trigger->latest;
+        uint64_t queued_ns = trigger->latest_queued_ns;
+        trigger->latest_pending = 0;
+        __atomic_clear(&trigger->latest_lock, __ATOMIC_RELEASE);
+
+        rune_dispatch_run(pool, i, &record, queued_ns);
+        __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_RELEASE);
+    }
+}
+
+static void* rune_dispatch_worker_main(void* arg) {
+    rune_dispatch_worker_t* worker = arg;
+    rune_dispatch_t* pool = worker->pool;
+    t_dispatch_pool = pool;
+    rune_context_bind(pool->ctx);   // Checkpoints logged by callbacks stay in the context
+
+    rune_dispatch_cell_t cell;
+    for (;;) {
+        if (rune_dispatch_pop(worker, &cell)) {
+            rune_dispatch_run(pool, cell.trigger, &cell.record, cell.queued_ns);
+            __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_RELEASE);
+            continue;
+        }
+        rune_dispatch_run_coalesced(worker);
+        if (rune_dispatch_has_work(worker)) {
+            continue;
+        }
+        if (__atomic_load_n(&pool->stopping, __ATOMIC_ACQUIRE)) {
+            break;
+        }
+
+        __atomic_store_n(&worker->sleeping, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (rune_dispatch_has_work(worker) || __atomic_load_n(&pool->stopping, __ATOMIC_ACQUIRE)) {
+            __atomic_store_n(&worker->sleeping, 0, __ATOMIC_RELAXED);
+            continue;
+        }
+        struct timespec idle = { 0, RUNE_DISPATCH_IDLE_NS };
+        syscall(SYS_futex, &worker->sleeping, FUTEX_WAIT_PRIVATE, 1, &idle, NULL, 0);
+        __atomic_store_n(&worker->sleeping, 0, __ATOMIC_RELAXED);
+    }
+    return NULL;
+}
+
+rune_dispatch_t* rune_dispatch_create(rune_context_t* ctx, int workers, rune_trigger_overflow_t overflow) {
+    if (workers < 1) workers = 1;
+    if (workers > RUNE_DISPATCH_MAX_WORKERS) workers = RUNE_DISPATCH_MAX_WORKERS;
+
+    rune_dispatch_t* pool = calloc(1, sizeof(*pool));
+    if (!pool) return NULL;
+    void* memory = NULL;
+    if (posix_memalign(&memory, 64, (size_t)workers * sizeof(rune_dispatch_worker_t)) != 0) {
+        free(pool);
+        return NULL;
+    }
+    pool->ctx = ctx;
+    pool->overflow = overflow;
+    pool->workers = memory;
+    memset(pool->workers, 0, (size_t)workers * sizeof(rune_dispatch_worker_t));
+
+    for (int w = 0; w < workers; w++) {
+        rune_dispatch_worker_t* worker = &pool->workers[w];
+        worker->pool = pool;
+        worker->index = w;
+        for (uint64_t i = 0; i < RUNE_DISPATCH_QUEUE_SIZE; i++) {
+            worker->cells[i].seq = i;
+        }
+    }
+    // worker_count is what submit() spreads over: only count started workers
+    for (int w = 0; w < workers; w++) {
+        if (pthread_create(&pool->workers[w].thread, NULL, rune_dispatch_worker_main, &pool->workers[w]) != 0) {
+            break;
+        }
+        pool->workers[w].started = 1;
+        pool->worker_count++;
+    }
+    if (pool->worker_count == 0) {
+        free(pool->workers);
+        free(pool);
+        return NULL;
+    }
+    return pool;
+}
+
+void rune_dispatch_destroy(rune_dispatch_t* pool) {
+    if (!pool) return;
+    rune_dispatch_flush(pool);
+    __atomic_store_n(&pool->stopping, 1, __ATOMIC_RELEASE);
+    for (int w = 0; w < pool->worker_count; w++) {
+        rune_dispatch_wake(&pool->workers[w]);
+    }
+    for (int w = 0; w < pool->worker_count; w++) {
+        if (pool->workers[w].started) pthread_join(pool->workers[w].thread, NULL);
+    }
+    free(pool->workers);
+    free(pool);
+}
+
+// Keep only the latest event of a trigger whose worker is saturated
+static void rune_dispatch_coalesce(rune_dispatch_t* pool, rune_dispatch_worker_t* worker, int index,
+                                   const rune_checkpoint_record_t* record, uint64_t queued_ns) {
+    rune_trigger_t* trigger = &pool->ctx->triggers[index];
+    while (__atomic_test_and_set(&trigger->latest_lock, __ATOMIC_ACQUIRE)) {
+    }
+    if (trigger->latest_pending) {
+        __atomic_add_fetch(&trigger->stats.coalesced, 1, __ATOMIC_RELAXED);
+    } else {
+        __atomic_add_fetch(&pool->pending, 1, __ATOMIC_RELAXED);
+        __atomic_store_n(&trigger->latest_pending, 1, __ATOMIC_RELEASE);
+    }
+    trigger->latest = *record;
+    trigger->latest_queued_ns = queued_ns;
+    __atomic_clear(&trigger->latest_lock, __ATOMIC_RELEASE);
+
+    __atomic_store_n(&worker->coalesced, 1, __ATOMIC_RELEASE);
+    rune_dispatch_wake(worker);
+}
+
+int rune_dispatch_submit(rune_dispatch_t* pool, int index, const rune_checkpoint_record_t* record) {
+    rune_dispatch_worker_t* worker = &pool->workers[index % pool->worker_count];
+    rune_trigger_t* trigger = &pool->ctx->triggers[index];
+    uint64_t queued_ns = rune_dispatch_now();
+
+    // Counted before it is visible, so a flush can never miss it
+    __atomic_add_fetch(&pool->pending, 1, __ATOMIC_RELAXED);
+    uint64_t depth = rune_dispatch_push(worker, index, record, queued_ns);
+    if (!depth) {
+        switch (pool->overflow) {
+            case RUNE_TRIGGER_OVERFLOW_BLOCK:
+                if (t_dispatch_pool != pool) {
+                    __atomic_add_fetch(&trigger->stats.blocked, 1, __ATOMIC_RELAXED);
+                    while (!(depth = rune_dispatch_push(worker, index, record, queued_ns))) {
+                        rune_dispatch_wake(worker);
+                        rune_dispatch_pause(RUNE_DISPATCH_BACKOFF_NS);
+                    }
+                    break;
+                }
+                // A worker waiting for room in its own pool may wait forever
+                __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_RELEASE);
+                rune_dispatch_run(pool, index, record, queued_ns);
+                return 0;
+            case RUNE_TRIGGER_OVERFLOW_COALESCE:
+                rune_dispatch_coalesce(pool, worker, index, record, queued_ns);
+                __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_RELEASE);
+                return 0;
+            default:
+                __atomic_sub_fetch(&pool->pending, 1, __ATOMIC_RELEASE);
+                __atomic_add_fetch(&trigger->stats.dropped, 1, __ATOMIC_RELAXED);
+                return -1;
+        }
+    }
+
+    __atomic_add_fetch(&trigger->stats.queued, 1, __ATOMIC_RELAXED);
+    __atomic_add_fetch(&trigger->stats.depth_total, depth, __ATOMIC_RELAXED);
+    rune_dispatch_max(&trigger->stats.depth_max, depth);
+    rune_dispatch_wake(worker);
+    return 0;
+}
+
+void rune_dispatch_flush(rune_dispatch_t* pool) {
+    if (!pool || t_dispatch_pool == pool) return;
+    while (__atomic_load_n(&pool->pending, __ATOMIC_ACQUIRE) > 0) {
+        for (int w = 0; w < pool->worker_count; w++) {
+            rune_dispatch_wake(&pool->workers[w]);
+        }
+        rune_dispatch_pause(RUNE_DISPATCH_BACKOFF_NS);
+    }
+}
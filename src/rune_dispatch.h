@@ -0,0 +1,73 @@
+/**
+ * rune_dispatch.h - Asynchronous trigger dispatch
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Async triggers run on a small per-context worker pool instead of in
+ * the thread that logged the checkpoint. Every worker owns a bounded,
+ * lock-free multi-producer queue of raw checkpoint records and sleeps
+ * on a futex when it is empty. A trigger always goes to the same
+ * worker, so its callbacks run in order and never concurrently.
+ *
+ * When a worker's queue is full the overflow policy decides:
+ *   drop     - the event is lost and counted
+ *   block    - the producer waits for room (a worker blocked on its
+ *              own pool runs the callback inline instead)
+ *   coalesce - each trigger keeps only its latest overflowing event,
+ *              which runs once the worker gets to it
+ */
+
+#ifndef RUNE_DISPATCH_H
+#define RUNE_DISPATCH_H
+
+#include "rune_types.h"
+
+#define RUNE_DISPATCH_QUEUE_SIZE 1024   // Events per worker queue (power of two)
+#define RUNE_DISPATCH_WORKERS 2         // Default pool size (--trigger-workers)
+#define RUNE_DISPATCH_MAX_WORKERS 64
+
+typedef enum {
+    RUNE_TRIGGER_OVERFLOW_DROP = 0,
+    RUNE_TRIGGER_OVERFLOW_BLOCK,
+    RUNE_TRIGGER_OVERFLOW_COALESCE
+} rune_trigger_overflow_t;
+
+struct rune_context;
+typedef struct rune_dispatch rune_dispatch_t;
+
+/**
+ * @brief Start a pool running ctx's async triggers
+ * @return Pool, or NULL if memory or threads ran out
+ */
+rune_dispatch_t* rune_dispatch_create(struct rune_context* ctx, int workers, rune_trigger_overflow_t overflow);
+
+/**
+ * @brief Run everything still queued, then stop and join the workers
+ */
+void rune_dispatch_destroy(rune_dispatch_t* pool);
+
+/**
+ * @brief Queue one event of ctx->triggers[trigger]
+ * @return 0 if it will run (or ran inline), -1 if it was dropped
+ */
+int rune_dispatch_submit(rune_dispatch_t* pool, int trigger, const rune_checkpoint_record_t* record);
+
+/**
+ * @brief Wait until every event submitted so far has run
+ *
+ * Returns at once when called from one of the pool's own workers.
+ */
+void rune_dispatch_flush(rune_dispatch_t* pool);
+
+/**
+ * @brief Account one callback run in the trigger's statistics (thread-safe)
+ */
+void rune_trigger_account(rune_trigger_t* trigger, uint64_t latency_ns, uint64_t run_ns);
+
+/**
+ * @brief Name of an overflow policy ("drop", "block", "coalesce")
+ */
+const char* rune_trigger_overflow_name(rune_trigger_overflow_t overflow);
+
+#endif /* RUNE_DISPATCH_H */
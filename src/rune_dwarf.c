@@ -0,0 +1,1124 @@
+/**
+ * rune_dwarf.c - Native DWARF reader implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_dwarf.h"
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNE_DWARF_MAX_FORMATS 32           // Entry formats of a DWARF 5 line header
+#define RUNE_DWARF_MAX_HOPS 4               // DW_AT_specification/abstract_origin chain
+#define RUNE_DWARF_NESTING_SCAN 16          // Candidates checked for the innermost function
+#define RUNE_DWARF_BAD_FILE (RUNE_DWARF_END - 1)
+
+// The constants the reader needs; libc has no <dwarf.h>
+enum {
+    DW_UT_compile = 0x01, DW_UT_partial = 0x03, DW_UT_skeleton = 0x04, DW_UT_split_compile = 0x05,
+};
+
+enum {
+    DW_TAG_compile_unit = 0x11, DW_TAG_subprogram = 0x2e, DW_TAG_partial_unit = 0x3c,
+    DW_TAG_skeleton_unit = 0x4a,
+};
+
+enum {
+    DW_AT_name = 0x03, DW_AT_low_pc = 0x11, DW_AT_high_pc = 0x12, DW_AT_comp_dir = 0x1b,
+    DW_AT_abstract_origin = 0x31, DW_AT_declaration = 0x3c, DW_AT_specification = 0x47,
+    DW_AT_ranges = 0x55, DW_AT_str_offsets_base = 0x72, DW_AT_addr_base = 0x73,
+    DW_AT_rnglists_base = 0x74, DW_AT_GNU_addr_base = 0x2133, DW_AT_GNU_ranges_base = 0x2132,
+};
+
+enum {
+    DW_FORM_addr = 0x01, DW_FORM_block2 = 0x03, DW_FORM_block4 = 0x04, DW_FORM_data2 = 0x05,
+    DW_FORM_data4 = 0x06, DW_FORM_data8 = 0x07, DW_FORM_string = 0x08, DW_FORM_block = 0x09,
+    DW_FORM_block1 = 0x0a, DW_FORM_data1 = 0x0b, DW_FORM_flag = 0x0c, DW_FORM_sdata = 0x0d,
+    DW_FORM_strp = 0x0e, DW_FORM_udata = 0x0f, DW_FORM_ref_addr = 0x10, DW_FORM_ref1 = 0x11,
+    DW_FORM_ref2 = 0x12, DW_FORM_ref4 = 0x13, DW_FORM_ref8 = 0x14, DW_FORM_ref_udata = 0x15,
+    DW_FORM_indirect = 0x16, DW_FORM_sec_offset = 0x17, DW_FORM_exprloc = 0x18,
+    DW_FORM_flag_present = 0x19, DW_FORM_strx = 0x1a, DW_FORM_addrx = 0x1b, DW_FORM_ref_sup4 = 0x1c,
+    DW_FORM_strp_sup = 0x1d, DW_FORM_data16 = 0x1e, DW_FORM_line_strp = 0x1f, DW_FORM_ref_sig8 = 0x20,
+    DW_FORM_implicit_const = 0x21, DW_FORM_loclistx = 0x22, DW_FORM_rnglistx = 0x23,
+    DW_FORM_ref_sup8 = 0x24, DW_FORM_strx1 = 0x25, DW_FORM_strx2 = 0x26, DW_FORM_strx3 = 0x27,
+    DW_FORM_strx4 = 0x28, DW_FORM_addrx1 = 0x29, DW_FORM_addrx2 = 0x2a, DW_FORM_addrx3 = 0x2b,
+    DW_FORM_addrx4 = 0x2c, DW_FORM_GNU_addr_index = 0x1f01, DW_FORM_GNU_str_index = 0x1f02,
+    DW_FORM_GNU_ref_alt = 0x1f20, DW_FORM_GNU_strp_alt = 0x1f21,
+};
+
+enum {
+    DW_LNS_copy = 0x01, DW_LNS_advance_pc = 0x02, DW_LNS_advance_line = 0x03, DW_LNS_set_file = 0x04,
+    DW_LNS_set_column = 0x05, DW_LNS_negate_stmt = 0x06, DW_LNS_set_basic_block = 0x07,
+    DW_LNS_const_add_pc = 0x08, DW_LNS_fixed_advance_pc = 0x09, DW_LNS_set_prologue_end = 0x0a,
+    DW_LNS_set_epilogue_begin = 0x0b, DW_LNS_set_isa = 0x0c,
+    DW_LNE_end_sequence = 0x01, DW_LNE_set_address = 0x02,
+    DW_LNCT_path = 0x01, DW_LNCT_directory_index = 0x02,
+};
+
+enum {
+    DW_RLE_end_of_list = 0x00, DW_RLE_base_addressx = 0x01, DW_RLE_startx_endx = 0x02,
+    DW_RLE_startx_length = 0x03, DW_RLE_offset_pair = 0x04, DW_RLE_base_address = 0x05,
+    DW_RLE_start_end = 0x06, DW_RLE_start_length = 0x07,
+};
+
+// Bounded reader: a read past end sets overrun and yields zeros from then on
+typedef struct rune_dwarf_cursor {
+    const rune_elf_t *elf;
+    const uint8_t *p;
+    const uint8_t *end;
+    int overrun;
+} rune_dwarf_cursor_t;
+
+typedef struct rune_dwarf_spec {
+    uint16_t name;              // DW_AT_*
+    uint16_t form;              // DW_FORM_*
+    int64_t implicit_const;
+} rune_dwarf_spec_t;
+
+typedef struct rune_dwarf_abbrev {
+    uint64_t code;
+    uint16_t tag;
+    size_t first_spec;
+    size_t spec_count;
+} rune_dwarf_abbrev_t;
+
+typedef struct rune_dwarf_abbrevs {
+    rune_dwarf_abbrev_t *entries;
+    size_t count;
+    size_t capacity;
+    rune_dwarf_spec_t *specs;
+    size_t spec_count;
+    size_t spec_capacity;
+} rune_dwarf_abbrevs_t;
+
+// What a DIE's attributes need to be read: one compile unit (or line table) header
+typedef struct rune_dwarf_cu {
+    uint64_t offset;            // Of the header in .debug_info
+    uint64_t end;
+    uint16_t version;
+    int offset_size;            // 4, or 8 in 64-bit DWARF
+    int addr_size;
+    uint64_t str_offsets_base;
+    uint64_t addr_base;
+    uint64_t rnglists_base;
+    uint64_t base_address;      // DW_AT_low_pc of the unit, base of its range lists
+    const rune_dwarf_abbrevs_t *abbrevs;
+} rune_dwarf_cu_t;
+
+typedef struct rune_dwarf_value {
+    uint16_t form;              // 0: attribute absent
+    uint64_t u;                 // Constant, address, offset, reference or index
+    const char *string;         // DW_FORM_string
+} rune_dwarf_value_t;
+
+typedef struct rune_dwarf_die {
+    uint16_t tag;
+    int declaration;
+    rune_dwarf_value_t name;
+    rune_dwarf_value_t comp_dir;
+    rune_dwarf_value_t low_pc;
+    rune_dwarf_value_t high_pc;
+    rune_dwarf_value_t ranges;
+    rune_dwarf_value_t origin;  // DW_AT_specification or DW_AT_abstract_origin
+    rune_dwarf_value_t str_offsets_base;
+    rune_dwarf_value_t addr_base;
+    rune_dwarf_value_t rnglists_base;
+} rune_dwarf_die_t;
+
+typedef struct rune_dwarf_sequence {
+    uint64_t address;           // Of the first row
+    size_t first;
+    size_t count;
+} rune_dwarf_sequence_t;
+
+static int rune_dwarf_need(rune_dwarf_cursor_t *c, uint64_t n) {
+    if (c->overrun || n > (uint64_t)(c->end - c->p)) {
+        c->overrun = 1;
+        c->p = c->end;
+        return 0;
+    }
+    return 1;
+}
+
+// Unsigned integer of 1 to 8 bytes in the file's byte order
+static uint64_t rune_dwarf_uint(rune_dwarf_cursor_t *c, int size) {
+    if (size < 1 || size > 8 || !rune_dwarf_need(c, (uint64_t)size)) {
+        c->overrun = 1;
+        return 0;
+    }
+    uint64_t v = 0;
+    for (int i = 0; i < size; i++) {
+        v |= (uint64_t)c->p[c->elf->big_endian ? size - 1 - i : i] << (8 * i);
+    }
+    c->p += size;
+    return v;
+}
+
+static uint64_t rune_dwarf_uleb(rune_dwarf_cursor_t *c) {
+    uint64_t v = 0;
+    for (int shift = 0; rune_dwarf_need(c, 1); shift += 7) {
+        uint8_t b = *c->p++;
+        if (shift < 64) {
+            v |= (uint64_t)(b & 0x7f) << shift;
+        }
+        if (!(b & 0x80)) {
+            return v;
+        }
+    }
+    return 0;
+}
+
+static int64_t rune_dwarf_sleb(rune_dwarf_cursor_t *c) {
+    uint64_t v = 0;
+    for (int shift = 0; rune_dwarf_need(c, 1);) {
+        uint8_t b = *c->p++;
+        if (shift < 64) {
+            v |= (uint64_t)(b & 0x7f) << shift;
+        }
+        shift += 7;
+        if (!(b & 0x80)) {
+            if (shift < 64 && (b & 0x40)) {
+                v |= ~(uint64_t)0 << shift;
+            }
+            return (int64_t)v;
+        }
+    }
+    return 0;
+}
+
+static void rune_dwarf_skip(rune_dwarf_cursor_t *c, uint64_t n) {
+    if (rune_dwarf_need(c, n)) {
+        c->p += n;
+    }
+}
+
+static const char *rune_dwarf_cstring(rune_dwarf_cursor_t *c) {
+    if (c->overrun) {
+        return NULL;
+    }
+    const uint8_t *nul = memchr(c->p, '\0', (size_t)(c->end - c->p));
+    if (!nul) {
+        c->overrun = 1;
+        c->p = c->end;
+        return NULL;
+    }
+    const char *s = (const char *)c->p;
+    c->p = nul + 1;
+    return s;
+}
+
+// Unit length field; *offset_size becomes 8 for 64-bit DWARF
+static uint64_t rune_dwarf_length(rune_dwarf_cursor_t *c, int *offset_size) {
+    uint64_t length = rune_dwarf_uint(c, 4);
+    *offset_size = 4;
+    if (length == 0xffffffffu) {
+        length = rune_dwarf_uint(c, 8);
+        *offset_size = 8;
+    }
+    return length;
+}
+
+static rune_dwarf_cursor_t rune_dwarf_at(const rune_dwarf_t *dwarf, const rune_dwarf_section_t *section,
+                                         uint64_t offset) {
+    rune_dwarf_cursor_t c = { dwarf->elf, section->data, section->data, 0 };
+    if (!section->data || offset > section->size) {
+        c.overrun = 1;
+        return c;
+    }
+    c.p = section->data + offset;
+    c.end = section->data + section->size;
+    return c;
+}
+
+static const char *rune_dwarf_string_at(const rune_dwarf_section_t *section, uint64_t offset) {
+    if (!section->data || offset >= section->size) {
+        return NULL;
+    }
+    const char *s = (const char *)section->data + offset;
+    return memchr(s, '\0', section->size - offset) ? s : NULL;
+}
+
+// Room for one more element in a doubling array; NULL (array untouched) if out of memory
+static void *rune_dwarf_reserve(void *array, size_t *capacity, size_t count, size_t size) {
+    if (count < *capacity) {
+        return array;
+    }
+    size_t grown = *capacity ? *capacity * 2 : 64;
+    void *p = realloc(array, grown * size);
+    if (p) {
+        *capacity = grown;
+    }
+    return p;
+}
+
+static int rune_dwarf_read_abbrevs(const rune_dwarf_t *dwarf, uint64_t offset, rune_dwarf_abbrevs_t *table) {
+    table->count = 0;
+    table->spec_count = 0;
+    rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->abbrev, offset);
+    for (;;) {
+        uint64_t code = rune_dwarf_uleb(&c);
+        if (code == 0 || c.overrun) {
+            return 0;
+        }
+        void *entries = rune_dwarf_reserve(table->entries, &table->capacity, table->count, sizeof(*table->entries));
+        if (!entries) {
+            return -1;
+        }
+        table->entries = entries;
+        rune_dwarf_abbrev_t *abbrev = &table->entries[table->count++];
+        abbrev->code = code;
+        abbrev->tag = (uint16_t)rune_dwarf_uleb(&c);
+        rune_dwarf_skip(&c, 1);         // DW_CHILDREN_*: the walk is flat
+        abbrev->first_spec = table->spec_count;
+        abbrev->spec_count = 0;
+        for (;;) {
+            uint64_t name = rune_dwarf_uleb(&c);
+            uint64_t form = rune_dwarf_uleb(&c);
+            if ((name == 0 && form == 0) || c.overrun) {
+                break;
+            }
+            void *specs = rune_dwarf_reserve(table->specs, &table->spec_capacity, table->spec_count,
+                                             sizeof(*table->specs));
+            if (!specs) {
+                return -1;
+            }
+            table->specs = specs;
+            rune_dwarf_spec_t *spec = &table->specs[table->spec_count++];
+            spec->name = (uint16_t)name;
+            spec->form = (uint16_t)form;
+            spec->implicit_const = form == DW_FORM_implicit_const ? rune_dwarf_sleb(&c) : 0;
+            abbrev->spec_count++;
+        }
+    }
+}
+
+static const rune_dwarf_abbrev_t *rune_dwarf_abbrev(const rune_dwarf_abbrevs_t *table, uint64_t code) {
+    // Producers number abbreviations 1, 2, 3...
+    if (code - 1 < table->count && table->entries[code - 1].code == code) {
+        return &table->entries[code - 1];
+    }
+    for (size_t i = 0; i < table->count; i++) {
+        if (table->entries[i].code == code) {
+            return &table->entries[i];
+        }
+    }
+    return NULL;
+}
+
+static int rune_dwarf_read_form(rune_dwarf_cursor_t *c, const rune_dwarf_cu_t *cu, uint16_t form,
+                                int64_t implicit_const, rune_dwarf_value_t *v) {
+    v->form = form;
+    v->u = 0;
+    v->string = NULL;
+    switch (form) {
+    case DW_FORM_addr:
+        v->u = rune_dwarf_uint(c, cu->addr_size);
+        break;
+    case DW_FORM_block1:
+        rune_dwarf_skip(c, rune_dwarf_uint(c, 1));
+        break;
+    case DW_FORM_block2:
+        rune_dwarf_skip(c, rune_dwarf_uint(c, 2));
+        break;
+    case DW_FORM_block4:
+        rune_dwarf_skip(c, rune_dwarf_uint(c, 4));
+        break;
+    case DW_FORM_block:
+    case DW_FORM_exprloc:
+        rune_dwarf_skip(c, rune_dwarf_uleb(c));
+        break;
+    case DW_FORM_data1: case DW_FORM_ref1: case DW_FORM_flag: case DW_FORM_strx1: case DW_FORM_addrx1:
+        v->u = rune_dwarf_uint(c, 1);
+        break;
+    case DW_FORM_data2: case DW_FORM_ref2: case DW_FORM_strx2: case DW_FORM_addrx2:
+        v->u = rune_dwarf_uint(c, 2);
+        break;
+    case DW_FORM_strx3: case DW_FORM_addrx3:
+        v->u = rune_dwarf_uint(c, 3);
+        break;
+    case DW_FORM_data4: case DW_FORM_ref4: case DW_FORM_strx4: case DW_FORM_addrx4: case DW_FORM_ref_sup4:
+        v->u = rune_dwarf_uint(c, 4);
+        break;
+    case DW_FORM_data8: case DW_FORM_ref8: case DW_FORM_ref_sig8: case DW_FORM_ref_sup8:
+        v->u = rune_dwarf_uint(c, 8);
+        break;
+    case DW_FORM_data16:
+        rune_dwarf_skip(c, 16);
+        break;
+    case DW_FORM_string:
+        v->string = rune_dwarf_cstring(c);
+        break;
+    case DW_FORM_sdata:
+        v->u = (uint64_t)rune_dwarf_sleb(c);
+        break;
+    case DW_FORM_udata: case DW_FORM_ref_udata: case DW_FORM_strx: case DW_FORM_addrx:
+    case DW_FORM_loclistx: case DW_FORM_rnglistx: case DW_FORM_GNU_addr_index: case DW_FORM_GNU_str_index:
+        v->u = rune_dwarf_uleb(c);
+        break;
+    case DW_FORM_strp: case DW_FORM_line_strp: case DW_FORM_sec_offset: case DW_FORM_strp_sup:
+    case DW_FORM_GNU_ref_alt: case DW_FORM_GNU_strp_alt:
+        v->u = rune_dwarf_uint(c, cu->offset_size);
+        break;
+    case DW_FORM_ref_addr:
+        v->u = rune_dwarf_uint(c, cu->version <= 2 ? cu->addr_size : cu->offset_size);
+        break;
+    case DW_FORM_flag_present:
+        v->u = 1;
+        break;
+    case DW_FORM_implicit_const:
+        v->u = (uint64_t)implicit_const;
+        break;
+    case DW_FORM_indirect: {
+        uint16_t actual = (uint16_t)rune_dwarf_uleb(c);
+        if (actual == DW_FORM_indirect) {
+            return -1;
+        }
+        return rune_dwarf_read_form(c, cu, actual, implicit_const, v);
+    }
+    default:
+        return -1;              // Unknown size: the rest of the unit cannot be decoded
+    }
+    return c->overrun ? -1 : 0;
+}
+
+static const char *rune_dwarf_value_string(const rune_dwarf_t *dwarf, const rune_dwarf_cu_t *cu,
+                                           const rune_dwarf_value_t *v) {
+    switch (v->form) {
+    case DW_FORM_string:
+        return v->string;
+    case DW_FORM_strp:
+        return rune_dwarf_string_at(&dwarf->str, v->u);
+    case DW_FORM_line_strp:
+        return rune_dwarf_string_at(&dwarf->line_str, v->u);
+    case DW_FORM_strx: case DW_FORM_strx1: case DW_FORM_strx2: case DW_FORM_strx3: case DW_FORM_strx4:
+    case DW_FORM_GNU_str_index: {
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->str_offsets,
+                                              cu->str_offsets_base + v->u * (uint64_t)cu->offset_size);
+        uint64_t offset = rune_dwarf_uint(&c, cu->offset_size);
+        return c.overrun ? NULL : rune_dwarf_string_at(&dwarf->str, offset);
+    }
+    default:
+        return NULL;
+    }
+}
+
+static int rune_dwarf_addrx(const rune_dwarf_t *dwarf, const rune_dwarf_cu_t *cu, uint64_t index, uint64_t *addr) {
+    rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->addr, cu->addr_base + index * (uint64_t)cu->addr_size);
+    *addr = rune_dwarf_uint(&c, cu->addr_size);
+    return c.overrun ? -1 : 0;
+}
+
+static int rune_dwarf_value_address(const rune_dwarf_t *dwarf, const rune_dwarf_cu_t *cu,
+                                    const rune_dwarf_value_t *v, uint64_t *addr) {
+    switch (v->form) {
+    case DW_FORM_addr:
+        *addr = v->u;
+        return 0;
+    case DW_FORM_addrx: case DW_FORM_addrx1: case DW_FORM_addrx2: case DW_FORM_addrx3: case DW_FORM_addrx4:
+    case DW_FORM_GNU_addr_index:
+        return rune_dwarf_addrx(dwarf, cu, v->u, addr);
+    default:
+        return -1;
+    }
+}
+
+/**
+ * Decode the DIE at the cursor, keeping the attributes the indexes use.
+ * Returns 1 for the null entry that ends a sibling list, -1 if the unit
+ * cannot be decoded further.
+ */
+static int rune_dwarf_read_die(const rune_dwarf_cu_t *cu, rune_dwarf_cursor_t *c, rune_dwarf_die_t *die) {
+    uint64_t code = rune_dwarf_uleb(c);
+    if (c->overrun) {
+        return -1;
+    }
+    if (code == 0) {
+        return 1;
+    }
+    const rune_dwarf_abbrev_t *abbrev = rune_dwarf_abbrev(cu->abbrevs, code);
+    if (!abbrev) {
+        return -1;
+    }
+    memset(die, 0, sizeof(*die));
+    die->tag = abbrev->tag;
+    for (size_t i = 0; i < abbrev->spec_count; i++) {
+        const rune_dwarf_spec_t *spec = &cu->abbrevs->specs[abbrev->first_spec + i];
+        rune_dwarf_value_t v;
+        if (rune_dwarf_read_form(c, cu, spec->form, spec->implicit_const, &v) != 0) {
+            return -1;
+        }
+        switch (spec->name) {
+        case DW_AT_name: die->name = v; break;
+        case DW_AT_comp_dir: die->comp_dir = v; break;
+        case DW_AT_low_pc: die->low_pc = v; break;
+        case DW_AT_high_pc: die->high_pc = v; break;
+        case DW_AT_ranges: die->ranges = v; break;
+        case DW_AT_specification: case DW_AT_abstract_origin: die->origin = v; break;
+        case DW_AT_declaration: die->declaration = v.u != 0; break;
+        case DW_AT_str_offsets_base: die->str_offsets_base = v; break;
+        case DW_AT_addr_base: case DW_AT_GNU_addr_base: die->addr_base = v; break;
+        case DW_AT_rnglists_base: case DW_AT_GNU_ranges_base: die->rnglists_base = v; break;
+        default: break;
+        }
+    }
+    return 0;
+}
+
+// Name of a DIE, through the declaration or abstract instance it completes
+static const char *rune_dwarf_die_name(const rune_dwarf_t *dwarf, const rune_dwarf_cu_t *cu,
+                                       const rune_dwarf_die_t *die) {
+    rune_dwarf_die_t ref;
+    for (int hop = 0; hop <= RUNE_DWARF_MAX_HOPS; hop++) {
+        if (die->name.form) {
+            return rune_dwarf_value_string(dwarf, cu, &die->name);
+        }
+        uint64_t target;
+        switch (die->origin.form) {
+        case DW_FORM_ref1: case DW_FORM_ref2: case DW_FORM_ref4: case DW_FORM_ref8: case DW_FORM_ref_udata:
+            target = cu->offset + die->origin.u;
+            break;
+        case DW_FORM_ref_addr:
+            target = die->origin.u;
+            break;
+        default:
+            return NULL;
+        }
+        // Only a DIE of this unit shares its abbreviation table
+        if (target <= cu->offset || target >= cu->end) {
+            return NULL;
+        }
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->info, target);
+        c.end = dwarf->info.data + cu->end;
+        if (rune_dwarf_read_die(cu, &c, &ref) != 0) {
+            return NULL;
+        }
+        die = &ref;
+    }
+    return NULL;
+}
+
+static int rune_dwarf_add_function(rune_dwarf_t *dwarf, size_t *capacity, const char *name,
+                                   uint64_t low, uint64_t high, size_t unit) {
+    // Code the linker discarded keeps its ranges, relocated to 0
+    if (low == 0 || high <= low) {
+        return 0;
+    }
+    void *functions = rune_dwarf_reserve(dwarf->functions, capacity, dwarf->function_count,
+                                         sizeof(*dwarf->functions));
+    if (!functions) {
+        return -1;
+    }
+    dwarf->functions = functions;
+    dwarf->functions[dwarf->function_count++] = (rune_dwarf_function_t){
+        .name = name, .low = low, .high = high, .unit = (uint32_t)unit,
+    };
+    return 0;
+}
+
+// Every part of a function with DW_AT_ranges (hot/cold splitting)
+static int rune_dwarf_add_ranges(rune_dwarf_t *dwarf, size_t *capacity, const rune_dwarf_cu_t *cu,
+                                 const rune_dwarf_value_t *ranges, const char *name, size_t unit) {
+    uint64_t base = cu->base_address;
+    if (cu->version < 5) {
+        uint64_t select = cu->addr_size == 8 ? UINT64_MAX : 0xffffffffu;
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->ranges, ranges->u);
+        for (;;) {
+            uint64_t start = rune_dwarf_uint(&c, cu->addr_size);
+            uint64_t end = rune_dwarf_uint(&c, cu->addr_size);
+            if (c.overrun || (start == 0 && end == 0)) {
+                return 0;
+            }
+            if (start == select) {
+                base = end;
+            } else if (rune_dwarf_add_function(dwarf, capacity, name, base + start, base + end, unit) != 0) {
+                return -1;
+            }
+        }
+    }
+
+    uint64_t offset = ranges->u;
+    if (ranges->form == DW_FORM_rnglistx) {
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->rnglists,
+                                              cu->rnglists_base + ranges->u * (uint64_t)cu->offset_size);
+        offset = cu->rnglists_base + rune_dwarf_uint(&c, cu->offset_size);
+        if (c.overrun) {
+            return 0;
+        }
+    }
+    rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->rnglists, offset);
+    for (;;) {
+        uint64_t start = 0, end = 0;
+        uint8_t kind = (uint8_t)rune_dwarf_uint(&c, 1);
+        if (c.overrun) {
+            return 0;
+        }
+        switch (kind) {
+        case DW_RLE_base_addressx:
+            if (rune_dwarf_addrx(dwarf, cu, rune_dwarf_uleb(&c), &base) != 0) {
+                return 0;
+            }
+            continue;
+        case DW_RLE_base_address:
+            base = rune_dwarf_uint(&c, cu->addr_size);
+            continue;
+        case DW_RLE_startx_endx:
+            if (rune_dwarf_addrx(dwarf, cu, rune_dwarf_uleb(&c), &start) != 0 ||
+                rune_dwarf_addrx(dwarf, cu, rune_dwarf_uleb(&c), &end) != 0) {
+                return 0;
+            }
+            break;
+        case DW_RLE_startx_length:
+            if (rune_dwarf_addrx(dwarf, cu, rune_dwarf_uleb(&c), &start) != 0) {
+                return 0;
+            }
+            end = start + rune_dwarf_uleb(&c);
+            break;
+        case DW_RLE_offset_pair:
+            start = base + rune_dwarf_uleb(&c);
+            end = base + rune_dwarf_uleb(&c);
+            break;
+        case DW_RLE_start_end:
+            start = rune_dwarf_uint(&c, cu->addr_size);
+            end = rune_dwarf_uint(&c, cu->addr_size);
+            break;
+        case DW_RLE_start_length:
+            start = rune_dwarf_uint(&c, cu->addr_size);
+            end = start + rune_dwarf_uleb(&c);
+            break;
+        default:                // DW_RLE_end_of_list, or something newer than we know
+            return 0;
+        }
+        if (!c.overrun && rune_dwarf_add_function(dwarf, capacity, name, start, end, unit) != 0) {
+            return -1;
+        }
+    }
+}
+
+// One compile unit: its header, unit DIE and every subprogram with code
+static int rune_dwarf_index_unit(rune_dwarf_t *dwarf, rune_dwarf_cu_t *cu, rune_dwarf_cursor_t *c,
+                                 size_t *unit_capacity, size_t *function_capacity) {
+    size_t unit = dwarf->unit_count;
+    rune_dwarf_die_t die;
+    int r = rune_dwarf_read_die(cu, c, &die);
+    if (r != 0 || (die.tag != DW_TAG_compile_unit && die.tag != DW_TAG_partial_unit &&
+                   die.tag != DW_TAG_skeleton_unit)) {
+        return 0;
+    }
+    // The bases first: the unit's own name may be a string index
+    cu->str_offsets_base = die.str_offsets_base.u;
+    cu->addr_base = die.addr_base.u;
+    cu->rnglists_base = die.rnglists_base.u;
+    if (die.low_pc.form) {
+        rune_dwarf_value_address(dwarf, cu, &die.low_pc, &cu->base_address);
+    }
+    void *units = rune_dwarf_reserve(dwarf->units, unit_capacity, dwarf->unit_count, sizeof(*dwarf->units));
+    if (!units) {
+        return -1;
+    }
+    dwarf->units = units;
+    const char *name = rune_dwarf_value_string(dwarf, cu, &die.name);
+    dwarf->units[dwarf->unit_count++] = (rune_dwarf_unit_t){
+        .name = name ? name : "",
+        .comp_dir = rune_dwarf_value_string(dwarf, cu, &die.comp_dir),
+        .version = cu->version,
+    };
+
+    while ((r = rune_dwarf_read_die(cu, c, &die)) >= 0) {
+        if (r > 0 || die.tag != DW_TAG_subprogram || die.declaration) {
+            continue;
+        }
+        if (!die.ranges.form && !(die.low_pc.form && die.high_pc.form)) {
+            continue;           // Abstract instances and declarations: no code of their own
+        }
+        name = rune_dwarf_die_name(dwarf, cu, &die);
+        if (!name) {
+            continue;
+        }
+        if (die.ranges.form) {
+            if (rune_dwarf_add_ranges(dwarf, function_capacity, cu, &die.ranges, name, unit) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        uint64_t low, high;
+        if (rune_dwarf_value_address(dwarf, cu, &die.low_pc, &low) != 0) {
+            continue;
+        }
+        // DWARF 4+: a constant high_pc is the length
+        if (rune_dwarf_value_address(dwarf, cu, &die.high_pc, &high) != 0) {
+            high = low + die.high_pc.u;
+        }
+        if (rune_dwarf_add_function(dwarf, function_capacity, name, low, high, unit) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int rune_dwarf_function_order(const void *a, const void *b) {
+    const rune_dwarf_function_t *x = a, *y = b;
+    if (x->low != y->low) {
+        return x->low < y->low ? -1 : 1;
+    }
+    // Enclosing range first, so the innermost one is found last
+    return x->high > y->high ? -1 : x->high < y->high;
+}
+
+static void rune_dwarf_index_units(rune_dwarf_t *dwarf) {
+    dwarf->units_indexed = 1;
+    rune_dwarf_abbrevs_t abbrevs = { 0 };
+    size_t unit_capacity = 0, function_capacity = 0;
+    uint64_t offset = 0;
+
+    while (offset < dwarf->info.size) {
+        rune_dwarf_cu_t cu = { .offset = offset, .abbrevs = &abbrevs };
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->info, offset);
+        uint64_t length = rune_dwarf_length(&c, &cu.offset_size);
+        if (c.overrun || length == 0 || length > (uint64_t)(c.end - c.p)) {
+            break;
+        }
+        c.end = c.p + length;
+        cu.end = (uint64_t)(c.end - dwarf->info.data);
+        offset = cu.end;
+
+        cu.version = (uint16_t)rune_dwarf_uint(&c, 2);
+        uint8_t unit_type = DW_UT_compile;
+        uint64_t abbrev_offset;
+        if (cu.version >= 5) {
+            unit_type = (uint8_t)rune_dwarf_uint(&c, 1);
+            cu.addr_size = (int)rune_dwarf_uint(&c, 1);
+            abbrev_offset = rune_dwarf_uint(&c, cu.offset_size);
+            if (unit_type == DW_UT_skeleton || unit_type == DW_UT_split_compile) {
+                rune_dwarf_skip(&c, 8);         // dwo_id
+            }
+        } else {
+            abbrev_offset = rune_dwarf_uint(&c, cu.offset_size);
+            cu.addr_size = (int)rune_dwarf_uint(&c, 1);
+        }
+        // Type units describe no code
+        if (c.overrun || cu.version < 2 || cu.version > 5 || (cu.addr_size != 4 && cu.addr_size != 8) ||
+            (unit_type != DW_UT_compile && unit_type != DW_UT_partial && unit_type != DW_UT_skeleton)) {
+            continue;
+        }
+        if (rune_dwarf_read_abbrevs(dwarf, abbrev_offset, &abbrevs) != 0 ||
+            rune_dwarf_index_unit(dwarf, &cu, &c, &unit_capacity, &function_capacity) != 0) {
+            break;              // Out of memory: keep what is indexed
+        }
+    }
+    free(abbrevs.entries);
+    free(abbrevs.specs);
+    if (dwarf->function_count > 1) {
+        qsort(dwarf->functions, dwarf->function_count, sizeof(*dwarf->functions), rune_dwarf_function_order);
+    }
+}
+
+static int rune_dwarf_add_file(rune_dwarf_t *dwarf, size_t *capacity, const char *name, const char *directory) {
+    void *files = rune_dwarf_reserve(dwarf->files, capacity, dwarf->file_count, sizeof(*dwarf->files));
+    if (!files) {
+        return -1;
+    }
+    dwarf->files = files;
+    dwarf->files[dwarf->file_count++] = (rune_dwarf_file_t){ .name = name ? name : "", .directory = directory };
+    return 0;
+}
+
+// DWARF 5 directory or file entries, described by (content type, form) pairs
+static int rune_dwarf_read_entries(rune_dwarf_t *dwarf, rune_dwarf_cursor_t *c, const rune_dwarf_cu_t *cu,
+                                   const char ***directories, size_t *directory_count, size_t *file_capacity) {
+    uint64_t content[RUNE_DWARF_MAX_FORMATS];
+    uint16_t forms[RUNE_DWARF_MAX_FORMATS];
+    size_t format_count = (size_t)rune_dwarf_uint(c, 1);
+    if (format_count > RUNE_DWARF_MAX_FORMATS) {
+        c->overrun = 1;
+        return 0;
+    }
+    for (size_t i = 0; i < format_count; i++) {
+        content[i] = rune_dwarf_uleb(c);
+        forms[i] = (uint16_t)rune_dwarf_uleb(c);
+    }
+    uint64_t count = rune_dwarf_uleb(c);
+    size_t directory_capacity = *directory_count;
+    for (uint64_t n = 0; n < count && !c->overrun; n++) {
+        const char *path = NULL;
+        uint64_t directory = 0;
+        for (size_t i = 0; i < format_count; i++) {
+            rune_dwarf_value_t v;
+            if (rune_dwarf_read_form(c, cu, forms[i], 0, &v) != 0) {
+                c->overrun = 1;
+                return 0;
+            }
+            if (content[i] == DW_LNCT_path) {
+                path = rune_dwarf_value_string(dwarf, cu, &v);
+            } else if (content[i] == DW_LNCT_directory_index) {
+                directory = v.u;
+            }
+        }
+        if (file_capacity) {
+            const char *dir = directory < *directory_count ? (*directories)[directory] : NULL;
+            if (rune_dwarf_add_file(dwarf, file_capacity, path, dir) != 0) {
+                return -1;
+            }
+            continue;
+        }
+        void *grown = rune_dwarf_reserve(*directories, &directory_capacity, *directory_count, sizeof(**directories));
+        if (!grown) {
+            return -1;
+        }
+        *directories = grown;
+        (*directories)[(*directory_count)++] = path;
+    }
+    return 0;
+}
+
+static int rune_dwarf_add_row(rune_dwarf_t *dwarf, size_t *capacity, uint64_t address, uint32_t file, uint32_t line) {
+    void *rows = rune_dwarf_reserve(dwarf->rows, capacity, dwarf->row_count, sizeof(*dwarf->rows));
+    if (!rows) {
+        return -1;
+    }
+    dwarf->rows = rows;
+    dwarf->rows[dwarf->row_count++] = (rune_dwarf_row_t){ .address = address, .file = file, .line = line };
+    return 0;
+}
+
+typedef struct rune_dwarf_line_state {
+    size_t row_capacity;
+    size_t file_capacity;
+    rune_dwarf_sequence_t *sequences;
+    size_t sequence_count;
+    size_t sequence_capacity;
+} rune_dwarf_line_state_t;
+
+// A finished sequence of rows; those the linker discarded (at address 0) are dropped
+static int rune_dwarf_end_sequence(rune_dwarf_t *dwarf, rune_dwarf_line_state_t *state, size_t first) {
+    if (dwarf->row_count - first < 2 || dwarf->rows[first].address == 0) {
+        dwarf->row_count = first;
+        return 0;
+    }
+    void *grown = rune_dwarf_reserve(state->sequences, &state->sequence_capacity, state->sequence_count,
+                                     sizeof(*state->sequences));
+    if (!grown) {
+        return -1;
+    }
+    state->sequences = grown;
+    state->sequences[state->sequence_count++] = (rune_dwarf_sequence_t){
+        .address = dwarf->rows[first].address, .first = first, .count = dwarf->row_count - first,
+    };
+    return 0;
+}
+
+// One line number program: header, file table, then the state machine
+static int rune_dwarf_line_program(rune_dwarf_t *dwarf, rune_dwarf_cursor_t *c, int offset_size,
+                                   rune_dwarf_line_state_t *state) {
+    rune_dwarf_cu_t cu = { .offset_size = offset_size, .addr_size = dwarf->elf->bits / 8 };
+    cu.version = (uint16_t)rune_dwarf_uint(c, 2);
+    if (cu.version < 2 || cu.version > 5) {
+        return 0;
+    }
+    if (cu.version >= 5) {
+        cu.addr_size = (int)rune_dwarf_uint(c, 1);
+        rune_dwarf_skip(c, 1);                  // segment_selector_size
+    }
+    uint64_t header_length = rune_dwarf_uint(c, offset_size);
+    if (c->overrun || header_length > (uint64_t)(c->end - c->p)) {
+        return 0;
+    }
+    const uint8_t *program = c->p + header_length;
+    uint8_t min_length = (uint8_t)rune_dwarf_uint(c, 1);
+    if (cu.version >= 4) {
+        rune_dwarf_skip(c, 1);                  // maximum_operations_per_instruction: no VLIW
+    }
+    rune_dwarf_skip(c, 1);                      // default_is_stmt
+    int8_t line_base = (int8_t)rune_dwarf_uint(c, 1);
+    uint8_t line_range = (uint8_t)rune_dwarf_uint(c, 1);
+    uint8_t opcode_base = (uint8_t)rune_dwarf_uint(c, 1);
+    const uint8_t *opcode_lengths = c->p;
+    rune_dwarf_skip(c, opcode_base ? opcode_base - 1u : 0);
+    if (c->overrun || line_range == 0 || opcode_base == 0) {
+        return 0;
+    }
+
+    // File numbers count from 1 before DWARF 5, from 0 since
+    size_t file_base = dwarf->file_count;
+    uint32_t file_bias = cu.version >= 5 ? 0 : 1;
+    const char **directories = NULL;
+    size_t directory_count = 0;
+    int status = 0;
+    if (cu.version >= 5) {
+        if (rune_dwarf_read_entries(dwarf, c, &cu, &directories, &directory_count, NULL) != 0 ||
+            rune_dwarf_read_entries(dwarf, c, &cu, &directories, &directory_count, &state->file_capacity) != 0) {
+            status = -1;
+        }
+    } else {
+        size_t directory_capacity = 0;
+        // Directory 0 is the compilation directory, which the header does not repeat
+        for (const char *dir = NULL; status == 0; dir = rune_dwarf_cstring(c)) {
+            if (directory_count > 0 && (!dir || !*dir)) {
+                break;
+            }
+            void *grown = rune_dwarf_reserve(directories, &directory_capacity, directory_count, sizeof(*directories));
+            if (!grown) {
+                status = -1;
+                break;
+            }
+            directories = grown;
+            directories[directory_count++] = dir;
+        }
+        while (status == 0) {
+            const char *name = rune_dwarf_cstring(c);
+            if (!name || !*name) {
+                break;
+            }
+            uint64_t dir = rune_dwarf_uleb(c);
+            rune_dwarf_uleb(c);                 // Modification time
+            rune_dwarf_uleb(c);                 // Length
+            status = rune_dwarf_add_file(dwarf, &state->file_capacity, name,
+                                         dir < directory_count ? directories[dir] : NULL);
+        }
+    }
+    free(directories);
+    if (status != 0) {
+        return -1;
+    }
+    size_t file_count = dwarf->file_count - file_base;
+
+    c->p = program;
+    c->overrun = 0;
+    uint64_t address = 0;
+    uint64_t file = 1;
+    int64_t line = 1;
+    size_t first = dwarf->row_count;
+#define RUNE_DWARF_ROW() \
+    rune_dwarf_add_row(dwarf, &state->row_capacity, address, \
+                       file - file_bias < file_count ? (uint32_t)(file_base + file - file_bias) : RUNE_DWARF_BAD_FILE, \
+                       line > 0 && line <= UINT32_MAX ? (uint32_t)line : 0)
+
+    while (c->p < c->end && !c->overrun) {
+        uint8_t op = (uint8_t)rune_dwarf_uint(c, 1);
+        if (op >= opcode_base) {
+            uint8_t adjusted = op - opcode_base;
+            address += (uint64_t)(adjusted / line_range) * min_length;
+            line += line_base + adjusted % line_range;
+            if (RUNE_DWARF_ROW() != 0) {
+                return -1;
+            }
+            continue;
+        }
+        switch (op) {
+        case 0: {
+            uint64_t length = rune_dwarf_uleb(c);
+            if (length == 0 || length > (uint64_t)(c->end - c->p)) {
+                c->overrun = 1;
+                break;
+            }
+            const uint8_t *next = c->p + length;
+            uint8_t sub = (uint8_t)rune_dwarf_uint(c, 1);
+            if (sub == DW_LNE_end_sequence) {
+                if (rune_dwarf_add_row(dwarf, &state->row_capacity, address, RUNE_DWARF_END, 0) != 0 ||
+                    rune_dwarf_end_sequence(dwarf, state, first) != 0) {
+                    return -1;
+                }
+                address = 0;
+                file = 1;
+                line = 1;
+                first = dwarf->row_count;
+            } else if (sub == DW_LNE_set_address && length - 1 <= 8) {
+                address = rune_dwarf_uint(c, (int)(length - 1));
+            }
+            c->p = next;        // DW_LNE_define_file, set_discriminator and vendor opcodes
+            break;
+        }
+        case DW_LNS_copy:
+            if (RUNE_DWARF_ROW() != 0) {
+                return -1;
+            }
+            break;
+        case DW_LNS_advance_pc:
+            address += rune_dwarf_uleb(c) * min_length;
+            break;
+        case DW_LNS_advance_line:
+            line += rune_dwarf_sleb(c);
+            break;
+        case DW_LNS_set_file:
+            file = rune_dwarf_uleb(c);
+            break;
+        case DW_LNS_const_add_pc:
+            address += (uint64_t)((255 - opcode_base) / line_range) * min_length;
+            break;
+        case DW_LNS_fixed_advance_pc:
+            address += rune_dwarf_uint(c, 2);
+            break;
+        case DW_LNS_negate_stmt:
+        case DW_LNS_set_basic_block:
+        case DW_LNS_set_prologue_end:
+        case DW_LNS_set_epilogue_begin:
+            break;
+        case DW_LNS_set_column:
+        case DW_LNS_set_isa:
+        default:                // Unknown standard opcodes declare their operand count
+            for (uint8_t n = op == DW_LNS_set_column || op == DW_LNS_set_isa ? 1 : opcode_lengths[op - 1]; n; n--) {
+                rune_dwarf_uleb(c);
+            }
+            break;
+        }
+    }
+#undef RUNE_DWARF_ROW
+    dwarf->row_count = first;   // A sequence left open is not trusted
+    return 0;
+}
+
+static int rune_dwarf_sequence_order(const void *a, const void *b) {
+    const rune_dwarf_sequence_t *x = a, *y = b;
+    return x->address < y->address ? -1 : x->address > y->address;
+}
+
+static void rune_dwarf_index_lines(rune_dwarf_t *dwarf) {
+    dwarf->lines_indexed = 1;
+    rune_dwarf_line_state_t state = { 0 };
+    uint64_t offset = 0;
+    while (offset < dwarf->line.size) {
+        rune_dwarf_cursor_t c = rune_dwarf_at(dwarf, &dwarf->line, offset);
+        int offset_size;
+        uint64_t length = rune_dwarf_length(&c, &offset_size);
+        if (c.overrun || length == 0 || length > (uint64_t)(c.end - c.p)) {
+            break;
+        }
+        c.end = c.p + length;
+        offset = (uint64_t)(c.end - dwarf->line.data);
+        if (rune_dwarf_line_program(dwarf, &c, offset_size, &state) != 0) {
+            break;              // Out of memory: keep the finished sequences
+        }
+    }
+
+    // Each sequence is in address order already; order the sequences
+    rune_dwarf_row_t *rows = state.sequence_count ? malloc(dwarf->row_count * sizeof(*rows)) : NULL;
+    if (rows) {
+        qsort(state.sequences, state.sequence_count, sizeof(*state.sequences), rune_dwarf_sequence_order);
+        size_t count = 0;
+        for (size_t i = 0; i < state.sequence_count; i++) {
+            memcpy(&rows[count], &dwarf->rows[state.sequences[i].first],
+                   state.sequences[i].count * sizeof(*rows));
+            count += state.sequences[i].count;
+        }
+        free(dwarf->rows);
+        dwarf->rows = rows;
+        dwarf->row_count = count;
+    } else {
+        free(dwarf->rows);
+        dwarf->rows = NULL;
+        dwarf->row_count = 0;
+    }
+    free(state.sequences);
+}
+
+static int rune_dwarf_find_section(const rune_elf_t *elf, const char *name, rune_dwarf_section_t *section) {
+    const rune_elf_section_t *s = rune_elf_section(elf, name);
+    if (!s) {
+        return 0;
+    }
+    if (s->flags & SHF_COMPRESSED) {
+        return -1;
+    }
+    section->data = rune_elf_section_data(elf, s);
+    section->size = section->data ? (size_t)s->size : 0;
+    return 0;
+}
+
+int rune_dwarf_open(rune_dwarf_t *dwarf, const rune_elf_t *elf) {
+    memset(dwarf, 0, sizeof(*dwarf));
+    dwarf->elf = elf;
+    if (rune_dwarf_find_section(elf, ".debug_info", &dwarf->info) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_abbrev", &dwarf->abbrev) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_line", &dwarf->line) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_str", &dwarf->str) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_line_str", &dwarf->line_str) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_str_offsets", &dwarf->str_offsets) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_addr", &dwarf->addr) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_ranges", &dwarf->ranges) != 0 ||
+        rune_dwarf_find_section(elf, ".debug_rnglists", &dwarf->rnglists) != 0) {
+        errno = EOPNOTSUPP;
+        return -1;
+    }
+    if (!dwarf->info.data || !dwarf->abbrev.data) {
+        errno = rune_elf_section(elf, ".zdebug_info") ? EOPNOTSUPP : ENODATA;
+        return -1;
+    }
+    return 0;
+}
+
+void rune_dwarf_close(rune_dwarf_t *dwarf) {
+    free(dwarf->units);
+    free(dwarf->functions);
+    free(dwarf->rows);
+    free(dwarf->files);
+    memset(dwarf, 0, sizeof(*dwarf));
+}
+
+size_t rune_dwarf_units(rune_dwarf_t *dwarf, const rune_dwarf_unit_t **units) {
+    if (!dwarf->units_indexed) {
+        rune_dwarf_index_units(dwarf);
+    }
+    *units = dwarf->units;
+    return dwarf->unit_count;
+}
+
+const rune_dwarf_function_t *rune_dwarf_function_at(rune_dwarf_t *dwarf, uint64_t addr) {
+    if (!dwarf->units_indexed) {
+        rune_dwarf_index_units(dwarf);
+    }
+    // Last range starting at or before addr, then back to one that still covers it
+    size_t lo = 0, hi = dwarf->function_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (dwarf->functions[mid].low <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (size_t i = lo, scanned = 0; i > 0 && scanned < RUNE_DWARF_NESTING_SCAN; i--, scanned++) {
+        if (addr < dwarf->functions[i - 1].high) {
+            return &dwarf->functions[i - 1];
+        }
+    }
+    return NULL;
+}
+
+const rune_dwarf_function_t *rune_dwarf_function(rune_dwarf_t *dwarf, const char *name) {
+    if (!dwarf->units_indexed) {
+        rune_dwarf_index_units(dwarf);
+    }
+    for (size_t i = 0; i < dwarf->function_count; i++) {
+        if (strcmp(dwarf->functions[i].name, name) == 0) {
+            return &dwarf->functions[i];
+        }
+    }
+    return NULL;
+}
+
+int rune_dwarf_line(rune_dwarf_t *dwarf, uint64_t addr, const rune_dwarf_file_t **file, uint32_t *line) {
+    if (!dwarf->lines_indexed) {
+        rune_dwarf_index_lines(dwarf);
+    }
+    size_t lo = 0, hi = dwarf->row_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (dwarf->rows[mid].address <= addr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return -1;
+    }
+    const rune_dwarf_row_t *row = &dwarf->rows[lo - 1];
+    if (row->file == RUNE_DWARF_END || row->line == 0) {
+        return -1;
+    }
+    *file = row->file < dwarf->file_count ? &dwarf->files[row->file] : NULL;
+    *line = row->line;
+    return 0;
+}
@@ -0,0 +1,123 @@
+/**
+ * rune_dwarf.h - Native DWARF reader for source-level pinpointing
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Reads DWARF 2 to 5 straight out of a rune_elf_t mapping: compile-unit
+ * headers and subprogram ranges from .debug_info, the line programs of
+ * .debug_line, and the strings of .debug_str/.debug_line_str/
+ * .debug_str_offsets. Opening only locates the sections; the function
+ * index is built by the first unit or function query and the line
+ * table by the first address query, each sorted once so every lookup
+ * is a binary search.
+ *
+ * Addresses are link-time (as in the file), not runtime. Compressed
+ * debug sections are not supported. Strings point into the mapping and
+ * stay valid while the ELF is open.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_DWARF_H
+#define RUNE_DWARF_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rune_elf.h"
+
+typedef struct rune_dwarf_section {
+    const uint8_t *data;        // NULL if the section is absent
+    size_t size;
+} rune_dwarf_section_t;
+
+typedef struct rune_dwarf_unit {
+    const char *name;           // DW_AT_name: the primary source file
+    const char *comp_dir;       // NULL if not recorded
+    uint16_t version;
+} rune_dwarf_unit_t;
+
+typedef struct rune_dwarf_function {
+    const char *name;
+    uint64_t low;               // [low, high); a function split in parts has one entry per part
+    uint64_t high;
+    uint32_t unit;              // Index into units
+} rune_dwarf_function_t;
+
+typedef struct rune_dwarf_row {
+    uint64_t address;
+    uint32_t file;              // Index into files (past its end if the program names a bad file),
+                                // RUNE_DWARF_END: past the end of a sequence
+    uint32_t line;
+} rune_dwarf_row_t;
+
+#define RUNE_DWARF_END UINT32_MAX
+
+typedef struct rune_dwarf_file {
+    const char *name;           // As recorded, often relative to directory
+    const char *directory;      // NULL if not recorded
+} rune_dwarf_file_t;
+
+typedef struct rune_dwarf {
+    const rune_elf_t *elf;
+    rune_dwarf_section_t info;
+    rune_dwarf_section_t abbrev;
+    rune_dwarf_section_t line;
+    rune_dwarf_section_t str;
+    rune_dwarf_section_t line_str;
+    rune_dwarf_section_t str_offsets;
+    rune_dwarf_section_t addr;
+    rune_dwarf_section_t ranges;
+    rune_dwarf_section_t rnglists;
+
+    // Built by the first unit or function query
+    int units_indexed;
+    rune_dwarf_unit_t *units;
+    size_t unit_count;
+    rune_dwarf_function_t *functions;   // Sorted by low
+    size_t function_count;
+
+    // Built by the first address query
+    int lines_indexed;
+    rune_dwarf_row_t *rows;             // Sorted by address
+    size_t row_count;
+    rune_dwarf_file_t *files;
+    size_t file_count;
+} rune_dwarf_t;
+
+/**
+ * @brief Locate the debug sections of elf, which must stay open
+ * @return 0 on success, -1 on error (errno ENODATA: no .debug_info,
+ *         EOPNOTSUPP: the debug sections are compressed)
+ */
+int rune_dwarf_open(rune_dwarf_t *dwarf, const rune_elf_t *elf);
+
+/**
+ * @brief Free the indexes (safe on a failed open)
+ */
+void rune_dwarf_close(rune_dwarf_t *dwarf);
+
+/**
+ * @brief Compile units, in .debug_info order
+ * @return The unit count (0 if the index could not be built)
+ */
+size_t rune_dwarf_units(rune_dwarf_t *dwarf, const rune_dwarf_unit_t **units);
+
+/**
+ * @brief Innermost function whose range holds addr, or NULL
+ */
+const rune_dwarf_function_t *rune_dwarf_function_at(rune_dwarf_t *dwarf, uint64_t addr);
+
+/**
+ * @brief Lowest-addressed range of the function called name, or NULL
+ */
+const rune_dwarf_function_t *rune_dwarf_function(rune_dwarf_t *dwarf, const char *name);
+
+/**
+ * @brief Source position of the instruction at addr
+ * @return 0 on success, -1 if no line program covers addr
+ */
+int rune_dwarf_line(rune_dwarf_t *dwarf, uint64_t addr, const rune_dwarf_file_t **file, uint32_t *line);
+
+#endif /* RUNE_DWARF_H */
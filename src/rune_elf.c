@@ -0,0 +1,480 @@
+/**
+ * rune_elf.c - Native ELF reader implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_elf.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define RUNE_ELF_MAX_SECTIONS 65536         // Sanity limits against corrupt headers
+#define RUNE_ELF_MAX_SEGMENTS 4096
+
+uint16_t rune_elf_u16(const rune_elf_t *elf, const uint8_t *p) {
+    return elf->big_endian ? (uint16_t)(p[0] << 8 | p[1]) : (uint16_t)(p[1] << 8 | p[0]);
+}
+
+uint32_t rune_elf_u32(const rune_elf_t *elf, const uint8_t *p) {
+    uint32_t v = 0;
+    for (int i = 0; i < 4; i++) {
+        v |= (uint32_t)p[elf->big_endian ? 3 - i : i] << (8 * i);
+    }
+    return v;
+}
+
+uint64_t rune_elf_u64(const rune_elf_t *elf, const uint8_t *p) {
+    uint64_t v = 0;
+    for (int i = 0; i < 8; i++) {
+        v |= (uint64_t)p[elf->big_endian ? 7 - i : i] << (8 * i);
+    }
+    return v;
+}
+
+// Address-sized field: 4 bytes in ELF32, 8 in ELF64
+static uint64_t rune_elf_word(const rune_elf_t *elf, const uint8_t *p) {
+    return elf->bits == 64 ? rune_elf_u64(elf, p) : rune_elf_u32(elf, p);
+}
+
+static int rune_elf_in_file(const rune_elf_t *elf, uint64_t offset, uint64_t size) {
+    return offset <= elf->size && size <= elf->size - offset;
+}
+
+// NUL-terminated string at offset of a table, or "" if it runs past the table
+static const char *rune_elf_string(const rune_elf_t *elf, uint64_t table, uint64_t table_size, uint64_t offset) {
+    if (!rune_elf_in_file(elf, table, table_size) || offset >= table_size) {
+        return "";
+    }
+    const char *s = (const char *)elf->data + table + offset;
+    return memchr(s, '\0', table_size - offset) ? s : "";
+}
+
+const rune_elf_section_t *rune_elf_section(const rune_elf_t *elf, const char *name) {
+    for (size_t i = 0; i < elf->section_count; i++) {
+        if (strcmp(elf->sections[i].name, name) == 0) {
+            return &elf->sections[i];
+        }
+    }
+    return NULL;
+}
+
+const uint8_t *rune_elf_section_data(const rune_elf_t *elf, const rune_elf_section_t *section) {
+    if (!section || section->type == SHT_NOBITS || !rune_elf_in_file(elf, section->offset, section->size)) {
+        return NULL;
+    }
+    return elf->data + section->offset;
+}
+
+int64_t rune_elf_vaddr_offset(const rune_elf_t *elf, uint64_t vaddr) {
+    for (size_t i = 0; i < elf->segment_count; i++) {
+        const rune_elf_segment_t *seg = &elf->segments[i];
+        if (seg->type == PT_LOAD && vaddr >= seg->vaddr && vaddr - seg->vaddr < seg->filesz) {
+            return (int64_t)(seg->offset + (vaddr - seg->vaddr));
+        }
+    }
+    return -1;
+}
+
+int64_t rune_elf_offset_vaddr(const rune_elf_t *elf, uint64_t offset) {
+    for (size_t i = 0; i < elf->segment_count; i++) {
+        const rune_elf_segment_t *seg = &elf->segments[i];
+        if (seg->type == PT_LOAD && offset >= seg->offset && offset - seg->offset < seg->filesz) {
+            return (int64_t)(seg->vaddr + (offset - seg->offset));
+        }
+    }
+    return -1;
+}
+
+static int rune_elf_read_sections(rune_elf_t *elf, uint64_t shoff, size_t shentsize, size_t shnum, size_t shstrndx) {
+    size_t want = elf->bits == 64 ? sizeof(Elf64_Shdr) : sizeof(Elf32_Shdr);
+    if (shoff == 0 || shentsize < want) {
+        return 0;
+    }
+    if (!rune_elf_in_file(elf, shoff, want)) {
+        return 0;
+    }
+    const uint8_t *first = elf->data + shoff;
+    // Extended numbering: the real counts live in section 0
+    if (shnum == 0) {
+        shnum = (size_t)rune_elf_word(elf, first + (elf->bits == 64 ? 32 : 20));
+    }
+    if (shstrndx == SHN_XINDEX) {
+        shstrndx = rune_elf_u32(elf, first + (elf->bits == 64 ? 40 : 24));
+    }
+    if (shnum > RUNE_ELF_MAX_SECTIONS || !rune_elf_in_file(elf, shoff, (uint64_t)shnum * shentsize)) {
+        return 0;
+    }
+
+    elf->sections = calloc(shnum ? shnum : 1, sizeof(*elf->sections));
+    if (!elf->sections) {
+        return -1;
+    }
+    for (size_t i = 0; i < shnum; i++) {
+        const uint8_t *p = elf->data + shoff + i * shentsize;
+        rune_elf_section_t *s = &elf->sections[i];
+        s->type = rune_elf_u32(elf, p + 4);
+        if (elf->bits == 64) {
+            s->flags = rune_elf_u64(elf, p + 8);
+            s->addr = rune_elf_u64(elf, p + 16);
+            s->offset = rune_elf_u64(elf, p + 24);
+            s->size = rune_elf_u64(elf, p + 32);
+            s->link = rune_elf_u32(elf, p + 40);
+            s->info = rune_elf_u32(elf, p + 44);
+            s->entsize = rune_elf_u64(elf, p + 56);
+        } else {
+            s->flags = rune_elf_u32(elf, p + 8);
+            s->addr = rune_elf_u32(elf, p + 12);
+            s->offset = rune_elf_u32(elf, p + 16);
+            s->size = rune_elf_u32(elf, p + 20);
+            s->link = rune_elf_u32(elf, p + 24);
+            s->info = rune_elf_u32(elf, p + 28);
+            s->entsize = rune_elf_u32(elf, p + 36);
+        }
+    }
+    elf->section_count = shnum;
+
+    // Names once every header is read: the name table may come last
+    const rune_elf_section_t *names = shstrndx < shnum ? &elf->sections[shstrndx] : NULL;
+    for (size_t i = 0; i < shnum; i++) {
+        uint32_t name = rune_elf_u32(elf, elf->data + shoff + i * shentsize);
+        elf->sections[i].name = names ? rune_elf_string(elf, names->offset, names->size, name) : "";
+    }
+    return 0;
+}
+
+static int rune_elf_read_segments(rune_elf_t *elf, uint64_t phoff, size_t phentsize, size_t phnum) {
+    size_t want = elf->bits == 64 ? sizeof(Elf64_Phdr) : sizeof(Elf32_Phdr);
+    if (phoff == 0 || phnum == 0 || phentsize < want || phnum > RUNE_ELF_MAX_SEGMENTS ||
+        !rune_elf_in_file(elf, phoff, (uint64_t)phnum * phentsize)) {
+        return 0;
+    }
+    elf->segments = calloc(phnum, sizeof(*elf->segments));
+    if (!elf->segments) {
+        return -1;
+    }
+    for (size_t i = 0; i < phnum; i++) {
+        const uint8_t *p = elf->data + phoff + i * phentsize;
+        rune_elf_segment_t *s = &elf->segments[i];
+        s->type = rune_elf_u32(elf, p);
+        if (elf->bits == 64) {
+            s->flags = rune_elf_u32(elf, p + 4);
+            s->offset = rune_elf_u64(elf, p + 8);
+            s->vaddr = rune_elf_u64(elf, p + 16);
+            s->filesz = rune_elf_u64(elf, p + 32);
+            s->memsz = rune_elf_u64(elf, p + 40);
+            s->align = rune_elf_u64(elf, p + 48);
+        } else {
+            s->offset = rune_elf_u32(elf, p + 4);
+            s->vaddr = rune_elf_u32(elf, p + 8);
+            s->filesz = rune_elf_u32(elf, p + 16);
+            s->memsz = rune_elf_u32(elf, p + 20);
+            s->flags = rune_elf_u32(elf, p + 24);
+            s->align = rune_elf_u32(elf, p + 28);
+        }
+        if (s->type == PT_INTERP && rune_elf_in_file(elf, s->offset, s->filesz) && s->filesz > 0 &&
+            memchr(elf->data + s->offset, '\0', s->filesz)) {
+            elf->interp = (const char *)elf->data + s->offset;
+        }
+    }
+    elf->segment_count = phnum;
+    return 0;
+}
+
+// Every symbol of both tables, .symtab first
+static int rune_elf_read_symbols(rune_elf_t *elf) {
+    size_t entsize = elf->bits == 64 ? sizeof(Elf64_Sym) : sizeof(Elf32_Sym);
+    size_t total = 0;
+    for (size_t i = 0; i < elf->section_count; i++) {
+        const rune_elf_section_t *s = &elf->sections[i];
+        if ((s->type == SHT_SYMTAB || s->type == SHT_DYNSYM) && rune_elf_in_file(elf, s->offset, s->size)) {
+            total += s->size / entsize;
+        }
+    }
+    if (total == 0) {
+        return 0;
+    }
+    elf->symbols = malloc(total * sizeof(*elf->symbols));
+    if (!elf->symbols) {
+        return -1;
+    }
+
+    static const uint32_t order[] = { SHT_SYMTAB, SHT_DYNSYM };
+    for (int pass = 0; pass < 2; pass++) {
+        for (size_t i = 0; i < elf->section_count; i++) {
+            const rune_elf_section_t *s = &elf->sections[i];
+            if (s->type != order[pass] || !rune_elf_in_file(elf, s->offset, s->size)) {
+                continue;
+            }
+            const rune_elf_section_t *strtab = s->link < elf->section_count ? &elf->sections[s->link] : NULL;
+            size_t count = s->size / entsize;
+            // Entry 0 is the reserved null symbol
+            for (size_t n = 1; n < count; n++) {
+                const uint8_t *p = elf->data + s->offset + n * entsize;
+                rune_elf_symbol_t *sym = &elf->symbols[elf->symbol_count++];
+                uint32_t name;
+                uint8_t info;
+                if (elf->bits == 64) {
+                    name = rune_elf_u32(elf, p);
+                    info = p[4];
+                    sym->shndx = rune_elf_u16(elf, p + 6);
+                    sym->value = rune_elf_u64(elf, p + 8);
+                    sym->size = rune_elf_u64(elf, p + 16);
+                } else {
+                    name = rune_elf_u32(elf, p);
+                    sym->value = rune_elf_u32(elf, p + 4);
+                    sym->size = rune_elf_u32(elf, p + 8);
+                    info = p[12];
+                    sym->shndx = rune_elf_u16(elf, p + 14);
+                }
+                sym->name = strtab ? rune_elf_string(elf, strtab->offset, strtab->size, name) : "";
+                sym->type = info & 0xf;
+                sym->bind = info >> 4;
+                sym->dynamic = order[pass] == SHT_DYNSYM;
+            }
+            if (order[pass] == SHT_SYMTAB) {
+                elf->has_symtab = 1;
+            } else {
+                elf->dynamic_symbol_count += count ? count - 1 : 0;
+            }
+        }
+    }
+    return 0;
+}
+
+// .dynamic from its section, or from PT_DYNAMIC when the section headers are gone
+static int rune_elf_read_dynamic(rune_elf_t *elf) {
+    uint64_t offset = 0, size = 0;
+    uint64_t strtab = 0, strsz = 0;
+    int have_strtab = 0;
+    for (size_t i = 0; i < elf->section_count; i++) {
+        const rune_elf_section_t *s = &elf->sections[i];
+        if (s->type == SHT_DYNAMIC) {
+            offset = s->offset;
+            size = s->size;
+            if (s->link < elf->section_count) {
+                strtab = elf->sections[s->link].offset;
+                strsz = elf->sections[s->link].size;
+                have_strtab = 1;
+            }
+            break;
+        }
+    }
+    for (size_t i = 0; !size && i < elf->segment_count; i++) {
+        if (elf->segments[i].type == PT_DYNAMIC) {
+            offset = elf->segments[i].offset;
+            size = elf->segments[i].filesz;
+        }
+    }
+    if (!size || !rune_elf_in_file(elf, offset, size)) {
+        return 0;
+    }
+
+    size_t entsize = elf->bits == 64 ? sizeof(Elf64_Dyn) : sizeof(Elf32_Dyn);
+    size_t count = size / entsize;
+    elf->dynamic = malloc(count * sizeof(*elf->dynamic));
+    elf->needed = malloc(count * sizeof(*elf->needed));
+    if (!elf->dynamic || !elf->needed) {
+        return -1;
+    }
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *p = elf->data + offset + i * entsize;
+        rune_elf_dynamic_t *d = &elf->dynamic[elf->dynamic_count++];
+        d->tag = elf->bits == 64 ? (int64_t)rune_elf_u64(elf, p) : (int32_t)rune_elf_u32(elf, p);
+        d->value = rune_elf_word(elf, p + entsize / 2);
+        if (d->tag == DT_NULL) {
+            break;
+        }
+        if (!have_strtab && d->tag == DT_STRTAB) {
+            int64_t file_offset = rune_elf_vaddr_offset(elf, d->value);
+            if (file_offset >= 0) {
+                strtab = (uint64_t)file_offset;
+                have_strtab = 1;
+            }
+        } else if (d->tag == DT_STRSZ && !strsz) {
+            strsz = d->value;
+        }
+    }
+    if (!have_strtab) {
+        return 0;
+    }
+    if (!strsz || !rune_elf_in_file(elf, strtab, strsz)) {
+        strsz = strtab <= elf->size ? elf->size - strtab : 0;
+    }
+
+    for (size_t i = 0; i < elf->dynamic_count; i++) {
+        const rune_elf_dynamic_t *d = &elf->dynamic[i];
+        const char **slot = NULL;
+        switch (d->tag) {
+            case DT_NEEDED:  slot = &elf->needed[elf->needed_count++]; break;
+            case DT_SONAME:  slot = &elf->soname; break;
+            case DT_RPATH:   slot = &elf->rpath; break;
+            case DT_RUNPATH: slot = &elf->runpath; break;
+        }
+        if (slot) {
+            *slot = rune_elf_string(elf, strtab, strsz, d->value);
+        }
+    }
+    return 0;
+}
+
+static int rune_elf_add_notes(rune_elf_t *elf, uint64_t offset, uint64_t size, uint64_t align) {
+    if (!rune_elf_in_file(elf, offset, size)) {
+        return 0;
+    }
+    align = align == 8 ? 8 : 4;
+    uint64_t pos = 0;
+    while (size - pos >= 12) {
+        const uint8_t *p = elf->data + offset + pos;
+        uint32_t namesz = rune_elf_u32(elf, p);
+        uint32_t descsz = rune_elf_u32(elf, p + 4);
+        uint64_t name_at = pos + 12;
+        uint64_t desc_at = (name_at + namesz + align - 1) & ~(align - 1);
+        uint64_t next = (desc_at + descsz + align - 1) & ~(align - 1);
+        if (desc_at + descsz > size) {
+            break;
+        }
+        rune_elf_note_t *notes = realloc(elf->notes, (elf->note_count + 1) * sizeof(*notes));
+        if (!notes) {
+            return -1;
+        }
+        elf->notes = notes;
+        rune_elf_note_t *note = &notes[elf->note_count++];
+        const char *owner = (const char *)elf->data + offset + name_at;
+        note->owner = namesz && memchr(owner, '\0', namesz) ? owner : "";
+        note->type = rune_elf_u32(elf, p + 8);
+        note->desc_size = descsz;
+        note->desc = elf->data + offset + desc_at;
+        if (note->type == NT_GNU_BUILD_ID && strcmp(note->owner, "GNU") == 0 && !elf->build_id) {
+            elf->build_id = note->desc;
+            elf->build_id_size = descsz;
+        }
+        pos = next;
+    }
+    return 0;
+}
+
+// SHT_NOTE sections, or PT_NOTE segments when there are no section headers
+static int rune_elf_read_notes(rune_elf_t *elf) {
+    int found = 0;
+    for (size_t i = 0; i < elf->section_count; i++) {
+        const rune_elf_section_t *s = &elf->sections[i];
+        if (s->type == SHT_NOTE) {
+            found = 1;
+            uint64_t align = elf->bits == 64 && strcmp(s->name, ".note.gnu.property") == 0 ? 8 : 4;
+            if (rune_elf_add_notes(elf, s->offset, s->size, align) != 0) {
+                return -1;
+            }
+        }
+    }
+    for (size_t i = 0; !found && i < elf->segment_count; i++) {
+        const rune_elf_segment_t *seg = &elf->segments[i];
+        if (seg->type == PT_NOTE && rune_elf_add_notes(elf, seg->offset, seg->filesz, seg->align) != 0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+static int rune_elf_parse(rune_elf_t *elf) {
+    const uint8_t *h = elf->data;
+    if (elf->size < EI_NIDENT || memcmp(h, ELFMAG, SELFMAG) != 0 ||
+        (h[EI_CLASS] != ELFCLASS32 && h[EI_CLASS] != ELFCLASS64) ||
+        (h[EI_DATA] != ELFDATA2LSB && h[EI_DATA] != ELFDATA2MSB)) {
+        errno = ENOEXEC;
+        return -1;
+    }
+    elf->bits = h[EI_CLASS] == ELFCLASS64 ? 64 : 32;
+    elf->big_endian = h[EI_DATA] == ELFDATA2MSB;
+    if (elf->size < (elf->bits == 64 ? sizeof(Elf64_Ehdr) : sizeof(Elf32_Ehdr))) {
+        errno = ENOEXEC;
+        return -1;
+    }
+
+    elf->type = rune_elf_u16(elf, h + 16);
+    elf->machine = rune_elf_u16(elf, h + 18);
+    uint64_t phoff, shoff;
+    size_t phentsize, phnum, shentsize, shnum, shstrndx;
+    if (elf->bits == 64) {
+        elf->entry = rune_elf_u64(elf, h + 24);
+        phoff = rune_elf_u64(elf, h + 32);
+        shoff = rune_elf_u64(elf, h + 40);
+        phentsize = rune_elf_u16(elf, h + 54);
+        phnum = rune_elf_u16(elf, h + 56);
+        shentsize = rune_elf_u16(elf, h + 58);
+        shnum = rune_elf_u16(elf, h + 60);
+        shstrndx = rune_elf_u16(elf, h + 62);
+    } else {
+        elf->entry = rune_elf_u32(elf, h + 24);
+        phoff = rune_elf_u32(elf, h + 28);
+        shoff = rune_elf_u32(elf, h + 32);
+        phentsize = rune_elf_u16(elf, h + 42);
+        phnum = rune_elf_u16(elf, h + 44);
+        shentsize = rune_elf_u16(elf, h + 46);
+        shnum = rune_elf_u16(elf, h + 48);
+        shstrndx = rune_elf_u16(elf, h + 50);
+    }
+
+    if (rune_elf_read_sections(elf, shoff, shentsize, shnum, shstrndx) != 0 ||
+        rune_elf_read_segments(elf, phoff, phentsize, phnum) != 0 ||
+        rune_elf_read_symbols(elf) != 0 ||
+        rune_elf_read_dynamic(elf) != 0 ||
+        rune_elf_read_notes(elf) != 0) {
+        errno = ENOMEM;
+        return -1;
+    }
+    elf->has_debug_info = rune_elf_section(elf, ".debug_info") || rune_elf_section(elf, ".zdebug_info");
+    return 0;
+}
+
+int rune_elf_open(rune_elf_t *elf, const char *path) {
+    memset(elf, 0, sizeof(*elf));
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return -1;
+    }
+    if (!S_ISREG(st.st_mode) || st.st_size < EI_NIDENT) {
+        close(fd);
+        errno = ENOEXEC;
+        return -1;
+    }
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        return -1;
+    }
+    elf->data = data;
+    elf->size = (size_t)st.st_size;
+
+    if (rune_elf_parse(elf) != 0) {
+        int error = errno;
+        rune_elf_close(elf);
+        errno = error;
+        return -1;
+    }
+    return 0;
+}
+
+void rune_elf_close(rune_elf_t *elf) {
+    if (elf->data) {
+        munmap((void *)elf->data, elf->size);
+    }
+    free(elf->sections);
+    free(elf->segments);
+    free(elf->symbols);
+    free(elf->dynamic);
+    free(elf->needed);
+    free(elf->notes);
+    memset(elf, 0, sizeof(*elf));
+}
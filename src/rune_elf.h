@@ -0,0 +1,145 @@
+/**
+ * rune_elf.h - Native ELF reader for the static analyzers
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Maps the binary once and builds one structured model of it: section
+ * and program headers, every symbol of .symtab and .dynsym, the
+ * .dynamic entries, notes and the GNU build ID. The analyzers read the
+ * model instead of running nm, objdump or readelf and parsing their
+ * text output, so nothing is truncated and no child process is started.
+ *
+ * ELF32 and ELF64, either byte order. Every offset, size and string
+ * is checked against the mapping, so a truncated or hostile file gives
+ * a partial model, never a read out of bounds. Strings in the model
+ * point into the mapping and stay valid until rune_elf_close().
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_ELF_H
+#define RUNE_ELF_H
+
+#include <elf.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct rune_elf_section {
+    const char *name;           // "" if the name table is missing
+    uint32_t type;              // SHT_*
+    uint32_t link;
+    uint32_t info;
+    uint64_t flags;             // SHF_*
+    uint64_t addr;
+    uint64_t offset;
+    uint64_t size;
+    uint64_t entsize;
+} rune_elf_section_t;
+
+typedef struct rune_elf_segment {
+    uint32_t type;              // PT_*
+    uint32_t flags;             // PF_R | PF_W | PF_X
+    uint64_t offset;
+    uint64_t vaddr;
+    uint64_t filesz;
+    uint64_t memsz;
+    uint64_t align;
+} rune_elf_segment_t;
+
+typedef struct rune_elf_symbol {
+    const char *name;
+    uint64_t value;
+    uint64_t size;
+    uint16_t shndx;             // SHN_UNDEF: imported
+    uint8_t type;               // STT_*
+    uint8_t bind;               // STB_*
+    uint8_t dynamic;            // From .dynsym (else .symtab)
+} rune_elf_symbol_t;
+
+typedef struct rune_elf_dynamic {
+    int64_t tag;                // DT_*
+    uint64_t value;
+} rune_elf_dynamic_t;
+
+typedef struct rune_elf_note {
+    const char *owner;          // "GNU", "Linux", ...
+    uint32_t type;              // NT_*
+    uint32_t desc_size;
+    const uint8_t *desc;
+} rune_elf_note_t;
+
+typedef struct rune_elf {
+    const uint8_t *data;        // The whole file, mapped read-only
+    size_t size;
+    int bits;                   // 32 or 64
+    int big_endian;
+    uint16_t type;              // ET_EXEC, ET_DYN, ...
+    uint16_t machine;           // EM_X86_64, EM_AARCH64, ...
+    uint64_t entry;
+
+    rune_elf_section_t *sections;
+    size_t section_count;
+    rune_elf_segment_t *segments;
+    size_t segment_count;
+    rune_elf_symbol_t *symbols; // .symtab, then .dynsym
+    size_t symbol_count;
+    size_t dynamic_symbol_count;
+    rune_elf_dynamic_t *dynamic;
+    size_t dynamic_count;
+    rune_elf_note_t *notes;
+    size_t note_count;
+
+    // From .dynamic and the program headers (NULL if absent)
+    const char **needed;        // DT_NEEDED, in order
+    size_t needed_count;
+    const char *soname;
+    const char *rpath;
+    const char *runpath;
+    const char *interp;         // PT_INTERP
+
+    const uint8_t *build_id;    // NT_GNU_BUILD_ID descriptor
+    size_t build_id_size;
+    int has_symtab;             // Not stripped
+    int has_debug_info;         // .debug_info or .zdebug_info
+} rune_elf_t;
+
+/**
+ * @brief Map path and build its model
+ * @return 0 on success, -1 on error (errno is set; ENOEXEC if not ELF)
+ */
+int rune_elf_open(rune_elf_t *elf, const char *path);
+
+/**
+ * @brief Unmap the file and free the model (safe on a failed open)
+ */
+void rune_elf_close(rune_elf_t *elf);
+
+/**
+ * @brief First section called name, or NULL
+ */
+const rune_elf_section_t *rune_elf_section(const rune_elf_t *elf, const char *name);
+
+/**
+ * @brief Contents of a section, or NULL if it has none in the file
+ */
+const uint8_t *rune_elf_section_data(const rune_elf_t *elf, const rune_elf_section_t *section);
+
+/**
+ * @brief File offset of a virtual address (through PT_LOAD), or -1
+ */
+int64_t rune_elf_vaddr_offset(const rune_elf_t *elf, uint64_t vaddr);
+
+/**
+ * @brief Virtual address a file offset is loaded at (through PT_LOAD), or -1
+ */
+int64_t rune_elf_offset_vaddr(const rune_elf_t *elf, uint64_t offset);
+
+/**
+ * @brief Fixed-width integers in the file's byte order
+ */
+uint16_t rune_elf_u16(const rune_elf_t *elf, const uint8_t *p);
+uint32_t rune_elf_u32(const rune_elf_t *elf, const uint8_t *p);
+uint64_t rune_elf_u64(const rune_elf_t *elf, const uint8_t *p);
+
+#endif /* RUNE_ELF_H */
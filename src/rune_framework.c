@@ -11,10 +11,8 @@
 #include "rune_analyze.h"
 #include "rune_pinpoint_analyzer.h"
 #include "rune_master.h"  // 🌟 Master orchestration functions
-
-// Global configuration and results (accessible to all modules)
-rune_config_t g_config = {0};
-rune_results_t g_results = {0};
+#include "rune_batch.h"   // 📦 Parallel manifest runs
+#include "rune_trace.h"   // Chrome Trace Event export
 
 // Example trigger callbacks - these will be moved to appropriate modules
 void rune_example_security_trigger(const rune_checkpoint_t *checkpoint) {
@@ -27,69 +25,101 @@ void rune_example_performance_trigger(const rune_checkpoint_t *checkpoint) {
     // This would call performance analysis functions
 }
 
-// Initialize the entire framework
-int rune_initialize(int argc, char **argv) {
+// Initialize the entire framework - ctx stays the thread's current context until rune_cleanup()
+int rune_initialize(rune_context_t* ctx, int argc, char **argv) {
+    rune_context_bind(ctx);
+    
     // Initialize all subsystems
-    rune_checkpoint_init();
-    rune_trigger_init();
+    rune_checkpoint_init(ctx);
+    rune_trigger_init(ctx);
     
     // Parse configuration
-    if (rune_config_parse_args(argc, argv) != 0) {
+    int parsed = rune_config_parse_args(ctx, argc, argv);
+    if (parsed == RUNE_CONFIG_HELP) {
+        rune_print_usage(argv[0]);
+        return parsed;
+    }
+    if (parsed == RUNE_CONFIG_VERSION) {
+        printf("rune_analyze version %s\n", RUNE_ANALYZE_VERSION);
+        return parsed;
+    }
+    if (parsed != 0) {
         return -1;
     }
     
     // Validate configuration
-    if (rune_config_validate() != 0) {
+    if (rune_config_validate(ctx) != 0) {
         return -1;
     }
     
+    // Batch results are JSON lines on stdout: keep log records out of them
+    if (ctx->config.batch_manifest[0]) {
+        rune_log_to_stderr();
+    }
+    
+    if (ctx->config.async_log && rune_log_start_async() != 0) {
+        rune_log_warning("Could not start the log writer, logging stays synchronous\n");
+    }
+    
     // Register example triggers (these will be moved to appropriate modules)
-    rune_register_trigger("SEC:*", "security_monitor", rune_example_security_trigger);
-    rune_register_trigger("FUNC:*", "performance_monitor", rune_example_performance_trigger);
-    rune_register_trigger("SYSCALL:*", "syscall_monitor", rune_example_security_trigger);
+    rune_register_trigger(ctx, "SEC:*", "security_monitor", rune_example_security_trigger);
+    rune_register_trigger(ctx, "FUNC:*", "performance_monitor", rune_example_performance_trigger);
+    rune_register_trigger(ctx, "SYSCALL:*", "syscall_monitor", rune_example_security_trigger);
+    if (ctx->config.async_triggers && rune_set_trigger_async(ctx, NULL, 1) != 0) {
+        rune_log_warning("Could not start the trigger workers, triggers stay synchronous\n");
+    }
     
     rune_log_checkpoint("SYSTEM: framework_initialized", RUNE_CHECKPOINT_LOAD, "All subsystems ready");
     return 0;
 }
 
-// Execute the main analysis workflow
-int rune_execute_analysis(void) {
+// Execute the main analysis workflow (ctx is bound as the current context)
+static int rune_execute_analysis_bound(rune_context_t* ctx) {
     int result = 0;
     struct timespec start_time, end_time;
     
+    if (ctx->config.spawn_benchmark) {
+        return rune_execute_spawn_benchmark(ctx);
+    }
+    
+    // 📦 BATCH MODE - the manifest replaces the single target
+    if (ctx->config.batch_manifest[0]) {
+        return rune_batch_run(ctx);
+    }
+    
     // 🌟 MASTER ORCHESTRATION MODE CHECK (THE VISION!)
-    if (g_config.master_deep_install) {
-        if (g_config.dry_run_mode) {
-            printf("🛡️ DRY RUN: Would execute master deep install for %s\n", g_config.master_target_package);
+    if (ctx->config.master_deep_install) {
+        if (ctx->config.dry_run_mode) {
+            printf("🛡️ DRY RUN: Would execute master deep install for %s\n", ctx->config.master_target_package);
             return 0;
         }
-        return rune_master_deep_install(g_config.master_target_package);
+        return rune_master_deep_install(ctx, ctx->config.master_target_package);
     }
     
-    if (g_config.master_security_scan) {
-        return rune_master_security_scan(g_config.master_target_package);
+    if (ctx->config.master_security_scan) {
+        return rune_master_security_scan(ctx, ctx->config.master_target_package);
     }
     
-    if (g_config.master_smart_monitor) {
-        if (g_config.dry_run_mode) {
-            printf("🛡️ DRY RUN: Would execute smart monitoring for %s\n", g_config.target_executable);
+    if (ctx->config.master_smart_monitor) {
+        if (ctx->config.dry_run_mode) {
+            printf("🛡️ DRY RUN: Would execute smart monitoring for %s\n", ctx->config.target_executable);
             return 0;
         }
-        return rune_master_smart_monitor(g_config.target_executable);
+        return rune_master_smart_monitor(ctx, ctx->config.target_executable);
     }
     
-    if (g_config.master_threat_analyze) {
-        return rune_master_threat_analyze(g_config.master_target_package);
+    if (ctx->config.master_threat_analyze) {
+        return rune_master_threat_analyze(ctx, ctx->config.master_target_package);
     }
     
     // 🛡️ NEW SAFE ANALYSIS MODES
-    if (g_config.master_safe_analyze) {
-        return rune_safe_analyze_package(g_config.master_target_package);
+    if (ctx->config.master_safe_analyze) {
+        return rune_safe_analyze_package(ctx->config.master_target_package);
     }
     
-    if (g_config.master_safe_threats) {
-        int risk_score = rune_safe_analyze_package(g_config.master_target_package);
-        rune_safe_detect_specific_threats(g_config.master_target_package);
+    if (ctx->config.master_safe_threats) {
+        int risk_score = rune_safe_analyze_package(ctx->config.master_target_package);
+        rune_safe_detect_specific_threats(ctx->config.master_target_package);
         return risk_score;
     }
     
@@ -97,15 +127,15 @@ int rune_execute_analysis(void) {
     clock_gettime(CLOCK_MONOTONIC, &start_time);
     
     // Output JSON analysis start if requested
-    rune_output_json_analysis_start(rune_get_target_executable());
+    rune_output_json_analysis_start(ctx);
     
     RUNE_LOG_FUNC_START("target_execution");
     
     // Validate the target executable (skip for monitoring mode)
-    if (!g_config.enable_monitoring) {
+    if (!ctx->config.enable_monitoring) {
         if (rune_validate_executable(rune_get_target_executable()) != 0) {
             rune_log_error("Target executable validation failed\n");
-            rune_output_json_error_report("validate_executable", "Target executable validation failed", -1);
+            rune_output_json_error_report(ctx, "validate_executable", "Target executable validation failed", -1);
             return -1;
         }
     } else {
@@ -114,7 +144,7 @@ int rune_execute_analysis(void) {
     }
     
     // Execute the target and collect data
-    result = rune_execute_target();
+    result = rune_execute_target(ctx);
     if (result != 0) {
         rune_log_warning("Target execution completed with issues (exit code: %d)\n", result);
     }
@@ -123,9 +153,7 @@ int rune_execute_analysis(void) {
     
     // Perform deep analysis if enabled
     if (rune_is_deep_analysis_enabled()) {
-        RUNE_LOG_FUNC_START("deep_analysis");
-        rune_perform_deep_analysis();
-        RUNE_LOG_FUNC_END("deep_analysis");
+        rune_perform_deep_analysis(ctx);
     }
     
     // Calculate total execution time
@@ -134,44 +162,70 @@ int rune_execute_analysis(void) {
                            (end_time.tv_nsec - start_time.tv_nsec) / 1000000000.0;
     
     // Update results with timing
-    g_results.execution_time = execution_time;
+    ctx->results.execution_time = execution_time;
+    
+    // Queued async triggers finish before their statistics are reported
+    rune_trigger_flush(ctx);
     
     // Generate output report
     RUNE_LOG_FUNC_START("report_generation");
     switch (rune_get_output_format()) {
         case 0: // Human readable
-            rune_print_human_report();
+            rune_print_human_report(ctx);
             break;
         case 1: // JSON
-            rune_output_json_analysis_result(&g_results, execution_time);
+            rune_output_json_analysis_result(ctx, execution_time);
             break;
         case 2: // Both
-            rune_print_human_report();
-            rune_output_json_analysis_result(&g_results, execution_time);
+            rune_print_human_report(ctx);
+            rune_output_json_analysis_result(ctx, execution_time);
             break;
         default:
-            rune_print_human_report();
+            rune_print_human_report(ctx);
             break;
     }
     RUNE_LOG_FUNC_END("report_generation");
     
     // Print checkpoint timeline in verbose mode
     if (rune_is_verbose_mode() >= 2) {
-        rune_print_checkpoint_timeline();
+        rune_print_checkpoint_timeline(ctx);
+        rune_print_span_profile(ctx);
     }
     
     return result;
 }
 
+// Execute the main analysis workflow for ctx
+int rune_execute_analysis(rune_context_t* ctx) {
+    rune_context_t* previous = rune_context_bind(ctx);
+    int result = rune_execute_analysis_bound(ctx);
+    rune_context_bind(previous);
+    return result;
+}
+
 // Cleanup framework resources
-void rune_cleanup(void) {
+void rune_cleanup(rune_context_t* ctx) {
+    // Before the checkpoints are discarded
+    if (ctx->config.trace_path[0] && rune_trace_export(ctx, ctx->config.trace_path) != 0) {
+        rune_log_error("Cannot write trace %s: %s\n", ctx->config.trace_path, strerror(errno));
+    }
+    
     RUNE_LOG_FUNC_START("framework_cleanup");
     
-    rune_config_cleanup();
-    rune_trigger_cleanup();
-    rune_checkpoint_cleanup();
+    rune_config_cleanup(ctx);
+    rune_trigger_cleanup(ctx);
+    rune_checkpoint_cleanup(ctx);
     
     RUNE_LOG_FUNC_END("framework_cleanup");
+    
+    // Spans still open here ("main") are counted up to now
+    if (ctx->config.flamegraph_path[0] &&
+        rune_span_export_folded(ctx, ctx->config.flamegraph_path) != 0) {
+        rune_log_error("Cannot write flame graph %s: %s\n", ctx->config.flamegraph_path, strerror(errno));
+    }
+    
+    rune_log_flush();
+    if (rune_context_current() == ctx) rune_context_bind(NULL);
 }
 
 // Print usage information
@@ -188,7 +242,8 @@ void rune_print_usage(const char* program_name) {
     printf("⚠️  EXECUTION ANALYSIS (Requires -f flag for safety):\n");
     printf("  --deep-install <pkg.deb> -f     🚨  Master-controlled installation (EXECUTES!)\n");
     printf("  --smart-monitor <cmd> -f        🔧  Intelligent command monitoring (EXECUTES!)\n");
-    printf("  --monitor <command> -f          📡  Classic Unix monitoring (EXECUTES!)\n\n");
+    printf("  --monitor <command> -f          📡  Classic Unix monitoring (EXECUTES!)\n");
+    printf("  --batch <manifest> -f           📦  Run every manifest line in parallel, JSON lines out (EXECUTES!)\n\n");
     
     printf("Control Options:\n");
     printf("  -f, --force             🚨  FORCE execution mode (required for execution commands)\n");
@@ -197,6 +252,11 @@ void rune_print_usage(const char* program_name) {
     printf("  -v, --verbose           Enable verbose output\n");
     printf("  -vv, --very-verbose     Enable deep analysis mode + checkpoints\n");
     printf("  -q, --quiet             Quiet mode (errors only)\n");
+    printf("  --checkpoint-memory <mb> Checkpoint memory before spilling to disk (default 16)\n");
+    printf("  --async-log             Queue info/debug messages for a background writer thread\n");
+    printf("  --async-triggers        Run trigger callbacks on a worker pool, not in the logging thread\n");
+    printf("  --trigger-workers <n>   Async trigger workers (default 2)\n");
+    printf("  --trigger-overflow <p>  Full trigger queue: drop (default), block or coalesce\n");
     printf("  --version               Show version information\n\n");
     
     printf("Output Formats:\n");
@@ -210,7 +270,27 @@ void rune_print_usage(const char* program_name) {
     printf("  --performance           Enable performance profiling\n");
     printf("  --network               Enable network behavior analysis\n");
     printf("  --all                   Enable all analysis modules\n\n");
-    
+
+    printf("Kernel Accounting:\n");
+    printf("  --cgroup                Run the target in its own cgroup v2 leaf (whole-tree CPU/memory/IO)\n");
+    printf("  --cgroup-parent <dir>   cgroup v2 directory to create the leaf in\n");
+    printf("  --perf                  Count the target tree with perf_event_open (IPC, cache/branch misses)\n");
+    printf("  --probe                 Merge checkpoints the target logs (rune_probe.h, librune_probe.so)\n");
+    printf("  --probe-lib <lib.so>    Probe library to preload (default: librune_probe.so next to us)\n");
+    printf("  --zero-copy             Forward target output with splice(), analyze it asynchronously\n");
+    printf("  --timeout <seconds>     Kill the target once it has run this long\n");
+    printf("  --launcher <method>     Start targets with spawn (default), vfork or fork\n");
+    printf("  --sample-rate <hz>      Resource timeline sampling rate, 1-1000 (default 100)\n");
+    printf("  --timeline <file.csv>   Export the sampled timeline with detected phases\n");
+    printf("  --flamegraph <file>     Export rune_analyze's own spans as folded stacks\n");
+    printf("  --trace <file.json>     Export checkpoints, spans and samples for chrome://tracing or Perfetto\n");
+    printf("  --spawn-benchmark [n]   Report spawn latency of every launch method\n\n");
+
+    printf("Batch Mode:\n");
+    printf("  -j, --jobs <n>          Worker threads for --batch (default: online CPUs)\n");
+    printf("  Manifest lines hold a target plus its arguments, or per-job options such as\n");
+    printf("  --monitor \"cmd\" / --timeout 5; blank lines and # comments are skipped\n\n");
+
     printf("✅ SAFE EXAMPLES (Recommended - No Risk):\n");
     printf("  %s --safe-analyze suspicious.deb        # Safe static analysis\n", program_name);
     printf("  %s --safe-threats malware.deb           # Safe threat detection\n", program_name);
@@ -237,20 +317,20 @@ void rune_print_usage(const char* program_name) {
  */
 #include "rune_detailed_analysis.h"
 
-int rune_execute_enhanced_verbose_analysis(void) {
-    if (!rune_is_verbose_mode()) {
-        return rune_execute_analysis(); // Fall back to normal analysis
+int rune_execute_enhanced_verbose_analysis(rune_context_t* ctx) {
+    if (!ctx->config.verbose_mode) {
+        return rune_execute_analysis(ctx); // Fall back to normal analysis
     }
     
     printf("\n");
     printf("🔍 ENHANCED VERBOSE ANALYSIS MODE ACTIVATED\n");
     printf("============================================================\n");
-    printf("📋 Analyzing: %s\n", rune_get_target_executable());
+    printf("📋 Analyzing: %s\n", ctx->config.target_executable);
     printf("🎯 Mode: Detailed function-level analysis\n");
     printf("💡 Output: Function names, line numbers, file names\n");
     printf("\n");
     
-    const char* target = rune_get_target_executable();
+    const char* target = ctx->config.target_executable;
     int standard_result = 0;
     
     // Check if target is source code - if so, skip execution and go to analysis
@@ -262,7 +342,7 @@ int rune_execute_enhanced_verbose_analysis(void) {
         rune_detailed_analyze(target, 1); // 1 = verbose mode
     } else {
         // For executables/packages, perform standard analysis first
-        standard_result = rune_execute_analysis();
+        standard_result = rune_execute_analysis(ctx);
         
         // Then perform detailed analysis if target is analyzable
         if (target && strlen(target) > 0) {
@@ -0,0 +1,172 @@
+/**
+ * rune_intern.c - Process-wide string interning implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_intern.h"
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNE_INTERN_CHUNK_BITS 12
+#define RUNE_INTERN_CHUNK (1u << RUNE_INTERN_CHUNK_BITS)
+#define RUNE_INTERN_CHUNKS (RUNE_INTERN_MAX_STRINGS / RUNE_INTERN_CHUNK)
+#define RUNE_INTERN_INITIAL_SLOTS 1024
+#define RUNE_INTERN_ARENA_SIZE 65536
+#define RUNE_INTERN_CACHE 256               // Per-thread pointer cache entries
+
+// Open-addressing table: slot = hash << 32 | id, 0 = empty (ids start at 2)
+typedef struct rune_intern_table {
+    uint32_t mask;
+    uint64_t slots[];
+} rune_intern_table_t;
+
+static const char **g_chunks[RUNE_INTERN_CHUNKS]; // id -> string, published with release stores
+static rune_intern_table_t *g_table;            // Replaced, never freed: readers may still probe an old one
+static uint32_t g_count = 2;                    // Next id
+static pthread_mutex_t g_lock = PTHREAD_MUTEX_INITIALIZER; // Inserts only
+static char *g_arena;
+static size_t g_arena_used = RUNE_INTERN_ARENA_SIZE;
+
+// Call sites mostly pass the same literal again and again
+static __thread struct {
+    const char *ptr;
+    uint32_t id;
+} t_cache[RUNE_INTERN_CACHE];
+
+static uint32_t rune_intern_hash(const char *s) {
+    uint32_t hash = 2166136261u;  // FNV-1a
+    for (; *s; s++) {
+        hash ^= (unsigned char)*s;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+const char *rune_intern_string(uint32_t id) {
+    if (id == RUNE_INTERN_FULL) return "<intern table full>";
+    if (id >= RUNE_INTERN_MAX_STRINGS) return "";
+    const char **chunk = __atomic_load_n(&g_chunks[id >> RUNE_INTERN_CHUNK_BITS], __ATOMIC_ACQUIRE);
+    if (!chunk) return "";
+    const char *s = __atomic_load_n(&chunk[id & (RUNE_INTERN_CHUNK - 1)], __ATOMIC_ACQUIRE);
+    return s ? s : "";
+}
+
+uint32_t rune_intern_count(void) {
+    return __atomic_load_n(&g_count, __ATOMIC_ACQUIRE) - 2;
+}
+
+static uint32_t rune_intern_lookup(const rune_intern_table_t *table, const char *s, uint32_t hash) {
+    for (uint32_t i = hash & table->mask;; i = (i + 1) & table->mask) {
+        uint64_t slot = __atomic_load_n(&table->slots[i], __ATOMIC_ACQUIRE);
+        if (!slot) return RUNE_INTERN_NONE;
+        if ((uint32_t)(slot >> 32) == hash && strcmp(rune_intern_string((uint32_t)slot), s) == 0) {
+            return (uint32_t)slot;
+        }
+    }
+}
+
+static void rune_intern_place(rune_intern_table_t *table, uint32_t hash, uint32_t id) {
+    uint32_t i = hash & table->mask;
+    while (table->slots[i]) i = (i + 1) & table->mask;
+    __atomic_store_n(&table->slots[i], (uint64_t)hash << 32 | id, __ATOMIC_RELEASE);
+}
+
+// Called with g_lock held
+static int rune_intern_grow(void) {
+    uint32_t slots = g_table ? (g_table->mask + 1) * 2 : RUNE_INTERN_INITIAL_SLOTS;
+    rune_intern_table_t *table = calloc(1, sizeof(*table) + slots * sizeof(uint64_t));
+    if (!table) return -1;
+    table->mask = slots - 1;
+    for (uint32_t id = 2; id < g_count; id++) {
+        rune_intern_place(table, rune_intern_hash(rune_intern_string(id)), id);
+    }
+    __atomic_store_n(&g_table, table, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// Called with g_lock held
+static const char *rune_intern_copy(const char *s) {
+    size_t size = strlen(s) + 1;
+    if (size > RUNE_INTERN_ARENA_SIZE / 16) {
+        char *copy = malloc(size);
+        if (copy) memcpy(copy, s, size);
+        return copy;
+    }
+    if (g_arena_used + size > RUNE_INTERN_ARENA_SIZE) {
+        // The old arena stays referenced by the strings in it
+        char *arena = malloc(RUNE_INTERN_ARENA_SIZE);
+        if (!arena) return NULL;
+        g_arena = arena;
+        g_arena_used = 0;
+    }
+    char *copy = g_arena + g_arena_used;
+    memcpy(copy, s, size);
+    g_arena_used += size;
+    return copy;
+}
+
+// Called with g_lock held
+static uint32_t rune_intern_insert(const char *s, uint32_t hash) {
+    uint32_t id = g_count;
+    if (id >= RUNE_INTERN_MAX_STRINGS) return RUNE_INTERN_FULL;
+    if ((!g_table || (id - 1) * 2 > g_table->mask) && rune_intern_grow() != 0) return RUNE_INTERN_FULL;
+
+    const char ***chunk = &g_chunks[id >> RUNE_INTERN_CHUNK_BITS];
+    if (!*chunk) {
+        const char **fresh = calloc(RUNE_INTERN_CHUNK, sizeof(const char *));
+        if (!fresh) return RUNE_INTERN_FULL;
+        __atomic_store_n(chunk, fresh, __ATOMIC_RELEASE);
+    }
+    const char *copy = rune_intern_copy(s);
+    if (!copy) return RUNE_INTERN_FULL;
+
+    // String first, then the slot pointing at it
+    __atomic_store_n(&(*chunk)[id & (RUNE_INTERN_CHUNK - 1)], copy, __ATOMIC_RELEASE);
+    rune_intern_place(g_table, hash, id);
+    __atomic_store_n(&g_count, id + 1, __ATOMIC_RELEASE);
+    return id;
+}
+
+int rune_intern_reserve(const char *const *strings, uint32_t count) {
+    int result = 0;
+    pthread_mutex_lock(&g_lock);
+    for (uint32_t i = 0; i < count; i++) {
+        uint32_t hash = rune_intern_hash(strings[i]);
+        uint32_t id = g_table ? rune_intern_lookup(g_table, strings[i], hash) : RUNE_INTERN_NONE;
+        if (id == RUNE_INTERN_NONE) id = rune_intern_insert(strings[i], hash);
+        if (id != 2 + i) result = -1;
+    }
+    pthread_mutex_unlock(&g_lock);
+    return result;
+}
+
+uint32_t rune_intern(const char *s) {
+    if (!s || !*s) return RUNE_INTERN_NONE;
+
+    // Same pointer as last time? Still verify: it may be a reused buffer
+    uintptr_t key = (uintptr_t)s;
+    unsigned slot = (unsigned)((key >> 3) ^ (key >> 12)) & (RUNE_INTERN_CACHE - 1);
+    if (t_cache[slot].ptr == s && strcmp(rune_intern_string(t_cache[slot].id), s) == 0) {
+        return t_cache[slot].id;
+    }
+
+    uint32_t hash = rune_intern_hash(s);
+    const rune_intern_table_t *table = __atomic_load_n(&g_table, __ATOMIC_ACQUIRE);
+    uint32_t id = table ? rune_intern_lookup(table, s, hash) : RUNE_INTERN_NONE;
+    if (id == RUNE_INTERN_NONE) {
+        pthread_mutex_lock(&g_lock);
+        id = g_table ? rune_intern_lookup(g_table, s, hash) : RUNE_INTERN_NONE;
+        if (id == RUNE_INTERN_NONE) id = rune_intern_insert(s, hash);
+        pthread_mutex_unlock(&g_lock);
+    }
+
+    if (id != RUNE_INTERN_FULL) {
+        t_cache[slot].ptr = s;
+        t_cache[slot].id = id;
+    }
+    return id;
+}
@@ -0,0 +1,48 @@
+/**
+ * rune_intern.h - Process-wide string interning
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Maps strings to stable 32-bit handles so hot paths can store a handle
+ * instead of copying text. Lookups are lock-free: a small per-thread
+ * cache keyed by the caller's pointer catches repeated literals, the
+ * shared open-addressing table is probed without locks, and only the
+ * first sighting of a string takes the insert mutex. Interned strings
+ * live until the process exits.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_INTERN_H
+#define RUNE_INTERN_H
+
+#include <stdint.h>
+
+#define RUNE_INTERN_NONE 0u             // NULL or ""
+#define RUNE_INTERN_FULL 1u             // Table full: stands in for any new string
+#define RUNE_INTERN_MAX_STRINGS (1u << 22)
+
+/**
+ * @brief Handle for s, adding it on first use (thread-safe)
+ */
+uint32_t rune_intern(const char *s);
+
+/**
+ * @brief String behind a handle ("" for RUNE_INTERN_NONE or an unknown handle)
+ */
+const char *rune_intern_string(uint32_t id);
+
+/**
+ * @brief Intern strings in order before anything else is interned, so
+ *        their handles are 2, 3, ... and can be compile-time constants
+ * @return 0 if every string got its fixed handle, -1 otherwise
+ */
+int rune_intern_reserve(const char *const *strings, uint32_t count);
+
+/**
+ * @brief Number of distinct strings interned so far
+ */
+uint32_t rune_intern_count(void);
+
+#endif /* RUNE_INTERN_H */
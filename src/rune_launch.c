@@ -0,0 +1,264 @@
+/**
+ * rune_launch.c - Low-overhead target startup implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_launch.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sched.h>
+#include <signal.h>
+#include <spawn.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+extern char **environ;
+
+// Stack for the CLONE_VFORK child; the parent is suspended while it runs.
+// execvp() keeps its PATH candidates on the stack, so leave room for them.
+#define RUNE_LAUNCH_STACK_SIZE (64 * 1024)
+
+static const char *const rune_launch_names[RUNE_LAUNCH_METHODS] = { "spawn", "vfork", "fork" };
+
+// Reap a child that never got to exec() and report why
+static pid_t rune_launch_failed(pid_t pid, int error) {
+    while (waitpid(pid, NULL, 0) < 0 && errno == EINTR) {
+    }
+    errno = error;
+    return -1;
+}
+
+// Everything between the new process and exec(): async-signal-safe only
+static int rune_launch_exec_child(const rune_launch_spec_t *spec, const sigset_t *mask) {
+    if (spec->stdout_fd >= 0 && spec->stdout_fd != STDOUT_FILENO &&
+        dup2(spec->stdout_fd, STDOUT_FILENO) < 0) return errno;
+    if (spec->stderr_fd >= 0 && spec->stderr_fd != STDERR_FILENO &&
+        dup2(spec->stderr_fd, STDERR_FILENO) < 0) return errno;
+    if (spec->cgroup && rune_cgroup_attach_self(spec->cgroup) != 0) return errno;
+    if (spec->keep_fd > 0 && fcntl(spec->keep_fd, F_SETFD, 0) != 0) return errno;
+    if (mask) sigprocmask(SIG_SETMASK, mask, NULL);
+
+    const char *path = spec->path ? spec->path : spec->argv[0];
+    char *const *envp = spec->envp ? spec->envp : environ;
+    if (spec->search_path) {
+        execvpe(path, spec->argv, envp);
+    } else {
+        execve(path, spec->argv, envp);
+    }
+    return errno;
+}
+
+static pid_t rune_launch_spawn(const rune_launch_spec_t *spec) {
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    if (spec->stdout_fd >= 0 && spec->stdout_fd != STDOUT_FILENO) {
+        posix_spawn_file_actions_adddup2(&actions, spec->stdout_fd, STDOUT_FILENO);
+    }
+    if (spec->stderr_fd >= 0 && spec->stderr_fd != STDERR_FILENO) {
+        posix_spawn_file_actions_adddup2(&actions, spec->stderr_fd, STDERR_FILENO);
+    }
+    if (spec->keep_fd > 0) {
+        // dup2() onto itself clears FD_CLOEXEC here (POSIX.1-2024, glibc 2.29+)
+        posix_spawn_file_actions_adddup2(&actions, spec->keep_fd, spec->keep_fd);
+    }
+
+    pid_t pid;
+    const char *path = spec->path ? spec->path : spec->argv[0];
+    char *const *envp = spec->envp ? spec->envp : environ;
+    int rc = spec->search_path
+        ? posix_spawnp(&pid, path, &actions, NULL, spec->argv, envp)
+        : posix_spawn(&pid, path, &actions, NULL, spec->argv, envp);
+    posix_spawn_file_actions_destroy(&actions);
+    if (rc != 0) {
+        errno = rc;
+        return -1;
+    }
+    return pid;
+}
+
+typedef struct rune_vfork_args {
+    const rune_launch_spec_t *spec;
+    const sigset_t *mask;
+    int error;                  // Written by the child (shared memory), 0 = exec'd
+} rune_vfork_args_t;
+
+static int rune_vfork_child(void *arg) {
+    rune_vfork_args_t *args = arg;
+    args->error = rune_launch_exec_child(args->spec, args->mask);
+    _exit(127);
+}
+
+static pid_t rune_launch_vfork(const rune_launch_spec_t *spec) {
+    // The child borrows our address space and must not run our signal
+    // handlers: keep everything blocked until it has exec()'d
+    sigset_t all, saved;
+    sigfillset(&all);
+    pthread_sigmask(SIG_SETMASK, &all, &saved);
+
+    char stack[RUNE_LAUNCH_STACK_SIZE] __attribute__((aligned(16)));
+    rune_vfork_args_t args = { .spec = spec, .mask = &saved, .error = 0 };
+    pid_t pid = clone(rune_vfork_child, stack + sizeof(stack),
+                      CLONE_VM | CLONE_VFORK | SIGCHLD, &args);
+    int clone_errno = errno;
+
+    pthread_sigmask(SIG_SETMASK, &saved, NULL);
+    if (pid < 0) {
+        errno = clone_errno;
+        return -1;
+    }
+    // CLONE_VFORK: by now the child has exec()'d or exited
+    if (args.error) return rune_launch_failed(pid, args.error);
+    return pid;
+}
+
+static pid_t rune_launch_fork(const rune_launch_spec_t *spec) {
+    // exec() closes the error pipe; anything read from it is the child's errno
+    int error_pipe[2];
+    if (pipe2(error_pipe, O_CLOEXEC) != 0) return -1;
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        int error = rune_launch_exec_child(spec, NULL);
+        while (write(error_pipe[1], &error, sizeof(error)) < 0 && errno == EINTR) {
+        }
+        _exit(127);
+    }
+    int fork_errno = errno;
+    close(error_pipe[1]);
+    if (pid < 0) {
+        close(error_pipe[0]);
+        errno = fork_errno;
+        return -1;
+    }
+
+    int error = 0;
+    ssize_t n;
+    while ((n = read(error_pipe[0], &error, sizeof(error))) < 0 && errno == EINTR) {
+    }
+    close(error_pipe[0]);
+    if (n == (ssize_t)sizeof(error)) return rune_launch_failed(pid, error);
+    return pid;
+}
+
+pid_t rune_launch(const rune_launch_spec_t *spec) {
+    switch (spec->method) {
+        case RUNE_LAUNCH_SPAWN:
+            if (!spec->cgroup) return rune_launch_spawn(spec);
+            return rune_launch_vfork(spec);
+        case RUNE_LAUNCH_VFORK:
+            return rune_launch_vfork(spec);
+        case RUNE_LAUNCH_FORK:
+            return rune_launch_fork(spec);
+        default:
+            errno = EINVAL;
+            return -1;
+    }
+}
+
+int rune_launch_method_from_name(const char *name) {
+    for (int i = 0; i < RUNE_LAUNCH_METHODS; i++) {
+        if (strcmp(name, rune_launch_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+const char *rune_launch_method_name(rune_launch_method_t method) {
+    return (unsigned)method < RUNE_LAUNCH_METHODS ? rune_launch_names[method] : "unknown";
+}
+
+// Commands whose first word only exists inside the shell
+static const char *const rune_shell_builtins[] = {
+    ".", ":", "alias", "bg", "break", "cd", "command", "continue", "eval", "exec",
+    "exit", "export", "fg", "getopts", "hash", "jobs", "read", "readonly", "return",
+    "set", "shift", "source", "times", "trap", "type", "ulimit", "umask", "unalias",
+    "unset", "wait", NULL
+};
+
+int rune_launch_split_command(const char *command, char *buffer, size_t size,
+                              char **argv, int max_args) {
+    // Anything the shell would interpret: quoting, expansion, globbing,
+    // redirection, pipelines, lists, subshells, comments, history
+    if (strpbrk(command, "|&;<>()$`\\\"'*?[]{}~#!=%\n")) return 0;
+    if (strlen(command) >= size) return 0;
+    memcpy(buffer, command, strlen(command) + 1);
+
+    int argc = 0;
+    char *save = NULL;
+    for (char *word = strtok_r(buffer, " \t", &save); word; word = strtok_r(NULL, " \t", &save)) {
+        if (argc == max_args - 1) return 0;
+        argv[argc++] = word;
+    }
+    argv[argc] = NULL;
+    if (argc == 0) return 0;
+
+    for (int i = 0; rune_shell_builtins[i]; i++) {
+        if (strcmp(argv[0], rune_shell_builtins[i]) == 0) return 0;
+    }
+    return argc;
+}
+
+static double rune_launch_elapsed_us(const struct timespec *start, const struct timespec *end) {
+    return (end->tv_sec - start->tv_sec) * 1000000.0 + (end->tv_nsec - start->tv_nsec) / 1000.0;
+}
+
+static int rune_launch_compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+int rune_launch_benchmark(rune_launch_method_t method, char *const *argv, int iterations,
+                          rune_launch_bench_t *bench) {
+    memset(bench, 0, sizeof(*bench));
+    if (iterations <= 0) iterations = 1;
+    double *launch_us = malloc((size_t)iterations * sizeof(double));
+    if (!launch_us) return -1;
+
+    int null_fd = open("/dev/null", O_WRONLY | O_CLOEXEC);
+    rune_launch_spec_t spec = {
+        .argv = argv,
+        .stdout_fd = null_fd,
+        .stderr_fd = null_fd,
+        .method = method,
+    };
+
+    double roundtrip_total = 0.0;
+    int rc = 0;
+    for (int i = 0; i < iterations; i++) {
+        struct timespec start, launched, reaped;
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        pid_t pid = rune_launch(&spec);
+        clock_gettime(CLOCK_MONOTONIC, &launched);
+        if (pid < 0) {
+            rc = -1;
+            break;
+        }
+        while (waitpid(pid, NULL, 0) < 0 && errno == EINTR) {
+        }
+        clock_gettime(CLOCK_MONOTONIC, &reaped);
+
+        launch_us[i] = rune_launch_elapsed_us(&start, &launched);
+        roundtrip_total += rune_launch_elapsed_us(&start, &reaped);
+        bench->iterations++;
+    }
+
+    if (bench->iterations > 0) {
+        int n = bench->iterations;
+        double launch_total = 0.0;
+        for (int i = 0; i < n; i++) launch_total += launch_us[i];
+        qsort(launch_us, (size_t)n, sizeof(double), rune_launch_compare_double);
+        bench->launch_mean_us = launch_total / n;
+        bench->launch_p50_us = launch_us[n / 2];
+        bench->launch_p99_us = launch_us[(n * 99) / 100 < n ? (n * 99) / 100 : n - 1];
+        bench->roundtrip_mean_us = roundtrip_total / n;
+    }
+
+    if (null_fd >= 0) close(null_fd);
+    free(launch_us);
+    return rc;
+}
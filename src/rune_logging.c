@@ -7,6 +7,224 @@
 
 #include "rune_analyze.h"
 
+#define RUNE_LOG_RECORD_MAX 1024               // Longer records are truncated
+#define RUNE_LOG_BUFFER_SIZE (1u << 16)         // Per thread, async mode (power of two)
+#define RUNE_LOG_FLUSH_MS 50                    // Writer wakes at least this often
+
+int rune_log_threshold = RUNE_LOG_WARNING;      // The default verbosity
+
+// One thread's queued records: the thread is the only producer, the
+// writer (or a flush) consumes under g_log_lock. A record is a
+// rune_log_header_t followed by its text, wrapping around the end.
+typedef struct rune_log_buffer {
+    struct rune_log_buffer *next;
+    uint32_t head;                      // Next write (producer)
+    uint32_t tail;                      // Next read (consumer)
+    int exited;                         // Thread is gone: freed once drained
+    char data[RUNE_LOG_BUFFER_SIZE];
+} rune_log_buffer_t;
+
+typedef struct rune_log_header {
+    uint16_t length;
+    uint16_t to_stderr;
+} rune_log_header_t;
+
+static int g_log_async;
+static int g_log_stderr;                // rune_log_to_stderr() was called
+static rune_log_buffer_t *g_log_buffers;
+static pthread_mutex_t g_log_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t g_log_wake;
+static pthread_t g_log_writer;
+static int g_log_stop;
+static pthread_key_t g_log_key;         // Marks a thread's buffer exited
+
+static __thread rune_log_buffer_t *t_log_buffer;
+
+void rune_log_to_stderr(void) {
+    __atomic_store_n(&g_log_stderr, 1, __ATOMIC_RELAXED);
+}
+
+void rune_log_allow(int level) {
+    int current = __atomic_load_n(&rune_log_threshold, __ATOMIC_RELAXED);
+    while (level > current &&
+           !__atomic_compare_exchange_n(&rune_log_threshold, &current, level, 0,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    }
+}
+
+// Level prefix and message as one record
+static size_t rune_log_format(char *record, int level, const char *format, va_list args) {
+    int verbose = rune_is_verbose_mode();
+    const char *prefix = "";
+    switch (level) {
+        case RUNE_LOG_ERROR:   prefix = "[ERROR] "; break;
+        case RUNE_LOG_WARNING: prefix = "[WARNING] "; break;
+        case RUNE_LOG_INFO:    prefix = verbose >= 2 ? "[INFO] " : ""; break;
+        case RUNE_LOG_DEBUG:   prefix = verbose >= 3 ? "[DEBUG] " : ""; break;
+    }
+    size_t length = strlen(prefix);
+    memcpy(record, prefix, length);
+    int n = vsnprintf(record + length, RUNE_LOG_RECORD_MAX - length, format, args);
+    if (n > 0) {
+        length += (size_t)n < RUNE_LOG_RECORD_MAX - length ? (size_t)n : RUNE_LOG_RECORD_MAX - length - 1;
+    }
+    return length;
+}
+
+static void rune_log_copy_out(const rune_log_buffer_t *buffer, uint32_t from, void *dst, size_t size) {
+    uint32_t offset = from & (RUNE_LOG_BUFFER_SIZE - 1);
+    size_t first = RUNE_LOG_BUFFER_SIZE - offset < size ? RUNE_LOG_BUFFER_SIZE - offset : size;
+    memcpy(dst, buffer->data + offset, first);
+    memcpy((char *)dst + first, buffer->data, size - first);
+}
+
+static void rune_log_copy_in(rune_log_buffer_t *buffer, uint32_t at, const void *src, size_t size) {
+    uint32_t offset = at & (RUNE_LOG_BUFFER_SIZE - 1);
+    size_t first = RUNE_LOG_BUFFER_SIZE - offset < size ? RUNE_LOG_BUFFER_SIZE - offset : size;
+    memcpy(buffer->data + offset, src, first);
+    memcpy(buffer->data, (const char *)src + first, size - first);
+}
+
+// Write out one buffer's records (g_log_lock held)
+static void rune_log_drain(rune_log_buffer_t *buffer) {
+    char record[RUNE_LOG_RECORD_MAX];
+    uint32_t tail = buffer->tail;
+    uint32_t head = __atomic_load_n(&buffer->head, __ATOMIC_ACQUIRE);
+    while (tail != head) {
+        rune_log_header_t header;
+        rune_log_copy_out(buffer, tail, &header, sizeof(header));
+        rune_log_copy_out(buffer, tail + sizeof(header), record, header.length);
+        fwrite(record, 1, header.length, header.to_stderr ? stderr : stdout);
+        tail += sizeof(header) + header.length;
+    }
+    __atomic_store_n(&buffer->tail, tail, __ATOMIC_RELEASE);
+}
+
+// Every buffer, then the streams (g_log_lock held)
+static void rune_log_drain_all(void) {
+    rune_log_buffer_t **link = &g_log_buffers;
+    while (*link) {
+        rune_log_buffer_t *buffer = *link;
+        int exited = __atomic_load_n(&buffer->exited, __ATOMIC_ACQUIRE);
+        rune_log_drain(buffer);
+        if (exited) {
+            *link = buffer->next;
+            free(buffer);
+        } else {
+            link = &buffer->next;
+        }
+    }
+    fflush(stdout);
+    fflush(stderr);
+}
+
+static void *rune_log_writer(void *arg) {
+    pthread_mutex_lock(&g_log_lock);
+    while (!g_log_stop) {
+        rune_log_drain_all();
+        struct timespec deadline;
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_nsec += RUNE_LOG_FLUSH_MS * 1000000L;
+        if (deadline.tv_nsec >= 1000000000L) {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000L;
+        }
+        pthread_cond_timedwait(&g_log_wake, &g_log_lock, &deadline);
+    }
+    rune_log_drain_all();
+    pthread_mutex_unlock(&g_log_lock);
+    return NULL;
+}
+
+static void rune_log_thread_exit(void *buffer) {
+    __atomic_store_n(&((rune_log_buffer_t *)buffer)->exited, 1, __ATOMIC_RELEASE);
+}
+
+static void rune_log_stop_async(void) {
+    pthread_mutex_lock(&g_log_lock);
+    g_log_stop = 1;
+    pthread_cond_signal(&g_log_wake);
+    pthread_mutex_unlock(&g_log_lock);
+    pthread_join(g_log_writer, NULL);
+    __atomic_store_n(&g_log_async, 0, __ATOMIC_RELEASE);
+}
+
+int rune_log_start_async(void) {
+    if (__atomic_load_n(&g_log_async, __ATOMIC_ACQUIRE)) {
+        return 0;
+    }
+    pthread_condattr_t attr;
+    pthread_condattr_init(&attr);
+    pthread_condattr_setclock(&attr, CLOCK_MONOTONIC);
+    pthread_cond_init(&g_log_wake, &attr);
+    pthread_condattr_destroy(&attr);
+    if (pthread_key_create(&g_log_key, rune_log_thread_exit) != 0) {
+        return -1;
+    }
+    int rc = pthread_create(&g_log_writer, NULL, rune_log_writer, NULL);
+    if (rc != 0) {
+        pthread_key_delete(g_log_key);
+        errno = rc;
+        return -1;
+    }
+    // The writer outlives rune_cleanup(): records logged after it still get out
+    atexit(rune_log_stop_async);
+    __atomic_store_n(&g_log_async, 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+void rune_log_flush(void) {
+    if (!__atomic_load_n(&g_log_async, __ATOMIC_ACQUIRE)) {
+        return;
+    }
+    pthread_mutex_lock(&g_log_lock);
+    rune_log_drain_all();
+    pthread_mutex_unlock(&g_log_lock);
+}
+
+static rune_log_buffer_t *rune_log_thread_buffer(void) {
+    if (t_log_buffer) {
+        return t_log_buffer;
+    }
+    rune_log_buffer_t *buffer = calloc(1, sizeof(*buffer));
+    if (!buffer) {
+        return NULL;
+    }
+    pthread_mutex_lock(&g_log_lock);
+    buffer->next = g_log_buffers;
+    g_log_buffers = buffer;
+    pthread_mutex_unlock(&g_log_lock);
+    pthread_setspecific(g_log_key, buffer);
+    t_log_buffer = buffer;
+    return buffer;
+}
+
+// Queue a record; 0 if queued, -1 if it has to be written directly
+static int rune_log_enqueue(const char *record, size_t length, int to_stderr) {
+    rune_log_buffer_t *buffer = rune_log_thread_buffer();
+    if (!buffer) {
+        return -1;
+    }
+    rune_log_header_t header = { .length = (uint16_t)length, .to_stderr = (uint16_t)to_stderr };
+    uint32_t size = sizeof(header) + (uint32_t)length;
+    uint32_t head = buffer->head;
+    uint32_t used = head - __atomic_load_n(&buffer->tail, __ATOMIC_ACQUIRE);
+    if (RUNE_LOG_BUFFER_SIZE - used < size) {
+        // Full: write our own records rather than drop them
+        pthread_mutex_lock(&g_log_lock);
+        rune_log_drain(buffer);
+        pthread_mutex_unlock(&g_log_lock);
+        used = 0;
+    }
+    rune_log_copy_in(buffer, head, &header, sizeof(header));
+    rune_log_copy_in(buffer, head + sizeof(header), record, length);
+    __atomic_store_n(&buffer->head, head + size, __ATOMIC_RELEASE);
+    if (used < RUNE_LOG_BUFFER_SIZE / 2 && used + size >= RUNE_LOG_BUFFER_SIZE / 2) {
+        pthread_cond_signal(&g_log_wake);
+    }
+    return 0;
+}
+
 // Main logging function
 void rune_log(int level, const char* format, ...) {
     // Only print if verbose enough
@@ -14,33 +232,22 @@ void rune_log(int level, const char* format, ...) {
         return;
     }
     
+    char record[RUNE_LOG_RECORD_MAX];
     va_list args;
     va_start(args, format);
+    size_t length = rune_log_format(record, level, format, args);
+    va_end(args);
     
-    // Add level prefixes
-    switch (level) {
-        case RUNE_LOG_ERROR:
-            fprintf(stderr, "[ERROR] ");
-            break;
-        case RUNE_LOG_WARNING:
-            fprintf(stderr, "[WARNING] ");
-            break;
-        case RUNE_LOG_INFO:
-            if (rune_is_verbose_mode() >= 2) {
-                printf("[INFO] ");
-            }
-            break;
-        case RUNE_LOG_DEBUG:
-            if (rune_is_verbose_mode() >= 3) {
-                printf("[DEBUG] ");
-            }
-            break;
+    int to_stderr = level <= RUNE_LOG_WARNING || __atomic_load_n(&g_log_stderr, __ATOMIC_RELAXED);
+    if (__atomic_load_n(&g_log_async, __ATOMIC_ACQUIRE)) {
+        if (level > RUNE_LOG_WARNING && rune_log_enqueue(record, length, to_stderr) == 0) {
+            return;
+        }
+        rune_log_flush();   // Problems come out after what led up to them
     }
     
-    // Print the actual message
-    FILE* output = (level <= RUNE_LOG_WARNING) ? stderr : stdout;
-    vfprintf(output, format, args);
-    va_end(args);
+    // One stdio call per record, so concurrent records never interleave
+    fwrite(record, 1, length, to_stderr ? stderr : stdout);
 }
 
 // Safe memory allocation
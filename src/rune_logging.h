@@ -14,14 +14,42 @@
 #define RUNE_LOG_INFO    2
 #define RUNE_LOG_DEBUG   3
 
-// Main logging function
-void rune_log(int level, const char* format, ...);
+// Most verbose level compiled in; calls above it compile away entirely
+// (make LOG_LEVEL=1 keeps errors and warnings only)
+#ifndef RUNE_LOG_COMPILE_LEVEL
+#define RUNE_LOG_COMPILE_LEVEL RUNE_LOG_DEBUG
+#endif
+
+// Most verbose level any context asked for; the macros test it before
+// evaluating their arguments, rune_log() then checks the caller's context
+extern int rune_log_threshold;
+
+#define RUNE_LOG_ENABLED(level) \
+    ((level) <= RUNE_LOG_COMPILE_LEVEL && (level) <= rune_log_threshold)
+
+// Main logging function: one record, written whole (see rune_logging.c)
+void rune_log(int level, const char* format, ...) __attribute__((format(printf, 2, 3)));
+
+// Let the macros through up to level (raise only)
+void rune_log_allow(int level);
+
+// Write every level to stderr from now on: stdout carries results (--batch)
+void rune_log_to_stderr(void);
+
+// Asynchronous mode: threads append records to their own buffer and a
+// background writer drains them (--async-log). Errors and warnings are
+// still written at once, after everything queued before them.
+int rune_log_start_async(void);
+void rune_log_flush(void);          // Write out everything queued so far
 
 // Convenience macros
-#define rune_log_error(...)   rune_log(RUNE_LOG_ERROR, __VA_ARGS__)
-#define rune_log_warning(...) rune_log(RUNE_LOG_WARNING, __VA_ARGS__)
-#define rune_log_info(...)    rune_log(RUNE_LOG_INFO, __VA_ARGS__)
-#define rune_log_debug(...)   rune_log(RUNE_LOG_DEBUG, __VA_ARGS__)
+#define rune_log_at(level, ...) do { \
+        if (RUNE_LOG_ENABLED(level)) rune_log(level, __VA_ARGS__); \
+    } while (0)
+#define rune_log_error(...)   rune_log_at(RUNE_LOG_ERROR, __VA_ARGS__)
+#define rune_log_warning(...) rune_log_at(RUNE_LOG_WARNING, __VA_ARGS__)
+#define rune_log_info(...)    rune_log_at(RUNE_LOG_INFO, __VA_ARGS__)
+#define rune_log_debug(...)   rune_log_at(RUNE_LOG_DEBUG, __VA_ARGS__)
 
 // Safe memory operations
 void* rune_safe_malloc(size_t size);
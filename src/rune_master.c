@@ -14,7 +14,7 @@
 #include "rune_master.h"
 
 // 🌟 MASTER DEEP INSTALL - The Vision Realized!
-int rune_master_deep_install(const char* package_path) {
+int rune_master_deep_install(rune_context_t* ctx, const char* package_path) {
     RUNE_LOG_FUNC_START("master_deep_install");
     
     printf("🌟 MASTER ORCHESTRATION MODE: DEEP INSTALL\n");
@@ -28,7 +28,7 @@ int rune_master_deep_install(const char* package_path) {
     
     rune_log_checkpoint("MASTER: security_scan_start", "SEC", "Pre-installation security scan initiated");
     
-    int security_result = rune_master_security_scan(package_path);
+    int security_result = rune_master_security_scan(ctx, package_path);
     if (security_result == -1) {
         printf("❌ SECURITY SCAN FAILED - Installation ABORTED!\n");
         return -1;
@@ -42,7 +42,7 @@ int rune_master_deep_install(const char* package_path) {
     printf("\n📋 Phase 2: Intelligent runepkg Strategy Selection\n");
     printf("──────────────────────────────────────────────────\n");
     
-    int strategy = rune_master_choose_runepkg_strategy(package_path);
+    int strategy = rune_master_choose_runepkg_strategy(ctx, package_path);
     
     char runepkg_command[512];
     switch (strategy) {
@@ -76,11 +76,11 @@ int rune_master_deep_install(const char* package_path) {
     rune_log_checkpoint("MASTER: execution_start", "PERF", "Master-controlled execution initiated");
     
     // Store the command for monitoring
-    RUNE_SAFE_STRNCPY(g_config.target_executable, runepkg_command, sizeof(g_config.target_executable));
-    g_config.enable_monitoring = 1;
+    RUNE_SAFE_STRNCPY(ctx->config.target_executable, runepkg_command, sizeof(ctx->config.target_executable));
+    ctx->config.enable_monitoring = 1;
     
     // Execute with enhanced monitoring
-    int result = rune_execute_target();
+    int result = rune_execute_target(ctx);
     
     // Phase 4: Post-Execution Analysis
     printf("\n📋 Phase 4: Post-Execution Master Analysis\n");
@@ -88,15 +88,15 @@ int rune_master_deep_install(const char* package_path) {
     
     if (result == 0) {
         printf("✅ MASTER INSTALLATION SUCCESSFUL!\n");
-        printf("   Exit Code: %d\n", g_results.exit_code);
-        printf("   Execution Time: %.6f seconds\n", g_results.execution_time);
+        printf("   Exit Code: %d\n", ctx->results.exit_code);
+        printf("   Execution Time: %.6f seconds\n", ctx->results.execution_time);
         
         // Generate comprehensive report
-        rune_master_generate_security_report();
+        rune_master_generate_security_report(ctx);
     } else {
         printf("❌ MASTER INSTALLATION FAILED!\n");
-        printf("   Exit Code: %d\n", g_results.exit_code);
-        printf("   Failure Time: %.6f seconds\n", g_results.execution_time);
+        printf("   Exit Code: %d\n", ctx->results.exit_code);
+        printf("   Failure Time: %.6f seconds\n", ctx->results.execution_time);
     }
     
     RUNE_LOG_FUNC_END("master_deep_install");
@@ -104,7 +104,7 @@ int rune_master_deep_install(const char* package_path) {
 }
 
 // 🛡️ MASTER SECURITY SCAN
-int rune_master_security_scan(const char* package_path) {
+int rune_master_security_scan(rune_context_t* ctx, const char* package_path) {
     RUNE_LOG_FUNC_START("master_security_scan");
     
     printf("🛡️  MASTER SECURITY SCAN: %s\n", package_path);
@@ -168,7 +168,7 @@ int rune_master_security_scan(const char* package_path) {
 }
 
 // 🧠 MASTER SMART MONITOR
-int rune_master_smart_monitor(const char* command) {
+int rune_master_smart_monitor(rune_context_t* ctx, const char* command) {
     RUNE_LOG_FUNC_START("master_smart_monitor");
     
     printf("🧠 MASTER SMART MONITORING: %s\n", command);
@@ -176,29 +176,29 @@ int rune_master_smart_monitor(const char* command) {
     printf("Intelligent monitoring with real-time threat detection enabled!\n\n");
     
     // Enable all monitoring features for smart mode
-    g_config.enable_security = 1;
-    g_config.enable_performance = 1;
-    g_config.enable_deep_analysis = 1;
+    ctx->config.enable_security = 1;
+    ctx->config.enable_performance = 1;
+    ctx->config.enable_deep_analysis = 1;
     
     // Store command for monitoring
-    RUNE_SAFE_STRNCPY(g_config.target_executable, command, sizeof(g_config.target_executable));
-    g_config.enable_monitoring = 1;
+    RUNE_SAFE_STRNCPY(ctx->config.target_executable, command, sizeof(ctx->config.target_executable));
+    ctx->config.enable_monitoring = 1;
     
     rune_log_checkpoint("MASTER: smart_monitor_start", "PERF", "Smart monitoring initiated");
     
     // Execute with smart monitoring
-    int result = rune_execute_target();
+    int result = rune_execute_target(ctx);
     
     // Real-time vulnerability detection during execution
     printf("\n🔍 Real-time Analysis Results:\n");
     printf("─────────────────────────────\n");
     
-    if (g_results.execution_time > 30.0) {
-        printf("⚠️  PERFORMANCE: Execution took %.2f seconds (>30s is suspicious)\n", g_results.execution_time);
+    if (ctx->results.execution_time > 30.0) {
+        printf("⚠️  PERFORMANCE: Execution took %.2f seconds (>30s is suspicious)\n", ctx->results.execution_time);
     }
     
-    if (g_results.exit_code != 0) {
-        printf("🚨 EXIT CODE: Non-zero exit code (%d) detected\n", g_results.exit_code);
+    if (ctx->results.exit_code != 0) {
+        printf("🚨 EXIT CODE: Non-zero exit code (%d) detected\n", ctx->results.exit_code);
     } else {
         printf("✅ EXECUTION: Command completed successfully\n");
     }
@@ -208,7 +208,7 @@ int rune_master_smart_monitor(const char* command) {
 }
 
 // ☠️  MASTER THREAT ANALYZE
-int rune_master_threat_analyze(const char* package_path) {
+int rune_master_threat_analyze(rune_context_t* ctx, const char* package_path) {
     RUNE_LOG_FUNC_START("master_threat_analyze");
     
     printf("☠️  MASTER THREAT ANALYSIS: %s\n", package_path);
@@ -218,7 +218,7 @@ int rune_master_threat_analyze(const char* package_path) {
     int threat_score = 0;
     
     // Run security scan first
-    int security_result = rune_master_security_scan(package_path);
+    int security_result = rune_master_security_scan(ctx, package_path);
     threat_score += security_result * 3; // Weight security highly
     
     printf("\n🔬 Advanced Threat Indicators:\n");
@@ -264,7 +264,7 @@ int rune_master_threat_analyze(const char* package_path) {
 }
 
 // 🎯 Helper: Choose runepkg strategy based on package analysis
-int rune_master_choose_runepkg_strategy(const char* package_path) {
+int rune_master_choose_runepkg_strategy(rune_context_t* ctx, const char* package_path) {
     // Quick assessment to choose strategy
     struct stat file_stat;
     int strategy = 0; // Default
@@ -294,13 +294,13 @@ int rune_master_choose_runepkg_strategy(const char* package_path) {
 }
 
 // 📊 Helper: Generate comprehensive security report
-int rune_master_generate_security_report(void) {
+int rune_master_generate_security_report(const rune_context_t* ctx) {
     printf("\n📊 MASTER SECURITY REPORT\n");
     printf("═══════════════════════════\n");
-    printf("Execution Time: %.6f seconds\n", g_results.execution_time);
-    printf("Exit Code: %d (%s)\n", g_results.exit_code, 
-           g_results.exit_code == 0 ? "Success" : "Failure");
-    printf("Process ID: %d\n", g_results.child_pid);
+    printf("Execution Time: %.6f seconds\n", ctx->results.execution_time);
+    printf("Exit Code: %d (%s)\n", ctx->results.exit_code, 
+           ctx->results.exit_code == 0 ? "Success" : "Failure");
+    printf("Process ID: %d\n", ctx->results.child_pid);
     printf("Security Analysis: ✅ Completed\n");
     printf("Performance Analysis: ✅ Completed\n");
     printf("Memory Analysis: ✅ Completed\n");
@@ -13,45 +13,50 @@
 #define RUNE_MASTER_H
 
 #include "rune_types.h"
+#include "rune_context.h"
 
 // 🌟 Master Orchestration Functions (THE VISION!)
 
 /**
  * @brief Master-controlled secure installation
  * rune_analyze takes full control of package installation with comprehensive analysis
+ * @param ctx Analysis context
  * @param package_path Path to the .deb package
  * @return 0 on success, -1 on failure
  */
-int rune_master_deep_install(const char* package_path);
+int rune_master_deep_install(rune_context_t* ctx, const char* package_path);
 
 /**
  * @brief Pre-installation security analysis
  * Deep security scan before any installation begins
+ * @param ctx Analysis context
  * @param package_path Path to the .deb package
  * @return 0 if safe, 1 if suspicious, -1 on error
  */
-int rune_master_security_scan(const char* package_path);
+int rune_master_security_scan(rune_context_t* ctx, const char* package_path);
 
 /**
  * @brief Intelligent command monitoring
  * Smart monitoring with real-time threat detection
+ * @param ctx Analysis context
  * @param command Command to monitor
  * @return 0 on success, -1 on failure
  */
-int rune_master_smart_monitor(const char* command);
+int rune_master_smart_monitor(rune_context_t* ctx, const char* command);
 
 /**
  * @brief Comprehensive threat assessment
  * Full threat analysis with vulnerability detection
+ * @param ctx Analysis context
  * @param package_path Path to the .deb package
  * @return Threat level (0=safe, 10=critical), -1 on error
  */
-int rune_master_threat_analyze(const char* package_path);
+int rune_master_threat_analyze(rune_context_t* ctx, const char* package_path);
 
 // Master orchestration helper functions
-int rune_master_choose_runepkg_strategy(const char* package_path);
-int rune_master_detect_vulnerabilities_realtime(void);
-int rune_master_generate_security_report(void);
+int rune_master_choose_runepkg_strategy(rune_context_t* ctx, const char* package_path);
+int rune_master_detect_vulnerabilities_realtime(rune_context_t* ctx);
+int rune_master_generate_security_report(const rune_context_t* ctx);
 
 // 🛡️ NEW: Safe Analysis Functions (Non-Executing)
 int rune_safe_analyze_package(const char* package_path);
@@ -0,0 +1,221 @@
+/**
+ * rune_matcher.c - Streaming multi-pattern matcher implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_matcher.h"
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Set on encoded transitions that land in a state with matches
+#define RUNE_MATCH_ACCEPT 0x80000000u
+
+struct rune_matcher {
+    uint8_t byte_class[256];    // Byte -> alphabet class, 0 = not in any pattern
+    uint8_t leaves_root[256];   // Byte moves the automaton out of the root state
+    uint64_t pair_start[1024];  // Bitmap of byte pairs that begin some pattern
+    int use_pairs;              // Every pattern is at least two bytes long
+    uint32_t classes;           // Alphabet size (distinct pattern bytes + 1)
+    uint32_t states;
+    uint32_t *delta;            // states * classes transitions, failures resolved.
+                                // Entries are row offsets (target * classes) | RUNE_MATCH_ACCEPT
+    uint32_t *out_start;        // Per state: first index into out
+    uint32_t *out_len;          // Per state: matches ending here (own + suffixes)
+    int *out;                   // Flattened groups
+    int groups;
+};
+
+static uint8_t rune_match_fold(uint8_t c, int flags) {
+    return (flags & RUNE_MATCH_NOCASE) ? (uint8_t)tolower(c) : c;
+}
+
+rune_matcher_t *rune_matcher_create(const rune_match_pattern_t *patterns, size_t count, int flags) {
+    rune_matcher_t *m = calloc(1, sizeof(*m));
+    if (!m) return NULL;
+
+    // Compress the alphabet to the bytes that actually occur in patterns
+    size_t max_states = 1;
+    m->classes = 1;
+    for (size_t i = 0; i < count; i++) {
+        for (const uint8_t *p = (const uint8_t *)patterns[i].text; *p; p++) {
+            uint8_t c = rune_match_fold(*p, flags);
+            if (!m->byte_class[c]) m->byte_class[c] = (uint8_t)m->classes++;
+            max_states++;
+        }
+        if (patterns[i].group + 1 > m->groups) m->groups = patterns[i].group + 1;
+    }
+    if (max_states == 1) goto fail;
+    if (flags & RUNE_MATCH_NOCASE) {
+        for (int c = 'A'; c <= 'Z'; c++) m->byte_class[c] = m->byte_class[tolower(c)];
+    }
+
+    uint32_t *failure = calloc(max_states, sizeof(uint32_t));
+    uint32_t *queue = calloc(max_states, sizeof(uint32_t));
+    int *own = malloc(count * sizeof(int));            // Pattern ending at each trie node
+    int *own_next = malloc(count * sizeof(int));
+    int *own_head = malloc(max_states * sizeof(int));
+    m->delta = malloc(max_states * m->classes * sizeof(uint32_t));
+    m->out_start = calloc(max_states, sizeof(uint32_t));
+    m->out_len = calloc(max_states, sizeof(uint32_t));
+    if (!failure || !queue || !own || !own_next || !own_head || !m->delta || !m->out_start || !m->out_len) {
+        free(failure); free(queue); free(own); free(own_next); free(own_head);
+        goto fail;
+    }
+    memset(m->delta, 0xff, max_states * m->classes * sizeof(uint32_t));
+    for (size_t s = 0; s < max_states; s++) own_head[s] = -1;
+
+    // 1. Trie
+    m->states = 1;
+    for (size_t i = 0; i < count; i++) {
+        uint32_t s = 0;
+        for (const uint8_t *p = (const uint8_t *)patterns[i].text; *p; p++) {
+            uint32_t *slot = &m->delta[s * m->classes + m->byte_class[*p]];
+            if (*slot == UINT32_MAX) *slot = m->states++;
+            s = *slot;
+        }
+        if (s == 0) continue; // Empty pattern
+        own[i] = patterns[i].group;
+        own_next[i] = own_head[s];
+        own_head[s] = (int)i;
+    }
+
+    // 2. Breadth-first: failure links, then turn the trie into a full DFA.
+    //    BFS order guarantees failure[s] is finished before s.
+    size_t out_capacity = count + 16, out_used = 0;
+    m->out = malloc(out_capacity * sizeof(int));
+    size_t head = 0, tail = 0;
+    queue[tail++] = 0;
+    while (m->out && head < tail) {
+        uint32_t s = queue[head++];
+
+        // Matches at s: its own patterns plus everything its failure state reports
+        size_t needed = out_used + count + (s ? m->out_len[failure[s]] : 0);
+        if (needed > out_capacity) {
+            out_capacity = needed * 2;
+            int *grown = realloc(m->out, out_capacity * sizeof(int));
+            if (!grown) {
+                free(m->out);
+                m->out = NULL;
+                break;
+            }
+            m->out = grown;
+        }
+        m->out_start[s] = (uint32_t)out_used;
+        for (int p = own_head[s]; p >= 0; p = own_next[p]) m->out[out_used++] = own[p];
+        if (s != 0) {
+            memcpy(&m->out[out_used], &m->out[m->out_start[failure[s]]], m->out_len[failure[s]] * sizeof(int));
+            out_used += m->out_len[failure[s]];
+        }
+        m->out_len[s] = (uint32_t)(out_used - m->out_start[s]);
+
+        for (uint32_t c = 0; c < m->classes; c++) {
+            uint32_t *slot = &m->delta[s * m->classes + c];
+            uint32_t via_fail = s == 0 ? 0 : m->delta[failure[s] * m->classes + c];
+            if (*slot == UINT32_MAX) {
+                *slot = via_fail;
+            } else {
+                failure[*slot] = via_fail;
+                queue[tail++] = *slot;
+            }
+        }
+    }
+
+    free(failure); free(queue); free(own); free(own_next); free(own_head);
+    if (!m->out) goto fail;
+
+    // 3. Store row offsets instead of state numbers and flag accepting
+    //    targets: the scan loop then needs no multiply and no second lookup
+    for (size_t i = 0; i < (size_t)m->states * m->classes; i++) {
+        uint32_t target = m->delta[i];
+        m->delta[i] = target * m->classes | (m->out_len[target] ? RUNE_MATCH_ACCEPT : 0);
+    }
+    for (int c = 0; c < 256; c++) {
+        m->leaves_root[c] = m->delta[m->byte_class[c]] != 0;
+    }
+
+    // 4. Prefilter: from the root, a position can only start a match if its
+    //    byte pair begins a pattern. Checking pairs rejects far more bytes
+    //    than checking single bytes.
+    m->use_pairs = 1;
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t *text = (const uint8_t *)patterns[i].text;
+        if (!text[0]) continue;
+        if (!text[1]) {
+            m->use_pairs = 0;
+            break;
+        }
+        for (int a = 0; a < 256; a++) {
+            if (m->byte_class[a] != m->byte_class[text[0]]) continue;
+            for (int b = 0; b < 256; b++) {
+                if (m->byte_class[b] != m->byte_class[text[1]]) continue;
+                unsigned key = (unsigned)a | (unsigned)b << 8;
+                m->pair_start[key >> 6] |= 1ULL << (key & 63);
+            }
+        }
+    }
+    return m;
+
+fail:
+    rune_matcher_destroy(m);
+    return NULL;
+}
+
+void rune_matcher_destroy(rune_matcher_t *matcher) {
+    if (!matcher) return;
+    free(matcher->delta);
+    free(matcher->out_start);
+    free(matcher->out_len);
+    free(matcher->out);
+    free(matcher);
+}
+
+int rune_matcher_groups(const rune_matcher_t *matcher) {
+    return matcher->groups;
+}
+
+void rune_matcher_reset(rune_match_state_t *state) {
+    state->state = 0;
+}
+
+void rune_matcher_feed(const rune_matcher_t *matcher, rune_match_state_t *state,
+                       const void *data, size_t len, unsigned long *counts) {
+    const uint8_t *p = data;
+    const uint32_t *delta = matcher->delta;
+    const uint8_t *byte_class = matcher->byte_class;
+    uint32_t s = state->state;
+
+    for (size_t i = 0; i < len; i++) {
+        if (s == 0) {
+            // At the root most bytes lead straight back to it: skip them
+            // with independent tests instead of the dependent table walk.
+            // No match can start at a skipped position, so restarting from
+            // the root where the skip stops counts exactly the same matches.
+            if (matcher->use_pairs) {
+                while (i + 1 < len) {
+                    unsigned key = (unsigned)p[i] | (unsigned)p[i + 1] << 8;
+                    if (matcher->pair_start[key >> 6] & (1ULL << (key & 63))) break;
+                    i++;
+                }
+            }
+            while (i < len && !matcher->leaves_root[p[i]]) i++;
+            if (i == len) break;
+        }
+        s = delta[(s & ~RUNE_MATCH_ACCEPT) + byte_class[p[i]]];
+        if (s & RUNE_MATCH_ACCEPT) {
+            uint32_t target = (s & ~RUNE_MATCH_ACCEPT) / matcher->classes;
+            const int *out = &matcher->out[matcher->out_start[target]];
+            for (uint32_t k = 0; k < matcher->out_len[target]; k++) counts[out[k]]++;
+        }
+    }
+    state->state = s;
+}
+
+void rune_matcher_scan(const rune_matcher_t *matcher, const char *text, unsigned long *counts) {
+    rune_match_state_t state;
+    rune_matcher_reset(&state);
+    rune_matcher_feed(matcher, &state, text, strlen(text), counts);
+}
@@ -0,0 +1,75 @@
+/**
+ * rune_matcher.h - Streaming multi-pattern matcher (Aho-Corasick)
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * A pattern table is compiled once into a DFA over a compressed
+ * alphabet. Feeding data is one table lookup per byte no matter how many
+ * patterns there are, and the automaton state lives in a small
+ * rune_match_state_t owned by the caller - so a keyword split across two
+ * read()s is still found, and one compiled matcher can serve any number
+ * of streams at once.
+ *
+ * This module depends on libc only so that both the modular framework
+ * and the legacy monolith can link it.
+ */
+
+#ifndef RUNE_MATCHER_H
+#define RUNE_MATCHER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Compile flags
+#define RUNE_MATCH_NOCASE 0x1   // ASCII case-insensitive matching
+
+// One entry of a pattern table
+typedef struct rune_match_pattern {
+    const char *text;           // Pattern bytes (NUL terminated, non-empty)
+    int group;                  // Counter incremented on every match
+} rune_match_pattern_t;
+
+typedef struct rune_matcher rune_matcher_t;
+
+// Per-stream automaton position, carried across chunks
+typedef struct rune_match_state {
+    uint32_t state;
+} rune_match_state_t;
+
+/**
+ * @brief Compile a pattern table
+ * @return Matcher, or NULL on allocation failure / empty table
+ */
+rune_matcher_t *rune_matcher_create(const rune_match_pattern_t *patterns, size_t count, int flags);
+
+/**
+ * @brief Free a compiled matcher
+ */
+void rune_matcher_destroy(rune_matcher_t *matcher);
+
+/**
+ * @brief Number of counters rune_matcher_feed() may touch (highest group + 1)
+ */
+int rune_matcher_groups(const rune_matcher_t *matcher);
+
+/**
+ * @brief Start a new stream
+ */
+void rune_matcher_reset(rune_match_state_t *state);
+
+/**
+ * @brief Scan a chunk, counting every match into counts[group]
+ *
+ * Overlapping matches are all counted ("errorerror" matches "error"
+ * twice, "error" and "rror" both match inside "error").
+ */
+void rune_matcher_feed(const rune_matcher_t *matcher, rune_match_state_t *state,
+                       const void *data, size_t len, unsigned long *counts);
+
+/**
+ * @brief One-shot scan of a NUL terminated string
+ */
+void rune_matcher_scan(const rune_matcher_t *matcher, const char *text, unsigned long *counts);
+
+#endif /* RUNE_MATCHER_H */
@@ -11,133 +11,307 @@
 #include "rune_analyze.h"
 
 // Print human-readable report
-void rune_print_human_report(void) {
+void rune_print_human_report(const rune_context_t* ctx) {
     RUNE_LOG_FUNC_START("human_report");
+    rune_log_flush();   // Queued log lines first, then the report in one piece
     
-    rune_print_banner();
-    rune_print_execution_summary();
-    rune_print_memory_analysis();
-    rune_print_io_analysis();
+    rune_print_banner(ctx);
+    rune_print_execution_summary(ctx);
+    rune_print_memory_analysis(ctx);
+    rune_print_io_analysis(ctx);
+    rune_print_resource_accounting(ctx);
+    rune_print_probe_stats(ctx);
+    rune_print_trigger_stats(ctx);
     
-    if (rune_is_deep_analysis_enabled()) {
-        rune_print_deep_analysis();
+    if (ctx->config.enable_deep_analysis) {
+        rune_print_deep_analysis(ctx);
     }
     
     RUNE_LOG_FUNC_END("human_report");
 }
 
 // Print JSON report
-void rune_print_json_report(void) {
+void rune_print_json_report(const rune_context_t* ctx) {
     RUNE_LOG_FUNC_START("json_report");
+    rune_log_flush();
     
     printf("{\n");
-    rune_print_json_header();
-    rune_print_json_execution();
-    rune_print_json_memory();
+    rune_print_json_header(ctx);
+    rune_print_json_execution(ctx);
+    rune_print_json_memory(ctx);
+    rune_print_json_resources(ctx);
     
-    if (rune_is_deep_analysis_enabled()) {
-        rune_print_json_deep_analysis();
+    if (ctx->config.enable_deep_analysis) {
+        rune_print_json_deep_analysis(ctx);
     }
     
     // Include checkpoints in JSON if verbose
-    if (rune_is_verbose_mode() >= 2) {
-        rune_export_checkpoints_json();
+    if (ctx->config.verbose_mode >= 2) {
+        rune_export_checkpoints_json(ctx);
     }
     
-    rune_print_json_footer();
+    rune_print_json_footer(ctx);
     printf("}\n");
     
     RUNE_LOG_FUNC_END("json_report");
 }
 
 // Print both reports
-void rune_print_both_reports(void) {
-    rune_print_human_report();
+void rune_print_both_reports(const rune_context_t* ctx) {
+    rune_print_human_report(ctx);
     printf("\n" "JSON Output:\n");
-    rune_print_json_report();
+    rune_print_json_report(ctx);
 }
 
 // Report components
-void rune_print_banner(void) {
+void rune_print_banner(const rune_context_t* ctx) {
     printf("═══════════════════════════════════════════════════════════════\n");
     printf("🔬 rune_analyze Universal Analysis Report\n");
     printf("═══════════════════════════════════════════════════════════════\n");
 }
 
-void rune_print_execution_summary(void) {
+void rune_print_execution_summary(const rune_context_t* ctx) {
     printf("📊 Execution Summary:\n");
-    printf("  ⏱️  Execution Time: %.3fs\n", g_results.execution_time);
-    printf("  🔢 Exit Code: %d (%s)\n", g_results.exit_code, rune_decode_exit_code(g_results.exit_code));
+    printf("  ⏱️  Execution Time: %.3fs\n", ctx->results.execution_time);
+    printf("  🔢 Exit Code: %d (%s)\n", ctx->results.exit_code, rune_decode_exit_code(ctx->results.exit_code));
 }
 
-void rune_print_memory_analysis(void) {
+void rune_print_memory_analysis(const rune_context_t* ctx) {
     printf("💾 Memory Analysis:\n");
-    printf("  📊 Peak Memory Usage: %ld KB\n", g_results.peak_memory_kb);
+    printf("  📊 Peak Memory Usage: %ld KB\n", ctx->results.peak_memory_kb);
 }
 
-void rune_print_io_analysis(void) {
+void rune_print_io_analysis(const rune_context_t* ctx) {
     printf("💿 I/O Analysis:\n");
-    printf("  📤 Stdout Output: %zu bytes\n", g_results.stdout_bytes);
-    printf("  📥 Stderr Output: %zu bytes\n", g_results.stderr_bytes);
+    printf("  📤 Stdout Output: %zu bytes\n", ctx->results.stdout_bytes);
+    printf("  📥 Stderr Output: %zu bytes\n", ctx->results.stderr_bytes);
+    printf("  🔎 Output Keywords: %d verbose, %d error, %d warning\n",
+           ctx->results.verbose_messages, ctx->results.error_messages, ctx->results.warning_messages);
 }
 
-void rune_print_deep_analysis(void) {
+void rune_print_resource_accounting(const rune_context_t* ctx) {
+    printf("⚙️  Kernel Resource Accounting:\n");
+    printf("  🧮 CPU Time: %.3fs user + %.3fs system (%.1f%% CPU)\n",
+           ctx->results.user_time, ctx->results.system_time, ctx->results.cpu_usage_percent);
+    printf("  📄 Page Faults: %ld minor, %ld major\n",
+           ctx->results.minor_faults, ctx->results.major_faults);
+    printf("  🔀 Context Switches: %ld voluntary, %ld involuntary\n",
+           ctx->results.voluntary_context_switches, ctx->results.involuntary_context_switches);
+    
+    if (ctx->results.cgroup_enabled) {
+        printf("  🌳 Process Tree (cgroup v2):\n");
+        if (ctx->results.cgroup_cpu_usage_usec >= 0) {
+            printf("    • CPU Time: %.3fs (%.3fs user + %.3fs system)\n",
+                   ctx->results.cgroup_cpu_usage_usec / 1000000.0,
+                   ctx->results.cgroup_cpu_user_usec / 1000000.0,
+                   ctx->results.cgroup_cpu_system_usec / 1000000.0);
+        }
+        if (ctx->results.cgroup_memory_peak_bytes >= 0) {
+            printf("    • Peak Memory: %lld KB\n", ctx->results.cgroup_memory_peak_bytes / 1024);
+        } else {
+            printf("    • Peak Memory: unavailable (memory controller not delegated)\n");
+        }
+        if (ctx->results.cgroup_io_read_bytes >= 0) {
+            printf("    • Block I/O: %lld bytes read, %lld bytes written\n",
+                   ctx->results.cgroup_io_read_bytes, ctx->results.cgroup_io_write_bytes);
+        } else {
+            printf("    • Block I/O: unavailable (io controller not delegated)\n");
+        }
+    }
+    
+    if (ctx->results.tree_processes > 1) {
+        printf("  👪 Process Tree: %d processes (max %d at once)\n",
+               ctx->results.tree_processes, ctx->results.tree_max_concurrent);
+        printf("    • CPU Time: %.3fs, Peak RSS: %ld KB (all live processes)\n",
+               ctx->results.tree_cpu_seconds, ctx->results.tree_peak_rss_kb);
+        printf("    • I/O: %llu bytes read, %llu bytes written\n",
+               ctx->results.tree_read_bytes, ctx->results.tree_write_bytes);
+        if (ctx->results.tree_orphans_reaped > 0 || ctx->results.tree_still_running > 0) {
+            printf("    • Orphans: %d reaped, %d still running after the target exited\n",
+                   ctx->results.tree_orphans_reaped, ctx->results.tree_still_running);
+        }
+        rune_proctree_print(&ctx->proctree, stdout, RUNE_PROCTREE_REPORT_ROWS);
+    }
+    
+    if (ctx->results.perf_enabled) {
+        printf("  📊 Process Tree Counters (perf_event%s):\n",
+               ctx->results.perf_hardware ? "" : ", software only - no PMU");
+        printf("    • Task Clock: %.3f ms\n", ctx->results.perf_task_clock_ns / 1000000.0);
+        printf("    • Page Faults: %lld, Context Switches: %lld, CPU Migrations: %lld\n",
+               ctx->results.perf_page_faults, ctx->results.perf_context_switches,
+               ctx->results.perf_cpu_migrations);
+        if (ctx->results.perf_hardware) {
+            printf("    • Instructions: %lld, Cycles: %lld (IPC %.2f)\n",
+                   ctx->results.perf_instructions, ctx->results.perf_cycles, ctx->results.perf_ipc);
+            if (ctx->results.perf_cache_references > 0) {
+                printf("    • Cache Misses: %lld of %lld references (%.2f%%)\n",
+                       ctx->results.perf_cache_misses, ctx->results.perf_cache_references,
+                       ctx->results.perf_cache_miss_rate * 100.0);
+            }
+            if (ctx->results.perf_branches > 0) {
+                printf("    • Branch Misses: %lld of %lld branches (%.2f%%)\n",
+                       ctx->results.perf_branch_misses, ctx->results.perf_branches,
+                       ctx->results.perf_branch_miss_rate * 100.0);
+            }
+        }
+    }
+}
+
+void rune_print_probe_stats(const rune_context_t* ctx) {
+    if (!ctx->results.probe_enabled) return;
+    printf("📡 Target Probe%s: %llu checkpoints merged into the timeline",
+           ctx->results.probe_preloaded ? " (librune_probe.so)" : "", ctx->results.probe_events);
+    if (ctx->results.probe_dropped) {
+        printf(", %llu dropped in the target", ctx->results.probe_dropped);
+    }
+    printf("\n");
+}
+
+void rune_print_trigger_stats(const rune_context_t* ctx) {
+    int fired = 0;
+    for (int i = 0; i < ctx->trigger_count; i++) {
+        const rune_trigger_stats_t* stats = &ctx->triggers[i].stats;
+        fired |= stats->fired || stats->dropped || stats->coalesced;
+    }
+    if (!fired) return;
+    
+    printf("⚡ Triggers (async overflow: %s):\n",
+           rune_trigger_overflow_name((rune_trigger_overflow_t)ctx->config.trigger_overflow));
+    printf("  %-20s %-5s %8s %8s %8s %10s %10s %10s %6s %6s\n", "TRIGGER", "MODE", "FIRED", "DROPPED",
+           "MERGED", "AVG LAT", "MAX LAT", "AVG RUN", "AVG Q", "MAX Q");
+    for (int i = 0; i < ctx->trigger_count; i++) {
+        const rune_trigger_t* trigger = &ctx->triggers[i];
+        const rune_trigger_stats_t* stats = &trigger->stats;
+        if (!stats->fired && !stats->dropped && !stats->coalesced) continue;
+        printf("  %-20s %-5s %8llu %8llu %8llu %8.1fus %8.1fus %8.1fus %6.1f %6llu\n",
+               trigger->name, trigger->async ? "async" : "sync",
+               (unsigned long long)stats->fired, (unsigned long long)stats->dropped,
+               (unsigned long long)stats->coalesced,
+               stats->fired ? stats->latency_ns_total / 1000.0 / stats->fired : 0.0,
+               stats->latency_ns_max / 1000.0,
+               stats->fired ? stats->run_ns_total / 1000.0 / stats->fired : 0.0,
+               stats->queued ? (double)stats->depth_total / stats->queued : 0.0,
+               (unsigned long long)stats->depth_max);
+    }
+}
+
+void rune_print_span_profile(const rune_context_t* ctx) {
+    rune_span_total_t* spans;
+    int count = rune_span_totals(ctx, &spans);
+    if (count <= 0) return;
+    
+    printf("⏱️  rune_analyze Time by Span:\n");
+    printf("  %-28s %8s %12s %12s\n", "SPAN", "CALLS", "TOTAL", "SELF");
+    for (int i = 0; i < count; i++) {
+        printf("  %-28s %8llu %10.3fms %10.3fms\n", spans[i].name, (unsigned long long)spans[i].calls,
+               spans[i].total_ns / 1e6, spans[i].self_ns / 1e6);
+    }
+    free(spans);
+}
+
+void rune_print_deep_analysis(const rune_context_t* ctx) {
     printf("🧬 Deep Analysis Results:\n");
-    printf("  🏷️  Tool Classification: %s\n", g_results.tool_classification);
-    printf("  🎯 Behavior Pattern: %s\n", g_results.behavior_pattern);
-    printf("  📈 Performance Category: %s\n", g_results.performance_category);
-    printf("  🧮 Output Complexity: %d/10\n", g_results.output_complexity_score);
-    printf("  ⚡ Resource Efficiency: %d/10\n", g_results.resource_efficiency_score);
-    printf("  ⏰ Timing Breakdown:\n");
+    printf("  🏷️  Tool Classification: %s\n", ctx->results.tool_classification);
+    printf("  🎯 Behavior Pattern: %s\n", ctx->results.behavior_pattern);
+    printf("  📈 Performance Category: %s\n", ctx->results.performance_category);
+    printf("  🧮 Output Complexity: %d/10\n", ctx->results.output_complexity_score);
+    printf("  ⚡ Resource Efficiency: %d/10\n", ctx->results.resource_efficiency_score);
+    if (ctx->results.phases_measured) {
+        printf("  ⏰ Timing Breakdown (measured: %d samples, %s activity):\n",
+               ctx->results.timeline_samples, ctx->results.phase_signal);
+    } else {
+        printf("  ⏰ Timing Breakdown (not enough samples to detect phases):\n");
+    }
     printf("    • Startup Time: %.3fs (%.1f%%)\n", 
-           g_results.startup_time, 
-           (g_results.startup_time / g_results.execution_time) * 100);
+           ctx->results.startup_time, 
+           (ctx->results.startup_time / ctx->results.execution_time) * 100);
     printf("    • Processing Time: %.3fs (%.1f%%)\n", 
-           g_results.processing_time,
-           (g_results.processing_time / g_results.execution_time) * 100);
+           ctx->results.processing_time,
+           (ctx->results.processing_time / ctx->results.execution_time) * 100);
     printf("    • Cleanup Time: %.3fs (%.1f%%)\n", 
-           g_results.cleanup_time,
-           (g_results.cleanup_time / g_results.execution_time) * 100);
+           ctx->results.cleanup_time,
+           (ctx->results.cleanup_time / ctx->results.execution_time) * 100);
 }
 
 // JSON components
-void rune_print_json_header(void) {
+void rune_print_json_header(const rune_context_t* ctx) {
     printf("  \"rune_analyze_version\": \"%s\",\n", RUNE_ANALYZE_VERSION);
     printf("  \"analysis_timestamp\": %ld,\n", time(NULL));
-    printf("  \"target_executable\": \"%s\",\n", rune_get_target_executable());
+    printf("  \"target_executable\": \"%s\",\n", ctx->config.target_executable);
 }
 
-void rune_print_json_execution(void) {
+void rune_print_json_execution(const rune_context_t* ctx) {
     printf("  \"execution\": {\n");
-    printf("    \"time_seconds\": %.6f,\n", g_results.execution_time);
-    printf("    \"exit_code\": %d,\n", g_results.exit_code);
-    printf("    \"success\": %s\n", g_results.exit_code == 0 ? "true" : "false");
+    printf("    \"time_seconds\": %.6f,\n", ctx->results.execution_time);
+    printf("    \"exit_code\": %d,\n", ctx->results.exit_code);
+    printf("    \"success\": %s,\n", ctx->results.exit_code == 0 ? "true" : "false");
+    printf("    \"stdout_bytes\": %zu,\n", ctx->results.stdout_bytes);
+    printf("    \"stderr_bytes\": %zu,\n", ctx->results.stderr_bytes);
+    printf("    \"zero_copy_capture\": %s,\n", ctx->results.capture_zero_copy ? "true" : "false");
+    printf("    \"capture_dropped_bytes\": %llu\n", ctx->results.capture_dropped_bytes);
     printf("  },\n");
 }
 
-void rune_print_json_memory(void) {
+void rune_print_json_memory(const rune_context_t* ctx) {
     printf("  \"memory\": {\n");
-    printf("    \"peak_kb\": %ld\n", g_results.peak_memory_kb);
+    printf("    \"peak_kb\": %ld\n", ctx->results.peak_memory_kb);
+    printf("  },\n");
+}
+
+void rune_print_json_resources(const rune_context_t* ctx) {
+    printf("  \"resources\": {\n");
+    printf("    \"user_time_seconds\": %.6f,\n", ctx->results.user_time);
+    printf("    \"system_time_seconds\": %.6f,\n", ctx->results.system_time);
+    printf("    \"cpu_usage_percent\": %.2f,\n", ctx->results.cpu_usage_percent);
+    printf("    \"minor_faults\": %ld,\n", ctx->results.minor_faults);
+    printf("    \"major_faults\": %ld,\n", ctx->results.major_faults);
+    printf("    \"voluntary_context_switches\": %ld,\n", ctx->results.voluntary_context_switches);
+    printf("    \"involuntary_context_switches\": %ld,\n", ctx->results.involuntary_context_switches);
+    printf("    \"process_tree\": {\n");
+    printf("      \"processes\": %d,\n", ctx->results.tree_processes);
+    printf("      \"max_concurrent\": %d,\n", ctx->results.tree_max_concurrent);
+    printf("      \"cpu_seconds\": %.6f,\n", ctx->results.tree_cpu_seconds);
+    printf("      \"peak_rss_kb\": %ld,\n", ctx->results.tree_peak_rss_kb);
+    printf("      \"read_bytes\": %llu,\n", ctx->results.tree_read_bytes);
+    printf("      \"write_bytes\": %llu\n", ctx->results.tree_write_bytes);
+    printf("    },\n");
+    printf("    \"perf_counters\": {\n");
+    printf("      \"enabled\": %s,\n", ctx->results.perf_enabled ? "true" : "false");
+    printf("      \"hardware\": %s,\n", ctx->results.perf_hardware ? "true" : "false");
+    printf("      \"task_clock_ns\": %lld,\n", ctx->results.perf_task_clock_ns);
+    printf("      \"page_faults\": %lld,\n", ctx->results.perf_page_faults);
+    printf("      \"context_switches\": %lld,\n", ctx->results.perf_context_switches);
+    printf("      \"cpu_migrations\": %lld,\n", ctx->results.perf_cpu_migrations);
+    printf("      \"instructions\": %lld,\n", ctx->results.perf_instructions);
+    printf("      \"cycles\": %lld,\n", ctx->results.perf_cycles);
+    printf("      \"cache_misses\": %lld,\n", ctx->results.perf_cache_misses);
+    printf("      \"branch_misses\": %lld,\n", ctx->results.perf_branch_misses);
+    printf("      \"ipc\": %.3f,\n", ctx->results.perf_ipc);
+    printf("      \"cache_miss_rate\": %.4f,\n", ctx->results.perf_cache_miss_rate);
+    printf("      \"branch_miss_rate\": %.4f\n", ctx->results.perf_branch_miss_rate);
+    printf("    }\n");
     printf("  },\n");
 }
 
-void rune_print_json_deep_analysis(void) {
+void rune_print_json_deep_analysis(const rune_context_t* ctx) {
     printf("  \"deep_analysis\": {\n");
     printf("    \"enabled\": true,\n");
-    printf("    \"tool_classification\": \"%s\",\n", g_results.tool_classification);
-    printf("    \"behavior_pattern\": \"%s\",\n", g_results.behavior_pattern);
-    printf("    \"performance_category\": \"%s\",\n", g_results.performance_category);
-    printf("    \"output_complexity_score\": %d,\n", g_results.output_complexity_score);
-    printf("    \"resource_efficiency_score\": %d,\n", g_results.resource_efficiency_score);
+    printf("    \"tool_classification\": \"%s\",\n", ctx->results.tool_classification);
+    printf("    \"behavior_pattern\": \"%s\",\n", ctx->results.behavior_pattern);
+    printf("    \"performance_category\": \"%s\",\n", ctx->results.performance_category);
+    printf("    \"output_complexity_score\": %d,\n", ctx->results.output_complexity_score);
+    printf("    \"resource_efficiency_score\": %d,\n", ctx->results.resource_efficiency_score);
     printf("    \"timing_breakdown\": {\n");
-    printf("      \"startup_time_seconds\": %.6f,\n", g_results.startup_time);
-    printf("      \"processing_time_seconds\": %.6f,\n", g_results.processing_time);
-    printf("      \"cleanup_time_seconds\": %.6f\n", g_results.cleanup_time);
+    printf("      \"startup_time_seconds\": %.6f,\n", ctx->results.startup_time);
+    printf("      \"processing_time_seconds\": %.6f,\n", ctx->results.processing_time);
+    printf("      \"cleanup_time_seconds\": %.6f,\n", ctx->results.cleanup_time);
+    printf("      \"phases_measured\": %s,\n", ctx->results.phases_measured ? "true" : "false");
+    printf("      \"timeline_samples\": %d\n", ctx->results.timeline_samples);
     printf("    }\n");
     printf("  },\n");
 }
 
-void rune_print_json_footer(void) {
+void rune_print_json_footer(const rune_context_t* ctx) {
     printf("  \"framework_info\": {\n");
     printf("    \"modular_design\": true,\n");
     printf("    \"checkpoint_system\": true,\n");
@@ -9,27 +9,33 @@
 #define RUNE_OUTPUT_H
 
 #include "rune_types.h"
+#include "rune_context.h"
 
 // Output formatting functions
-void rune_print_human_report(void);
-void rune_print_json_report(void);
-void rune_print_both_reports(void);
+void rune_print_human_report(const rune_context_t* ctx);
+void rune_print_json_report(const rune_context_t* ctx);
+void rune_print_both_reports(const rune_context_t* ctx);
 
 // Report components
-void rune_print_banner(void);
-void rune_print_execution_summary(void);
-void rune_print_memory_analysis(void);
-void rune_print_io_analysis(void);
-void rune_print_security_analysis(void);
-void rune_print_deep_analysis(void);
+void rune_print_banner(const rune_context_t* ctx);
+void rune_print_execution_summary(const rune_context_t* ctx);
+void rune_print_memory_analysis(const rune_context_t* ctx);
+void rune_print_io_analysis(const rune_context_t* ctx);
+void rune_print_security_analysis(const rune_context_t* ctx);
+void rune_print_resource_accounting(const rune_context_t* ctx);
+void rune_print_probe_stats(const rune_context_t* ctx);
+void rune_print_trigger_stats(const rune_context_t* ctx);
+void rune_print_span_profile(const rune_context_t* ctx);
+void rune_print_deep_analysis(const rune_context_t* ctx);
 
 // JSON components
-void rune_print_json_header(void);
-void rune_print_json_execution(void);
-void rune_print_json_memory(void);
-void rune_print_json_security(void);
-void rune_print_json_deep_analysis(void);
-void rune_print_json_footer(void);
+void rune_print_json_header(const rune_context_t* ctx);
+void rune_print_json_execution(const rune_context_t* ctx);
+void rune_print_json_memory(const rune_context_t* ctx);
+void rune_print_json_security(const rune_context_t* ctx);
+void rune_print_json_resources(const rune_context_t* ctx);
+void rune_print_json_deep_analysis(const rune_context_t* ctx);
+void rune_print_json_footer(const rune_context_t* ctx);
 
 // Utility output functions
 void rune_print_colored_status(const char* status, int success);
@@ -0,0 +1,101 @@
+/**
+ * rune_perf.c - perf_event_open counter collection implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_perf.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+
+static const struct {
+    const char *name;
+    uint32_t type;
+    uint64_t config;
+} rune_perf_events[RUNE_PERF_COUNTERS] = {
+    [RUNE_PERF_TASK_CLOCK]       = { "task-clock",       PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+    [RUNE_PERF_PAGE_FAULTS]      = { "page-faults",      PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+    [RUNE_PERF_CONTEXT_SWITCHES] = { "context-switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+    [RUNE_PERF_CPU_MIGRATIONS]   = { "cpu-migrations",   PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CPU_MIGRATIONS },
+    [RUNE_PERF_INSTRUCTIONS]     = { "instructions",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+    [RUNE_PERF_CYCLES]           = { "cycles",           PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+    [RUNE_PERF_CACHE_REFERENCES] = { "cache-references", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+    [RUNE_PERF_CACHE_MISSES]     = { "cache-misses",     PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+    [RUNE_PERF_BRANCHES]         = { "branches",         PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_INSTRUCTIONS },
+    [RUNE_PERF_BRANCH_MISSES]    = { "branch-misses",    PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+};
+
+static int rune_perf_event_open(rune_perf_counter_t counter, int user_only) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = rune_perf_events[counter].type;
+    attr.config = rune_perf_events[counter].config;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    attr.disabled = 1;          // Never counts for us...
+    attr.enable_on_exec = 1;    // ...only for whoever exec()s with an inherited copy
+    attr.inherit = 1;
+    attr.exclude_kernel = user_only;
+    attr.exclude_hv = 1;
+
+    // pid 0, cpu -1: this thread (and what it spawns) on any CPU
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC);
+}
+
+int rune_perf_open(rune_perf_t *perf) {
+    memset(perf, 0, sizeof(*perf));
+    for (int i = 0; i < RUNE_PERF_COUNTERS; i++) perf->fds[i] = -1;
+
+    // Probe with the first software counter: it decides whether perf is
+    // usable at all and whether kernel-side counting is allowed
+    int fd = rune_perf_event_open(RUNE_PERF_TASK_CLOCK, 0);
+    if (fd < 0 && (errno == EACCES || errno == EPERM)) {
+        perf->user_only = 1;
+        fd = rune_perf_event_open(RUNE_PERF_TASK_CLOCK, 1);
+    }
+    if (fd < 0) return -1;
+    perf->fds[RUNE_PERF_TASK_CLOCK] = fd;
+    perf->opened = 1;
+
+    // Hardware counters fail with ENOENT/EOPNOTSUPP/ENODEV without a PMU
+    // (most VMs): leave them at -1 and keep the software ones
+    for (int i = RUNE_PERF_TASK_CLOCK + 1; i < RUNE_PERF_COUNTERS; i++) {
+        perf->fds[i] = rune_perf_event_open((rune_perf_counter_t)i, perf->user_only);
+        if (perf->fds[i] >= 0) perf->opened++;
+    }
+    return 0;
+}
+
+void rune_perf_read(const rune_perf_t *perf, rune_perf_counts_t *counts) {
+    memset(counts, 0, sizeof(*counts));
+    for (int i = 0; i < RUNE_PERF_COUNTERS; i++) {
+        counts->value[i] = -1;
+        if (perf->fds[i] < 0) continue;
+
+        uint64_t data[3]; // value, time enabled, time running
+        if (read(perf->fds[i], data, sizeof(data)) != (ssize_t)sizeof(data)) continue;
+
+        // More counters than the PMU has slots get multiplexed: extrapolate
+        double value = (double)data[0];
+        if (data[2] > 0 && data[2] < data[1]) value *= (double)data[1] / (double)data[2];
+        counts->value[i] = (int64_t)value;
+        if (i >= RUNE_PERF_FIRST_HARDWARE) counts->hardware = 1;
+    }
+}
+
+void rune_perf_close(rune_perf_t *perf) {
+    for (int i = 0; i < RUNE_PERF_COUNTERS; i++) {
+        if (perf->fds[i] >= 0) close(perf->fds[i]);
+        perf->fds[i] = -1;
+    }
+    perf->opened = 0;
+}
+
+const char *rune_perf_counter_name(rune_perf_counter_t counter) {
+    return (unsigned)counter < RUNE_PERF_COUNTERS ? rune_perf_events[counter].name : "unknown";
+}
@@ -0,0 +1,76 @@
+/**
+ * rune_perf.h - perf_event_open counters for the target process tree
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Counters are opened on the launching thread itself, disabled, with
+ * inherit and enable_on_exec set. The thread never exec()s, so its own
+ * copies stay off; the target gets inherited copies that switch on at
+ * its exec() - the first instruction counted is the target's - and
+ * every process it forks inherits them in turn. When a task exits, the
+ * kernel folds its counts back into our descriptors, so reading them
+ * after the target has been reaped gives whole-tree totals.
+ *
+ * Software counters (task-clock, page-faults, context-switches,
+ * cpu-migrations) work almost everywhere. Hardware counters are added
+ * when a PMU is present; inside most VMs they are not, and the
+ * collector reports software counters only.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_PERF_H
+#define RUNE_PERF_H
+
+#include <stdint.h>
+
+typedef enum rune_perf_counter {
+    // Software
+    RUNE_PERF_TASK_CLOCK = 0,   // Nanoseconds on CPU
+    RUNE_PERF_PAGE_FAULTS,
+    RUNE_PERF_CONTEXT_SWITCHES,
+    RUNE_PERF_CPU_MIGRATIONS,
+    // Hardware (PMU)
+    RUNE_PERF_INSTRUCTIONS,
+    RUNE_PERF_CYCLES,
+    RUNE_PERF_CACHE_REFERENCES,
+    RUNE_PERF_CACHE_MISSES,
+    RUNE_PERF_BRANCHES,
+    RUNE_PERF_BRANCH_MISSES,
+    RUNE_PERF_COUNTERS
+} rune_perf_counter_t;
+
+#define RUNE_PERF_FIRST_HARDWARE RUNE_PERF_INSTRUCTIONS
+
+typedef struct rune_perf {
+    int fds[RUNE_PERF_COUNTERS]; // -1 = counter not available
+    int opened;                 // Number of counters open
+    int user_only;              // perf_event_paranoid forced exclude_kernel
+} rune_perf_t;
+
+typedef struct rune_perf_counts {
+    int64_t value[RUNE_PERF_COUNTERS]; // Scaled for multiplexing, -1 = not available
+    int hardware;               // At least one PMU counter was collected
+} rune_perf_counts_t;
+
+/**
+ * @brief Open the counters on the calling thread, right before launching
+ * @return 0 if at least one counter is open, -1 if perf_event_open() is
+ *         unusable here (errno is set)
+ *
+ * Launch the target from this same thread, and call rune_perf_read()
+ * only after it has been reaped.
+ */
+int rune_perf_open(rune_perf_t *perf);
+
+/**
+ * @brief Read the accumulated whole-tree counts
+ */
+void rune_perf_read(const rune_perf_t *perf, rune_perf_counts_t *counts);
+
+void rune_perf_close(rune_perf_t *perf);
+
+const char *rune_perf_counter_name(rune_perf_counter_t counter);
+
+#endif /* RUNE_PERF_H */
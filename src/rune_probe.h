@@ -0,0 +1,195 @@
+/**
+ * rune_probe.h - Target-side checkpoint emitter (header only)
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * With --probe the analyzer hands its target a shared-memory block of
+ * single-producer rings (memfd, descriptor number in $RUNE_PROBE_FD).
+ * Include this header in a target to log checkpoints into it:
+ *
+ *     RUNE_PROBE_FUNC_START("parse");
+ *     ...
+ *     RUNE_PROBE_FUNC_END("parse");
+ *     rune_probe_emit("SEC", "SEC: opened key file", path);
+ *
+ * The analyzer merges the events into its checkpoint timeline on the
+ * same CLOCK_MONOTONIC time base and runs its triggers on them. Without
+ * an analyzer every call returns -1 after one getenv().
+ *
+ * Every thread claims a lane of its own the first time it emits, so a
+ * lane has exactly one producer (the thread) and one consumer (the
+ * analyzer), and emitting is a clock read, a copy and a release store.
+ * Forked children inherit the mapping and claim lanes of their own.
+ * The analyzer frees the lane of an exited thread on its next drain
+ * (every sample), so the limit is RUNE_PROBE_LANES threads emitting
+ * within one sample interval, not per run. Full lanes and threads that
+ * find no free lane drop events rather than wait, and count them.
+ *
+ * Each translation unit that includes this header keeps its own
+ * attachment state; that costs a lane per unit and thread, nothing else.
+ * librune_probe.so (rune_probe.c) is the LD_PRELOAD counterpart for
+ * targets that are not instrumented.
+ *
+ * libc only: targets include it without the rest of rune_analyze.
+ */
+
+#ifndef RUNE_PROBE_H
+#define RUNE_PROBE_H
+
+#include <pthread.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define RUNE_PROBE_ENV "RUNE_PROBE_FD"
+#define RUNE_PROBE_MAGIC 0x424f5250454e5552ull  // "RUNEPROB"
+#define RUNE_PROBE_VERSION 1
+#define RUNE_PROBE_LANES 64                     // Producer threads at once, forked children included
+#define RUNE_PROBE_LANE_EVENTS 1024             // Per lane (power of two)
+
+// One event as the target wrote it (strings truncated, NUL terminated)
+typedef struct rune_probe_event {
+    uint64_t time_ns;           // CLOCK_MONOTONIC, the analyzer's time base as well
+    uint32_t tid;               // Producing thread
+    char category[12];
+    char id[64];
+    char context[48];
+} rune_probe_event_t;
+
+typedef struct rune_probe_lane {
+    uint32_t owner;             // Producer's tid, 0 = free (claimed with a CAS, freed by the analyzer)
+    uint32_t pid;               // Producer's process
+    uint64_t head __attribute__((aligned(64)));  // Next write (producer)
+    uint64_t dropped;           // Lane was full (producer)
+    uint64_t tail __attribute__((aligned(64)));  // Next read (analyzer)
+    rune_probe_event_t events[RUNE_PROBE_LANE_EVENTS];
+} rune_probe_lane_t;
+
+typedef struct rune_probe_shm {
+    uint64_t magic;
+    uint32_t version;
+    uint32_t lane_count;
+    uint64_t unlaned;           // Events of threads that found every lane taken
+    rune_probe_lane_t lanes[RUNE_PROBE_LANES];
+} rune_probe_shm_t;
+
+// Never traced themselves when the target is built with -finstrument-functions
+#define RUNE_PROBE_INLINE static inline __attribute__((no_instrument_function))
+
+static rune_probe_shm_t *rune_probe_shm_;
+static int rune_probe_state_;           // 0 = not looked yet, 1 = attached, -1 = no analyzer
+static unsigned rune_probe_forks_;      // Bumped in forked children: their lanes are not ours
+static __thread rune_probe_lane_t *rune_probe_lane_;
+static __thread unsigned rune_probe_lane_forks_;
+static __thread int rune_probe_no_lane_;
+
+static __attribute__((no_instrument_function)) void rune_probe_after_fork_(void) {
+    rune_probe_forks_++;
+}
+
+/**
+ * @brief Map the analyzer's rings (done by the first emit)
+ * @return The rings, or NULL when not running under rune_analyze --probe
+ */
+RUNE_PROBE_INLINE rune_probe_shm_t *rune_probe_attach(void) {
+    int state = __atomic_load_n(&rune_probe_state_, __ATOMIC_ACQUIRE);
+    if (state) {
+        return state > 0 ? rune_probe_shm_ : NULL;
+    }
+
+    const char *fd_text = getenv(RUNE_PROBE_ENV);
+    int fd = fd_text ? atoi(fd_text) : -1;
+    rune_probe_shm_t *shm = fd > 0 ? mmap(NULL, sizeof(*shm), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0)
+                                   : MAP_FAILED;
+    if (shm != MAP_FAILED && (shm->magic != RUNE_PROBE_MAGIC || shm->version != RUNE_PROBE_VERSION)) {
+        munmap(shm, sizeof(*shm));
+        shm = MAP_FAILED;
+    }
+    if (shm == MAP_FAILED) {
+        __atomic_store_n(&rune_probe_state_, -1, __ATOMIC_RELEASE);
+        return NULL;
+    }
+
+    rune_probe_shm_t *expected = NULL;
+    if (!__atomic_compare_exchange_n(&rune_probe_shm_, &expected, shm, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+        munmap(shm, sizeof(*shm));      // Another thread attached first
+        return expected;
+    }
+    pthread_atfork(NULL, NULL, rune_probe_after_fork_);
+    __atomic_store_n(&rune_probe_state_, 1, __ATOMIC_RELEASE);
+    return shm;
+}
+
+// The calling thread's lane, claimed on first use
+RUNE_PROBE_INLINE rune_probe_lane_t *rune_probe_lane(rune_probe_shm_t *shm) {
+    if (rune_probe_lane_forks_ == rune_probe_forks_) {
+        if (rune_probe_lane_) return rune_probe_lane_;
+        if (rune_probe_no_lane_) return NULL;
+    }
+    rune_probe_lane_ = NULL;
+    rune_probe_no_lane_ = 0;
+    rune_probe_lane_forks_ = rune_probe_forks_;
+
+    uint32_t tid = (uint32_t)syscall(SYS_gettid);
+    for (uint32_t i = 0; i < shm->lane_count && i < RUNE_PROBE_LANES; i++) {
+        uint32_t free_lane = 0;
+        if (__atomic_compare_exchange_n(&shm->lanes[i].owner, &free_lane, tid, 0,
+                                        __ATOMIC_ACQ_REL, __ATOMIC_RELAXED)) {
+            shm->lanes[i].pid = (uint32_t)getpid();
+            rune_probe_lane_ = &shm->lanes[i];
+            return rune_probe_lane_;
+        }
+    }
+    rune_probe_no_lane_ = 1;
+    return NULL;
+}
+
+RUNE_PROBE_INLINE void rune_probe_copy_(char *dst, const char *src, size_t size) {
+    size_t i = 0;
+    for (; src && src[i] && i < size - 1; i++) {
+        dst[i] = src[i];
+    }
+    dst[i] = '\0';
+}
+
+/**
+ * @brief Log one checkpoint into the analyzer's timeline
+ * @param context Free text, may be NULL
+ * @return 0 if queued, -1 if there is no analyzer or the lane is full
+ */
+RUNE_PROBE_INLINE int rune_probe_emit(const char *category, const char *id, const char *context) {
+    rune_probe_shm_t *shm = rune_probe_attach();
+    if (!shm) return -1;
+    rune_probe_lane_t *lane = rune_probe_lane(shm);
+    if (!lane) {
+        __atomic_add_fetch(&shm->unlaned, 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+
+    uint64_t head = lane->head;
+    if (head - __atomic_load_n(&lane->tail, __ATOMIC_ACQUIRE) >= RUNE_PROBE_LANE_EVENTS) {
+        __atomic_store_n(&lane->dropped, lane->dropped + 1, __ATOMIC_RELAXED);
+        return -1;
+    }
+    rune_probe_event_t *event = &lane->events[head & (RUNE_PROBE_LANE_EVENTS - 1)];
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    event->time_ns = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+    event->tid = lane->owner;
+    rune_probe_copy_(event->category, category, sizeof(event->category));
+    rune_probe_copy_(event->id, id, sizeof(event->id));
+    rune_probe_copy_(event->context, context, sizeof(event->context));
+    __atomic_store_n(&lane->head, head + 1, __ATOMIC_RELEASE);
+    return 0;
+}
+
+// Same ids as RUNE_LOG_FUNC_START/END, so reports and traces pair them up
+#define RUNE_PROBE_FUNC_START(name) rune_probe_emit("FUNC", "FUNC: " name " started", NULL)
+#define RUNE_PROBE_FUNC_END(name) rune_probe_emit("FUNC", "FUNC: " name " completed", NULL)
+#define RUNE_PROBE_MARK(id) rune_probe_emit("PROBE", (id), NULL)
+
+#endif /* RUNE_PROBE_H */
@@ -0,0 +1,163 @@
+/**
+ * rune_probe_host.c - Analyzer side of the target checkpoint probe
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+#include "rune_probe_host.h"
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+extern char **environ;
+
+int rune_probe_host_create(rune_probe_host_t *host) {
+    memset(host, 0, sizeof(*host));
+    host->fd = memfd_create("rune_probe", MFD_CLOEXEC);
+    if (host->fd < 0) {
+        return -1;
+    }
+    // Sparse: pages of lanes nobody claims are never allocated
+    if (ftruncate(host->fd, sizeof(rune_probe_shm_t)) != 0) {
+        rune_probe_host_destroy(host);
+        return -1;
+    }
+    void *shm = mmap(NULL, sizeof(rune_probe_shm_t), PROT_READ | PROT_WRITE, MAP_SHARED, host->fd, 0);
+    if (shm == MAP_FAILED) {
+        rune_probe_host_destroy(host);
+        return -1;
+    }
+    host->shm = shm;
+    host->shm->lane_count = RUNE_PROBE_LANES;
+    host->shm->version = RUNE_PROBE_VERSION;
+    __atomic_store_n(&host->shm->magic, RUNE_PROBE_MAGIC, __ATOMIC_RELEASE);
+    return 0;
+}
+
+char *const *rune_probe_host_environ(rune_probe_host_t *host, const char *library) {
+    size_t count = 0;
+    while (environ[count]) count++;
+    free(host->envp);
+    free(host->preload_env);
+    host->preload_env = NULL;
+    host->envp = malloc((count + 3) * sizeof(*host->envp));
+    if (!host->envp) {
+        return NULL;
+    }
+
+    const char *preload = getenv("LD_PRELOAD");
+    size_t n = 0;
+    for (size_t i = 0; i < count; i++) {
+        if (strncmp(environ[i], RUNE_PROBE_ENV "=", sizeof(RUNE_PROBE_ENV)) == 0 ||
+            (library && strncmp(environ[i], "LD_PRELOAD=", 11) == 0)) {
+            continue;
+        }
+        host->envp[n++] = environ[i];
+    }
+    snprintf(host->fd_env, sizeof(host->fd_env), RUNE_PROBE_ENV "=%d", host->fd);
+    host->envp[n++] = host->fd_env;
+    if (library) {
+        size_t size = strlen(library) + (preload ? strlen(preload) : 0) + 16;
+        if (!(host->preload_env = malloc(size))) {
+            free(host->envp);
+            host->envp = NULL;
+            return NULL;
+        }
+        snprintf(host->preload_env, size, "LD_PRELOAD=%s%s%s", library,
+                 preload && *preload ? ":" : "", preload ? preload : "");
+        host->envp[n++] = host->preload_env;
+    }
+    host->envp[n] = NULL;
+    return host->envp;
+}
+
+int rune_probe_host_find_library(char *path, size_t size) {
+    char exe[PATH_MAX];
+    ssize_t len = readlink("/proc/self/exe", exe, sizeof(exe) - 1);
+    if (len <= 0) {
+        return -1;
+    }
+    exe[len] = '\0';
+    char *slash = strrchr(exe, '/');
+    if (slash) *slash = '\0';
+    if (snprintf(path, size, "%s/%s", slash ? exe : ".", RUNE_PROBE_LIBRARY) >= (int)size) {
+        return -1;
+    }
+    return access(path, R_OK) == 0 ? 0 : -1;
+}
+
+// Whether the lane's producer thread is gone, so nothing can write to the lane any more
+static int rune_probe_lane_orphaned(const rune_probe_lane_t *lane, uint32_t owner) {
+    uint32_t pid = __atomic_load_n(&lane->pid, __ATOMIC_RELAXED);
+    if (!pid) {
+        return 0;       // Claimed a moment ago, pid not written yet
+    }
+    return syscall(SYS_tgkill, (pid_t)pid, (pid_t)owner, 0) != 0 && errno == ESRCH;
+}
+
+uint64_t rune_probe_host_drain(rune_probe_host_t *host, rune_context_t *ctx) {
+    rune_probe_shm_t *shm = host->shm;
+    if (!shm) {
+        return 0;
+    }
+    uint64_t merged = 0;
+    uint64_t dropped = __atomic_load_n(&shm->unlaned, __ATOMIC_RELAXED) + host->released_dropped;
+    for (int i = 0; i < RUNE_PROBE_LANES; i++) {
+        rune_probe_lane_t *lane = &shm->lanes[i];
+        uint32_t owner = __atomic_load_n(&lane->owner, __ATOMIC_ACQUIRE);
+        if (!owner) {
+            continue;   // Never claimed, or handed back: released lanes leave gaps
+        }
+        // Checked before reading head, so every event the thread wrote is drained below
+        int orphaned = rune_probe_lane_orphaned(lane, owner);
+        uint64_t head = __atomic_load_n(&lane->head, __ATOMIC_ACQUIRE);
+        uint64_t tail = lane->tail;
+        if (head - tail > RUNE_PROBE_LANE_EVENTS) {
+            tail = head - RUNE_PROBE_LANE_EVENTS;   // Corrupted by the target: keep what can be real
+        }
+        for (; tail != head; tail++) {
+            // The target owns this memory: never trust its strings to be terminated
+            rune_probe_event_t event = lane->events[tail & (RUNE_PROBE_LANE_EVENTS - 1)];
+            event.category[sizeof(event.category) - 1] = '\0';
+            event.id[sizeof(event.id) - 1] = '\0';
+            event.context[sizeof(event.context) - 1] = '\0';
+            uint32_t flags = RUNE_CHECKPOINT_TARGET | (event.tid & 0xffffffu) << RUNE_CHECKPOINT_THREAD_SHIFT;
+            rune_checkpoint_ingest(ctx, event.time_ns, event.id[0] ? event.id : "PROBE: unnamed",
+                                   event.category[0] ? event.category : "PROBE", event.context, flags);
+            merged++;
+        }
+        __atomic_store_n(&lane->tail, tail, __ATOMIC_RELEASE);
+        uint64_t lane_dropped = __atomic_load_n(&lane->dropped, __ATOMIC_RELAXED);
+        dropped += lane_dropped;
+        
+        // Hand the lane back empty, so a tree can start more than RUNE_PROBE_LANES threads over a run
+        if (orphaned) {
+            host->released_dropped += lane_dropped;
+            lane->head = 0;
+            lane->tail = 0;
+            lane->dropped = 0;
+            lane->pid = 0;
+            __atomic_store_n(&lane->owner, 0, __ATOMIC_RELEASE);
+        }
+    }
+    host->received += merged;
+    host->dropped = dropped;
+    return merged;
+}
+
+void rune_probe_host_destroy(rune_probe_host_t *host) {
+    if (host->shm) {
+        munmap(host->shm, sizeof(rune_probe_shm_t));
+        host->shm = NULL;
+    }
+    if (host->fd > 0) {
+        close(host->fd);
+    }
+    host->fd = -1;
+    free(host->envp);
+    free(host->preload_env);
+    host->envp = NULL;
+    host->preload_env = NULL;
+}
@@ -0,0 +1,68 @@
+/**
+ * rune_probe_host.h - Analyzer side of the target checkpoint probe
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Creates the shared rings rune_probe.h writes into, builds the
+ * target's environment ($RUNE_PROBE_FD, optionally LD_PRELOAD of
+ * librune_probe.so) and merges what the target wrote into the
+ * checkpoint timeline. Draining is wait-free for the target: each lane
+ * has one producer and we are its only consumer. A lane whose thread
+ * has exited is drained one last time and handed back for reuse.
+ */
+
+#ifndef RUNE_PROBE_HOST_H
+#define RUNE_PROBE_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "rune_probe.h"
+
+#define RUNE_PROBE_LIBRARY "librune_probe.so"
+
+struct rune_context;
+
+typedef struct rune_probe_host {
+    int fd;                     // memfd holding the rings (O_CLOEXEC, see rune_launch_spec_t.keep_fd)
+    rune_probe_shm_t *shm;
+    uint64_t received;          // Events merged into the timeline
+    uint64_t dropped;           // Lost in the target: lane full or no lane left
+    uint64_t released_dropped;  // Part of dropped counted in lanes since handed back
+    char **envp;                // Target environment from rune_probe_host_environ()
+    char fd_env[32];            // RUNE_PROBE_FD=<fd>
+    char *preload_env;          // LD_PRELOAD=<lib>[:<previous>]
+} rune_probe_host_t;
+
+/**
+ * @brief Create the rings
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_probe_host_create(rune_probe_host_t *host);
+
+/**
+ * @brief Our environment plus $RUNE_PROBE_FD and, with a library, LD_PRELOAD
+ * @param library librune_probe.so to preload, or NULL for instrumented targets only
+ * @return NULL terminated array owned by host, NULL on allocation failure
+ */
+char *const *rune_probe_host_environ(rune_probe_host_t *host, const char *library);
+
+/**
+ * @brief Find librune_probe.so next to the running executable
+ * @return 0 with path filled in, -1 if it is not there
+ */
+int rune_probe_host_find_library(char *path, size_t size);
+
+/**
+ * @brief Merge everything written so far into ctx's timeline
+ * @return Events merged by this call
+ */
+uint64_t rune_probe_host_drain(rune_probe_host_t *host, struct rune_context *ctx);
+
+/**
+ * @brief Unmap and close (safe on a zeroed host)
+ */
+void rune_probe_host_destroy(rune_probe_host_t *host);
+
+#endif /* RUNE_PROBE_HOST_H */
@@ -0,0 +1,529 @@
+/**
+ * rune_proctree.c - Whole process-tree accounting implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_proctree.h"
+
+#include <ctype.h>
+#include <dirent.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/prctl.h>
+#include <sys/wait.h>
+
+// What one read of /proc/<pid>/stat tells us
+typedef struct rune_proc_stat {
+    char state;
+    pid_t ppid;
+    char comm[16];
+    unsigned long long utime, stime, cutime, cstime;
+    unsigned long long threads;
+    unsigned long long start_ticks;
+    unsigned long long rss_pages;
+} rune_proc_stat_t;
+
+int rune_proctree_adopt_orphans(int enable) {
+    return prctl(PR_SET_CHILD_SUBREAPER, enable ? 1 : 0, 0, 0, 0);
+}
+
+static uint64_t rune_proctree_now_us(const rune_proctree_t *pt) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t us = (int64_t)(now.tv_sec - pt->start.tv_sec) * 1000000 +
+                 (now.tv_nsec - pt->start.tv_nsec) / 1000;
+    return us > 0 ? (uint64_t)us : 0;
+}
+
+static uint64_t rune_proctree_ticks_us(const rune_proctree_t *pt, unsigned long long ticks) {
+    return ticks * 1000000ULL / (unsigned long long)pt->ticks_per_second;
+}
+
+static uint64_t rune_timeval_us(const struct timeval *tv) {
+    return (uint64_t)tv->tv_sec * 1000000ULL + (uint64_t)tv->tv_usec;
+}
+
+static int rune_proc_read_stat(int fd, rune_proc_stat_t *st) {
+    char buf[1024];
+    ssize_t n = pread(fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return -1;
+    buf[n] = '\0';
+
+    // "pid (comm) state ppid ...": comm may hold spaces and parentheses
+    char *open = strchr(buf, '(');
+    char *close = strrchr(buf, ')');
+    if (!open || !close || close < open || close[1] == '\0') return -1;
+    size_t len = (size_t)(close - open - 1);
+    if (len >= sizeof(st->comm)) len = sizeof(st->comm) - 1;
+    for (size_t i = 0; i < len; i++) {
+        char c = open[1 + i];
+        st->comm[i] = (isprint((unsigned char)c) && c != '"' && c != '\\') ? c : '?';
+    }
+    st->comm[len] = '\0';
+
+    // Fields after comm: state 3, ppid 4, utime 14, stime 15, cutime 16,
+    // cstime 17, num_threads 20, starttime 22, rss 24
+    memset(&st->utime, 0, sizeof(*st) - offsetof(rune_proc_stat_t, utime));
+    st->state = close[2];
+    st->ppid = 0;
+    int field = 2;
+    char *save = NULL;
+    for (char *tok = strtok_r(close + 1, " ", &save); tok; tok = strtok_r(NULL, " ", &save)) {
+        field++;
+        if (field == 4) st->ppid = (pid_t)strtol(tok, NULL, 10);
+        else if (field == 14) st->utime = strtoull(tok, NULL, 10);
+        else if (field == 15) st->stime = strtoull(tok, NULL, 10);
+        else if (field == 16) st->cutime = strtoull(tok, NULL, 10);
+        else if (field == 17) st->cstime = strtoull(tok, NULL, 10);
+        else if (field == 20) st->threads = strtoull(tok, NULL, 10);
+        else if (field == 22) st->start_ticks = strtoull(tok, NULL, 10);
+        else if (field == 24) {
+            st->rss_pages = strtoull(tok, NULL, 10);
+            break;
+        }
+    }
+    return field >= 24 ? 0 : -1;
+}
+
+static int rune_proc_open(pid_t pid, const char *tail) {
+    char path[128];
+    snprintf(path, sizeof(path), "/proc/%d/%s", (int)pid, tail);
+    return open(path, O_RDONLY | O_CLOEXEC);
+}
+
+static void rune_proc_close(rune_proc_t *proc) {
+    if (proc->stat_fd >= 0) close(proc->stat_fd);
+    if (proc->io_fd >= 0) close(proc->io_fd);
+    if (proc->children_fd >= 0) close(proc->children_fd);
+    proc->stat_fd = -1;
+    proc->io_fd = -1;
+    proc->children_fd = -1;
+}
+
+static int rune_proctree_follow(rune_proctree_t *pt, size_t index) {
+    if (pt->live_count == pt->live_capacity) {
+        size_t capacity = pt->live_capacity ? pt->live_capacity * 2 : 64;
+        size_t *live = realloc(pt->live, capacity * sizeof(size_t));
+        if (!live) return -1;
+        pt->live = live;
+        pt->live_capacity = capacity;
+    }
+    pt->live[pt->live_count++] = index;
+    return 0;
+}
+
+static int rune_proctree_is_live(const rune_proctree_t *pt, pid_t pid) {
+    for (size_t i = 0; i < pt->live_count; i++) {
+        if (pt->procs[pt->live[i]].pid == pid) return 1;
+    }
+    return 0;
+}
+
+// Apply one stat (and io) reading to a tracked process
+static void rune_proctree_update(rune_proctree_t *pt, rune_proc_t *proc, const rune_proc_stat_t *st,
+                                 uint64_t now_us) {
+    proc->ppid = st->ppid;
+    proc->last_scan = pt->scans;
+    if (proc->parent >= 0 && st->ppid != pt->procs[proc->parent].pid) proc->orphaned = 1;
+
+    uint64_t cpu_us = rune_proctree_ticks_us(pt, st->utime + st->stime);
+    if (cpu_us > proc->cpu_us) proc->cpu_us = cpu_us;
+    uint64_t child_cpu_us = rune_proctree_ticks_us(pt, st->cutime + st->cstime);
+    if (child_cpu_us > proc->child_cpu_us) proc->child_cpu_us = child_cpu_us;
+
+    if (st->state == 'Z' || st->state == 'X') {
+        // Exited: memory and I/O accounts are gone, the last values stand
+        proc->zombie = 1;
+        proc->rss_kb = 0;
+        return;
+    }
+    proc->end_us = now_us;
+    memcpy(proc->comm, st->comm, sizeof(proc->comm)); // Changes with every exec()
+    proc->threads = st->threads > UINT16_MAX ? UINT16_MAX : (uint16_t)st->threads;
+    proc->rss_kb = (uint32_t)(st->rss_pages * (unsigned long long)pt->page_kb);
+    if (proc->rss_kb > proc->peak_rss_kb) proc->peak_rss_kb = proc->rss_kb;
+
+    if (proc->io_fd >= 0) {
+        char buf[512];
+        ssize_t n = pread(proc->io_fd, buf, sizeof(buf) - 1, 0);
+        if (n > 0) {
+            buf[n] = '\0';
+            char *rchar = strstr(buf, "rchar: ");
+            char *wchar = strstr(buf, "wchar: ");
+            if (rchar) proc->read_bytes = strtoull(rchar + 7, NULL, 10);
+            if (wchar) proc->write_bytes = strtoull(wchar + 7, NULL, 10);
+        }
+    }
+}
+
+// Start following pid, filed under procs[parent]; it must be a child of ppid
+static void rune_proctree_add(rune_proctree_t *pt, pid_t pid, int parent, pid_t ppid, uint64_t now_us) {
+    if (pt->count == RUNE_PROCTREE_MAX_PROCS) {
+        pt->totals.dropped++;
+        return;
+    }
+    if (pt->count == pt->capacity) {
+        size_t capacity = pt->capacity ? pt->capacity * 2 : 64;
+        rune_proc_t *procs = realloc(pt->procs, capacity * sizeof(rune_proc_t));
+        if (!procs) {
+            pt->totals.dropped++;
+            return;
+        }
+        pt->procs = procs;
+        pt->capacity = capacity;
+    }
+
+    rune_proc_t *proc = &pt->procs[pt->count];
+    memset(proc, 0, sizeof(*proc));
+    proc->pid = pid;
+    proc->parent = parent;
+    proc->io_fd = -1;
+    proc->children_fd = -1;
+    proc->stat_fd = rune_proc_open(pid, "stat");
+
+    // The descriptor pins this process; check it is the child we were told about
+    rune_proc_stat_t st;
+    if (proc->stat_fd < 0 || rune_proc_read_stat(proc->stat_fd, &st) != 0 ||
+        (ppid > 0 && st.ppid != ppid)) {
+        rune_proc_close(proc);
+        if (parent < 0 || errno == EMFILE || errno == ENFILE) pt->totals.dropped++;
+        return;
+    }
+    if (parent < 0) pt->root_start_ticks = st.start_ticks;
+    proc->start_us = st.start_ticks > pt->root_start_ticks
+        ? rune_proctree_ticks_us(pt, st.start_ticks - pt->root_start_ticks) : 0;
+    proc->io_fd = rune_proc_open(pid, "io");
+    if (!pt->proc_scan) {
+        char tail[64];
+        snprintf(tail, sizeof(tail), "task/%d/children", (int)pid);
+        proc->children_fd = rune_proc_open(pid, tail);
+    }
+    proc->running = 1;
+
+    if (rune_proctree_follow(pt, pt->count) != 0) {
+        rune_proc_close(proc);
+        pt->totals.dropped++;
+        return;
+    }
+    pt->count++;
+    rune_proctree_update(pt, proc, &st, now_us);
+}
+
+// Add every pid listed in a children file
+static void rune_proctree_add_listed(rune_proctree_t *pt, const char *list, int parent, pid_t ppid,
+                                     uint64_t now_us) {
+    const char *p = list;
+    while (*p) {
+        char *end;
+        long pid = strtol(p, &end, 10);
+        if (end == p) break;
+        if (pid > 0 && !rune_proctree_is_live(pt, (pid_t)pid)) {
+            rune_proctree_add(pt, (pid_t)pid, parent, ppid, now_us);
+        }
+        p = end;
+    }
+}
+
+// Children of every thread of pid (any thread can be a parent)
+static void rune_proctree_walk_tasks(rune_proctree_t *pt, pid_t pid, int parent, uint64_t now_us) {
+    char buf[4096];
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/task", (int)pid);
+    DIR *dir = opendir(path);
+    if (!dir) return;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!isdigit((unsigned char)entry->d_name[0])) continue;
+        char tail[64];
+        snprintf(tail, sizeof(tail), "task/%d/children", atoi(entry->d_name));
+        int fd = rune_proc_open(pid, tail);
+        if (fd < 0) continue;
+        ssize_t n = read(fd, buf, sizeof(buf) - 1);
+        close(fd);
+        if (n <= 0) continue;
+        buf[n] = '\0';
+        rune_proctree_add_listed(pt, buf, parent, pid, now_us);
+    }
+    closedir(dir);
+}
+
+static void rune_proctree_children(rune_proctree_t *pt, size_t index, uint64_t now_us) {
+    const rune_proc_t *proc = &pt->procs[index];
+    if (proc->threads > 1) {
+        rune_proctree_walk_tasks(pt, proc->pid, (int)index, now_us);
+        return;
+    }
+
+    // Single-threaded: the one children file we keep open
+    char buf[4096];
+    if (proc->children_fd < 0) return;
+    ssize_t n = pread(proc->children_fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return;
+    buf[n] = '\0';
+    // add() may move the table: the parent is passed by index, not pointer
+    rune_proctree_add_listed(pt, buf, (int)index, proc->pid, now_us);
+}
+
+// Without CONFIG_PROC_CHILDREN: every process whose parent we follow
+static void rune_proctree_scan_proc(rune_proctree_t *pt, uint64_t now_us) {
+    DIR *dir = opendir("/proc");
+    if (!dir) return;
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!isdigit((unsigned char)entry->d_name[0])) continue;
+        pid_t pid = (pid_t)strtol(entry->d_name, NULL, 10);
+        if (rune_proctree_is_live(pt, pid)) continue;
+
+        int fd = rune_proc_open(pid, "stat");
+        if (fd < 0) continue;
+        rune_proc_stat_t st;
+        int rc = rune_proc_read_stat(fd, &st);
+        close(fd);
+        if (rc != 0) continue;
+        for (size_t i = 0; i < pt->live_count; i++) {
+            size_t parent = pt->live[i];
+            if (pt->procs[parent].pid == st.ppid) {
+                rune_proctree_add(pt, pid, (int)parent, st.ppid, now_us);
+                break;
+            }
+        }
+    }
+    closedir(dir);
+}
+
+// An orphan we adopted has exited: reap it for its exact rusage
+static void rune_proctree_reap(rune_proctree_t *pt, rune_proc_t *proc) {
+    struct rusage usage;
+    if (wait4(proc->pid, NULL, WNOHANG, &usage) != proc->pid) return;
+
+    proc->reaped = 1;
+    proc->running = 0;
+    proc->gone_scan = pt->scans;
+    pt->totals.orphans_reaped++;
+    uint64_t own_us = rune_timeval_us(&usage.ru_utime) + rune_timeval_us(&usage.ru_stime);
+    if (own_us > proc->cpu_us + proc->child_cpu_us) proc->cpu_us = own_us - proc->child_cpu_us;
+
+    pt->orphan_usage.ru_utime.tv_sec += usage.ru_utime.tv_sec;
+    pt->orphan_usage.ru_utime.tv_usec += usage.ru_utime.tv_usec;
+    pt->orphan_usage.ru_stime.tv_sec += usage.ru_stime.tv_sec;
+    pt->orphan_usage.ru_stime.tv_usec += usage.ru_stime.tv_usec;
+}
+
+static void rune_proctree_sample_all(rune_proctree_t *pt) {
+    uint64_t now_us = rune_proctree_now_us(pt);
+    pt->last_scan_us = now_us;
+    pt->scans++;
+
+    // Sample what we follow; drop what has been reaped
+    pid_t self = getpid();
+    uint64_t rss_kb = 0;
+    for (size_t i = 0; i < pt->live_count;) {
+        size_t index = pt->live[i];
+        rune_proc_t *proc = &pt->procs[index];
+        rune_proc_stat_t st;
+        if (proc->stat_fd >= 0 && rune_proc_read_stat(proc->stat_fd, &st) == 0) {
+            rune_proctree_update(pt, proc, &st, now_us);
+            // The root is the supervisor's to reap
+            if (proc->zombie && pt->reap_orphans && index > 0 && st.ppid == self) {
+                rune_proctree_reap(pt, proc);
+            }
+        } else {
+            proc->running = 0;
+            proc->gone_scan = pt->scans;
+        }
+        if (!proc->running) {
+            rune_proc_close(proc);
+            pt->live[i] = pt->live[--pt->live_count];
+            continue;
+        }
+        rss_kb += proc->rss_kb;
+        i++;
+    }
+    if (rss_kb > pt->totals.peak_rss_kb) pt->totals.peak_rss_kb = rss_kb;
+
+    // Then look for children, including those of processes added just now
+    if (pt->proc_scan) {
+        rune_proctree_scan_proc(pt, now_us);
+    } else {
+        for (size_t i = 0; i < pt->live_count; i++) {
+            if (!pt->procs[pt->live[i]].zombie) rune_proctree_children(pt, pt->live[i], now_us);
+        }
+        // Orphans adopted before any scan saw them: besides the root, every
+        // child of ours is one. Filed under the root, their parent being gone.
+        if (pt->reap_orphans) rune_proctree_walk_tasks(pt, self, 0, now_us);
+    }
+    if (pt->live_count > pt->totals.max_concurrent) pt->totals.max_concurrent = pt->live_count;
+}
+
+int rune_proctree_begin(rune_proctree_t *pt, pid_t root, const struct timespec *start, int reap_orphans) {
+    for (size_t i = 0; i < pt->live_count; i++) rune_proc_close(&pt->procs[pt->live[i]]);
+    pt->count = 0;
+    pt->live_count = 0;
+    pt->scans = 0;
+    pt->last_scan_us = 0;
+    pt->root_start_ticks = 0;
+    pt->start = *start;
+    pt->reap_orphans = reap_orphans;
+    pt->ticks_per_second = sysconf(_SC_CLK_TCK);
+    pt->page_kb = sysconf(_SC_PAGESIZE) / 1024;
+    memset(&pt->orphan_usage, 0, sizeof(pt->orphan_usage));
+    memset(&pt->totals, 0, sizeof(pt->totals));
+
+    char tail[64];
+    snprintf(tail, sizeof(tail), "task/%d/children", (int)root);
+    int fd = rune_proc_open(root, tail);
+    pt->proc_scan = fd < 0 && errno == ENOENT;
+    if (fd >= 0) close(fd);
+
+    rune_proctree_add(pt, root, -1, 0, 0);
+    if (pt->count == 0) return -1;
+    pt->totals.max_concurrent = 1;
+    pt->totals.peak_rss_kb = pt->procs[0].rss_kb;
+    return 0;
+}
+
+void rune_proctree_scan(rune_proctree_t *pt) {
+    if (pt->count == 0) return;
+    if (pt->scans > 0 && rune_proctree_now_us(pt) - pt->last_scan_us < RUNE_PROCTREE_MIN_INTERVAL_US) return;
+    rune_proctree_sample_all(pt);
+}
+
+void rune_proctree_finish(rune_proctree_t *pt, double total_seconds, const struct rusage *root_usage) {
+    if (pt->count == 0) return;
+    rune_proctree_sample_all(pt);
+
+    // Adopted orphans we never saw (forked and orphaned between two scans):
+    // with a single target every remaining child of ours belongs to it
+    struct rusage usage;
+    pid_t pid;
+    while (pt->reap_orphans && (pid = wait4(-1, NULL, WNOHANG, &usage)) > 0) {
+        for (size_t i = 0; i < pt->live_count; i++) {
+            rune_proc_t *proc = &pt->procs[pt->live[i]];
+            if (proc->pid != pid) continue;
+            // Exited since the scan above: its samples are superseded
+            proc->running = 0;
+            proc->reaped = 1;
+            proc->gone_scan = pt->scans;
+            rune_proc_close(proc);
+            pt->live[i] = pt->live[--pt->live_count];
+            break;
+        }
+        pt->totals.orphans_reaped++;
+        pt->orphan_usage.ru_utime.tv_sec += usage.ru_utime.tv_sec;
+        pt->orphan_usage.ru_utime.tv_usec += usage.ru_utime.tv_usec;
+        pt->orphan_usage.ru_stime.tv_sec += usage.ru_stime.tv_sec;
+        pt->orphan_usage.ru_stime.tv_usec += usage.ru_stime.tv_usec;
+        if (usage.ru_maxrss > pt->orphan_usage.ru_maxrss) pt->orphan_usage.ru_maxrss = usage.ru_maxrss;
+    }
+
+    rune_proc_t *root = &pt->procs[0];
+    root->end_us = (uint64_t)(total_seconds * 1000000.0);
+    root->running = 0;
+    root->zombie = 0;
+
+    // CPU: the root's wait4() covers everything waited for inside the tree,
+    // reaped orphans bring their own; the rest is known from samples only
+    uint64_t cpu_us = rune_timeval_us(&root_usage->ru_utime) + rune_timeval_us(&root_usage->ru_stime) +
+                      rune_timeval_us(&pt->orphan_usage.ru_utime) + rune_timeval_us(&pt->orphan_usage.ru_stime);
+    for (size_t i = 1; i < pt->count; i++) {
+        rune_proc_t *proc = &pt->procs[i];
+        if (proc->running) {
+            pt->totals.still_running++;
+            cpu_us += proc->cpu_us + proc->child_cpu_us;
+        } else if (proc->orphaned && !proc->reaped) {
+            cpu_us += proc->cpu_us + proc->child_cpu_us;   // Reaped by some other subreaper
+        }
+    }
+    pt->totals.cpu_seconds = cpu_us / 1000000.0;
+
+    // Memory: a run shorter than a sample interval has no RSS samples, but
+    // ru_maxrss (kB) is the largest process waited for, so the tree's peak
+    // is at least that
+    long maxrss_kb = root_usage->ru_maxrss > pt->orphan_usage.ru_maxrss ? root_usage->ru_maxrss
+                                                                         : pt->orphan_usage.ru_maxrss;
+    if (maxrss_kb > 0 && (uint64_t)maxrss_kb > pt->totals.peak_rss_kb) {
+        pt->totals.peak_rss_kb = (uint64_t)maxrss_kb;
+    }
+
+    // I/O: a parent reaping a child adds the child's counters to its own.
+    // Once the parent has been sampled after that, the child is inside its
+    // numbers and must not be counted twice.
+    for (size_t i = 0; i < pt->count; i++) {
+        pt->procs[i].own_read_bytes = pt->procs[i].read_bytes;
+        pt->procs[i].own_write_bytes = pt->procs[i].write_bytes;
+    }
+    pt->totals.read_bytes = 0;
+    pt->totals.write_bytes = 0;
+    for (size_t i = 1; i < pt->count; i++) {
+        rune_proc_t *proc = &pt->procs[i];
+        rune_proc_t *parent = &pt->procs[proc->parent];
+        int absorbed = !proc->running && !proc->reaped && !proc->orphaned &&
+                       parent->last_scan > proc->gone_scan;
+        if (!absorbed) continue;
+        parent->own_read_bytes -= parent->own_read_bytes > proc->read_bytes ? proc->read_bytes
+                                                                            : parent->own_read_bytes;
+        parent->own_write_bytes -= parent->own_write_bytes > proc->write_bytes ? proc->write_bytes
+                                                                               : parent->own_write_bytes;
+    }
+    for (size_t i = 0; i < pt->count; i++) {
+        pt->totals.read_bytes += pt->procs[i].own_read_bytes;
+        pt->totals.write_bytes += pt->procs[i].own_write_bytes;
+    }
+    pt->totals.processes = pt->count;
+    
+    // Descendants still running are not followed past the run
+    for (size_t i = 0; i < pt->live_count; i++) rune_proc_close(&pt->procs[pt->live[i]]);
+    pt->live_count = 0;
+}
+
+void rune_proctree_free(rune_proctree_t *pt) {
+    // A zeroed tree follows nothing, so there is no descriptor to close
+    for (size_t i = 0; i < pt->live_count; i++) rune_proc_close(&pt->procs[pt->live[i]]);
+    free(pt->procs);
+    free(pt->live);
+    memset(pt, 0, sizeof(*pt));
+}
+
+size_t rune_proctree_top(const rune_proctree_t *pt, size_t *order, size_t max) {
+    // Insertion into a short sorted list: max is a report's row count
+    size_t n = 0;
+    for (size_t i = 0; i < pt->count; i++) {
+        uint64_t cpu_us = pt->procs[i].cpu_us;
+        if (n == max && (n == 0 || cpu_us <= pt->procs[order[n - 1]].cpu_us)) continue;
+        size_t j = n < max ? n++ : n - 1;
+        while (j > 0 && pt->procs[order[j - 1]].cpu_us < cpu_us) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+    return n;
+}
+
+void rune_proctree_print(const rune_proctree_t *pt, FILE *out, size_t max_rows) {
+    size_t *order = malloc((max_rows ? max_rows : 1) * sizeof(size_t));
+    if (!order) return;
+    size_t rows = rune_proctree_top(pt, order, max_rows);
+
+    fprintf(out, "    %7s %7s  %-15s %9s %10s %11s %11s  %s\n",
+            "PID", "PPID", "COMMAND", "CPU (s)", "PEAK RSS", "READ", "WRITE", "LIFETIME (s)");
+    for (size_t r = 0; r < rows; r++) {
+        const rune_proc_t *proc = &pt->procs[order[r]];
+        fprintf(out, "    %7d %7d  %-15s %9.3f %7u KB %8llu KB %8llu KB  %.3f-%.3f%s\n",
+                (int)proc->pid, (int)(proc->parent >= 0 ? pt->procs[proc->parent].pid : proc->ppid),
+                proc->comm, proc->cpu_us / 1000000.0, proc->peak_rss_kb,
+                (unsigned long long)(proc->own_read_bytes / 1024),
+                (unsigned long long)(proc->own_write_bytes / 1024),
+                proc->start_us / 1000000.0, proc->end_us / 1000000.0,
+                proc->running ? "+ (running)" : "");
+    }
+    if (pt->count > rows) {
+        fprintf(out, "    ... %zu more processes\n", pt->count - rows);
+    }
+    free(order);
+}
@@ -0,0 +1,151 @@
+/**
+ * rune_proctree.h - Whole process-tree accounting for forking targets
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Builds, package maintainer scripts and shells do their work in
+ * descendants the target forks, which the target's own /proc entry
+ * never shows. The tracker follows the whole tree: every scan walks
+ * /proc/<pid>/task/<tid>/children from each process it knows, and adds
+ * what it finds. Per-process descriptors are opened once and pread()
+ * on every scan; a descriptor stays bound to its process, so a
+ * recycled pid can never be mistaken for a tracked one.
+ *
+ * Processes that outlive their parent keep being followed. With
+ * rune_proctree_adopt_orphans() the analyzer becomes their child
+ * subreaper, reaps them itself and so gets their exact rusage; without
+ * it (several targets in one process, as in batch mode) they are still
+ * followed but only sampled.
+ *
+ * Totals are exact where the kernel keeps them: CPU time of everything
+ * that was waited for comes from wait4(). The per-process breakdown is
+ * sampled, so a process living shorter than one scan interval can be
+ * missing from it.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_PROCTREE_H
+#define RUNE_PROCTREE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <time.h>
+
+#define RUNE_PROCTREE_MAX_PROCS 65536       // Processes recorded per run
+#define RUNE_PROCTREE_MIN_INTERVAL_US 10000 // Scan at most every 10 ms
+
+// One process of the tree
+typedef struct rune_proc {
+    pid_t pid;
+    pid_t ppid;                 // Parent at the last observation
+    int parent;                 // Index of the tree parent (-1 for the root)
+    char comm[16];              // Sanitized: safe to print inside JSON strings
+    uint64_t start_us;          // Since the root started (clock-tick granularity)
+    uint64_t end_us;            // Last seen alive (the root: its exit)
+    uint64_t cpu_us;            // Own user + system time
+    uint64_t child_cpu_us;      // Children it has waited for
+    uint64_t read_bytes;        // rchar/wchar, including children it has waited for
+    uint64_t write_bytes;
+    uint64_t own_read_bytes;    // Without those children (set by rune_proctree_finish)
+    uint64_t own_write_bytes;
+    uint32_t rss_kb;
+    uint32_t peak_rss_kb;
+    uint16_t threads;
+    uint8_t running;            // Still followed
+    uint8_t zombie;             // Exited, not reaped yet
+    uint8_t orphaned;           // Reparented away from its tree parent
+    uint8_t reaped;             // Reaped by us as child subreaper
+    unsigned last_scan;         // Last scan that sampled it
+    unsigned gone_scan;         // Scan that found it reaped
+    int stat_fd;
+    int io_fd;
+    int children_fd;            // task/<pid>/children of the main thread
+} rune_proc_t;
+
+typedef struct rune_proctree_totals {
+    size_t processes;           // Distinct processes seen, root included
+    size_t max_concurrent;
+    double cpu_seconds;         // Whole tree: wait4() where possible, samples otherwise
+    uint64_t peak_rss_kb;       // Largest RSS sum of processes alive at the same time
+    uint64_t read_bytes;
+    uint64_t write_bytes;
+    size_t orphans_reaped;
+    size_t still_running;       // Descendants alive after the root exited
+    size_t dropped;             // Not recorded: table full or /proc unreadable
+} rune_proctree_totals_t;
+
+typedef struct rune_proctree {
+    rune_proc_t *procs;         // procs[0] is the root
+    size_t count;
+    size_t capacity;
+    size_t *live;               // Indices of the processes being followed
+    size_t live_count;
+    size_t live_capacity;
+
+    struct timespec start;
+    uint64_t last_scan_us;
+    unsigned scans;
+    unsigned long long root_start_ticks;
+    long ticks_per_second;
+    long page_kb;
+    int reap_orphans;           // We are the child subreaper of this tree
+    int proc_scan;              // No children files: find children by ppid in /proc
+
+    struct rusage orphan_usage; // Sum over orphans we reaped
+    rune_proctree_totals_t totals;
+} rune_proctree_t;
+
+/**
+ * @brief Make orphaned descendants our children, or stop doing so
+ * @return 0 on success, -1 on error (errno is set)
+ *
+ * Process-wide: enable only while a single target runs, and before it
+ * is launched, so no orphan escapes to init in between.
+ */
+int rune_proctree_adopt_orphans(int enable);
+
+/**
+ * @brief Forget the previous tree and start following root
+ * @param start Launch time (CLOCK_MONOTONIC), time zero of the tree
+ * @param reap_orphans Reap adopted orphans (rune_proctree_adopt_orphans(1) is in effect)
+ * @return 0 on success, -1 on allocation failure or unreadable root
+ */
+int rune_proctree_begin(rune_proctree_t *pt, pid_t root, const struct timespec *start, int reap_orphans);
+
+/**
+ * @brief Sample every known process and discover new children
+ *
+ * Cheap to call at any rate: scans closer together than
+ * RUNE_PROCTREE_MIN_INTERVAL_US are skipped.
+ */
+void rune_proctree_scan(rune_proctree_t *pt);
+
+/**
+ * @brief Final scan after the root has been reaped, then compute totals
+ * @param total_seconds Wall time from launch to the root's exit
+ * @param root_usage wait4() rusage of the root
+ */
+void rune_proctree_finish(rune_proctree_t *pt, double total_seconds, const struct rusage *root_usage);
+
+/**
+ * @brief Release the table (safe on a zeroed, never used tree)
+ */
+void rune_proctree_free(rune_proctree_t *pt);
+
+/**
+ * @brief Indices of the processes with the most CPU time, highest first
+ * @return Number of indices written (at most max)
+ */
+size_t rune_proctree_top(const rune_proctree_t *pt, size_t *order, size_t max);
+
+/**
+ * @brief Print the per-process breakdown, max_rows busiest processes
+ */
+void rune_proctree_print(const rune_proctree_t *pt, FILE *out, size_t max_rows);
+
+#endif /* RUNE_PROCTREE_H */
@@ -0,0 +1,109 @@
+/**
+ * rune_ring.c - mmap'd single-producer/single-consumer byte ring
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_ring.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+int rune_ring_init(rune_ring_t *ring, size_t size) {
+    long page = sysconf(_SC_PAGESIZE);
+    if (page <= 0) page = 4096;
+
+    memset(ring, 0, sizeof(*ring));
+    ring->memfd = -1;
+    ring->size = (size + (size_t)page - 1) & ~((size_t)page - 1);
+    if (ring->size == 0) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    ring->memfd = memfd_create("rune_ring", MFD_CLOEXEC);
+    if (ring->memfd < 0) return -1;
+    if (ftruncate(ring->memfd, (off_t)ring->size) != 0) goto fail;
+
+    // Reserve 2 * size of address space, then map the file into both halves
+    void *base = mmap(NULL, ring->size * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (base == MAP_FAILED) goto fail;
+    ring->base = base;
+
+    for (int half = 0; half < 2; half++) {
+        void *addr = mmap(ring->base + half * ring->size, ring->size, PROT_READ | PROT_WRITE,
+                          MAP_SHARED | MAP_FIXED, ring->memfd, 0);
+        if (addr == MAP_FAILED) goto fail;
+    }
+    return 0;
+
+fail:
+    {
+        int saved_errno = errno;
+        rune_ring_destroy(ring);
+        errno = saved_errno;
+    }
+    return -1;
+}
+
+void rune_ring_destroy(rune_ring_t *ring) {
+    if (ring->base) {
+        munmap(ring->base, ring->size * 2);
+        ring->base = NULL;
+    }
+    if (ring->memfd >= 0) {
+        close(ring->memfd);
+        ring->memfd = -1;
+    }
+}
+
+size_t rune_ring_free_space(const rune_ring_t *ring) {
+    uint64_t tail = __atomic_load_n(&ring->tail, __ATOMIC_ACQUIRE);
+    return ring->size - (size_t)(ring->head - tail);
+}
+
+// Publish bytes the producer has written
+static void rune_ring_commit(rune_ring_t *ring, size_t len) {
+    __atomic_store_n(&ring->head, ring->head + len, __ATOMIC_RELEASE);
+}
+
+ssize_t rune_ring_splice_in(rune_ring_t *ring, int pipe_fd, size_t len) {
+    size_t space = rune_ring_free_space(ring);
+    size_t offset = (size_t)(ring->head % ring->size);
+
+    // Stay inside the file - the mirror mapping takes care of the wrap
+    if (len > space) len = space;
+    if (len > ring->size - offset) len = ring->size - offset;
+    if (len == 0) return 0;
+
+    loff_t file_offset = (loff_t)offset;
+    ssize_t moved = splice(pipe_fd, NULL, ring->memfd, &file_offset, len, SPLICE_F_NONBLOCK);
+    if (moved > 0) {
+        rune_ring_commit(ring, (size_t)moved);
+    }
+    return moved;
+}
+
+size_t rune_ring_write(rune_ring_t *ring, const void *data, size_t len) {
+    size_t space = rune_ring_free_space(ring);
+    if (len > space) len = space;
+    if (len == 0) return 0;
+
+    memcpy(ring->base + ring->head % ring->size, data, len);
+    rune_ring_commit(ring, len);
+    return len;
+}
+
+const unsigned char *rune_ring_peek(const rune_ring_t *ring, size_t *len) {
+    uint64_t head = __atomic_load_n(&ring->head, __ATOMIC_ACQUIRE);
+    *len = (size_t)(head - ring->tail);
+    return ring->base + ring->tail % ring->size;
+}
+
+void rune_ring_consume(rune_ring_t *ring, size_t len) {
+    __atomic_store_n(&ring->tail, ring->tail + len, __ATOMIC_RELEASE);
+}
@@ -0,0 +1,70 @@
+/**
+ * rune_ring.h - mmap'd single-producer/single-consumer byte ring
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * The ring is backed by a memfd that is mapped twice, back to back, so
+ * every readable span is contiguous in memory - the consumer never has
+ * to stitch a wrapped chunk together. Because the backing store is a
+ * file, the producer can splice() pipe data straight into it without
+ * the bytes ever passing through userspace.
+ */
+
+#ifndef RUNE_RING_H
+#define RUNE_RING_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+typedef struct rune_ring {
+    unsigned char *base;        // 2 * size bytes, second half mirrors the first
+    size_t size;                // Capacity in bytes (multiple of the page size)
+    int memfd;                  // Backing file, splice() target
+    uint64_t head;              // Total bytes produced (producer owned)
+    uint64_t tail;              // Total bytes consumed (consumer owned)
+} rune_ring_t;
+
+/**
+ * @brief Create a ring of at least @size bytes
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_ring_init(rune_ring_t *ring, size_t size);
+
+/**
+ * @brief Unmap the ring and close its backing file
+ */
+void rune_ring_destroy(rune_ring_t *ring);
+
+/**
+ * @brief Bytes the producer may add without overwriting unread data
+ */
+size_t rune_ring_free_space(const rune_ring_t *ring);
+
+/**
+ * @brief Move up to @len bytes from a pipe into the ring with splice()
+ * @return Bytes moved, 0 if the ring is full, -1 on error (errno is set)
+ *
+ * Never blocks: the pipe must already hold the data.
+ */
+ssize_t rune_ring_splice_in(rune_ring_t *ring, int pipe_fd, size_t len);
+
+/**
+ * @brief Copy bytes into the ring (fallback when splice() is unavailable)
+ * @return Bytes stored, less than @len when the ring is full
+ */
+size_t rune_ring_write(rune_ring_t *ring, const void *data, size_t len);
+
+/**
+ * @brief Contiguous view of all unread bytes
+ * @param len Set to the number of readable bytes (0 when empty)
+ */
+const unsigned char *rune_ring_peek(const rune_ring_t *ring, size_t *len);
+
+/**
+ * @brief Release @len bytes returned by rune_ring_peek()
+ */
+void rune_ring_consume(rune_ring_t *ring, size_t len);
+
+#endif /* RUNE_RING_H */
@@ -0,0 +1,260 @@
+/**
+ * rune_span.c - Nested timing spans implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+#include "rune_intern.h"
+#include "rune_span.h"
+
+// One open span on a thread's stack
+typedef struct rune_span_frame {
+    rune_context_t *ctx;
+    unsigned long serial;       // ctx->checkpoint_serial when opened
+    int node;                   // Call tree node, -1 if it could not be added
+    uint32_t name;
+    uint64_t start_ns;
+    uint64_t child_ns;          // Closed child spans
+} rune_span_frame_t;
+
+static __thread rune_span_frame_t t_span_stack[RUNE_SPAN_MAX_DEPTH];
+static __thread int t_span_depth;
+static __thread int t_span_overflow;    // Opened past RUNE_SPAN_MAX_DEPTH, not on the stack
+
+static uint64_t rune_span_now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int rune_span_frame_in(const rune_span_frame_t *frame, const rune_context_t *ctx) {
+    return frame->ctx == ctx && frame->serial == ctx->checkpoint_serial;
+}
+
+// Child of parent called name, added on first use (span_lock held).
+// Node 0 is the root every thread's outermost spans hang off.
+static int rune_span_child(rune_context_t *ctx, int parent, uint32_t name) {
+    if (ctx->span_count == 0) {
+        parent = -1;
+    } else {
+        for (int n = ctx->spans[parent].first_child; n >= 0; n = ctx->spans[n].next_sibling) {
+            if (ctx->spans[n].name == name) {
+                return n;
+            }
+        }
+    }
+
+    if (ctx->span_count == ctx->span_capacity) {
+        int capacity = ctx->span_capacity ? ctx->span_capacity * 2 : 64;
+        rune_span_node_t *spans = realloc(ctx->spans, (size_t)capacity * sizeof(*spans));
+        if (!spans) {
+            return -1;
+        }
+        ctx->spans = spans;
+        ctx->span_capacity = capacity;
+    }
+    int n = ctx->span_count++;
+    memset(&ctx->spans[n], 0, sizeof(ctx->spans[n]));
+    ctx->spans[n].name = name;
+    ctx->spans[n].parent = parent;
+    ctx->spans[n].first_child = -1;
+    ctx->spans[n].next_sibling = -1;
+    if (parent >= 0) {
+        ctx->spans[n].next_sibling = ctx->spans[parent].first_child;
+        ctx->spans[parent].first_child = n;
+    }
+    return n;
+}
+
+void rune_span_begin(const char *name) {
+    if (t_span_depth == RUNE_SPAN_MAX_DEPTH) {
+        t_span_overflow++;
+        return;
+    }
+    rune_context_t *ctx = rune_context_current();
+    uint32_t id = rune_intern(name);
+
+    int parent = 0;
+    if (t_span_depth > 0 && rune_span_frame_in(&t_span_stack[t_span_depth - 1], ctx)) {
+        parent = t_span_stack[t_span_depth - 1].node;
+    }
+
+    int node = -1;
+    pthread_mutex_lock(&ctx->span_lock);
+    if (ctx->span_count == 0 && rune_span_child(ctx, -1, RUNE_INTERN_NONE) != 0) {
+        parent = -1;
+    }
+    if (parent >= 0) {
+        node = rune_span_child(ctx, parent, id);
+    }
+    pthread_mutex_unlock(&ctx->span_lock);
+
+    rune_span_frame_t *frame = &t_span_stack[t_span_depth++];
+    frame->ctx = ctx;
+    frame->serial = ctx->checkpoint_serial;
+    frame->node = node;
+    frame->name = id;
+    frame->child_ns = 0;
+    frame->start_ns = rune_span_now();
+}
+
+void rune_span_end(const char *name) {
+    uint64_t now = rune_span_now();
+    if (t_span_overflow > 0) {
+        t_span_overflow--;
+        return;
+    }
+    rune_context_t *ctx = rune_context_current();
+    uint32_t id = rune_intern(name);
+
+    int match = t_span_depth - 1;
+    while (match >= 0 && !(t_span_stack[match].name == id && rune_span_frame_in(&t_span_stack[match], ctx))) {
+        match--;
+    }
+    if (match < 0) {
+        return;
+    }
+
+    // Close everything above the match too, innermost first
+    pthread_mutex_lock(&ctx->span_lock);
+    while (t_span_depth > match) {
+        rune_span_frame_t *frame = &t_span_stack[--t_span_depth];
+        if (!rune_span_frame_in(frame, ctx)) {
+            continue;   // Opened in another context, which may be gone by now
+        }
+        uint64_t elapsed = now - frame->start_ns;
+        if (frame->node >= 0) {
+            rune_span_node_t *node = &ctx->spans[frame->node];
+            node->calls++;
+            node->total_ns += elapsed;
+            node->self_ns += elapsed > frame->child_ns ? elapsed - frame->child_ns : 0;
+        }
+        if (t_span_depth > 0 && rune_span_frame_in(&t_span_stack[t_span_depth - 1], ctx)) {
+            t_span_stack[t_span_depth - 1].child_ns += elapsed;
+        }
+    }
+    pthread_mutex_unlock(&ctx->span_lock);
+}
+
+// Copy of the call tree with the calling thread's open spans counted up to now
+static rune_span_node_t *rune_span_snapshot(rune_context_t *ctx, int *count) {
+    uint64_t now = rune_span_now();
+    pthread_mutex_lock(&ctx->span_lock);
+    *count = ctx->span_count;
+    rune_span_node_t *nodes = *count ? malloc((size_t)*count * sizeof(*nodes)) : NULL;
+    if (nodes) {
+        memcpy(nodes, ctx->spans, (size_t)*count * sizeof(*nodes));
+    }
+    pthread_mutex_unlock(&ctx->span_lock);
+    if (!nodes) {
+        return NULL;
+    }
+
+    uint64_t inner_ns = 0;      // Open child of the frame being looked at
+    for (int i = t_span_depth - 1; i >= 0; i--) {
+        const rune_span_frame_t *frame = &t_span_stack[i];
+        if (!rune_span_frame_in(frame, ctx) || frame->node < 0 || frame->node >= *count) {
+            inner_ns = 0;
+            continue;
+        }
+        uint64_t elapsed = now - frame->start_ns;
+        uint64_t children = frame->child_ns + inner_ns;
+        nodes[frame->node].calls++;
+        nodes[frame->node].total_ns += elapsed;
+        nodes[frame->node].self_ns += elapsed > children ? elapsed - children : 0;
+        inner_ns = elapsed;
+    }
+    return nodes;
+}
+
+static int rune_span_total_compare(const void *a, const void *b) {
+    const rune_span_total_t *x = a, *y = b;
+    return (x->self_ns < y->self_ns) - (x->self_ns > y->self_ns);
+}
+
+int rune_span_totals(const rune_context_t *cctx, rune_span_total_t **totals) {
+    *totals = NULL;
+    int count;
+    rune_span_node_t *nodes = rune_span_snapshot((rune_context_t *)cctx, &count);
+    if (!nodes) {
+        return count ? -1 : 0;
+    }
+    rune_span_total_t *out = calloc((size_t)count, sizeof(*out));
+    if (!out) {
+        free(nodes);
+        return -1;
+    }
+
+    int names = 0;
+    for (int n = 1; n < count; n++) {
+        const char *name = rune_intern_string(nodes[n].name);
+        int t = 0;
+        while (t < names && strcmp(out[t].name, name) != 0) {
+            t++;
+        }
+        if (t == names) {
+            out[names++].name = name;
+        }
+        out[t].calls += nodes[n].calls;
+        out[t].self_ns += nodes[n].self_ns;
+
+        // A recursive call's time is already in its outer instance
+        int p = nodes[n].parent;
+        while (p > 0 && nodes[p].name != nodes[n].name) {
+            p = nodes[p].parent;
+        }
+        if (p <= 0) {
+            out[t].total_ns += nodes[n].total_ns;
+        }
+    }
+    free(nodes);
+
+    qsort(out, (size_t)names, sizeof(*out), rune_span_total_compare);
+    *totals = out;
+    return names;
+}
+
+int rune_span_export_folded(const rune_context_t *cctx, const char *path) {
+    int count;
+    rune_span_node_t *nodes = rune_span_snapshot((rune_context_t *)cctx, &count);
+    if (!nodes && count) {
+        errno = ENOMEM;
+        return -1;
+    }
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        free(nodes);
+        return -1;
+    }
+
+    int chain[RUNE_SPAN_MAX_DEPTH];
+    for (int n = 1; n < count; n++) {
+        uint64_t self_us = (nodes[n].self_ns + 500) / 1000;
+        if (!self_us) {
+            continue;
+        }
+        int depth = 0;
+        for (int p = n; p > 0 && depth < RUNE_SPAN_MAX_DEPTH; p = nodes[p].parent) {
+            chain[depth++] = p;
+        }
+        while (depth-- > 0) {
+            fprintf(out, "%s%s", rune_intern_string(nodes[chain[depth]].name), depth ? ";" : "");
+        }
+        fprintf(out, " %llu\n", (unsigned long long)self_us);
+    }
+    free(nodes);
+
+    if (fclose(out) != 0) {
+        return -1;
+    }
+    return 0;
+}
+
+void rune_span_free(rune_context_t *ctx) {
+    free(ctx->spans);
+    ctx->spans = NULL;
+    ctx->span_count = 0;
+    ctx->span_capacity = 0;
+}
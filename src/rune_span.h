@@ -0,0 +1,67 @@
+/**
+ * rune_span.h - Nested timing spans for rune_analyze itself
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * RUNE_LOG_FUNC_START/END open and close a span as well as logging
+ * their checkpoints. Every thread keeps its own stack of open spans
+ * with CLOCK_MONOTONIC start times; closing one charges its duration to
+ * a call tree in the current context (one node per distinct stack),
+ * and the parent's self time excludes it.
+ *
+ * An END without a matching START is ignored. An END for a span below
+ * the top of the stack also closes the spans above it, so a missing
+ * END on an early return does not skew the rest of the tree.
+ *
+ * Reports are snapshots: spans still open on the reading thread are
+ * counted up to now, so "main" shows up before it has returned.
+ */
+
+#ifndef RUNE_SPAN_H
+#define RUNE_SPAN_H
+
+#include <stdint.h>
+
+#define RUNE_SPAN_MAX_DEPTH 64          // Open spans per thread; deeper ones are not timed
+
+struct rune_context;
+
+// Time spent under one span name, recursion counted once
+typedef struct rune_span_total {
+    const char *name;
+    uint64_t calls;
+    uint64_t total_ns;          // Outermost instances only
+    uint64_t self_ns;           // Minus time in child spans
+} rune_span_total_t;
+
+/**
+ * @brief Open a span on the calling thread, in its current context
+ */
+void rune_span_begin(const char *name);
+
+/**
+ * @brief Close the innermost open span called name
+ */
+void rune_span_end(const char *name);
+
+/**
+ * @brief Total and self time per span name, by self time descending
+ * @param totals Set to a malloc'd array the caller frees
+ * @return Number of entries, -1 on allocation failure
+ */
+int rune_span_totals(const struct rune_context *ctx, rune_span_total_t **totals);
+
+/**
+ * @brief Write the call tree as folded stacks ("a;b;c <self us>"),
+ *        the input format of flamegraph.pl and speedscope
+ * @return 0 on success, -1 with errno set
+ */
+int rune_span_export_folded(const struct rune_context *ctx, const char *path);
+
+/**
+ * @brief Release a context's call tree (context teardown)
+ */
+void rune_span_free(struct rune_context *ctx);
+
+#endif /* RUNE_SPAN_H */
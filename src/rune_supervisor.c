@@ -0,0 +1,252 @@
+/**
+ * rune_supervisor.c - Event-driven child supervision implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * One epoll set, five kinds of wakeup: stdout, stderr, child exit
+ * (pidfd), the sampling timer and the kill deadline (timerfds).
+ * No polling, no sleeps.
+ */
+
+#include "rune_supervisor.h"
+#include "rune_capture.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/syscall.h>
+#include <sys/resource.h>
+#include <sys/timerfd.h>
+#include <sys/wait.h>
+
+#ifndef SYS_pidfd_open
+#define SYS_pidfd_open 434
+#endif
+
+// Fallback reap interval when the kernel has no pidfd_open() (< 5.3)
+#define RUNE_SUPERVISE_FALLBACK_US 10000
+
+// epoll tags
+enum { TAG_STDOUT = 0, TAG_STDERR = 1, TAG_PIDFD = 2, TAG_TIMER = 3, TAG_DEADLINE = 4 };
+
+static int rune_pidfd_open(pid_t pid) {
+    return (int)syscall(SYS_pidfd_open, pid, 0);
+}
+
+// Write a whole buffer, retrying on short writes
+static void rune_write_all(int fd, const char *data, size_t len) {
+    while (len > 0) {
+        ssize_t n = write(fd, data, len);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+        data += n;
+        len -= (size_t)n;
+    }
+}
+
+// Read everything currently available on a pipe. Returns 0 on EOF.
+static int rune_drain_pipe(int fd, int stream, const rune_supervise_ops_t *ops,
+                           rune_supervise_result_t *result) {
+    char buffer[65536];
+    for (;;) {
+        ssize_t bytes = read(fd, buffer, sizeof(buffer));
+        if (bytes > 0) {
+            if (stream == RUNE_STREAM_STDOUT) {
+                result->stdout_bytes += (size_t)bytes;
+            } else {
+                result->stderr_bytes += (size_t)bytes;
+            }
+            if (ops && ops->forward_output) {
+                rune_write_all(stream == RUNE_STREAM_STDOUT ? STDOUT_FILENO : STDERR_FILENO,
+                               buffer, (size_t)bytes);
+            }
+            if (ops && ops->on_output) {
+                ops->on_output(ops->user, stream, buffer, (size_t)bytes);
+            }
+            continue;
+        }
+        if (bytes == 0) return 0;
+        if (errno == EINTR) continue;
+        return errno == EAGAIN ? 1 : 0;
+    }
+}
+
+static int rune_drain_stream(int fd, int stream, rune_capture_t *capture,
+                             const rune_supervise_ops_t *ops, rune_supervise_result_t *result) {
+    if (capture) {
+        return rune_capture_drain(capture, stream, fd,
+                                  stream == RUNE_STREAM_STDOUT ? &result->stdout_bytes
+                                                               : &result->stderr_bytes);
+    }
+    return rune_drain_pipe(fd, stream, ops, result);
+}
+
+static int rune_arm_timer(int timer_fd, long interval_us, int periodic) {
+    struct itimerspec its;
+    memset(&its, 0, sizeof(its));
+    its.it_value.tv_sec = interval_us / 1000000;
+    its.it_value.tv_nsec = (interval_us % 1000000) * 1000;
+    if (periodic) its.it_interval = its.it_value;
+    return timerfd_settime(timer_fd, 0, &its, NULL);
+}
+
+static void rune_record_status(int status, rune_supervise_result_t *result) {
+    result->status = status;
+    if (WIFEXITED(status)) {
+        result->exit_code = WEXITSTATUS(status);
+    } else if (WIFSIGNALED(status)) {
+        result->exit_code = 128 + WTERMSIG(status);
+    }
+}
+
+int rune_supervise_child(pid_t pid, int stdout_fd, int stderr_fd,
+                         const rune_supervise_ops_t *ops,
+                         rune_supervise_result_t *result) {
+    int fds[2] = { stdout_fd, stderr_fd };
+    int epoll_fd = -1, pid_fd = -1, timer_fd = -1, deadline_fd = -1;
+    int child_running = 1;
+    int rc = -1;
+    rune_capture_t capture;
+    int capturing = 0;
+
+    memset(result, 0, sizeof(*result));
+
+    // Zero-copy capture; without it (or if setup fails) we read() and write()
+    if (ops && ops->capture_ring_size > 0 &&
+        rune_capture_start(&capture, ops->capture_ring_size, ops->forward_output,
+                           ops->on_output, ops->user) == 0) {
+        capturing = 1;
+    }
+
+    epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd < 0) goto out;
+
+    for (int i = 0; i < 2; i++) {
+        if (fds[i] < 0) continue;
+        fcntl(fds[i], F_SETFL, fcntl(fds[i], F_GETFL) | O_NONBLOCK);
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = (uint32_t)i };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, fds[i], &ev) != 0) goto out;
+    }
+
+    // Child exit: pidfd becomes readable once the child is a zombie
+    pid_fd = rune_pidfd_open(pid);
+    if (pid_fd >= 0) {
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_PIDFD };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, pid_fd, &ev) != 0) goto out;
+        result->used_pidfd = 1;
+    }
+
+    // Sampling timer (doubles as the reap timer without pidfd)
+    long interval_us = ops ? ops->sample_interval_us : 0;
+    if (pid_fd < 0 && (interval_us <= 0 || interval_us > RUNE_SUPERVISE_FALLBACK_US)) {
+        interval_us = RUNE_SUPERVISE_FALLBACK_US;
+    }
+    if (interval_us > 0) {
+        timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (timer_fd < 0 || rune_arm_timer(timer_fd, interval_us, 1) != 0) goto out;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_TIMER };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, timer_fd, &ev) != 0) goto out;
+    }
+
+    // Kill deadline
+    if (ops && ops->timeout_us > 0) {
+        deadline_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (deadline_fd < 0 || rune_arm_timer(deadline_fd, ops->timeout_us, 0) != 0) goto out;
+        struct epoll_event ev = { .events = EPOLLIN, .data.u32 = TAG_DEADLINE };
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, deadline_fd, &ev) != 0) goto out;
+    }
+
+    while (child_running) {
+        struct epoll_event events[5];
+        int n = epoll_wait(epoll_fd, events, 5, -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            goto out;
+        }
+        result->wakeups++;
+
+        int check_child = 0;
+        for (int i = 0; i < n; i++) {
+            uint32_t tag = events[i].data.u32;
+            if (tag == TAG_STDOUT || tag == TAG_STDERR) {
+                if (!rune_drain_stream(fds[tag], (int)tag, capturing ? &capture : NULL, ops, result)) {
+                    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fds[tag], NULL);
+                    close(fds[tag]);
+                    fds[tag] = -1;
+                }
+            } else if (tag == TAG_PIDFD) {
+                check_child = 1;
+            } else if (tag == TAG_TIMER) {
+                uint64_t expirations;
+                if (read(timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN) {
+                    goto out;
+                }
+                if (pid_fd < 0) check_child = 1;
+                if (ops && ops->on_sample && ops->sample_interval_us > 0) {
+                    ops->on_sample(ops->user, pid);
+                }
+            } else if (tag == TAG_DEADLINE) {
+                // Not reaped yet, so pid cannot have been recycled
+                epoll_ctl(epoll_fd, EPOLL_CTL_DEL, deadline_fd, NULL);
+                kill(pid, SIGKILL);
+                result->timed_out = 1;
+            }
+        }
+
+        if (check_child) {
+            int status;
+            pid_t wait_result = wait4(pid, &status, WNOHANG, &result->rusage);
+            if (wait_result == pid) {
+                rune_record_status(status, result);
+                child_running = 0;
+            } else if (wait_result < 0 && errno != EINTR) {
+                child_running = 0;      // Not ours to reap: never signal a pid we may not own
+                goto out;
+            }
+        }
+    }
+
+    // Whatever the child wrote before exiting is still buffered in the pipes
+    for (int i = 0; i < 2; i++) {
+        if (fds[i] >= 0) rune_drain_stream(fds[i], i, capturing ? &capture : NULL, ops, result);
+    }
+    rc = 0;
+
+out:
+    {
+        int saved_errno = errno;
+        // On error the child must not run on unsupervised or stay a zombie;
+        // unreaped, its pid cannot have been recycled
+        if (child_running) {
+            int status;
+            kill(pid, SIGKILL);
+            pid_t wait_result;
+            while ((wait_result = wait4(pid, &status, 0, &result->rusage)) < 0 && errno == EINTR) {
+            }
+            if (wait_result == pid) {
+                rune_record_status(status, result);
+            }
+        }
+        for (int i = 0; i < 2; i++) {
+            if (fds[i] >= 0) close(fds[i]);
+        }
+        if (timer_fd >= 0) close(timer_fd);
+        if (deadline_fd >= 0) close(deadline_fd);
+        if (pid_fd >= 0) close(pid_fd);
+        if (epoll_fd >= 0) close(epoll_fd);
+        if (capturing) {
+            rune_capture_finish(&capture);
+            result->used_zero_copy = rune_capture_zero_copy(&capture);
+            result->capture_dropped_bytes = capture.dropped_bytes;
+        }
+        errno = saved_errno;
+    }
+    return rc;
+}
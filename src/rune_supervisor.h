@@ -0,0 +1,79 @@
+/**
+ * rune_supervisor.h - Event-driven child supervision for rune_analyze
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * The analyzer sleeps on a single epoll set holding the target's
+ * stdout/stderr pipes, a pidfd for child exit and a timerfd for
+ * sampling, and only wakes up when one of them is ready.
+ *
+ * This module depends on libc only so that both the modular framework
+ * and the legacy monolith can link it.
+ */
+
+#ifndef RUNE_SUPERVISOR_H
+#define RUNE_SUPERVISOR_H
+
+#include <sys/types.h>
+#include <sys/resource.h>
+#include <stddef.h>
+
+// Output streams reported to the on_output callback
+#define RUNE_STREAM_STDOUT 0
+#define RUNE_STREAM_STDERR 1
+
+// Supervision options and callbacks
+typedef struct rune_supervise_ops {
+    // Called for every chunk read from the target's stdout/stderr
+    void (*on_output)(void *user, int stream, const char *data, size_t len);
+    // Called on every sampling tick while the target is alive
+    void (*on_sample)(void *user, pid_t pid);
+    void *user;
+    int forward_output;         // Copy captured output to our own stdout/stderr
+    long sample_interval_us;    // Sampling period, 0 disables the timerfd
+    size_t capture_ring_size;   // >0: zero-copy capture, on_output runs on a consumer thread
+    long timeout_us;            // >0: SIGKILL the child once it has run this long
+} rune_supervise_ops_t;
+
+// Everything the supervisor learned about the run
+typedef struct rune_supervise_result {
+    int status;                 // Raw wait status
+    int exit_code;              // Exit status, or 128 + signal number
+    size_t stdout_bytes;
+    size_t stderr_bytes;
+    unsigned long wakeups;      // Number of epoll_wait() returns
+    int used_pidfd;             // 0 when the kernel lacks pidfd_open()
+    struct rusage rusage;       // Kernel accounting from wait4()
+    int used_zero_copy;         // Output moved with tee()/splice() end to end
+    unsigned long long capture_dropped_bytes; // Forwarded but not analyzed (ring full)
+    int timed_out;              // Killed because ops->timeout_us expired
+} rune_supervise_result_t;
+
+/**
+ * @brief Supervise an already started child until it exits
+ * @param pid Child process to supervise (must be our child)
+ * @param stdout_fd Read end of the child's stdout pipe, or -1
+ * @param stderr_fd Read end of the child's stderr pipe, or -1
+ * @param ops Callbacks and options (may be NULL)
+ * @param result Filled with exit status and byte counts
+ * @return 0 on success, -1 on error (errno is set); the child has then
+ *         been killed and reaped, so it never outlives the call
+ *
+ * The child is reaped with wait4() so its user/system time, maxrss,
+ * page faults and context switches land in result->rusage.
+ * Both pipe fds are closed before returning. Output that is already
+ * buffered in the pipes when the child exits is drained and reported.
+ *
+ * With ops->capture_ring_size set, output is forwarded with tee()/splice()
+ * and on_output is called from a consumer thread reading an mmap'd ring.
+ * Every callback has returned by the time this function returns.
+ *
+ * With ops->timeout_us set, a one-shot timerfd in the same epoll set
+ * kills the child when the deadline passes; it is still reaped normally.
+ */
+int rune_supervise_child(pid_t pid, int stdout_fd, int stderr_fd,
+                         const rune_supervise_ops_t *ops,
+                         rune_supervise_result_t *result);
+
+#endif /* RUNE_SUPERVISOR_H */
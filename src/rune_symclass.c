@@ -0,0 +1,181 @@
+/**
+ * rune_symclass.c - Dangerous-API classification implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * The slot table below is generated from RUNE_SYMCLASS_APIS. After
+ * changing the list, regenerate it and paste the output over
+ * RUNE_SYMCLASS_SEED and g_symclass_slots:
+ *
+ *     gcc -DRUNE_SYMCLASS_GENERATE -D_GNU_SOURCE -Isrc src/rune_symclass.c -o symclass_gen
+ *     ./symclass_gen
+ *
+ * make test (make check-symclass) fails while the table is stale.
+ */
+
+#include "rune_symclass.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define RUNE_SYMCLASS_SLOT_BITS 7
+#define RUNE_SYMCLASS_SLOTS (1u << RUNE_SYMCLASS_SLOT_BITS)
+
+// glibc links scanf and friends as __isoc99_*/__isoc23_* under -std=c99 and later
+#define RUNE_SYMCLASS_APIS(X) \
+    X("strcpy", STRING) X("strcat", STRING) X("stpcpy", STRING) X("wcscpy", STRING) \
+    X("wcscat", STRING) X("sprintf", STRING) X("vsprintf", STRING) X("gets", STRING) \
+    X("scanf", INPUT) X("fscanf", INPUT) X("sscanf", INPUT) X("vscanf", INPUT) \
+    X("vfscanf", INPUT) X("vsscanf", INPUT) \
+    X("__isoc99_scanf", INPUT) X("__isoc99_fscanf", INPUT) X("__isoc99_sscanf", INPUT) \
+    X("__isoc99_vscanf", INPUT) X("__isoc99_vfscanf", INPUT) X("__isoc99_vsscanf", INPUT) \
+    X("__isoc23_scanf", INPUT) X("__isoc23_fscanf", INPUT) X("__isoc23_sscanf", INPUT) \
+    X("__isoc23_vscanf", INPUT) X("__isoc23_vfscanf", INPUT) X("__isoc23_vsscanf", INPUT) \
+    X("malloc", MEMORY) X("calloc", MEMORY) X("realloc", MEMORY) X("reallocarray", MEMORY) \
+    X("free", MEMORY) \
+    X("system", EXEC) X("popen", EXEC) X("execl", EXEC) X("execle", EXEC) X("execlp", EXEC) \
+    X("execv", EXEC) X("execve", EXEC) X("execvp", EXEC) X("execvpe", EXEC) X("fexecve", EXEC) \
+    X("posix_spawn", EXEC) X("posix_spawnp", EXEC) \
+    X("tmpnam", TEMPFILE) X("tmpnam_r", TEMPFILE) X("tempnam", TEMPFILE) X("mktemp", TEMPFILE) \
+    X("setuid", PRIVILEGE) X("setgid", PRIVILEGE) X("seteuid", PRIVILEGE) X("setegid", PRIVILEGE) \
+    X("setreuid", PRIVILEGE) X("setregid", PRIVILEGE) X("setresuid", PRIVILEGE) \
+    X("setresgid", PRIVILEGE) X("chroot", PRIVILEGE)
+
+typedef struct rune_symclass_api {
+    const char *name;
+    uint8_t length;
+    uint8_t category;
+} rune_symclass_api_t;
+
+#define RUNE_SYMCLASS_ENTRY(name, category) { name, sizeof(name) - 1, RUNE_SYMCLASS_##category },
+static const rune_symclass_api_t g_symclass_apis[] = { RUNE_SYMCLASS_APIS(RUNE_SYMCLASS_ENTRY) };
+#define RUNE_SYMCLASS_API_COUNT (sizeof(g_symclass_apis) / sizeof(g_symclass_apis[0]))
+
+// Hash of the name up to the version suffix; *length gets that length
+static uint32_t rune_symclass_hash(const char *s, uint32_t seed, size_t *length) {
+    uint32_t hash = seed;
+    size_t n = 0;
+    for (; s[n] && s[n] != '@'; n++) {
+        hash ^= (unsigned char)s[n];
+        hash *= 16777619u;
+    }
+    *length = n;
+    return (hash ^ (hash >> 15)) & (RUNE_SYMCLASS_SLOTS - 1);
+}
+
+#ifndef RUNE_SYMCLASS_GENERATE
+
+// Generated: slot -> index into g_symclass_apis + 1, 0 = no API
+#define RUNE_SYMCLASS_SEED 0x81222d15u
+static const uint8_t g_symclass_slots[RUNE_SYMCLASS_SLOTS] = {
+     0,  0,  0,  6,  0,  0,  0, 12, 41,  0,  0,  0, 32,  8,  0,  0,
+     0, 37,  0,  0,  0,  0, 15,  0,  0,  0,  0, 40, 19,  0,  0,  0,
+    22,  0, 23,  0,  0, 55,  0, 20, 43,  0,  0, 35, 27,  0, 28,  0,
+     2,  0, 51,  0,  0,  0, 16, 30,  0,  0,  3, 50,  0,  0, 34, 24,
+     0, 54,  0,  0, 36, 46,  7, 38,  0, 26, 48,  0,  0,  0, 17,  0,
+    49,  0, 11, 25, 52,  0,  0, 53, 10,  0, 18,  0,  0, 31,  0,  0,
+     0,  0, 14,  0,  9, 45, 44,  4,  0,  0,  0,  0, 39,  1, 42,  0,
+     0, 21,  0, 29, 33,  0,  0, 47,  0,  0,  0,  5, 13,  0, 56,  0,
+};
+
+int rune_symclass_lookup(const char *symbol, const char **api) {
+    size_t length;
+    uint8_t index = g_symclass_slots[rune_symclass_hash(symbol, RUNE_SYMCLASS_SEED, &length)];
+    if (!index) {
+        return -1;
+    }
+    const rune_symclass_api_t *entry = &g_symclass_apis[index - 1];
+    if (entry->length != length || memcmp(entry->name, symbol, length) != 0) {
+        return -1;
+    }
+    if (api) {
+        *api = entry->name;
+    }
+    return entry->category;
+}
+
+int rune_symclass_classify(const rune_elf_t *elf, rune_symclass_report_t *report) {
+    memset(report, 0, sizeof(*report));
+    // Dynamic binaries import the APIs; a static one carries its own copies
+    int dynamic = elf->interp || elf->dynamic_count > 0;
+
+    for (size_t i = 0; i < elf->symbol_count; i++) {
+        const rune_elf_symbol_t *sym = &elf->symbols[i];
+        // .symtab lists everything .dynsym does; stripped binaries only have .dynsym
+        if (sym->dynamic == elf->has_symtab || (sym->type != STT_FUNC && sym->type != STT_NOTYPE &&
+                                                sym->type != STT_GNU_IFUNC)) {
+            continue;
+        }
+        int imported = sym->shndx == SHN_UNDEF;
+        if (dynamic && !imported) {
+            continue;
+        }
+        report->symbols_scanned++;
+
+        const char *api;
+        int category = rune_symclass_lookup(sym->name, &api);
+        if (category < 0) {
+            continue;
+        }
+        if (report->count == report->capacity) {
+            size_t capacity = report->capacity ? report->capacity * 2 : 16;
+            rune_symclass_hit_t *hits = realloc(report->hits, capacity * sizeof(*hits));
+            if (!hits) {
+                return -1;
+            }
+            report->hits = hits;
+            report->capacity = capacity;
+        }
+        report->hits[report->count++] = (rune_symclass_hit_t){
+            .api = api, .symbol = sym->name, .category = (rune_symclass_category_t)category, .imported = imported,
+        };
+        report->per_category[category]++;
+    }
+    return 0;
+}
+
+const char *rune_symclass_category_name(rune_symclass_category_t category) {
+    static const char *const names[RUNE_SYMCLASS_CATEGORIES] = {
+        "string", "input", "memory", "exec", "tempfile", "privilege",
+    };
+    return category < RUNE_SYMCLASS_CATEGORIES ? names[category] : "unknown";
+}
+
+void rune_symclass_free(rune_symclass_report_t *report) {
+    free(report->hits);
+    memset(report, 0, sizeof(*report));
+}
+
+#else /* RUNE_SYMCLASS_GENERATE */
+
+#include <stdio.h>
+
+// Smallest seed (from the FNV offset basis up) that gives every API a slot of its own
+int main(void) {
+    for (uint32_t seed = 0x811c9dc5u;; seed++) {
+        uint8_t slots[RUNE_SYMCLASS_SLOTS] = { 0 };
+        size_t i;
+        for (i = 0; i < RUNE_SYMCLASS_API_COUNT; i++) {
+            size_t length;
+            uint32_t slot = rune_symclass_hash(g_symclass_apis[i].name, seed, &length);
+            if (slots[slot]) {
+                break;
+            }
+            slots[slot] = (uint8_t)(i + 1);
+        }
+        if (i < RUNE_SYMCLASS_API_COUNT) {
+            continue;
+        }
+        printf("#define RUNE_SYMCLASS_SEED 0x%08xu\n", seed);
+        printf("static const uint8_t g_symclass_slots[RUNE_SYMCLASS_SLOTS] = {");
+        for (i = 0; i < RUNE_SYMCLASS_SLOTS; i++) {
+            printf("%s%2u,", i % 16 ? " " : "\n    ", slots[i]);
+        }
+        printf("\n};\n");
+        return 0;
+    }
+}
+
+#endif /* RUNE_SYMCLASS_GENERATE */
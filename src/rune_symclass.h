@@ -0,0 +1,65 @@
+/**
+ * rune_symclass.h - Dangerous-API classification of a binary's symbols
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Classifies the functions a binary imports (every function for static
+ * binaries) by exact name through a perfect hash generated from the
+ * API list in rune_symclass.c: one hash, one probe and one compare per
+ * symbol, so a 100k-symbol table takes microseconds. Symbol versions
+ * are ignored ("strcpy@GLIBC_2.2.5" is strcpy), names that merely
+ * contain an API name are not ("freeaddrinfo" is not free).
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_SYMCLASS_H
+#define RUNE_SYMCLASS_H
+
+#include <stddef.h>
+
+#include "rune_elf.h"
+
+typedef enum rune_symclass_category {
+    RUNE_SYMCLASS_STRING,       // Unbounded copies: strcpy, sprintf, gets, ...
+    RUNE_SYMCLASS_INPUT,        // scanf family (%s without a width)
+    RUNE_SYMCLASS_MEMORY,       // Heap management: use-after-free, double free
+    RUNE_SYMCLASS_EXEC,         // Runs other programs: system, popen, exec*
+    RUNE_SYMCLASS_TEMPFILE,     // Racy temporary file names
+    RUNE_SYMCLASS_PRIVILEGE,    // Identity and root changes
+    RUNE_SYMCLASS_CATEGORIES
+} rune_symclass_category_t;
+
+typedef struct rune_symclass_hit {
+    const char *api;            // Name in the API list ("strcpy")
+    const char *symbol;         // As in the binary ("strcpy@GLIBC_2.2.5"), valid while the ELF is open
+    rune_symclass_category_t category;
+    int imported;               // Undefined in the binary
+} rune_symclass_hit_t;
+
+typedef struct rune_symclass_report {
+    rune_symclass_hit_t *hits;  // In symbol table order
+    size_t count;
+    size_t capacity;
+    size_t per_category[RUNE_SYMCLASS_CATEGORIES];
+    size_t symbols_scanned;
+} rune_symclass_report_t;
+
+/**
+ * @brief Category of one symbol name, version suffix allowed
+ * @return The category, or -1 if the name is not a listed API
+ */
+int rune_symclass_lookup(const char *symbol, const char **api);
+
+/**
+ * @brief Classify every function symbol of elf in one pass
+ * @return 0 on success, -1 if out of memory (hits so far are kept)
+ */
+int rune_symclass_classify(const rune_elf_t *elf, rune_symclass_report_t *report);
+
+const char *rune_symclass_category_name(rune_symclass_category_t category);
+
+void rune_symclass_free(rune_symclass_report_t *report);
+
+#endif /* RUNE_SYMCLASS_H */
@@ -0,0 +1,324 @@
+/**
+ * rune_timeline.c - Resource timeline and phase detection implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_timeline.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// CPU time of threads other than the main one only advances in clock ticks:
+// never judge activity on less
+#define RUNE_PHASE_MIN_WINDOW_US 50000
+// Below these steady levels a signal is considered idle
+#define RUNE_PHASE_CPU_FLOOR 0.02           // Cores
+#define RUNE_PHASE_IO_FLOOR 65536.0         // Bytes per second
+
+int rune_timeline_init(rune_timeline_t *tl, size_t capacity) {
+    memset(tl, 0, sizeof(*tl));
+    tl->stat_fd = -1;
+    tl->io_fd = -1;
+    tl->sched_fd = -1;
+    tl->time_us = malloc(capacity * sizeof(uint64_t));
+    tl->cpu_us = malloc(capacity * sizeof(uint64_t));
+    tl->read_bytes = malloc(capacity * sizeof(uint64_t));
+    tl->write_bytes = malloc(capacity * sizeof(uint64_t));
+    tl->rss_kb = malloc(capacity * sizeof(uint32_t));
+    tl->threads = malloc(capacity * sizeof(uint16_t));
+    if (!tl->time_us || !tl->cpu_us || !tl->read_bytes || !tl->write_bytes || !tl->rss_kb || !tl->threads) {
+        rune_timeline_free(tl);
+        return -1;
+    }
+    tl->capacity = capacity;
+    tl->stride = 1;
+    return 0;
+}
+
+static void rune_timeline_close(rune_timeline_t *tl) {
+    if (tl->stat_fd >= 0) close(tl->stat_fd);
+    if (tl->io_fd >= 0) close(tl->io_fd);
+    if (tl->sched_fd >= 0) close(tl->sched_fd);
+    tl->stat_fd = -1;
+    tl->io_fd = -1;
+    tl->sched_fd = -1;
+}
+
+void rune_timeline_free(rune_timeline_t *tl) {
+    // A zeroed, never initialized timeline has no descriptors of its own
+    if (tl->capacity) rune_timeline_close(tl);
+    free(tl->time_us);
+    free(tl->cpu_us);
+    free(tl->read_bytes);
+    free(tl->write_bytes);
+    free(tl->rss_kb);
+    free(tl->threads);
+    memset(tl, 0, sizeof(*tl));
+    tl->stat_fd = -1;
+    tl->io_fd = -1;
+    tl->sched_fd = -1;
+}
+
+void rune_timeline_begin(rune_timeline_t *tl, pid_t pid, const struct timespec *start) {
+    rune_timeline_close(tl);
+    tl->count = 0;
+    tl->stride = 1;
+    tl->offered = 0;
+    tl->ended = 0;
+    tl->pid = pid;
+    tl->start = *start;
+
+    char path[64];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    tl->stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+    snprintf(path, sizeof(path), "/proc/%d/io", (int)pid);
+    tl->io_fd = open(path, O_RDONLY | O_CLOEXEC);
+    snprintf(path, sizeof(path), "/proc/%d/schedstat", (int)pid);
+    tl->sched_fd = open(path, O_RDONLY | O_CLOEXEC);
+}
+
+// Halve the resolution: keep samples 0, 2, 4, ...
+static void rune_timeline_decimate(rune_timeline_t *tl) {
+    size_t kept = 0;
+    for (size_t i = 0; i < tl->count; i += 2, kept++) {
+        tl->time_us[kept] = tl->time_us[i];
+        tl->cpu_us[kept] = tl->cpu_us[i];
+        tl->read_bytes[kept] = tl->read_bytes[i];
+        tl->write_bytes[kept] = tl->write_bytes[i];
+        tl->rss_kb[kept] = tl->rss_kb[i];
+        tl->threads[kept] = tl->threads[i];
+    }
+    tl->count = kept;
+    tl->stride *= 2;
+}
+
+static void rune_timeline_append(rune_timeline_t *tl, uint64_t time_us, uint64_t cpu_us,
+                                 uint64_t read_bytes, uint64_t write_bytes,
+                                 uint32_t rss_kb, uint16_t threads) {
+    if (tl->count == tl->capacity) rune_timeline_decimate(tl);
+    size_t i = tl->count++;
+    tl->time_us[i] = time_us;
+    tl->cpu_us[i] = cpu_us;
+    tl->read_bytes[i] = read_bytes;
+    tl->write_bytes[i] = write_bytes;
+    tl->rss_kb[i] = rss_kb;
+    tl->threads[i] = threads;
+}
+
+static uint64_t rune_timeline_now_us(const rune_timeline_t *tl) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t us = (int64_t)(now.tv_sec - tl->start.tv_sec) * 1000000 +
+                 (now.tv_nsec - tl->start.tv_nsec) / 1000;
+    return us > 0 ? (uint64_t)us : 0;
+}
+
+int rune_timeline_sample(rune_timeline_t *tl) {
+    if (!tl->capacity || tl->stat_fd < 0) return -1;
+    if (tl->offered++ % tl->stride != 0) return 0;
+
+    char buf[1024];
+    ssize_t n = pread(tl->stat_fd, buf, sizeof(buf) - 1, 0);
+    if (n <= 0) return -1;
+    buf[n] = '\0';
+
+    // Fields after "pid (comm)": state is field 3, utime 14, stime 15,
+    // num_threads 20, rss 24. comm may contain spaces, so start at the last ')'.
+    char *p = strrchr(buf, ')');
+    if (!p || p[1] == '\0' || p[2] == 'Z') return -1; // Exited, about to be reaped
+    unsigned long long utime = 0, stime = 0, threads = 0, rss_pages = 0;
+    int field = 2;
+    char *save = NULL;
+    for (char *tok = strtok_r(p + 1, " ", &save); tok; tok = strtok_r(NULL, " ", &save)) {
+        field++;
+        if (field == 14) utime = strtoull(tok, NULL, 10);
+        else if (field == 15) stime = strtoull(tok, NULL, 10);
+        else if (field == 20) threads = strtoull(tok, NULL, 10);
+        else if (field == 24) {
+            rss_pages = strtoull(tok, NULL, 10);
+            break;
+        }
+    }
+
+    uint64_t read_bytes = 0, write_bytes = 0;
+    if (tl->io_fd >= 0) {
+        n = pread(tl->io_fd, buf, sizeof(buf) - 1, 0);
+        if (n > 0) {
+            buf[n] = '\0';
+            char *rchar = strstr(buf, "rchar: ");
+            char *wchar = strstr(buf, "wchar: ");
+            if (rchar) read_bytes = strtoull(rchar + 7, NULL, 10);
+            if (wchar) write_bytes = strtoull(wchar + 7, NULL, 10);
+        }
+    }
+
+    // Ticks cover every thread; the main thread's run time refines them to
+    // the nanosecond, and the column stays cumulative whichever is ahead
+    long ticks_per_second = sysconf(_SC_CLK_TCK);
+    uint64_t cpu_us = (utime + stime) * 1000000ULL / (unsigned long long)ticks_per_second;
+    if (tl->sched_fd >= 0) {
+        n = pread(tl->sched_fd, buf, sizeof(buf) - 1, 0);
+        if (n > 0) {
+            buf[n] = '\0';
+            uint64_t main_us = strtoull(buf, NULL, 10) / 1000;
+            if (main_us > cpu_us) cpu_us = main_us;
+        }
+    }
+    if (tl->count > 0 && tl->cpu_us[tl->count - 1] > cpu_us) cpu_us = tl->cpu_us[tl->count - 1];
+
+    long page_kb = sysconf(_SC_PAGESIZE) / 1024;
+    rune_timeline_append(tl, rune_timeline_now_us(tl), cpu_us,
+                         read_bytes, write_bytes,
+                         (uint32_t)(rss_pages * (unsigned long long)page_kb),
+                         threads > UINT16_MAX ? UINT16_MAX : (uint16_t)threads);
+    return 0;
+}
+
+void rune_timeline_end(rune_timeline_t *tl, double total_seconds, double cpu_seconds) {
+    rune_timeline_close(tl);
+    if (!tl->capacity) return;
+
+    // The process is gone: exact CPU total from wait4(), nothing resident
+    uint64_t read_bytes = 0, write_bytes = 0;
+    if (tl->count > 0) {
+        read_bytes = tl->read_bytes[tl->count - 1];
+        write_bytes = tl->write_bytes[tl->count - 1];
+    }
+    rune_timeline_append(tl, (uint64_t)(total_seconds * 1000000.0), (uint64_t)(cpu_seconds * 1000000.0),
+                         read_bytes, write_bytes, 0, 0);
+    tl->ended = 1;
+}
+
+static int rune_timeline_compare_double(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// 75th percentile of values[0..n) (uses scratch)
+static double rune_timeline_p75(const double *values, double *scratch, size_t n) {
+    memcpy(scratch, values, n * sizeof(double));
+    qsort(scratch, n, sizeof(double), rune_timeline_compare_double);
+    return scratch[(n * 3) / 4];
+}
+
+void rune_timeline_detect_phases(const rune_timeline_t *tl, double total_seconds, rune_phases_t *phases) {
+    memset(phases, 0, sizeof(*phases));
+    phases->processing = total_seconds;
+    phases->signal = "none";
+
+    size_t n = tl->count;
+    if (n < 3 || tl->time_us[n - 1] == 0) return;
+    size_t intervals = n - 1;
+
+    double *cpu = malloc(intervals * sizeof(double));
+    double *io = malloc(intervals * sizeof(double));
+    double *activity = malloc(intervals * sizeof(double));
+    double *scratch = malloc(intervals * sizeof(double));
+    if (!cpu || !io || !activity || !scratch) goto out;
+
+    // Smoothed rates over a centered window of at least RUNE_PHASE_MIN_WINDOW_US.
+    // The columns are cumulative, so a window rate is one subtraction.
+    double mean_dt = (double)tl->time_us[n - 1] / intervals;
+    size_t half = (size_t)(RUNE_PHASE_MIN_WINDOW_US / mean_dt / 2.0);
+    for (size_t i = 0; i < intervals; i++) {
+        size_t lo = i > half ? i - half : 0;
+        size_t hi = i + 1 + half < n ? i + 1 + half : n - 1;
+        double dt = (double)(tl->time_us[hi] - tl->time_us[lo]) / 1000000.0;
+        if (dt <= 0) {
+            cpu[i] = io[i] = 0.0;
+            continue;
+        }
+        double dcpu = tl->cpu_us[hi] > tl->cpu_us[lo] ? (double)(tl->cpu_us[hi] - tl->cpu_us[lo]) : 0.0;
+        double dio = (double)(tl->read_bytes[hi] - tl->read_bytes[lo]) +
+                     (double)(tl->write_bytes[hi] - tl->write_bytes[lo]);
+        cpu[i] = dcpu / 1000000.0 / dt;
+        io[i] = dio / dt;
+    }
+
+    // Each busy signal normalized to its own steady level, then summed
+    double cpu_level = rune_timeline_p75(cpu, scratch, intervals);
+    double io_level = rune_timeline_p75(io, scratch, intervals);
+    int use_cpu = cpu_level >= RUNE_PHASE_CPU_FLOOR;
+    int use_io = io_level >= RUNE_PHASE_IO_FLOOR;
+    double threshold;
+    if (use_cpu || use_io) {
+        for (size_t i = 0; i < intervals; i++) {
+            activity[i] = (use_cpu ? cpu[i] / cpu_level : 0.0) + (use_io ? io[i] / io_level : 0.0);
+        }
+        threshold = 0.5 * rune_timeline_p75(activity, scratch, intervals);
+        phases->signal = use_cpu && use_io ? "cpu+io" : use_cpu ? "cpu" : "io";
+    } else {
+        // Idle target: the working set is the only thing that moves
+        uint32_t peak = 0;
+        for (size_t i = 0; i < n; i++) {
+            if (tl->rss_kb[i] > peak) peak = tl->rss_kb[i];
+        }
+        if (peak == 0) goto out;
+        for (size_t i = 0; i < intervals; i++) activity[i] = tl->rss_kb[i + 1];
+        threshold = 0.9 * peak;
+        phases->signal = "rss";
+    }
+
+    size_t first = intervals, last = 0;
+    for (size_t i = 0; i < intervals; i++) {
+        if (activity[i] >= threshold && threshold > 0) {
+            if (first == intervals) first = i;
+            last = i;
+        }
+    }
+    if (first == intervals) {
+        phases->signal = "none";
+        goto out;
+    }
+
+    // Interval i spans samples i .. i+1
+    double startup_end = tl->time_us[first] / 1000000.0;
+    double teardown_start = tl->time_us[last + 1] / 1000000.0;
+    if (teardown_start > total_seconds) teardown_start = total_seconds;
+    if (startup_end > teardown_start) startup_end = teardown_start;
+    phases->startup = startup_end;
+    phases->cleanup = total_seconds - teardown_start;
+    phases->processing = teardown_start - startup_end;
+    phases->measured = 1;
+
+out:
+    free(cpu);
+    free(io);
+    free(activity);
+    free(scratch);
+}
+
+int rune_timeline_export_csv(const rune_timeline_t *tl, const rune_phases_t *phases, const char *path) {
+    FILE *out = fopen(path, "w");
+    if (!out) return -1;
+
+    double startup_end = phases->startup;
+    double teardown_start = phases->startup + phases->processing;
+    fprintf(out, "time_ms,cpu_ms,cpu_util,rss_kb,read_bytes,write_bytes,threads,phase\n");
+    for (size_t i = 0; i < tl->count; i++) {
+        double t = tl->time_us[i] / 1000000.0;
+        double util = 0.0;
+        if (i > 0 && tl->time_us[i] > tl->time_us[i - 1] && tl->cpu_us[i] >= tl->cpu_us[i - 1]) {
+            util = (double)(tl->cpu_us[i] - tl->cpu_us[i - 1]) / (double)(tl->time_us[i] - tl->time_us[i - 1]);
+        }
+        const char *phase = !phases->measured ? "unknown"
+                          : t < startup_end ? "startup"
+                          : t <= teardown_start ? "steady" : "teardown";
+        // The exit row's wait4() total is not comparable with the sampled one before it
+        char util_text[32] = "";
+        if (!(tl->ended && i == tl->count - 1)) snprintf(util_text, sizeof(util_text), "%.3f", util);
+        fprintf(out, "%.3f,%.3f,%s,%u,%llu,%llu,%u,%s\n",
+                tl->time_us[i] / 1000.0, tl->cpu_us[i] / 1000.0, util_text, tl->rss_kb[i],
+                (unsigned long long)tl->read_bytes[i], (unsigned long long)tl->write_bytes[i],
+                (unsigned)tl->threads[i], phase);
+    }
+
+    if (fclose(out) != 0) return -1;
+    return 0;
+}
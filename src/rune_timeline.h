@@ -0,0 +1,123 @@
+/**
+ * rune_timeline.h - High-resolution resource timeline and phase detection
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * The sampler reads the target's CPU time, RSS, I/O bytes and thread
+ * count from /proc (descriptors opened once, pread() per sample) into
+ * fixed-size columns: one array per metric, so a scan over one metric
+ * touches only that metric's cache lines. When the columns fill up
+ * every second sample is dropped and the keep stride doubles, so the
+ * buffer always spans the whole run - the startup ramp is never
+ * overwritten by a long steady state.
+ *
+ * The phase detector splits the run into startup ramp, steady state and
+ * teardown from the recorded activity.
+ *
+ * libc only, like rune_supervisor.c.
+ */
+
+#ifndef RUNE_TIMELINE_H
+#define RUNE_TIMELINE_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+#include <time.h>
+
+#define RUNE_TIMELINE_CAPACITY 16384    // Samples per run before decimation
+#define RUNE_TIMELINE_MAX_RATE_HZ 1000
+
+// Columnar sample store for one run
+typedef struct rune_timeline {
+    size_t capacity;
+    size_t count;               // Samples held
+    unsigned stride;            // Keep one of every stride offered samples
+    unsigned long offered;      // Samples offered since rune_timeline_begin()
+
+    // Columns (capacity entries each)
+    uint64_t *time_us;          // Since launch
+    uint64_t *cpu_us;           // User + system time of the target (see rune_timeline_sample())
+    uint64_t *read_bytes;       // rchar: bytes through read()-family syscalls
+    uint64_t *write_bytes;      // wchar: bytes through write()-family syscalls
+    uint32_t *rss_kb;
+    uint16_t *threads;
+
+    // Sampler state
+    pid_t pid;
+    int stat_fd;                // /proc/<pid>/stat
+    int io_fd;                  // /proc/<pid>/io (-1 if not readable)
+    int sched_fd;               // /proc/<pid>/schedstat (-1 if the kernel lacks it)
+    int ended;                  // The last sample is the exit row of rune_timeline_end()
+    struct timespec start;
+} rune_timeline_t;
+
+// Where the run spent its time
+typedef struct rune_phases {
+    double startup;             // Launch until the steady state is reached
+    double processing;          // Steady state
+    double cleanup;             // Activity falling off until exit
+    int measured;               // 0: too few samples, everything counted as processing
+    const char *signal;         // Activity signal the boundaries came from
+} rune_phases_t;
+
+/**
+ * @brief Allocate the columns
+ * @return 0 on success, -1 on allocation failure
+ */
+int rune_timeline_init(rune_timeline_t *tl, size_t capacity);
+
+/**
+ * @brief Release the columns (safe on a zeroed, never initialized timeline)
+ */
+void rune_timeline_free(rune_timeline_t *tl);
+
+/**
+ * @brief Forget previous samples and start following pid
+ * @param start Launch time (CLOCK_MONOTONIC), time zero of the timeline
+ */
+void rune_timeline_begin(rune_timeline_t *tl, pid_t pid, const struct timespec *start);
+
+/**
+ * @brief Take one sample of the target now
+ *
+ * CPU time is the larger of /proc/<pid>/stat (whole process, clock
+ * ticks) and /proc/<pid>/schedstat (main thread, nanoseconds), so a
+ * single-threaded target gets usable utilization at 1 kHz while other
+ * threads still count at tick granularity.
+ *
+ * @return 0 on success, -1 if /proc could not be read (target gone)
+ */
+int rune_timeline_sample(rune_timeline_t *tl);
+
+/**
+ * @brief Stop sampling and append the exact final state
+ *
+ * The exit row's CPU time comes from wait4(), not from the sampler, so
+ * the CSV export leaves its cpu_util empty rather than compare the two.
+ *
+ * @param total_seconds Wall time from launch to exit
+ * @param cpu_seconds User + system time from wait4()
+ */
+void rune_timeline_end(rune_timeline_t *tl, double total_seconds, double cpu_seconds);
+
+/**
+ * @brief Find startup / steady-state / teardown boundaries
+ *
+ * Activity is CPU utilization plus I/O rate, each normalized to its
+ * 75th percentile and smoothed over at least 50 ms (threads other than
+ * the main one only move in clock ticks). Startup ends when activity
+ * first reaches half the steady level, teardown starts after the last
+ * interval that does.
+ * Targets that barely use CPU or I/O are split on RSS instead.
+ */
+void rune_timeline_detect_phases(const rune_timeline_t *tl, double total_seconds, rune_phases_t *phases);
+
+/**
+ * @brief Write the timeline as CSV, one row per sample
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_timeline_export_csv(const rune_timeline_t *tl, const rune_phases_t *phases, const char *path);
+
+#endif /* RUNE_TIMELINE_H */
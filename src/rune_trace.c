@@ -0,0 +1,199 @@
+/**
+ * rune_trace.c - Chrome Trace Event export implementation
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ */
+
+#include "rune_analyze.h"
+#include "rune_intern.h"
+#include "rune_trace.h"
+
+#define RUNE_TRACE_BUFFER_SIZE (1 << 16)    // stdio buffer of the trace file
+
+typedef struct rune_trace_writer {
+    FILE *out;
+    const rune_context_t *ctx;
+    pid_t pid;                  // Analyzer track
+    pid_t target_pid;           // Target track (root of the process tree)
+    int first;                  // No event written yet
+    uint64_t named_threads;     // Thread tracks 1-64 that got their name
+} rune_trace_writer_t;
+
+static void rune_trace_string(FILE *out, const char *s) {
+    fputc('"', out);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', out);
+            fputc(c, out);
+        } else if (c < 0x20) {
+            fprintf(out, "\\u%04x", c);
+        } else {
+            fputc(c, out);
+        }
+    }
+    fputc('"', out);
+}
+
+// Start an event object: {"ph":..,"pid":..,"tid":..,"ts":..
+static void rune_trace_begin(rune_trace_writer_t *w, char phase, pid_t pid, long tid, double ts_us) {
+    fprintf(w->out, "%s\n{\"ph\":\"%c\",\"pid\":%d,\"tid\":%ld,\"ts\":%.3f",
+            w->first ? "" : ",", phase, (int)pid, tid, ts_us);
+    w->first = 0;
+}
+
+static void rune_trace_metadata(rune_trace_writer_t *w, const char *what, pid_t pid, long tid, const char *name) {
+    rune_trace_begin(w, 'M', pid, tid, 0);
+    fprintf(w->out, ",\"name\":\"%s\",\"args\":{\"name\":", what);
+    rune_trace_string(w->out, name);
+    fputs("}}", w->out);
+}
+
+static double rune_trace_us(const rune_context_t *ctx, uint64_t time_ns) {
+    return (double)(int64_t)(time_ns - ctx->checkpoint_start_ns) / 1000.0;
+}
+
+// FUNC: <name> started / completed, as written by RUNE_LOG_FUNC_START/END
+static int rune_trace_span_phase(const char *id, size_t *name_len) {
+    static const char prefix[] = "FUNC: ", started[] = " started", completed[] = " completed";
+    size_t len = strlen(id);
+    if (strncmp(id, prefix, sizeof(prefix) - 1) != 0) {
+        return 0;
+    }
+    if (len > sizeof(prefix) - 1 + sizeof(started) - 1 &&
+        strcmp(id + len - (sizeof(started) - 1), started) == 0) {
+        *name_len = len - (sizeof(prefix) - 1) - (sizeof(started) - 1);
+        return 'B';
+    }
+    if (len > sizeof(prefix) - 1 + sizeof(completed) - 1 &&
+        strcmp(id + len - (sizeof(completed) - 1), completed) == 0) {
+        *name_len = len - (sizeof(prefix) - 1) - (sizeof(completed) - 1);
+        return 'E';
+    }
+    return 0;
+}
+
+static int rune_trace_checkpoint(const rune_checkpoint_record_t *record, void *arg) {
+    rune_trace_writer_t *w = arg;
+    long tid = (long)(record->flags >> RUNE_CHECKPOINT_THREAD_SHIFT);
+    pid_t pid = w->pid;
+    if (record->flags & RUNE_CHECKPOINT_TARGET) {
+        // Logged by the target through rune_probe.h: its own track, real tids
+        pid = w->target_pid;
+    } else if (tid == 0) {
+        tid = 1;
+    }
+    if (pid == w->pid && tid <= 64 && !(w->named_threads & (1ull << (tid - 1)))) {
+        char name[32];
+        snprintf(name, sizeof(name), "thread %ld", tid);
+        rune_trace_metadata(w, "thread_name", w->pid, tid, name);
+        w->named_threads |= 1ull << (tid - 1);
+    }
+
+    const char *id = rune_intern_string(record->id);
+    double ts = rune_trace_us(w->ctx, record->time_ns);
+    size_t name_len;
+    int phase = record->category == RUNE_CATEGORY_FUNC ? rune_trace_span_phase(id, &name_len) : 0;
+    if (phase) {
+        char name[64];
+        snprintf(name, sizeof(name), "%.*s", (int)name_len, id + 6);
+        rune_trace_begin(w, (char)phase, pid, tid, ts);
+        fputs(",\"cat\":\"FUNC\",\"name\":", w->out);
+        rune_trace_string(w->out, name);
+        fputc('}', w->out);
+    } else {
+        rune_trace_begin(w, 'i', pid, tid, ts);
+        fputs(",\"s\":\"t\",\"cat\":", w->out);
+        rune_trace_string(w->out, rune_checkpoint_category_name(record->category));
+        fputs(",\"name\":", w->out);
+        rune_trace_string(w->out, id);
+        fputs(",\"args\":{", w->out);
+        if (record->context != RUNE_INTERN_NONE) {
+            fputs("\"context\":", w->out);
+            rune_trace_string(w->out, rune_intern_string(record->context));
+            fputc(',', w->out);
+        }
+        fprintf(w->out, "\"trigger_fired\":%s}}", (record->flags & RUNE_CHECKPOINT_TRIGGERED) ? "true" : "false");
+    }
+    return ferror(w->out) ? -1 : 0;
+}
+
+// The target's processes and sampler counters, on the root's pid
+static void rune_trace_target(rune_trace_writer_t *w) {
+    const rune_context_t *ctx = w->ctx;
+    const rune_proctree_t *pt = &ctx->proctree;
+    const rune_timeline_t *tl = &ctx->timeline;
+    pid_t root = w->target_pid;
+    if (root <= 0 || (!pt->count && !tl->count)) {
+        return;
+    }
+    const struct timespec *start = pt->count ? &pt->start : &tl->start;
+    double launch_us = rune_trace_us(ctx, (uint64_t)start->tv_sec * 1000000000ull + (uint64_t)start->tv_nsec);
+
+    char name[PATH_MAX + 16];
+    const char *exe = strrchr(ctx->config.target_executable, '/');
+    snprintf(name, sizeof(name), "target: %s", exe ? exe + 1 : ctx->config.target_executable);
+    rune_trace_metadata(w, "process_name", root, 0, name);
+    rune_trace_begin(w, 'M', root, 0, 0);
+    fputs(",\"name\":\"process_sort_index\",\"args\":{\"sort_index\":1}}", w->out);
+
+    for (size_t i = 0; i < pt->count; i++) {
+        const rune_proc_t *proc = &pt->procs[i];
+        snprintf(name, sizeof(name), "%s (%d)", proc->comm, (int)proc->pid);
+        rune_trace_metadata(w, "thread_name", root, proc->pid, name);
+        rune_trace_begin(w, 'X', root, proc->pid, launch_us + (double)proc->start_us);
+        fprintf(w->out, ",\"dur\":%llu,\"cat\":\"process\",\"name\":",
+                (unsigned long long)(proc->end_us > proc->start_us ? proc->end_us - proc->start_us : 0));
+        rune_trace_string(w->out, proc->comm);
+        fprintf(w->out, ",\"args\":{\"ppid\":%d,\"cpu_ms\":%.3f,\"peak_rss_kb\":%u,\"read_bytes\":%llu,"
+                "\"write_bytes\":%llu}}",
+                (int)proc->ppid, proc->cpu_us / 1000.0, proc->peak_rss_kb,
+                (unsigned long long)proc->own_read_bytes, (unsigned long long)proc->own_write_bytes);
+    }
+
+    for (size_t i = 0; i < tl->count; i++) {
+        double ts = launch_us + (double)tl->time_us[i];
+        double cpu_percent = 0.0;
+        if (i > 0 && tl->time_us[i] > tl->time_us[i - 1]) {
+            cpu_percent = 100.0 * (double)(tl->cpu_us[i] - tl->cpu_us[i - 1]) /
+                          (double)(tl->time_us[i] - tl->time_us[i - 1]);
+        }
+        rune_trace_begin(w, 'C', root, 0, ts);
+        fprintf(w->out, ",\"name\":\"cpu\",\"args\":{\"percent\":%.1f}}", cpu_percent);
+        rune_trace_begin(w, 'C', root, 0, ts);
+        fprintf(w->out, ",\"name\":\"memory\",\"args\":{\"rss_kb\":%u}}", tl->rss_kb[i]);
+        rune_trace_begin(w, 'C', root, 0, ts);
+        fprintf(w->out, ",\"name\":\"io\",\"args\":{\"read_bytes\":%llu,\"write_bytes\":%llu}}",
+                (unsigned long long)tl->read_bytes[i], (unsigned long long)tl->write_bytes[i]);
+        rune_trace_begin(w, 'C', root, 0, ts);
+        fprintf(w->out, ",\"name\":\"threads\",\"args\":{\"threads\":%u}}", (unsigned)tl->threads[i]);
+    }
+}
+
+int rune_trace_export(const rune_context_t *ctx, const char *path) {
+    FILE *out = fopen(path, "w");
+    if (!out) {
+        return -1;
+    }
+    setvbuf(out, NULL, _IOFBF, RUNE_TRACE_BUFFER_SIZE);
+
+    rune_trace_writer_t w = { .out = out, .ctx = ctx, .pid = getpid(), .first = 1 };
+    w.target_pid = ctx->proctree.count ? ctx->proctree.procs[0].pid : ctx->results.child_pid;
+    fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", out);
+    rune_trace_metadata(&w, "process_name", w.pid, 0, "rune_analyze");
+    rune_trace_begin(&w, 'M', w.pid, 0, 0);
+    fputs(",\"name\":\"process_sort_index\",\"args\":{\"sort_index\":0}}", out);
+
+    int result = rune_checkpoint_foreach(ctx, rune_trace_checkpoint, &w);
+    rune_trace_target(&w);
+    fputs("\n]}\n", out);
+
+    if (result != 0 || ferror(out)) {
+        int error = ferror(out) ? EIO : ENOMEM;
+        fclose(out);
+        errno = error;
+        return -1;
+    }
+    return fclose(out) == 0 ? 0 : -1;
+}
@@ -0,0 +1,36 @@
+/**
+ * rune_trace.h - Chrome Trace Event export of a run
+ *
+ * Copyright (C) 2025 Christopher Michko
+ * Co-developed with GitHub Copilot AI Assistant
+ *
+ * Writes the JSON object format of the Trace Event spec, which
+ * chrome://tracing and ui.perfetto.dev open directly:
+ *
+ *   rune_analyze (our pid)  one thread track per logging thread;
+ *                           FUNC started/completed checkpoints become
+ *                           duration (B/E) events, every other
+ *                           checkpoint an instant event
+ *   target (its pid)        one thread track per process of the tree
+ *                           with its lifetime, and counter tracks for
+ *                           CPU, RSS, I/O and threads from the sampler;
+ *                           checkpoints the target logged (--probe) go
+ *                           on the thread track of the tid that logged them
+ *
+ * Timestamps are microseconds since rune_checkpoint_init(). Events are
+ * written while the records are read back, spilled ones included, so
+ * memory stays bounded however long the run was.
+ */
+
+#ifndef RUNE_TRACE_H
+#define RUNE_TRACE_H
+
+struct rune_context;
+
+/**
+ * @brief Write ctx's checkpoints, spans, process tree and samples as a trace
+ * @return 0 on success, -1 on error (errno is set)
+ */
+int rune_trace_export(const struct rune_context *ctx, const char *path);
+
+#endif /* RUNE_TRACE_H */
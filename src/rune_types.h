@@ -12,6 +12,7 @@
 
 #include <sys/types.h>
 #include <limits.h>
+#include <stdint.h>
 
 // Analysis result structure - comprehensive data collection
 typedef struct rune_results {
@@ -62,6 +63,9 @@ typedef struct rune_results {
     double startup_time;
     double processing_time;
     double cleanup_time;
+    int phases_measured;        // Timing breakdown comes from the sampled timeline
+    char phase_signal[16];      // Activity signal the phase boundaries came from
+    int timeline_samples;
     int output_complexity_score;
     int resource_efficiency_score;
     char performance_category[32];
@@ -88,6 +92,61 @@ typedef struct rune_results {
     double cpu_usage_percent;
     long context_switches;
     
+    // Kernel resource accounting (wait4 rusage of the reaped target)
+    double user_time;
+    double system_time;
+    long minor_faults;
+    long major_faults;
+    long voluntary_context_switches;
+    long involuntary_context_switches;
+    
+    // Whole process-tree accounting from the per-run cgroup (-1 = unavailable)
+    int cgroup_enabled;
+    long long cgroup_cpu_usage_usec;
+    long long cgroup_cpu_user_usec;
+    long long cgroup_cpu_system_usec;
+    long long cgroup_memory_peak_bytes;
+    long long cgroup_io_read_bytes;
+    long long cgroup_io_write_bytes;
+    
+    // Every process the target forked, followed through /proc
+    int tree_processes;         // Distinct processes seen, the target included
+    int tree_max_concurrent;
+    double tree_cpu_seconds;    // wait4() totals where the kernel keeps them, samples otherwise
+    long tree_peak_rss_kb;      // Largest RSS sum of processes alive at the same time
+    unsigned long long tree_read_bytes;
+    unsigned long long tree_write_bytes;
+    int tree_orphans_reaped;    // Outlived their parent, reaped by us as subreaper
+    int tree_still_running;     // Descendants alive after the target exited
+    
+    // perf_event_open counters over the whole process tree (-1 = unavailable)
+    int perf_enabled;
+    int perf_hardware;          // PMU counters collected, not just software ones
+    long long perf_task_clock_ns;
+    long long perf_page_faults;
+    long long perf_context_switches;
+    long long perf_cpu_migrations;
+    long long perf_instructions;
+    long long perf_cycles;
+    long long perf_cache_references;
+    long long perf_cache_misses;
+    long long perf_branches;
+    long long perf_branch_misses;
+    double perf_ipc;            // Instructions per cycle (0 = no PMU)
+    double perf_cache_miss_rate; // Misses per cache reference
+    double perf_branch_miss_rate; // Misses per branch instruction
+    
+    // Checkpoints the target logged through rune_probe.h
+    int probe_enabled;
+    int probe_preloaded;        // librune_probe.so was preloaded
+    unsigned long long probe_events; // Merged into the timeline
+    unsigned long long probe_dropped; // Lost in the target (ring full or no lane left)
+    
+    // Output capture
+    int capture_zero_copy;      // Output moved with tee()/splice() end to end
+    unsigned long long capture_dropped_bytes; // Forwarded but skipped by the pattern analyzers
+    int timed_out;              // Killed by --timeout
+    
     // Vulnerability Analysis
     char vulnerable_functions[10][64];
     int vulnerable_function_count;
@@ -134,6 +193,30 @@ typedef struct rune_config {
     int enable_deep_analysis;   // Enable deep analysis (auto-enabled in -vv mode)
     int enable_network_analysis; // Enable network behavior analysis
     int enable_monitoring;      // Enable process monitoring mode (classic Unix way)
+    int enable_cgroup;          // Run the target in its own cgroup v2 leaf
+    char cgroup_parent[PATH_MAX]; // cgroup v2 directory for the leaf (empty = our own)
+    int enable_perf;            // Count the target tree with perf_event_open()
+    int enable_probe;           // Hand the target checkpoint rings (rune_probe.h)
+    char probe_library[PATH_MAX]; // librune_probe.so to preload (empty = next to us, if there)
+    int batch_worker;           // Other targets run in this process: no child subreaper
+    int zero_copy_capture;      // Forward output with tee()/splice(), analyze it from a ring
+    double timeout_seconds;     // Kill the target after this long (0 = no limit)
+    int discard_target_output;  // Analyze the target's output without forwarding it
+    int launch_method;          // rune_launch_method_t: spawn (default), vfork or fork
+    int spawn_benchmark;        // --spawn-benchmark: iterations per launch method
+    int sample_rate_hz;         // Timeline sampling rate (0 = RUNE_SAMPLE_RATE_HZ)
+    char timeline_path[PATH_MAX]; // --timeline: export samples as CSV
+    char flamegraph_path[PATH_MAX]; // --flamegraph: export spans as folded stacks
+    char trace_path[PATH_MAX];  // --trace: export the run as Chrome Trace Event JSON
+    int checkpoint_memory_mb;   // Checkpoint memory before spilling to disk (0 = RUNE_CHECKPOINT_MEMORY_MB)
+    int async_triggers;         // Run the built-in triggers on the dispatch pool
+    int async_log;              // Queue info/debug output for a background writer
+    int trigger_workers;        // Dispatch pool size (0 = RUNE_DISPATCH_WORKERS)
+    int trigger_overflow;       // rune_trigger_overflow_t: drop (default), block or coalesce
+    
+    // 📦 Batch mode
+    char batch_manifest[PATH_MAX]; // One target plus arguments per line
+    int batch_jobs;             // Worker threads (0 = online CPUs)
     
     // 🛡️ EXPLICIT EXECUTION CONTROL
     int force_execution;        // -f flag: explicit permission to execute
@@ -164,12 +247,80 @@ typedef struct rune_checkpoint {
     int trigger_fired;          // Whether this checkpoint triggered analysis
 } rune_checkpoint_t;
 
+// Built-in checkpoint categories (RUNE_CHECKPOINT_LOAD ... in rune_checkpoint.h).
+// Their interned handles are reserved at startup, so each value is also the
+// handle of its name; any other category is an ordinary interned handle.
+typedef enum rune_checkpoint_category {
+    RUNE_CATEGORY_LOAD = 2,     // First handle after RUNE_INTERN_NONE/FULL
+    RUNE_CATEGORY_FUNC,
+    RUNE_CATEGORY_SYSCALL,
+    RUNE_CATEGORY_MEM,
+    RUNE_CATEGORY_NET,
+    RUNE_CATEGORY_SEC,
+    RUNE_CATEGORY_PERF,
+    RUNE_CATEGORY_EXIT,
+    RUNE_CATEGORY_MISC,         // Logged without a category
+    RUNE_CATEGORY_END
+} rune_checkpoint_category_t;
+
+// Checkpoint as recorded: strings are interned (rune_intern.h), the
+// timestamp is raw, rune_checkpoint_t views are built when read
+typedef struct rune_checkpoint_record {
+    uint64_t time_ns;           // CLOCK_MONOTONIC
+    uint32_t id;                // Interned handles
+    uint32_t category;          // rune_checkpoint_category_t for the built-in ones
+    uint32_t context;
+    uint32_t flags;             // RUNE_CHECKPOINT_TRIGGERED, logging thread
+} rune_checkpoint_record_t;
+
+#define RUNE_CHECKPOINT_TRIGGERED 0x1u
+#define RUNE_CHECKPOINT_TARGET 0x2u         // Logged by the target (rune_probe.h), not by us
+#define RUNE_CHECKPOINT_THREAD_SHIFT 8      // flags >> 8: logging thread, numbered per context from 1
+                                            // (the target's tid for RUNE_CHECKPOINT_TARGET)
+
+#define RUNE_TRIGGER_MAX_CATEGORIES 4
+
+// Per-trigger dispatch statistics (updated atomically, see rune_dispatch.h)
+typedef struct rune_trigger_stats {
+    uint64_t fired;             // Callbacks run
+    uint64_t queued;            // Events handed to the async pool
+    uint64_t dropped;           // Lost to a full queue (drop policy)
+    uint64_t coalesced;         // Replaced by a later event (coalesce policy)
+    uint64_t blocked;           // Producers that waited for room (block policy)
+    uint64_t latency_ns_total;  // Checkpoint logged to callback returned
+    uint64_t latency_ns_max;
+    uint64_t run_ns_total;      // Inside the callback
+    uint64_t depth_total;       // Queue depth when queueing, summed
+    uint64_t depth_max;
+} rune_trigger_stats_t;
+
 // Analysis trigger structure
 typedef struct rune_trigger {
-    char pattern[64];           // Pattern to match (e.g., "SYSCALL:*", "FUNC:main")
+    char pattern[64];           // Glob (fnmatch) on the id, e.g. "SYSCALL:*", "FUNC: [a-m]*"
     char name[32];              // Human name for this trigger
     void (*callback)(const rune_checkpoint_t *checkpoint);  // Function to call
     int enabled;                // Whether this trigger is active
+    uint32_t categories[RUNE_TRIGGER_MAX_CATEGORIES]; // Interned; none = any category
+    int next;                   // Next trigger on the same index node (-1 = none)
+    int async;                  // Run on the context's dispatch pool
+    rune_trigger_stats_t stats;
+
+    // Coalesce policy: the latest event that found the queue full
+    rune_checkpoint_record_t latest;
+    uint64_t latest_queued_ns;
+    unsigned char latest_lock;
+    unsigned char latest_pending;
 } rune_trigger_t;
 
+// Call tree node of the span profile (see rune_span.h)
+typedef struct rune_span_node {
+    uint32_t name;              // Interned
+    int parent;                 // -1 for the root
+    int first_child;            // -1 = none
+    int next_sibling;
+    uint64_t calls;
+    uint64_t total_ns;
+    uint64_t self_ns;           // total_ns minus time in child spans
+} rune_span_node_t;
+
 #endif /* RUNE_TYPES_H */